@@ -0,0 +1,386 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Banded matrix fill shared by the single reference aligners
+///
+
+#pragma once
+
+#include "alignment/AlignerUtil.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+/// \brief A band of alignment matrix diagonals
+///
+/// The diagonal of matrix cell (queryIndex,refIndex) is (refIndex-queryIndex), so that an ungapped alignment
+/// stays on one diagonal.
+///
+struct AlignerBand {
+  AlignerBand(const int initMinDiagonal, const int initMaxDiagonal)
+    : minDiagonal(initMinDiagonal), maxDiagonal(initMaxDiagonal)
+  {
+    assert(minDiagonal <= maxDiagonal);
+  }
+
+  /// \brief Get the band containing the diagonals of two anchor positions, padded by \p width on each side
+  ///
+  /// Anchors are query positions which are known to align to a reference position, such as the first and
+  /// last shared kmers of the query and reference. Anchors on two different diagonals put the gap between
+  /// them inside the band.
+  static AlignerBand getAnchorBand(
+      const int queryPos1, const int refPos1, const int queryPos2, const int refPos2, const unsigned width)
+  {
+    const int diagonal1(refPos1 - queryPos1);
+    const int diagonal2(refPos2 - queryPos2);
+    return AlignerBand(
+        std::min(diagonal1, diagonal2) - static_cast<int>(width),
+        std::max(diagonal1, diagonal2) + static_cast<int>(width));
+  }
+
+  /// Get a band covering every matrix diagonal
+  static AlignerBand getUnboundedBand()
+  {
+    return AlignerBand(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+  }
+
+  bool isInBand(const unsigned queryIndex, const unsigned refIndex) const
+  {
+    const int64_t diagonal(static_cast<int64_t>(refIndex) - static_cast<int64_t>(queryIndex));
+    return ((diagonal >= minDiagonal) and (diagonal <= maxDiagonal));
+  }
+
+  int minDiagonal;
+  int maxDiagonal;
+};
+
+/// Range of query rows [begin,end) in one column of an alignment matrix
+struct AlignerRowRange {
+  AlignerRowRange(const unsigned initBegin, const unsigned initEnd) : begin(initBegin), end(initEnd) {}
+
+  unsigned begin;
+  unsigned end;
+};
+
+/// \brief Back-pointer matrix which only stores the cells filled by a banded alignment
+///
+/// Columns are added in order, and the cells of each column must be added in increasing row order.
+///
+template <typename T>
+struct AlignerBandMatrix {
+  /// Remove all cells, and reserve space for \p colCount columns
+  void clear(const unsigned colCount)
+  {
+    _cells.clear();
+    _ranges.clear();
+    _rangeOffsets.clear();
+    _colBegin.clear();
+    _colBegin.reserve(colCount + 1);
+  }
+
+  /// Start the next column of the matrix
+  void addColumn() { _colBegin.push_back(_ranges.size()); }
+
+  /// Add cell \p row to the current column and return a reference to its value
+  T& addCell(const unsigned row)
+  {
+    assert(not _colBegin.empty());
+    if ((_ranges.size() == _colBegin.back()) or (_ranges.back().end != row)) {
+      assert((_ranges.size() == _colBegin.back()) or (_ranges.back().end < row));
+      _ranges.emplace_back(row, row);
+      _rangeOffsets.push_back(_cells.size());
+    }
+    _ranges.back().end++;
+    _cells.emplace_back();
+    return _cells.back();
+  }
+
+  /// Get the value of a stored cell
+  const T& val(const unsigned row, const unsigned col) const
+  {
+    const size_t cellIndex(getCellIndex(row, col));
+    assert(cellIndex != noCell);
+    return _cells[cellIndex];
+  }
+
+  /// Total number of stored cells
+  size_t size() const { return _cells.size(); }
+
+private:
+  static const size_t noCell = std::numeric_limits<size_t>::max();
+
+  size_t getCellIndex(const unsigned row, const unsigned col) const
+  {
+    if (col >= _colBegin.size()) return noCell;
+    const auto rangeBegin(_ranges.begin() + _colBegin[col]);
+    const auto rangeEnd(
+        (col + 1) < _colBegin.size() ? (_ranges.begin() + _colBegin[col + 1]) : _ranges.end());
+
+    // find the last range starting at or before row:
+    auto rangeIter(
+        std::upper_bound(rangeBegin, rangeEnd, row, [](const unsigned r, const AlignerRowRange& range) {
+          return (r < range.begin);
+        }));
+    if (rangeIter == rangeBegin) return noCell;
+    --rangeIter;
+    if (row >= rangeIter->end) return noCell;
+    return (_rangeOffsets[rangeIter - _ranges.begin()] + (row - rangeIter->begin));
+  }
+
+  std::vector<T>               _cells;
+  std::vector<AlignerRowRange> _ranges;
+  std::vector<size_t>          _rangeOffsets;
+  std::vector<size_t>          _colBegin;
+};
+
+/// Score columns and filled row ranges reused across banded matrix fills
+template <typename ScoreValType>
+struct AlignerBandWorkspace {
+  void reset(const unsigned querySize)
+  {
+    for (unsigned i(0); i < 2; ++i) {
+      scores[i].resize(querySize + 1);
+      cols[i].assign(querySize + 1, noCol);
+      ranges[i].clear();
+    }
+  }
+
+  static const unsigned noCol = std::numeric_limits<unsigned>::max();
+
+  /// scores of the two most recently filled matrix columns
+  std::vector<ScoreValType> scores[2];
+
+  /// for each row of the score columns, the matrix column which filled it, or noCol
+  std::vector<unsigned> cols[2];
+
+  /// ranges of filled rows in the two most recently filled matrix columns
+  std::vector<AlignerRowRange> ranges[2];
+};
+
+/// \brief Fill the subset of an alignment matrix within \p band, and find the backtrace start
+///
+/// Each column is filled in the row ranges which can be reached from the cells filled in the previous
+/// column, and all cells outside of the filled set are treated as unreachable. A cell is filled if it is
+/// within \p band and, if \p isScoreThreshold is set, the highest score of any alignment path through the
+/// cell could reach \p scoreThreshold.
+///
+/// CellPolicy provides the matrix recursion of a specific aligner:
+/// - ScoreValType, PtrValType and AlignScoreType typedefs
+/// - scores, the AlignmentScores of the aligner
+/// - badCell, a ScoreValType with all states set to the aligner's unreachable score
+/// - maxQueryGain, the highest score change from any transition which consumes one query symbol
+/// - scoreRange, the sum of the absolute values of all aligner scores
+/// - isBandSupported, false if any transition which does not consume a query symbol can increase the score
+/// - initEdgeCell(queryIndex,val,ptr) to set the first matrix column
+/// - initTopCell(val,ptr) to set the first matrix row
+/// - updateCell(queryIndex,isMatch,diag,left,up,head,headPtr) to fill cell (queryIndex+1,refIndex+1)
+/// - getPotentialScore(val), the highest score of any state in val plus any score which the state may later
+///   recover, such that no transition which does not consume a query symbol increases this value
+///
+/// \param[in] ptrMatPtr If non-null, back-pointers of all filled cells are stored here
+template <typename CellPolicy, typename SymIter>
+void fillAlignerBand(
+    const CellPolicy&                                        policy,
+    const SymIter                                            queryBegin,
+    const SymIter                                            queryEnd,
+    const SymIter                                            refBegin,
+    const SymIter                                            refEnd,
+    const AlignerBand&                                       band,
+    const bool                                               isScoreThreshold,
+    const typename CellPolicy::AlignScoreType                scoreThreshold,
+    AlignerBandWorkspace<typename CellPolicy::ScoreValType>& workspace,
+    AlignerBandMatrix<typename CellPolicy::PtrValType>*      ptrMatPtr,
+    BackTrace<typename CellPolicy::AlignScoreType>&          btrace)
+{
+  typedef typename CellPolicy::AlignScoreType ScoreType;
+  typedef typename CellPolicy::ScoreValType   ScoreVal;
+  typedef typename CellPolicy::PtrValType     PtrVal;
+
+  const size_t querySize(std::distance(queryBegin, queryEnd));
+  const size_t refSize(std::distance(refBegin, refEnd));
+
+  workspace.reset(querySize);
+  if (ptrMatPtr != nullptr) ptrMatPtr->clear(refSize + 1);
+
+  std::vector<ScoreVal>*        thisSV(&workspace.scores[0]);
+  std::vector<ScoreVal>*        prevSV(&workspace.scores[1]);
+  std::vector<unsigned>*        thisCols(&workspace.cols[0]);
+  std::vector<unsigned>*        prevCols(&workspace.cols[1]);
+  std::vector<AlignerRowRange>* thisRanges(&workspace.ranges[0]);
+  std::vector<AlignerRowRange>* prevRanges(&workspace.ranges[1]);
+
+  // test if a cell is filled, and if so record it in the current column:
+  PtrVal     ptr;
+  const auto addCell = [&](const unsigned queryIndex, const unsigned refIndex, const ScoreVal& val) {
+    if (not band.isInBand(queryIndex, refIndex)) return;
+    if (isScoreThreshold) {
+      const int64_t bestScore(
+          static_cast<int64_t>(policy.getPotentialScore(val)) +
+          static_cast<int64_t>(querySize - queryIndex) * policy.maxQueryGain);
+      if (bestScore < scoreThreshold) return;
+    }
+    (*thisCols)[queryIndex] = refIndex;
+    if (thisRanges->empty() or (thisRanges->back().end != queryIndex)) {
+      thisRanges->emplace_back(queryIndex, queryIndex);
+    }
+    thisRanges->back().end++;
+    if (ptrMatPtr != nullptr) ptrMatPtr->addCell(queryIndex) = ptr;
+  };
+
+  if (ptrMatPtr != nullptr) ptrMatPtr->addColumn();
+  for (unsigned queryIndex(0); queryIndex <= querySize; queryIndex++) {
+    ScoreVal& val((*thisSV)[queryIndex]);
+    policy.initEdgeCell(queryIndex, val, ptr);
+    addCell(queryIndex, 0, val);
+  }
+
+  unsigned refIndex(0);
+  for (SymIter refIter(refBegin); refIter != refEnd; ++refIter, ++refIndex) {
+    std::swap(thisSV, prevSV);
+    std::swap(thisCols, prevCols);
+    std::swap(thisRanges, prevRanges);
+    thisRanges->clear();
+    if (ptrMatPtr != nullptr) ptrMatPtr->addColumn();
+
+    const unsigned col(refIndex + 1);
+    const auto     getVal = [&](const std::vector<ScoreVal>* sv,
+                            const std::vector<unsigned>* cols,
+                            const unsigned               queryIndex,
+                            const unsigned               checkCol) -> const ScoreVal& {
+      return (((*cols)[queryIndex] == checkCol) ? (*sv)[queryIndex] : policy.badCell);
+    };
+
+    // fill the row range [rowBegin,rowEnd), and continue past the end of the range for as long as the
+    // previous row is filled, because it can still reach later rows in this column:
+    unsigned   nextRow(0);
+    const auto fillRange = [&](const unsigned rowBegin, const unsigned rowEnd) {
+      unsigned row(std::max(rowBegin, nextRow));
+      for (; row <= querySize; ++row) {
+        if ((row >= rowEnd) and ((row == 0) or ((*thisCols)[row - 1] != col))) break;
+        ScoreVal& head((*thisSV)[row]);
+        if (row == 0) {
+          policy.initTopCell(head, ptr);
+        } else {
+          const unsigned queryIndex(row - 1);
+          policy.updateCell(
+              queryIndex,
+              (*(queryBegin + queryIndex) == *refIter),
+              getVal(prevSV, prevCols, queryIndex, refIndex),
+              getVal(prevSV, prevCols, row, refIndex),
+              getVal(thisSV, thisCols, queryIndex, col),
+              head,
+              ptr);
+        }
+        addCell(row, col, head);
+      }
+      nextRow = row;
+    };
+
+    // every cell in the first row is a possible alignment start, every other cell must be reached from the
+    // previous column:
+    fillRange(0, 1);
+    for (const AlignerRowRange& range : *prevRanges) {
+      fillRange(range.begin, std::min(range.end + 1, static_cast<unsigned>(querySize + 1)));
+    }
+
+    // get backtrace info:
+    if ((*thisCols)[querySize] == col) {
+      const ScoreVal& sval((*thisSV)[querySize]);
+      updateBacktrace(sval.match, col, querySize, btrace);
+    }
+  }
+
+  if ((*thisCols)[querySize] == refSize) {
+    // optionally allow for trailing insertion
+    if (policy.scores.isAllowEdgeInsertion) {
+      const ScoreVal& sval((*thisSV)[querySize]);
+      updateBacktrace(sval.ins, refSize, querySize, btrace, AlignState::INSERT);
+    }
+  }
+
+  // also allow for the case where query falls-off the end of the reference:
+  for (const AlignerRowRange& range : *thisRanges) {
+    for (unsigned queryIndex(range.begin); queryIndex < std::min(range.end, static_cast<unsigned>(querySize));
+         queryIndex++) {
+      const ScoreVal& sval((*thisSV)[queryIndex]);
+      const ScoreType thisMax(sval.match + (querySize - queryIndex) * policy.scores.offEdge);
+      updateBacktrace(thisMax, refSize, queryIndex, btrace);
+    }
+  }
+}
+
+/// \brief Find the backtrace start of the optimal alignment in a banded back-pointer matrix
+///
+/// The matrix is first filled within \p band only, which finds the score of the best alignment in the band.
+/// The matrix is then filled again without a band, skipping every cell which cannot be on any alignment path
+/// scoring at least as high as the band alignment. Every optimal alignment path is within this second fill,
+/// so the backtrace start and all back-pointers on the optimal path are the same as those from a full
+/// matrix fill. The band alignment only needs to be close to the optimal alignment for this to be fast, and
+/// the set of filled cells widens automatically wherever the optimal path leaves the initial band.
+///
+/// \return False if the band score could not be used to bound the matrix fill, in which case the caller
+/// should fall back to a full matrix alignment.
+template <typename CellPolicy, typename SymIter>
+bool getBandedBacktrace(
+    const CellPolicy&                                        policy,
+    const SymIter                                            queryBegin,
+    const SymIter                                            queryEnd,
+    const SymIter                                            refBegin,
+    const SymIter                                            refEnd,
+    const AlignerBand&                                       band,
+    AlignerBandWorkspace<typename CellPolicy::ScoreValType>& workspace,
+    AlignerBandMatrix<typename CellPolicy::PtrValType>&      ptrMat,
+    BackTrace<typename CellPolicy::AlignScoreType>&          btrace)
+{
+  typedef typename CellPolicy::AlignScoreType ScoreType;
+
+  if (not policy.isBandSupported) return false;
+
+  BackTrace<ScoreType> bandBtrace;
+  fillAlignerBand(
+      policy, queryBegin, queryEnd, refBegin, refEnd, band, false, 0, workspace, nullptr, bandBtrace);
+  if (not bandBtrace.isInit) return false;
+
+  // Skipped cells are treated as unreachable by the second fill. This is only safe if every score on the
+  // optimal path is clearly higher than the unreachable score:
+  const int64_t querySize(std::distance(queryBegin, queryEnd));
+  const int64_t minPathScore(
+      static_cast<int64_t>(bandBtrace.max) - (querySize * policy.maxQueryGain) - policy.scoreRange);
+  if (minPathScore <= policy.badCell.match) return false;
+
+  fillAlignerBand(
+      policy,
+      queryBegin,
+      queryEnd,
+      refBegin,
+      refEnd,
+      AlignerBand::getUnboundedBand(),
+      true,
+      bandBtrace.max,
+      workspace,
+      &ptrMat,
+      btrace);
+  assert(btrace.isInit and (btrace.max >= bandBtrace.max));
+  return true;
+}
@@ -19,8 +19,12 @@
 
 #pragma once
 
+#include "AlignerBand.hpp"
 #include "SingleRefAlignerShared.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 /// \brief Implementation of global alignment with affine gap costs
 ///
 /// alignment outputs start positions and CIGAR-style alignment
@@ -34,7 +38,10 @@
 /// derived from ELAND implementation by Tony Cox
 template <typename ScoreType>
 struct GlobalAligner : public SingleRefAlignerBase<ScoreType> {
-  GlobalAligner(const AlignmentScores<ScoreType>& scores) : SingleRefAlignerBase<ScoreType>(scores) {}
+  GlobalAligner(const AlignmentScores<ScoreType>& scores)
+    : SingleRefAlignerBase<ScoreType>(scores), _cellPolicy(scores)
+  {
+  }
 
   /// returns alignment path of query to reference
   template <typename SymIter>
@@ -45,6 +52,22 @@ struct GlobalAligner : public SingleRefAlignerBase<ScoreType> {
       const SymIter               refEnd,
       AlignmentResult<ScoreType>& result) const;
 
+  /// \brief returns alignment path of query to reference, using \p band to limit the matrix fill
+  ///
+  /// The result is the same as align(), \p band only needs to contain an alignment close to the optimal
+  /// alignment for this to be faster and use less memory than align(). See getBandedBacktrace() for
+  /// details.
+  ///
+  /// SymIter must be a random access iterator.
+  template <typename SymIter>
+  void alignBanded(
+      const SymIter               queryBegin,
+      const SymIter               queryEnd,
+      const SymIter               refBegin,
+      const SymIter               refEnd,
+      const AlignerBand&          band,
+      AlignmentResult<ScoreType>& result) const;
+
 private:
   // insert and delete are for query wrt reference
   struct ScoreVal {
@@ -100,11 +123,104 @@ private:
     code_t ins : 2;
   };
 
+  /// matrix recursion shared by the full and banded matrix fills, see fillAlignerBand()
+  struct CellPolicy {
+    typedef ScoreType AlignScoreType;
+    typedef ScoreVal  ScoreValType;
+    typedef PtrVal    PtrValType;
+
+    explicit CellPolicy(const AlignmentScores<ScoreType>& initScores)
+      : scores(initScores),
+        maxQueryGain(std::max({0,
+                               static_cast<int>(scores.match),
+                               static_cast<int>(scores.mismatch),
+                               static_cast<int>(scores.offEdge),
+                               static_cast<int>(scores.open + scores.extend),
+                               static_cast<int>(scores.extend)})),
+        scoreRange(
+            std::abs(scores.match) + std::abs(scores.mismatch) + std::abs(scores.open) +
+            std::abs(scores.extend) + std::abs(scores.offEdge)),
+        isBandSupported(((scores.open + scores.extend) <= 0) and (scores.extend <= 0))
+    {
+      badCell.match = getBadVal();
+      badCell.del   = getBadVal();
+      badCell.ins   = getBadVal();
+    }
+
+    static ScoreType getBadVal() { return -10000; }
+
+    /// initialize cell (queryIndex,0)
+    void initEdgeCell(const unsigned queryIndex, ScoreVal& val, PtrVal& ptr) const
+    {
+      ptr.match = AlignState::MATCH;
+      val.match = queryIndex * scores.offEdge;
+      ptr.del   = AlignState::MATCH;
+      val.del   = getBadVal();
+      if (not scores.isAllowEdgeInsertion) {
+        ptr.ins = AlignState::MATCH;
+        val.ins = getBadVal();
+      } else {
+        ptr.ins = AlignState::INSERT;
+        val.ins = scores.open + (queryIndex * scores.extend);
+      }
+    }
+
+    /// initialize cell (0,refIndex+1)
+    void initTopCell(ScoreVal& val, PtrVal& ptr) const
+    {
+      // disallow start from the delete or insert state
+      ptr.match = AlignState::MATCH;
+      val.match = 0;
+      ptr.del   = AlignState::MATCH;
+      val.del   = getBadVal();
+      ptr.ins   = AlignState::MATCH;
+      val.ins   = getBadVal();
+    }
+
+    /// fill cell (queryIndex+1,refIndex+1) from its diagonal, left and upper neighbors
+    void updateCell(
+        const unsigned  queryIndex,
+        const bool      isMatch,
+        const ScoreVal& diag,
+        const ScoreVal& left,
+        const ScoreVal& up,
+        ScoreVal&       headScore,
+        PtrVal&         headPtr) const
+    {
+      // update match
+      headPtr.match = AlignerBase<ScoreType>::max3(headScore.match, diag.match, diag.del, diag.ins);
+      headScore.match += (isMatch ? scores.match : scores.mismatch);
+
+      // update delete
+      headPtr.del = AlignerBase<ScoreType>::max3(headScore.del, left.match + scores.open, left.del, left.ins);
+      headScore.del += scores.extend;
+      if (0 == queryIndex) headScore.del = getBadVal();
+
+      // update insert
+      headPtr.ins = AlignerBase<ScoreType>::max3(headScore.ins, up.match + scores.open, getBadVal(), up.ins);
+      headScore.ins += scores.extend;
+      if (0 == queryIndex) headScore.ins = getBadVal();
+    }
+
+    ScoreType getPotentialScore(const ScoreVal& val) const { return std::max({val.match, val.del, val.ins}); }
+
+    const AlignmentScores<ScoreType> scores;
+    ScoreVal                         badCell;
+    const int64_t                    maxQueryGain;
+    const int64_t                    scoreRange;
+    const bool                       isBandSupported;
+  };
+
+  const CellPolicy _cellPolicy;
+
   // add the matrices here to reduce allocations over many alignment calls:
   typedef std::vector<ScoreVal> ScoreVec;
   mutable ScoreVec              _score1;
   mutable ScoreVec              _score2;
   mutable basic_matrix<PtrVal>  _ptrMat;
+
+  mutable AlignerBandWorkspace<ScoreVal> _bandWorkspace;
+  mutable AlignerBandMatrix<PtrVal>      _bandPtrMat;
 };
 
 #include "alignment/GlobalAlignerImpl.hpp"
@@ -54,8 +54,6 @@ void GlobalAligner<ScoreType>::align(
   ScoreVec* thisSV(&_score1);
   ScoreVec* prevSV(&_score2);
 
-  static const ScoreType badVal(-10000);
-
   // global alignment of query
   //
   // disallow start from the delete state, control start from insert state with flag
@@ -64,19 +62,7 @@ void GlobalAligner<ScoreType>::align(
   // be soft-clipped and each base off the end will be scored as offEdge
   //
   for (unsigned queryIndex(0); queryIndex <= querySize; queryIndex++) {
-    PtrVal&   headPtr(_ptrMat.val(queryIndex, 0));
-    ScoreVal& val((*thisSV)[queryIndex]);
-    headPtr.match = AlignState::MATCH;
-    val.match     = queryIndex * scores.offEdge;
-    headPtr.del   = AlignState::MATCH;
-    val.del       = badVal;
-    if (not scores.isAllowEdgeInsertion) {
-      headPtr.ins = AlignState::MATCH;
-      val.ins     = badVal;
-    } else {
-      headPtr.ins = AlignState::INSERT;
-      val.ins     = scores.open + (queryIndex * scores.extend);
-    }
+    _cellPolicy.initEdgeCell(queryIndex, (*thisSV)[queryIndex], _ptrMat.val(queryIndex, 0));
   }
 
 #ifdef DEBUG_ALN_MATRIX
@@ -93,47 +79,20 @@ void GlobalAligner<ScoreType>::align(
     for (SymIter refIter(refBegin); refIter != refEnd; ++refIter, ++refIndex) {
       std::swap(thisSV, prevSV);
 
-      {
-        // disallow start from the delete or insert state
-        PtrVal&   headPtr(_ptrMat.val(0, refIndex + 1));
-        ScoreVal& val((*thisSV)[0]);
-        headPtr.match = AlignState::MATCH;
-        val.match     = 0;
-        headPtr.del   = AlignState::MATCH;
-        val.del       = badVal;
-        headPtr.ins   = AlignState::MATCH;
-        val.ins       = badVal;
-      }
+      _cellPolicy.initTopCell((*thisSV)[0], _ptrMat.val(0, refIndex + 1));
 
       unsigned queryIndex(0);
       for (SymIter queryIter(queryBegin); queryIter != queryEnd; ++queryIter, ++queryIndex) {
-        // update match
         ScoreVal& headScore((*thisSV)[queryIndex + 1]);
         PtrVal&   headPtr(_ptrMat.val(queryIndex + 1, refIndex + 1));
-        {
-          const ScoreVal& sval((*prevSV)[queryIndex]);
-          headPtr.match = this->max3(headScore.match, sval.match, sval.del, sval.ins);
-
-          headScore.match += ((*queryIter == *refIter) ? scores.match : scores.mismatch);
-        }
-
-        // update delete
-        {
-          const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.del = this->max3(headScore.del, sval.match + scores.open, sval.del, sval.ins);
-
-          headScore.del += scores.extend;
-          if (0 == queryIndex) headScore.del = badVal;
-        }
-
-        // update insert
-        {
-          const ScoreVal& sval((*thisSV)[queryIndex]);
-          headPtr.ins = this->max3(headScore.ins, sval.match + scores.open, badVal, sval.ins);
-
-          headScore.ins += scores.extend;
-          if (0 == queryIndex) headScore.ins = badVal;
-        }
+        _cellPolicy.updateCell(
+            queryIndex,
+            (*queryIter == *refIter),
+            (*prevSV)[queryIndex],
+            (*prevSV)[queryIndex + 1],
+            (*thisSV)[queryIndex],
+            headScore,
+            headPtr);
 
 #ifdef DEBUG_ALN
         log_os << "i1i2: " << queryIndex + 1 << " " << refIndex + 1 << "\n";
@@ -179,3 +138,36 @@ void GlobalAligner<ScoreType>::align(
   this->backTraceAlignment(
       queryBegin, queryEnd, refBegin, refEnd, querySize, refSize, _ptrMat, btrace, result);
 }
+
+template <typename ScoreType>
+template <typename SymIter>
+void GlobalAligner<ScoreType>::alignBanded(
+    const SymIter               queryBegin,
+    const SymIter               queryEnd,
+    const SymIter               refBegin,
+    const SymIter               refEnd,
+    const AlignerBand&          band,
+    AlignmentResult<ScoreType>& result) const
+{
+  result.clear();
+
+  const size_t querySize(std::distance(queryBegin, queryEnd));
+  const size_t refSize(std::distance(refBegin, refEnd));
+
+  if (0 == querySize) {
+    BOOST_THROW_EXCEPTION(illumina::common::GeneralException("Unexpected empty query sequence"));
+  }
+  if (0 == refSize) {
+    BOOST_THROW_EXCEPTION(illumina::common::GeneralException("Unexpected empty reference sequence"));
+  }
+
+  BackTrace<ScoreType> btrace;
+  if (not getBandedBacktrace(
+          _cellPolicy, queryBegin, queryEnd, refBegin, refEnd, band, _bandWorkspace, _bandPtrMat, btrace)) {
+    align(queryBegin, queryEnd, refBegin, refEnd, result);
+    return;
+  }
+
+  this->backTraceAlignment(
+      queryBegin, queryEnd, refBegin, refEnd, querySize, refSize, _bandPtrMat, btrace, result);
+}
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "GlobalJumpAlignerKernel.hpp"
 #include "JumpAlignerBase.hpp"
 
 /// \brief a method to align a contig to two references
@@ -35,12 +36,24 @@
 template <typename ScoreType>
 struct GlobalJumpAligner : public JumpAlignerBase<ScoreType> {
   GlobalJumpAligner(const AlignmentScores<ScoreType>& scores, const ScoreType jumpScore)
-    : JumpAlignerBase<ScoreType>(scores, jumpScore)
+    : JumpAlignerBase<ScoreType>(scores, jumpScore), _isa(GlobalJumpAlignerKernel::getBestSupportedIsa())
   {
     // unsupported option:
     assert(not scores.isAllowEdgeInsertion);
   }
 
+  /// \brief Select the instruction set used to fill the alignment matrices
+  ///
+  /// The default is the best instruction set supported by the current cpu. All choices produce identical
+  /// alignments, so this is only intended for testing and benchmarking.
+  void setIsa(const GlobalJumpAlignerIsa::index_t isa)
+  {
+    assert(GlobalJumpAlignerKernel::isIsaSupported(isa));
+    _isa = isa;
+  }
+
+  GlobalJumpAlignerIsa::index_t getIsa() const { return _isa; }
+
   /// returns alignment path of query to reference
   template <typename SymIter>
   void align(
@@ -53,6 +66,35 @@ struct GlobalJumpAligner : public JumpAlignerBase<ScoreType> {
       JumpAlignmentResult<ScoreType>& result) const;
 
 private:
+  /// Score used to disallow a state
+  static ScoreType getBadVal() { return -10000; }
+
+  /// True if the vectorized matrix fill can be used for this score and symbol type
+  template <typename SymIter>
+  bool isVectorFill() const;
+
+  /// Fill the alignment matrices one cell at a time, and find the backtrace start
+  template <typename SymIter>
+  void scalarFill(
+      const SymIter         queryBegin,
+      const SymIter         queryEnd,
+      const SymIter         ref1Begin,
+      const SymIter         ref1End,
+      const SymIter         ref2Begin,
+      const SymIter         ref2End,
+      BackTrace<ScoreType>& btrace) const;
+
+  /// Fill the alignment matrices with GlobalJumpAlignerKernel, and find the backtrace start
+  template <typename SymIter>
+  void vectorFill(
+      const SymIter         queryBegin,
+      const SymIter         queryEnd,
+      const SymIter         ref1Begin,
+      const SymIter         ref1End,
+      const SymIter         ref2Begin,
+      const SymIter         ref2End,
+      BackTrace<ScoreType>& btrace) const;
+
   // insert and delete are for seq1 wrt seq2
   struct ScoreVal {
     ScoreType getScore(const AlignState::index_t i) const
@@ -88,30 +130,29 @@ private:
       return static_cast<AlignState::index_t>(getStateCode(i));
     }
 
+    /// set the highest scoring previous state for state i
+    void setStatePtr(const AlignState::index_t i, const code_t ptr)
+    {
+      const unsigned shift(getStateShift(i));
+      code = ((code & ~(0x3 << shift)) | (ptr << shift));
+    }
+
+    /// set the highest scoring previous state for all states
+    void setAllStatePtrs(const code_t ptr) { code = (ptr * 0x55); }
+
   private:
-    code_t getStateCode(const AlignState::index_t i) const
+    static unsigned getStateShift(const AlignState::index_t i)
     {
-      switch (i) {
-      case AlignState::MATCH:
-        return match;
-      case AlignState::INSERT:
-        return ins;
-      case AlignState::DELETE:
-        return del;
-      case AlignState::JUMP:
-        return jump;
-      default:
-        assert(false && "Unexpected Index Value");
-        return 0;
-      }
+      assert(i <= AlignState::JUMP);
+      return (i * 2);
     }
 
+    code_t getStateCode(const AlignState::index_t i) const { return ((code >> getStateShift(i)) & 0x3); }
+
   public:
-    // pack 2x4 bits into 1 byte:
-    code_t match : 2;
-    code_t ins : 2;
-    code_t del : 2;
-    code_t jump : 2;
+    // pack 4x2 bits into 1 byte, the pointer for each state is stored at bit offset (2 * state index). This
+    // layout is shared with GlobalJumpAlignerKernel, which writes the codes directly.
+    code_t code;
   };
 
   // add the matrices here to reduce allocations over many alignment calls:
@@ -122,6 +163,9 @@ private:
   typedef basic_matrix<PtrVal> PtrMat;
   mutable PtrMat               _ptrMat1;
   mutable PtrMat               _ptrMat2;
+
+  GlobalJumpAlignerIsa::index_t   _isa;
+  mutable GlobalJumpAlignerKernel _kernel;
 };
 
 #include "alignment/GlobalJumpAlignerImpl.hpp"
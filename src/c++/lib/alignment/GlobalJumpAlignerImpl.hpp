@@ -23,6 +23,9 @@
 
 #include "common/Exceptions.hpp"
 
+#include <iterator>
+#include <type_traits>
+
 #ifdef DEBUG_ALN
 #include <iostream>
 #include "blt_util/log.hpp"
@@ -41,8 +44,6 @@ void GlobalJumpAligner<ScoreType>::align(
 {
   result.clear();
 
-  const AlignmentScores<ScoreType>& scores(this->getScores());
-
   const size_t querySize(std::distance(queryBegin, queryEnd));
   const size_t ref1Size(std::distance(ref1Begin, ref1End));
   const size_t ref2Size(std::distance(ref2Begin, ref2End));
@@ -57,15 +58,72 @@ void GlobalJumpAligner<ScoreType>::align(
     BOOST_THROW_EXCEPTION(illumina::common::GeneralException("Unexpected empty reference2 sequence"));
   }
 
-  _score1.resize(querySize + 1);
-  _score2.resize(querySize + 1);
   _ptrMat1.resize(querySize + 1, ref1Size + 1);
   _ptrMat2.resize(querySize + 1, ref2Size + 1);
 
+  BackTrace<ScoreType> btrace;
+
+  if (isVectorFill<SymIter>()) {
+    vectorFill(queryBegin, queryEnd, ref1Begin, ref1End, ref2Begin, ref2End, btrace);
+  } else {
+    scalarFill(queryBegin, queryEnd, ref1Begin, ref1End, ref2Begin, ref2End, btrace);
+  }
+
+  this->backTraceAlignment(
+      queryBegin,
+      queryEnd,
+      ref1Begin,
+      ref1End,
+      ref2Begin,
+      ref2End,
+      querySize,
+      ref1Size,
+      ref2Size,
+      _ptrMat1,
+      _ptrMat2,
+      btrace,
+      result);
+}
+
+template <typename ScoreType>
+template <typename SymIter>
+bool GlobalJumpAligner<ScoreType>::isVectorFill() const
+{
+#if defined(DEBUG_ALN) || defined(DEBUG_ALN_MATRIX)
+  // debug output is only provided by the scalar fill:
+  return false;
+#else
+  typedef typename std::iterator_traits<SymIter>::value_type SymType;
+  return (
+      (_isa != GlobalJumpAlignerIsa::SCALAR) && std::is_same<ScoreType, int>::value &&
+      std::is_same<SymType, char>::value);
+#endif
+}
+
+template <typename ScoreType>
+template <typename SymIter>
+void GlobalJumpAligner<ScoreType>::scalarFill(
+    const SymIter         queryBegin,
+    const SymIter         queryEnd,
+    const SymIter         ref1Begin,
+    const SymIter         ref1End,
+    const SymIter         ref2Begin,
+    const SymIter         ref2End,
+    BackTrace<ScoreType>& btrace) const
+{
+  const AlignmentScores<ScoreType>& scores(this->getScores());
+
+  const size_t querySize(std::distance(queryBegin, queryEnd));
+  const size_t ref1Size(std::distance(ref1Begin, ref1End));
+  const size_t ref2Size(std::distance(ref2Begin, ref2End));
+
+  _score1.resize(querySize + 1);
+  _score2.resize(querySize + 1);
+
   ScoreVec* thisSV(&_score1);
   ScoreVec* prevSV(&_score2);
 
-  static const ScoreType badVal(-10000);
+  static const ScoreType badVal(getBadVal());
 
   // global alignment of query
   //
@@ -75,21 +133,13 @@ void GlobalJumpAligner<ScoreType>::align(
   // be soft-clipped and each base off the end will be scored as offEdge
   //
   for (unsigned queryIndex(0); queryIndex <= querySize; queryIndex++) {
-    PtrVal&   headPtr1(_ptrMat1.val(queryIndex, 0));
-    PtrVal&   headPtr2(_ptrMat2.val(queryIndex, 0));
     ScoreVal& val((*thisSV)[queryIndex]);
-    headPtr1.match = AlignState::MATCH;
-    headPtr2.match = AlignState::MATCH;
-    val.match      = queryIndex * scores.offEdge;
-    headPtr1.del   = AlignState::MATCH;
-    headPtr2.del   = AlignState::MATCH;
-    val.del        = badVal;
-    headPtr1.ins   = AlignState::MATCH;
-    headPtr2.ins   = AlignState::MATCH;
-    val.ins        = badVal;
-    headPtr1.jump  = AlignState::MATCH;
-    headPtr2.jump  = AlignState::MATCH;
-    val.jump       = badVal;
+    _ptrMat1.val(queryIndex, 0).setAllStatePtrs(AlignState::MATCH);
+    _ptrMat2.val(queryIndex, 0).setAllStatePtrs(AlignState::MATCH);
+    val.match = queryIndex * scores.offEdge;
+    val.del   = badVal;
+    val.ins   = badVal;
+    val.jump  = badVal;
   }
 
 #ifdef DEBUG_ALN_MATRIX
@@ -99,8 +149,6 @@ void GlobalJumpAligner<ScoreType>::align(
   storeScores.push_back(*thisSV);
 #endif
 
-  BackTrace<ScoreType> btrace;
-
   {
     unsigned ref1Index(0);
     for (SymIter ref1Iter(ref1Begin); ref1Iter != ref1End; ++ref1Iter, ++ref1Index) {
@@ -108,16 +156,12 @@ void GlobalJumpAligner<ScoreType>::align(
 
       {
         // disallow start from the insert or delete state:
-        PtrVal&   headPtr(_ptrMat1.val(0, ref1Index + 1));
         ScoreVal& val((*thisSV)[0]);
-        headPtr.match = AlignState::MATCH;
-        val.match     = 0;
-        headPtr.del   = AlignState::MATCH;
-        val.del       = badVal;
-        headPtr.ins   = AlignState::MATCH;
-        val.ins       = badVal;
-        headPtr.jump  = AlignState::MATCH;
-        val.jump      = badVal;
+        _ptrMat1.val(0, ref1Index + 1).setAllStatePtrs(AlignState::MATCH);
+        val.match = 0;
+        val.del   = badVal;
+        val.ins   = badVal;
+        val.jump  = badVal;
       }
 
       unsigned queryIndex(0);
@@ -127,7 +171,7 @@ void GlobalJumpAligner<ScoreType>::align(
         PtrVal&   headPtr(_ptrMat1.val(queryIndex + 1, ref1Index + 1));
         {
           const ScoreVal& sval((*prevSV)[queryIndex]);
-          headPtr.match = this->max3(headScore.match, sval.match, sval.del, sval.ins);
+          headPtr.setStatePtr(AlignState::MATCH, this->max3(headScore.match, sval.match, sval.del, sval.ins));
 
           headScore.match += ((*queryIter == *ref1Iter) ? scores.match : scores.mismatch);
         }
@@ -135,7 +179,8 @@ void GlobalJumpAligner<ScoreType>::align(
         // update delete
         {
           const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.del = this->max3(headScore.del, sval.match + scores.open, sval.del, sval.ins);
+          headPtr.setStatePtr(
+              AlignState::DELETE, this->max3(headScore.del, sval.match + scores.open, sval.del, sval.ins));
 
           headScore.del += scores.extend;
           if (0 == queryIndex) headScore.del = badVal;
@@ -144,7 +189,8 @@ void GlobalJumpAligner<ScoreType>::align(
         // update insert
         {
           const ScoreVal& sval((*thisSV)[queryIndex]);
-          headPtr.ins = this->max3(headScore.ins, sval.match + scores.open, badVal, sval.ins);
+          headPtr.setStatePtr(
+              AlignState::INSERT, this->max3(headScore.ins, sval.match + scores.open, badVal, sval.ins));
 
           headScore.ins += scores.extend;
           if (0 == queryIndex) headScore.ins = badVal;
@@ -153,20 +199,24 @@ void GlobalJumpAligner<ScoreType>::align(
         // update jump
         {
           const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.jump = this->max4(
-              headScore.jump,
-              headScore.match + this->getJumpScore(),
-              badVal,
-              headScore.ins + this->getJumpScore(),
-              sval.jump);
+          headPtr.setStatePtr(
+              AlignState::JUMP,
+              this->max4(
+                  headScore.jump,
+                  headScore.match + this->getJumpScore(),
+                  badVal,
+                  headScore.ins + this->getJumpScore(),
+                  sval.jump));
         }
 
 #ifdef DEBUG_ALN
         log_os << "queryIdx refIdx ref1Idx: " << queryIndex + 1 << " " << ref1Index + 1 << " "
                << ref1Index + 1 << "\n";
         log_os << "MIDJ: " << headScore.match << ":" << headScore.ins << ":" << headScore.del << ":"
-               << headScore.jump << "/" << static_cast<int>(headPtr.match) << static_cast<int>(headPtr.ins)
-               << static_cast<int>(headPtr.del) << static_cast<int>(headPtr.jump) << "\n";
+               << headScore.jump << "/" << static_cast<int>(headPtr.getStatePtr(AlignState::MATCH))
+               << static_cast<int>(headPtr.getStatePtr(AlignState::INSERT))
+               << static_cast<int>(headPtr.getStatePtr(AlignState::DELETE))
+               << static_cast<int>(headPtr.getStatePtr(AlignState::JUMP)) << "\n";
         log_os << "QuerySymbol:" << *queryIter << " RefSymbol:" << *ref1Iter << "\n";
 #endif
       }
@@ -213,16 +263,12 @@ void GlobalJumpAligner<ScoreType>::align(
 
       {
         // disallow start from the insert or delete state:
-        PtrVal&   headPtr(_ptrMat2.val(0, ref2Index + 1));
         ScoreVal& val((*thisSV)[0]);
-        headPtr.match = AlignState::MATCH;
-        val.match     = 0;
-        headPtr.del   = AlignState::MATCH;
-        val.del       = badVal;
-        headPtr.ins   = AlignState::MATCH;
-        val.ins       = badVal;
-        headPtr.jump  = AlignState::MATCH;
-        val.jump      = badVal;
+        _ptrMat2.val(0, ref2Index + 1).setAllStatePtrs(AlignState::MATCH);
+        val.match = 0;
+        val.del   = badVal;
+        val.ins   = badVal;
+        val.jump  = badVal;
       }
 
       unsigned queryIndex(0);
@@ -232,7 +278,8 @@ void GlobalJumpAligner<ScoreType>::align(
         PtrVal&   headPtr(_ptrMat2.val(queryIndex + 1, ref2Index + 1));
         {
           const ScoreVal& sval((*prevSV)[queryIndex]);
-          headPtr.match = this->max4(headScore.match, sval.match, sval.del, sval.ins, sval.jump);
+          headPtr.setStatePtr(
+              AlignState::MATCH, this->max4(headScore.match, sval.match, sval.del, sval.ins, sval.jump));
 
           headScore.match += ((*queryIter == *ref2Iter) ? scores.match : scores.mismatch);
         }
@@ -240,7 +287,8 @@ void GlobalJumpAligner<ScoreType>::align(
         // update delete
         {
           const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.del = this->max3(headScore.del, sval.match + scores.open, sval.del, sval.ins);
+          headPtr.setStatePtr(
+              AlignState::DELETE, this->max3(headScore.del, sval.match + scores.open, sval.del, sval.ins));
 
           headScore.del += scores.extend;
         }
@@ -248,13 +296,15 @@ void GlobalJumpAligner<ScoreType>::align(
         // update insert
         {
           const ScoreVal& sval((*thisSV)[queryIndex]);
-          headPtr.ins = this->max4(
-              headScore.ins,
-              sval.match + scores.open,
-              badVal,
-              sval.ins,
-              sval.jump);  // jump->ins moves get a pass on the gap-open penalty, to support breakend
-                           // insertions
+          headPtr.setStatePtr(
+              AlignState::INSERT,
+              this->max4(
+                  headScore.ins,
+                  sval.match + scores.open,
+                  badVal,
+                  sval.ins,
+                  sval.jump));  // jump->ins moves get a pass on the gap-open penalty, to support breakend
+                                // insertions
 
           headScore.ins += scores.extend;
         }
@@ -262,7 +312,7 @@ void GlobalJumpAligner<ScoreType>::align(
         // update jump
         {
           const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.jump   = AlignState::JUMP;
+          headPtr.setStatePtr(AlignState::JUMP, AlignState::JUMP);
           headScore.jump = sval.jump;
         }
 
@@ -270,8 +320,10 @@ void GlobalJumpAligner<ScoreType>::align(
         log_os << "queryIdx refIdx ref2Idx: " << queryIndex + 1 << " " << ref1Size + ref2Index + 1 << " "
                << ref2Index + 1 << "\n";
         log_os << "MIDJ: " << headScore.match << ":" << headScore.ins << ":" << headScore.del << ":"
-               << headScore.jump << "/" << static_cast<int>(headPtr.match) << static_cast<int>(headPtr.ins)
-               << static_cast<int>(headPtr.del) << static_cast<int>(headPtr.jump) << "\n";
+               << headScore.jump << "/" << static_cast<int>(headPtr.getStatePtr(AlignState::MATCH))
+               << static_cast<int>(headPtr.getStatePtr(AlignState::INSERT))
+               << static_cast<int>(headPtr.getStatePtr(AlignState::DELETE))
+               << static_cast<int>(headPtr.getStatePtr(AlignState::JUMP)) << "\n";
         log_os << "QuerySymbol:" << *queryIter << " RefSymbol:" << *ref2Iter << "\n";
 #endif
       }
@@ -315,19 +367,62 @@ void GlobalJumpAligner<ScoreType>::align(
       dumpStates,
       storeScores);
 #endif
+}
 
-  this->backTraceAlignment(
+template <typename ScoreType>
+template <typename SymIter>
+void GlobalJumpAligner<ScoreType>::vectorFill(
+    const SymIter         queryBegin,
+    const SymIter         queryEnd,
+    const SymIter         ref1Begin,
+    const SymIter         ref1End,
+    const SymIter         ref2Begin,
+    const SymIter         ref2End,
+    BackTrace<ScoreType>& btrace) const
+{
+  const AlignmentScores<ScoreType>& scores(this->getScores());
+
+  const size_t querySize(std::distance(queryBegin, queryEnd));
+  const size_t ref1Size(std::distance(ref1Begin, ref1End));
+  const size_t ref2Size(std::distance(ref2Begin, ref2End));
+
+  static const ScoreType badVal(getBadVal());
+
+  // the kernel writes PtrVal codes directly into the matrix storage:
+  static_assert(sizeof(PtrVal) == sizeof(typename PtrVal::code_t), "Unexpected PtrVal size");
+
+  _kernel.fill(
+      _isa,
+      scores,
+      this->getJumpScore(),
+      badVal,
       queryBegin,
       queryEnd,
       ref1Begin,
       ref1End,
       ref2Begin,
       ref2End,
-      querySize,
-      ref1Size,
-      ref2Size,
-      _ptrMat1,
-      _ptrMat2,
-      btrace,
-      result);
+      &(_ptrMat1.val(0, 0).code),
+      &(_ptrMat2.val(0, 0).code));
+
+  // replay the backtrace start search in the same order as scalarFill, so that ties are resolved
+  // identically:
+  for (unsigned ref1Index(0); ref1Index < ref1Size; ref1Index++) {
+    updateBacktrace<ScoreType>(_kernel.ref1LastRowMatch[ref1Index], ref1Index + 1, querySize, btrace);
+  }
+
+  for (unsigned queryIndex(0); queryIndex < querySize; queryIndex++) {
+    const ScoreType thisMax(_kernel.ref1LastColMatch[queryIndex] + (querySize - queryIndex) * scores.offEdge);
+    updateBacktrace(thisMax, ref1Size, queryIndex, btrace);
+  }
+
+  for (unsigned ref2Index(0); ref2Index < ref2Size; ref2Index++) {
+    updateBacktrace<ScoreType>(
+        _kernel.ref2LastRowMatch[ref2Index], ref1Size + ref2Index + 1, querySize, btrace);
+  }
+
+  for (unsigned queryIndex(0); queryIndex < querySize; queryIndex++) {
+    const ScoreType thisMax(_kernel.ref2LastColMatch[queryIndex] + (querySize - queryIndex) * scores.offEdge);
+    updateBacktrace(thisMax, ref1Size + ref2Size, queryIndex, btrace);
+  }
 }
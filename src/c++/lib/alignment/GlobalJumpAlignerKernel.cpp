@@ -0,0 +1,123 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "alignment/GlobalJumpAlignerKernel.hpp"
+
+#include "common/Exceptions.hpp"
+
+#include <sstream>
+
+// Instruction set specific fill functions, each returns nullptr if its instruction set was not enabled for
+// this build:
+GlobalJumpAlignerFillFunc getGlobalJumpAlignerSse41Fill();
+GlobalJumpAlignerFillFunc getGlobalJumpAlignerAvx2Fill();
+
+static GlobalJumpAlignerFillFunc getFillFunc(const GlobalJumpAlignerIsa::index_t isa)
+{
+  switch (isa) {
+  case GlobalJumpAlignerIsa::SSE41:
+    return getGlobalJumpAlignerSse41Fill();
+  case GlobalJumpAlignerIsa::AVX2:
+    return getGlobalJumpAlignerAvx2Fill();
+  default:
+    return nullptr;
+  }
+}
+
+static bool isCpuSupported(const GlobalJumpAlignerIsa::index_t isa)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  switch (isa) {
+  case GlobalJumpAlignerIsa::SCALAR:
+    return true;
+  case GlobalJumpAlignerIsa::SSE41:
+    return __builtin_cpu_supports("sse4.1");
+  case GlobalJumpAlignerIsa::AVX2:
+    return __builtin_cpu_supports("avx2");
+  default:
+    return false;
+  }
+#else
+  return (isa == GlobalJumpAlignerIsa::SCALAR);
+#endif
+}
+
+bool GlobalJumpAlignerKernel::isIsaSupported(const GlobalJumpAlignerIsa::index_t isa)
+{
+  if (isa == GlobalJumpAlignerIsa::SCALAR) return true;
+  return ((getFillFunc(isa) != nullptr) && isCpuSupported(isa));
+}
+
+GlobalJumpAlignerIsa::index_t GlobalJumpAlignerKernel::getBestSupportedIsa()
+{
+  static const GlobalJumpAlignerIsa::index_t bestIsa([]() {
+    if (isIsaSupported(GlobalJumpAlignerIsa::AVX2)) return GlobalJumpAlignerIsa::AVX2;
+    if (isIsaSupported(GlobalJumpAlignerIsa::SSE41)) return GlobalJumpAlignerIsa::SSE41;
+    return GlobalJumpAlignerIsa::SCALAR;
+  }());
+  return bestIsa;
+}
+
+void GlobalJumpAlignerKernel::fillCore(
+    const GlobalJumpAlignerIsa::index_t isa, GlobalJumpAlignerKernelData& data)
+{
+  const GlobalJumpAlignerFillFunc fillFunc(getFillFunc(isa));
+  if (fillFunc == nullptr) {
+    std::ostringstream oss;
+    oss << "Jump aligner vector fill is not available for instruction set '"
+        << GlobalJumpAlignerIsa::label(isa) << "'";
+    BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+  }
+
+  const unsigned querySize(_query.size() - maxLaneCount);
+  const unsigned ref1Size(_ref1Reversed.size() - maxLaneCount);
+  const unsigned ref2Size(_ref2Reversed.size() - maxLaneCount);
+
+  // each anti-diagonal buffer is indexed by query position, and padded so that the final vector on each
+  // anti-diagonal can always be loaded and stored in full:
+  data.diagSize = querySize + 1 + maxLaneCount;
+  _diagBuffer.resize(3 * 4 * data.diagSize);
+
+  ref1LastRowMatch.resize(ref1Size);
+  ref2LastRowMatch.resize(ref2Size);
+  ref1LastColMatch.resize(querySize + 1);
+  ref2LastColMatch.resize(querySize + 1);
+  _ref1LastColJump.resize(querySize + 1);
+  _ref2LastColJump.resize(querySize + 1);
+
+  data.query            = _query.data();
+  data.querySize        = querySize;
+  data.ref1Reversed     = _ref1Reversed.data();
+  data.ref1Size         = ref1Size;
+  data.ref2Reversed     = _ref2Reversed.data();
+  data.ref2Size         = ref2Size;
+  data.diagBuffer       = _diagBuffer.data();
+  data.ref1LastRowMatch = ref1LastRowMatch.data();
+  data.ref2LastRowMatch = ref2LastRowMatch.data();
+  data.ref1LastColMatch = ref1LastColMatch.data();
+  data.ref1LastColJump  = _ref1LastColJump.data();
+  data.ref2LastColMatch = ref2LastColMatch.data();
+  data.ref2LastColJump  = _ref2LastColJump.data();
+
+  fillFunc(data);
+}
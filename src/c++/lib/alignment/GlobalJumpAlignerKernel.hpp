@@ -0,0 +1,184 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Vectorized matrix fill for GlobalJumpAligner
+///
+
+#pragma once
+
+#include "alignment/AlignmentScores.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/// Instruction sets which can be used to fill the GlobalJumpAligner matrices
+struct GlobalJumpAlignerIsa {
+  enum index_t { SCALAR, SSE41, AVX2, SIZE };
+
+  static const char* label(const index_t i)
+  {
+    switch (i) {
+    case SCALAR:
+      return "scalar";
+    case SSE41:
+      return "sse4.1";
+    case AVX2:
+      return "avx2";
+    default:
+      assert(false && "Unexpected Index Value");
+      return nullptr;
+    }
+  }
+};
+
+/// \brief All input and output buffers for one vectorized matrix fill
+///
+/// Buffers are owned by GlobalJumpAlignerKernel, this struct only exists to pass them to the instruction set
+/// specific fill functions.
+struct GlobalJumpAlignerKernelData {
+  int match;
+  int mismatch;
+  int open;
+  int extend;
+  int jump;
+  int offEdge;
+  int badVal;
+
+  /// query, padded with GlobalJumpAlignerKernel::maxLaneCount trailing symbols
+  const char* query;
+  unsigned    querySize;
+
+  /// reversed references, each padded with GlobalJumpAlignerKernel::maxLaneCount trailing symbols
+  const char* ref1Reversed;
+  unsigned    ref1Size;
+  const char* ref2Reversed;
+  unsigned    ref2Size;
+
+  /// row-major back-pointer matrices, in the GlobalJumpAligner PtrVal code layout
+  uint8_t* ptrMat1;
+  uint8_t* ptrMat2;
+
+  /// workspace for 3 anti-diagonals of 4 states each, every state buffer has size diagSize
+  int*     diagBuffer;
+  unsigned diagSize;
+
+  /// match scores in the last query row, for reference positions [1,refSize]
+  int* ref1LastRowMatch;
+  int* ref2LastRowMatch;
+
+  /// match and jump scores in the last reference column, for query positions [0,querySize]
+  int* ref1LastColMatch;
+  int* ref1LastColJump;
+  int* ref2LastColMatch;
+  int* ref2LastColJump;
+};
+
+typedef void (*GlobalJumpAlignerFillFunc)(const GlobalJumpAlignerKernelData&);
+
+/// \brief Vectorized matrix fill for GlobalJumpAligner
+///
+/// The alignment matrices are filled one anti-diagonal at a time. All cells on an anti-diagonal only depend
+/// on the previous two anti-diagonals, so they can be computed in independent vector lanes. Every cell
+/// follows the same recursion and max tie-breaking order as the scalar GlobalJumpAligner fill, so the
+/// back-pointer matrices and the scores used to find the backtrace start are identical to the scalar result.
+///
+/// Scores are computed with 32 bit integers.
+///
+struct GlobalJumpAlignerKernel {
+  /// Vector lane count of the widest supported instruction set, this sets the sequence padding
+  static const unsigned maxLaneCount = 8;
+
+  /// True if \p isa is compiled into this build and supported by the current cpu
+  static bool isIsaSupported(const GlobalJumpAlignerIsa::index_t isa);
+
+  /// Get the fastest instruction set supported by this build and cpu, or SCALAR if none are supported
+  static GlobalJumpAlignerIsa::index_t getBestSupportedIsa();
+
+  /// \brief Fill both back-pointer matrices and the last row/column scores used to start the backtrace
+  ///
+  /// \param[in] isa A vector instruction set supported on the current cpu
+  /// \param[out] ptrMat1 Back-pointer matrix of size (querySize+1) x (ref1Size+1)
+  /// \param[out] ptrMat2 Back-pointer matrix of size (querySize+1) x (ref2Size+1)
+  template <typename ScoreType, typename SymIter>
+  void fill(
+      const GlobalJumpAlignerIsa::index_t isa,
+      const AlignmentScores<ScoreType>&   scores,
+      const ScoreType                     jumpScore,
+      const ScoreType                     badVal,
+      const SymIter                       queryBegin,
+      const SymIter                       queryEnd,
+      const SymIter                       ref1Begin,
+      const SymIter                       ref1End,
+      const SymIter                       ref2Begin,
+      const SymIter                       ref2End,
+      uint8_t*                            ptrMat1,
+      uint8_t*                            ptrMat2)
+  {
+    _query.assign(queryBegin, queryEnd);
+    _query.resize(_query.size() + maxLaneCount, 0);
+    assignReversed(ref1Begin, ref1End, _ref1Reversed);
+    assignReversed(ref2Begin, ref2End, _ref2Reversed);
+
+    GlobalJumpAlignerKernelData data;
+    data.match    = scores.match;
+    data.mismatch = scores.mismatch;
+    data.open     = scores.open;
+    data.extend   = scores.extend;
+    data.jump     = jumpScore;
+    data.offEdge  = scores.offEdge;
+    data.badVal   = badVal;
+    data.ptrMat1  = ptrMat1;
+    data.ptrMat2  = ptrMat2;
+    fillCore(isa, data);
+  }
+
+  /// match scores in the last query row of the ref1 matrix, for ref1 positions [1,ref1Size]
+  std::vector<int> ref1LastRowMatch;
+
+  /// match scores in the last column of the ref1 matrix, for query positions [0,querySize]
+  std::vector<int> ref1LastColMatch;
+
+  /// match scores in the last query row of the ref2 matrix, for ref2 positions [1,ref2Size]
+  std::vector<int> ref2LastRowMatch;
+
+  /// match scores in the last column of the ref2 matrix, for query positions [0,querySize]
+  std::vector<int> ref2LastColMatch;
+
+private:
+  template <typename SymIter>
+  static void assignReversed(const SymIter begin, const SymIter end, std::vector<char>& reversed)
+  {
+    reversed.assign(begin, end);
+    std::reverse(reversed.begin(), reversed.end());
+    reversed.resize(reversed.size() + maxLaneCount, 0);
+  }
+
+  /// Complete the fill data with all workspace buffers and run the fill function for \p isa
+  void fillCore(const GlobalJumpAlignerIsa::index_t isa, GlobalJumpAlignerKernelData& data);
+
+  std::vector<char> _query;
+  std::vector<char> _ref1Reversed;
+  std::vector<char> _ref2Reversed;
+  std::vector<int>  _diagBuffer;
+  std::vector<int>  _ref1LastColJump;
+  std::vector<int>  _ref2LastColJump;
+};
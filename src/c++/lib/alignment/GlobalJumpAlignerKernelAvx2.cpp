@@ -0,0 +1,91 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief AVX2 GlobalJumpAlignerKernel matrix fill
+///
+/// This file is compiled with AVX2 code generation enabled when supported by the compiler, it must only be
+/// called after checking for AVX2 cpu support.
+///
+
+#include "alignment/GlobalJumpAlignerKernel.hpp"
+
+#ifdef __AVX2__
+
+#include "alignment/GlobalJumpAlignerKernelImpl.hpp"
+
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+  typedef __m256i       vec_t;
+  static const unsigned laneCount = 8;
+
+  static vec_t set1(const int val) { return _mm256_set1_epi32(val); }
+
+  static vec_t laneIndex() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+  static vec_t load(const int* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+
+  static void store(int* ptr, const vec_t val) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), val); }
+
+  static vec_t add(const vec_t a, const vec_t b) { return _mm256_add_epi32(a, b); }
+
+  static vec_t bitOr(const vec_t a, const vec_t b) { return _mm256_or_si256(a, b); }
+
+  static vec_t cmpgt(const vec_t a, const vec_t b) { return _mm256_cmpgt_epi32(a, b); }
+
+  static vec_t cmpeq(const vec_t a, const vec_t b) { return _mm256_cmpeq_epi32(a, b); }
+
+  /// select b where mask is set, otherwise a
+  static vec_t blend(const vec_t a, const vec_t b, const vec_t mask)
+  {
+    return _mm256_blendv_epi8(a, b, mask);
+  }
+
+  /// compare laneCount symbols from each sequence
+  static vec_t cmpeqSymbols(const char* seq1, const char* seq2)
+  {
+    const __m128i val1(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(seq1)));
+    const __m128i val2(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(seq2)));
+    return _mm256_cvtepi8_epi32(_mm_cmpeq_epi8(val1, val2));
+  }
+};
+
+}  // namespace
+
+static void fillAvx2(const GlobalJumpAlignerKernelData& data)
+{
+  fillGlobalJumpAlignerMatrices<Avx2Ops>(data);
+}
+
+GlobalJumpAlignerFillFunc getGlobalJumpAlignerAvx2Fill()
+{
+  return fillAvx2;
+}
+
+#else
+
+GlobalJumpAlignerFillFunc getGlobalJumpAlignerAvx2Fill()
+{
+  return nullptr;
+}
+
+#endif
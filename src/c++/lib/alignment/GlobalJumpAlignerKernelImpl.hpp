@@ -0,0 +1,235 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Instruction set independent implementation of the GlobalJumpAlignerKernel matrix fill
+///
+/// This header should only be included by the instruction set specific translation units. To keep inline
+/// functions compiled with extended instruction sets out of the rest of the build, everything here is
+/// templated on a vector operations type with internal linkage, and no standard library templates are used.
+///
+
+#pragma once
+
+#include "alignment/GlobalJumpAlignerKernel.hpp"
+
+/// \brief Fill one reference matrix of the jump alignment
+///
+/// \tparam VecOps Vector operations for 32 bit signed integer lanes
+/// \tparam isRef2 True for the second reference, which is entered from the jump state of the first
+///
+template <typename VecOps, bool isRef2>
+void fillGlobalJumpAlignerRefMatrix(
+    const GlobalJumpAlignerKernelData& data,
+    const char*                        refReversed,
+    const unsigned                     refSize,
+    uint8_t*                           ptrMat,
+    const int*                         colInitJump,
+    int*                               lastRowMatch,
+    int*                               lastColMatch,
+    int*                               lastColJump)
+{
+  typedef typename VecOps::vec_t vec_t;
+
+  enum { MATCH, DELETE, INSERT, JUMP, STATE_COUNT };
+  static const unsigned laneCount = VecOps::laneCount;
+
+  const unsigned querySize(data.querySize);
+  const unsigned colCount(refSize + 1);
+
+  // all back-pointers on the first row and column point to the match state:
+  for (unsigned queryIndex(0); queryIndex <= querySize; ++queryIndex) {
+    ptrMat[queryIndex * colCount] = 0;
+  }
+  for (unsigned refIndex(1); refIndex <= refSize; ++refIndex) {
+    ptrMat[refIndex] = 0;
+  }
+
+  // score buffers for the current anti-diagonal and the two preceding ones, indexed by query position:
+  int* diag[3][STATE_COUNT];
+  for (unsigned diagIndex(0); diagIndex < 3; ++diagIndex) {
+    for (unsigned stateIndex(0); stateIndex < STATE_COUNT; ++stateIndex) {
+      diag[diagIndex][stateIndex] =
+          data.diagBuffer + ((diagIndex * STATE_COUNT) + stateIndex) * data.diagSize;
+    }
+  }
+
+  // first column, which is entered from the jump state for ref2:
+  auto setFirstColumn = [&](int** cur, const unsigned queryIndex) {
+    cur[MATCH][queryIndex]  = queryIndex * data.offEdge;
+    cur[DELETE][queryIndex] = data.badVal;
+    cur[INSERT][queryIndex] = data.badVal;
+    cur[JUMP][queryIndex]   = (isRef2 ? colInitJump[queryIndex] : data.badVal);
+  };
+
+  // first row, disallow start from the insert or delete state:
+  auto setFirstRow = [&](int** cur) {
+    cur[MATCH][0]  = 0;
+    cur[DELETE][0] = data.badVal;
+    cur[INSERT][0] = data.badVal;
+    cur[JUMP][0]   = data.badVal;
+  };
+
+  setFirstColumn(diag[0], 0);
+
+  // back-pointer codes for each state, pre-shifted to the PtrVal bit layout:
+  vec_t codes[STATE_COUNT][STATE_COUNT];
+  for (unsigned stateIndex(0); stateIndex < STATE_COUNT; ++stateIndex) {
+    for (unsigned fromIndex(0); fromIndex < STATE_COUNT; ++fromIndex) {
+      codes[stateIndex][fromIndex] = VecOps::set1(fromIndex << (stateIndex * 2));
+    }
+  }
+
+  const vec_t matchVal(VecOps::set1(data.match));
+  const vec_t mismatchVal(VecOps::set1(data.mismatch));
+  const vec_t openVal(VecOps::set1(data.open));
+  const vec_t extendVal(VecOps::set1(data.extend));
+  const vec_t jumpVal(VecOps::set1(data.jump));
+  const vec_t badVal(VecOps::set1(data.badVal));
+  const vec_t zero(VecOps::set1(0));
+
+  // replicate max3/max4 from AlignerBase, where ties go to the earlier state:
+  auto updateMax = [](vec_t& max, vec_t& code, const vec_t val, const vec_t valCode) {
+    const vec_t isGreater(VecOps::cmpgt(val, max));
+    max  = VecOps::blend(max, val, isGreater);
+    code = VecOps::blend(code, valCode, isGreater);
+  };
+
+  const unsigned diagCount(querySize + refSize + 1);
+  for (unsigned diagIndex(1); diagIndex < diagCount; ++diagIndex) {
+    int** cur(diag[diagIndex % 3]);
+    int** prev1(diag[(diagIndex + 2) % 3]);
+    int** prev2(diag[(diagIndex + 1) % 3]);
+
+    // range of query positions for cells on this anti-diagonal, excluding the first row and column:
+    const unsigned queryBegin((diagIndex > refSize) ? (diagIndex - refSize) : 1);
+    const unsigned queryEnd(((diagIndex - 1) < querySize) ? diagIndex : (querySize + 1));
+
+    for (unsigned queryIndex(queryBegin); queryIndex < queryEnd; queryIndex += laneCount) {
+      const unsigned refIndex(diagIndex - queryIndex);
+
+      // update match
+      vec_t match(VecOps::load(prev2[MATCH] + queryIndex - 1));
+      vec_t matchCode(zero);
+      updateMax(match, matchCode, VecOps::load(prev2[DELETE] + queryIndex - 1), codes[MATCH][DELETE]);
+      updateMax(match, matchCode, VecOps::load(prev2[INSERT] + queryIndex - 1), codes[MATCH][INSERT]);
+      if (isRef2) {
+        updateMax(match, matchCode, VecOps::load(prev2[JUMP] + queryIndex - 1), codes[MATCH][JUMP]);
+      }
+      const vec_t isSymbolMatch(VecOps::cmpeqSymbols(
+          data.query + queryIndex - 1, refReversed + (refSize + queryIndex - diagIndex)));
+      match = VecOps::add(match, VecOps::blend(mismatchVal, matchVal, isSymbolMatch));
+
+      // update delete
+      vec_t del(VecOps::add(VecOps::load(prev1[MATCH] + queryIndex), openVal));
+      vec_t delCode(zero);
+      updateMax(del, delCode, VecOps::load(prev1[DELETE] + queryIndex), codes[DELETE][DELETE]);
+      updateMax(del, delCode, VecOps::load(prev1[INSERT] + queryIndex), codes[DELETE][INSERT]);
+      del = VecOps::add(del, extendVal);
+
+      // update insert
+      vec_t ins(VecOps::add(VecOps::load(prev1[MATCH] + queryIndex - 1), openVal));
+      vec_t insCode(zero);
+      updateMax(ins, insCode, badVal, codes[INSERT][DELETE]);
+      updateMax(ins, insCode, VecOps::load(prev1[INSERT] + queryIndex - 1), codes[INSERT][INSERT]);
+      if (isRef2) {
+        // jump->ins moves get a pass on the gap-open penalty, to support breakend insertions
+        updateMax(ins, insCode, VecOps::load(prev1[JUMP] + queryIndex - 1), codes[INSERT][JUMP]);
+      }
+      ins = VecOps::add(ins, extendVal);
+
+      if ((!isRef2) && (queryIndex == 1)) {
+        // the first query row of ref1 can't be entered from delete or insert:
+        const vec_t isFirstRow(VecOps::cmpeq(VecOps::laneIndex(), zero));
+        del = VecOps::blend(del, badVal, isFirstRow);
+        ins = VecOps::blend(ins, badVal, isFirstRow);
+      }
+
+      // update jump
+      vec_t jump;
+      vec_t jumpCode;
+      if (isRef2) {
+        jump     = VecOps::load(prev1[JUMP] + queryIndex);
+        jumpCode = codes[JUMP][JUMP];
+      } else {
+        jump     = VecOps::add(match, jumpVal);
+        jumpCode = zero;
+        updateMax(jump, jumpCode, badVal, codes[JUMP][DELETE]);
+        updateMax(jump, jumpCode, VecOps::add(ins, jumpVal), codes[JUMP][INSERT]);
+        updateMax(jump, jumpCode, VecOps::load(prev1[JUMP] + queryIndex), codes[JUMP][JUMP]);
+      }
+
+      VecOps::store(cur[MATCH] + queryIndex, match);
+      VecOps::store(cur[DELETE] + queryIndex, del);
+      VecOps::store(cur[INSERT] + queryIndex, ins);
+      VecOps::store(cur[JUMP] + queryIndex, jump);
+
+      // scatter back-pointers along the anti-diagonal:
+      int ptrCodes[laneCount];
+      VecOps::store(
+          ptrCodes, VecOps::bitOr(VecOps::bitOr(matchCode, delCode), VecOps::bitOr(insCode, jumpCode)));
+      const unsigned laneEnd(((queryEnd - queryIndex) < laneCount) ? (queryEnd - queryIndex) : laneCount);
+      uint8_t*       ptr(ptrMat + (queryIndex * colCount) + refIndex);
+      for (unsigned laneIndex(0); laneIndex < laneEnd; ++laneIndex) {
+        *ptr = static_cast<uint8_t>(ptrCodes[laneIndex]);
+        ptr += (colCount - 1);
+      }
+    }
+
+    // lanes past the end of the anti-diagonal may have overwritten the first column cell, so the first row
+    // and column are set last:
+    if (diagIndex <= refSize) setFirstRow(cur);
+    if (diagIndex <= querySize) setFirstColumn(cur, diagIndex);
+
+    if (diagIndex > querySize) {
+      lastRowMatch[diagIndex - querySize - 1] = cur[MATCH][querySize];
+    }
+    if (diagIndex >= refSize) {
+      const unsigned queryIndex(diagIndex - refSize);
+      lastColMatch[queryIndex] = cur[MATCH][queryIndex];
+      lastColJump[queryIndex]  = cur[JUMP][queryIndex];
+    }
+  }
+}
+
+/// Fill both reference matrices of the jump alignment
+template <typename VecOps>
+void fillGlobalJumpAlignerMatrices(const GlobalJumpAlignerKernelData& data)
+{
+  fillGlobalJumpAlignerRefMatrix<VecOps, false>(
+      data,
+      data.ref1Reversed,
+      data.ref1Size,
+      data.ptrMat1,
+      nullptr,
+      data.ref1LastRowMatch,
+      data.ref1LastColMatch,
+      data.ref1LastColJump);
+
+  // ref2 is entered from the jump state scores in the last column of ref1:
+  fillGlobalJumpAlignerRefMatrix<VecOps, true>(
+      data,
+      data.ref2Reversed,
+      data.ref2Size,
+      data.ptrMat2,
+      data.ref1LastColJump,
+      data.ref2LastRowMatch,
+      data.ref2LastColMatch,
+      data.ref2LastColJump);
+}
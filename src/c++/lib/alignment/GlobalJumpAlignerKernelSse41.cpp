@@ -0,0 +1,91 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief SSE4.1 GlobalJumpAlignerKernel matrix fill
+///
+/// This file is compiled with SSE4.1 code generation enabled when supported by the compiler, it must only be
+/// called after checking for SSE4.1 cpu support.
+///
+
+#include "alignment/GlobalJumpAlignerKernel.hpp"
+
+#ifdef __SSE4_1__
+
+#include "alignment/GlobalJumpAlignerKernelImpl.hpp"
+
+#include <smmintrin.h>
+
+#include <cstring>
+
+namespace {
+
+struct Sse41Ops {
+  typedef __m128i       vec_t;
+  static const unsigned laneCount = 4;
+
+  static vec_t set1(const int val) { return _mm_set1_epi32(val); }
+
+  static vec_t laneIndex() { return _mm_setr_epi32(0, 1, 2, 3); }
+
+  static vec_t load(const int* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+
+  static void store(int* ptr, const vec_t val) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), val); }
+
+  static vec_t add(const vec_t a, const vec_t b) { return _mm_add_epi32(a, b); }
+
+  static vec_t bitOr(const vec_t a, const vec_t b) { return _mm_or_si128(a, b); }
+
+  static vec_t cmpgt(const vec_t a, const vec_t b) { return _mm_cmpgt_epi32(a, b); }
+
+  static vec_t cmpeq(const vec_t a, const vec_t b) { return _mm_cmpeq_epi32(a, b); }
+
+  /// select b where mask is set, otherwise a
+  static vec_t blend(const vec_t a, const vec_t b, const vec_t mask) { return _mm_blendv_epi8(a, b, mask); }
+
+  /// compare laneCount symbols from each sequence
+  static vec_t cmpeqSymbols(const char* seq1, const char* seq2)
+  {
+    int val1, val2;
+    memcpy(&val1, seq1, sizeof(val1));
+    memcpy(&val2, seq2, sizeof(val2));
+    return _mm_cvtepi8_epi32(_mm_cmpeq_epi8(_mm_cvtsi32_si128(val1), _mm_cvtsi32_si128(val2)));
+  }
+};
+
+}  // namespace
+
+static void fillSse41(const GlobalJumpAlignerKernelData& data)
+{
+  fillGlobalJumpAlignerMatrices<Sse41Ops>(data);
+}
+
+GlobalJumpAlignerFillFunc getGlobalJumpAlignerSse41Fill()
+{
+  return fillSse41;
+}
+
+#else
+
+GlobalJumpAlignerFillFunc getGlobalJumpAlignerSse41Fill()
+{
+  return nullptr;
+}
+
+#endif
@@ -23,8 +23,12 @@
 
 #pragma once
 
+#include "AlignerBand.hpp"
 #include "SingleRefAlignerShared.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 /// \brief align a contig to reference and allow very large insert or deletion events
 ///
 /// this is essentially a regular global alignment with affine gap penalties for small
@@ -40,7 +44,9 @@ struct GlobalLargeIndelAligner : public SingleRefAlignerBase<ScoreType> {
   /// \param largeIndelScore is the 'gap open' for the large indels
   ///
   GlobalLargeIndelAligner(const AlignmentScores<ScoreType>& scores, const ScoreType largeIndelScore)
-    : SingleRefAlignerBase<ScoreType>(scores), _largeIndelScore(largeIndelScore)
+    : SingleRefAlignerBase<ScoreType>(scores),
+      _largeIndelScore(largeIndelScore),
+      _cellPolicy(scores, largeIndelScore)
   {
   }
 
@@ -53,6 +59,22 @@ struct GlobalLargeIndelAligner : public SingleRefAlignerBase<ScoreType> {
       const SymIter               refEnd,
       AlignmentResult<ScoreType>& result) const;
 
+  /// \brief returns alignment path of query to reference, using \p band to limit the matrix fill
+  ///
+  /// The result is the same as align(), \p band only needs to contain an alignment close to the optimal
+  /// alignment for this to be faster and use less memory than align(). See getBandedBacktrace() for
+  /// details.
+  ///
+  /// SymIter must be a random access iterator.
+  template <typename SymIter>
+  void alignBanded(
+      const SymIter               queryBegin,
+      const SymIter               queryEnd,
+      const SymIter               refBegin,
+      const SymIter               refEnd,
+      const AlignerBand&          band,
+      AlignmentResult<ScoreType>& result) const;
+
 private:
   // insert and delete are for seq1 wrt seq2
   struct ScoreVal {
@@ -150,6 +172,138 @@ private:
     return ptr;
   }
 
+  /// matrix recursion shared by the full and banded matrix fills, see fillAlignerBand()
+  struct CellPolicy {
+    typedef ScoreType AlignScoreType;
+    typedef ScoreVal  ScoreValType;
+    typedef PtrVal    PtrValType;
+
+    CellPolicy(const AlignmentScores<ScoreType>& initScores, const ScoreType initLargeIndelScore)
+      : scores(initScores),
+        largeIndelScore(initLargeIndelScore),
+        insertBonus(std::max(0, largeIndelScore - scores.open)),
+        maxQueryGain(std::max({0,
+                               static_cast<int>(scores.match),
+                               static_cast<int>(scores.mismatch),
+                               static_cast<int>(scores.offEdge),
+                               static_cast<int>(scores.open + scores.extend),
+                               static_cast<int>(scores.extend),
+                               static_cast<int>(largeIndelScore)})),
+        scoreRange(
+            std::abs(scores.match) + std::abs(scores.mismatch) + std::abs(scores.open) +
+            std::abs(scores.extend) + std::abs(scores.offEdge) + std::abs(largeIndelScore)),
+        isBandSupported(
+            ((scores.open + scores.extend) <= 0) and (scores.extend <= 0) and (largeIndelScore <= 0))
+    {
+      badCell.match   = getBadVal();
+      badCell.ins     = getBadVal();
+      badCell.del     = getBadVal();
+      badCell.jumpIns = getBadVal();
+      badCell.jumpDel = getBadVal();
+    }
+
+    static ScoreType getBadVal() { return -10000; }
+
+    /// initialize cell (queryIndex,0)
+    void initEdgeCell(const unsigned queryIndex, ScoreVal& val, PtrVal& ptr) const
+    {
+      ptr.match = AlignState::MATCH;
+      val.match = queryIndex * scores.offEdge;
+      ptr.del   = AlignState::MATCH;
+      val.del   = getBadVal();
+      if (not scores.isAllowEdgeInsertion) {
+        ptr.ins = AlignState::MATCH;
+        val.ins = getBadVal();
+      } else {
+        ptr.ins = AlignState::INSERT;
+        val.ins = scores.open + (queryIndex * scores.extend);
+      }
+      ptr.jumpDel = AlignState::MATCH;
+      val.jumpDel = getBadVal();
+      ptr.jumpIns = AlignState::MATCH;
+      val.jumpIns = getBadVal();
+    }
+
+    /// initialize cell (0,refIndex+1)
+    void initTopCell(ScoreVal& val, PtrVal& ptr) const
+    {
+      // disallow start from the insert or delete states:
+      ptr.match   = AlignState::MATCH;
+      val.match   = 0;
+      ptr.del     = AlignState::MATCH;
+      val.del     = getBadVal();
+      ptr.ins     = AlignState::MATCH;
+      val.ins     = getBadVal();
+      ptr.jumpDel = AlignState::MATCH;
+      val.jumpDel = getBadVal();
+      ptr.jumpIns = AlignState::MATCH;
+      val.jumpIns = getBadVal();
+    }
+
+    /// fill cell (queryIndex+1,refIndex+1) from its diagonal, left and upper neighbors
+    void updateCell(
+        const unsigned  queryIndex,
+        const bool      isMatch,
+        const ScoreVal& diag,
+        const ScoreVal& left,
+        const ScoreVal& up,
+        ScoreVal&       headScore,
+        PtrVal&         headPtr) const
+    {
+      const ScoreType badVal(getBadVal());
+
+      // update match
+      headPtr.match = max5(headScore.match, diag.match, diag.del, diag.ins, diag.jumpDel, diag.jumpIns);
+      headScore.match += (isMatch ? scores.match : scores.mismatch);
+
+      // update delete
+      headPtr.del = max5(headScore.del, left.match + scores.open, left.del, left.ins, badVal, left.jumpIns);
+      headScore.del += scores.extend;
+      if (0 == queryIndex) headScore.del = badVal;
+
+      // update insert
+      headPtr.ins = max5(headScore.ins, up.match + scores.open, badVal, up.ins, badVal, badVal);
+      headScore.ins += scores.extend;
+      if (0 == queryIndex) headScore.ins = badVal;
+
+      // update jumpDel
+      //
+      // you can switch between long ins and delete but only
+      // by paying the full open penalty again
+      //
+      // the switch from short ins to jump del is meant to simulate
+      // a free transition from jump del to short ins, but makes
+      // the cigar I->D order come out the same as other aligners in this library
+      headPtr.jumpDel = max5(
+          headScore.jumpDel,
+          left.match + largeIndelScore,
+          badVal,
+          left.ins + largeIndelScore - scores.open,
+          left.jumpDel,
+          left.jumpIns + largeIndelScore);
+      if (0 == queryIndex) headScore.jumpDel = badVal;
+
+      // update jumpIns
+      headPtr.jumpIns =
+          max5(headScore.jumpIns, up.match + largeIndelScore, badVal, badVal, badVal, up.jumpIns);
+      if (0 == queryIndex) headScore.jumpIns = badVal;
+    }
+
+    /// the insert state can later recover (largeIndelScore - open) with a transition to jumpDel
+    ScoreType getPotentialScore(const ScoreVal& val) const
+    {
+      return std::max({val.match, val.del, ScoreType(val.ins + insertBonus), val.jumpDel, val.jumpIns});
+    }
+
+    const AlignmentScores<ScoreType> scores;
+    const ScoreType                  largeIndelScore;
+    const ScoreType                  insertBonus;
+    ScoreVal                         badCell;
+    const int64_t                    maxQueryGain;
+    const int64_t                    scoreRange;
+    const bool                       isBandSupported;
+  };
+
   // add the matrices here to reduce allocations over many alignment calls:
   typedef std::vector<ScoreVal> ScoreVec;
   mutable ScoreVec              _score1;
@@ -158,7 +312,11 @@ private:
   typedef basic_matrix<PtrVal> PtrMat;
   mutable PtrMat               _ptrMat;
 
-  const ScoreType _largeIndelScore;
+  mutable AlignerBandWorkspace<ScoreVal> _bandWorkspace;
+  mutable AlignerBandMatrix<PtrVal>      _bandPtrMat;
+
+  const ScoreType  _largeIndelScore;
+  const CellPolicy _cellPolicy;
 };
 
 #include "alignment/GlobalLargeIndelAlignerImpl.hpp"
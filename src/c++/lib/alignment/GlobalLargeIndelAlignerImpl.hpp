@@ -56,8 +56,6 @@ void GlobalLargeIndelAligner<ScoreType>::align(
   ScoreVec* thisSV(&_score1);
   ScoreVec* prevSV(&_score2);
 
-  static const ScoreType badVal(-10000);
-
   // global alignment of query
   //
   // disallow start from the delete state, control start from insert state with flag
@@ -66,23 +64,7 @@ void GlobalLargeIndelAligner<ScoreType>::align(
   // be soft-clipped and each base off the end will be scored as offEdge
   //
   for (unsigned queryIndex(0); queryIndex <= querySize; queryIndex++) {
-    PtrVal&   headPtr(_ptrMat.val(queryIndex, 0));
-    ScoreVal& val((*thisSV)[queryIndex]);
-    headPtr.match = AlignState::MATCH;
-    val.match     = queryIndex * scores.offEdge;
-    headPtr.del   = AlignState::MATCH;
-    val.del       = badVal;
-    if (not scores.isAllowEdgeInsertion) {
-      headPtr.ins = AlignState::MATCH;
-      val.ins     = badVal;
-    } else {
-      headPtr.ins = AlignState::INSERT;
-      val.ins     = scores.open + (queryIndex * scores.extend);
-    }
-    headPtr.jumpDel = AlignState::MATCH;
-    val.jumpDel     = badVal;
-    headPtr.jumpIns = AlignState::MATCH;
-    val.jumpIns     = badVal;
+    _cellPolicy.initEdgeCell(queryIndex, (*thisSV)[queryIndex], _ptrMat.val(queryIndex, 0));
   }
 
 #ifdef DEBUG_ALN_MATRIX
@@ -99,82 +81,20 @@ void GlobalLargeIndelAligner<ScoreType>::align(
     for (SymIter refIter(refBegin); refIter != refEnd; ++refIter, ++refIndex) {
       std::swap(thisSV, prevSV);
 
-      {
-        // disallow start from the insert or delete states:
-        PtrVal&   headPtr(_ptrMat.val(0, refIndex + 1));
-        ScoreVal& val((*thisSV)[0]);
-        headPtr.match   = AlignState::MATCH;
-        val.match       = 0;
-        headPtr.del     = AlignState::MATCH;
-        val.del         = badVal;
-        headPtr.ins     = AlignState::MATCH;
-        val.ins         = badVal;
-        headPtr.jumpDel = AlignState::MATCH;
-        val.jumpDel     = badVal;
-        headPtr.jumpIns = AlignState::MATCH;
-        val.jumpIns     = badVal;
-      }
+      _cellPolicy.initTopCell((*thisSV)[0], _ptrMat.val(0, refIndex + 1));
 
       unsigned queryIndex(0);
       for (SymIter queryIter(queryBegin); queryIter != queryEnd; ++queryIter, ++queryIndex) {
-        // update match
         ScoreVal& headScore((*thisSV)[queryIndex + 1]);
         PtrVal&   headPtr(_ptrMat.val(queryIndex + 1, refIndex + 1));
-        {
-          const ScoreVal& sval((*prevSV)[queryIndex]);
-          headPtr.match =
-              this->max5(headScore.match, sval.match, sval.del, sval.ins, sval.jumpDel, sval.jumpIns);
-
-          headScore.match += ((*queryIter == *refIter) ? scores.match : scores.mismatch);
-        }
-
-        // update delete
-        {
-          const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.del =
-              this->max5(headScore.del, sval.match + scores.open, sval.del, sval.ins, badVal, sval.jumpIns);
-
-          headScore.del += scores.extend;
-          if (0 == queryIndex) headScore.del = badVal;
-        }
-
-        // update insert
-        {
-          const ScoreVal& sval((*thisSV)[queryIndex]);
-          headPtr.ins = this->max5(headScore.ins, sval.match + scores.open, badVal, sval.ins, badVal, badVal);
-
-          headScore.ins += scores.extend;
-          if (0 == queryIndex) headScore.ins = badVal;
-        }
-
-        // update jumpDel
-        {
-          // you can switch between long ins and delete but only
-          // by paying the full open penalty again
-          //
-          // the switch from short ins to jump del is meant to simulate
-          // a free transition from jump del to short ins, but makes
-          // the cigar I->D order come out the same as other aligners in this library
-          const ScoreVal& sval((*prevSV)[queryIndex + 1]);
-          headPtr.jumpDel = this->max5(
-              headScore.jumpDel,
-              sval.match + _largeIndelScore,
-              badVal,
-              sval.ins + _largeIndelScore - scores.open,
-              sval.jumpDel,
-              sval.jumpIns + _largeIndelScore);
-
-          if (0 == queryIndex) headScore.jumpDel = badVal;
-        }
-
-        // update jumpIns
-        {
-          const ScoreVal& sval((*thisSV)[queryIndex]);
-          headPtr.jumpIns = this->max5(
-              headScore.jumpIns, sval.match + _largeIndelScore, badVal, badVal, badVal, sval.jumpIns);
-
-          if (0 == queryIndex) headScore.jumpIns = badVal;
-        }
+        _cellPolicy.updateCell(
+            queryIndex,
+            (*queryIter == *refIter),
+            (*prevSV)[queryIndex],
+            (*prevSV)[queryIndex + 1],
+            (*thisSV)[queryIndex],
+            headScore,
+            headPtr);
 
 #ifdef DEBUG_ALN
         log_os << "queryIdx refIdx: " << queryIndex + 1 << " " << refIndex + 1 << "\n";
@@ -223,3 +143,32 @@ void GlobalLargeIndelAligner<ScoreType>::align(
   this->backTraceAlignment(
       queryBegin, queryEnd, refBegin, refEnd, querySize, refSize, _ptrMat, btrace, result);
 }
+
+template <typename ScoreType>
+template <typename SymIter>
+void GlobalLargeIndelAligner<ScoreType>::alignBanded(
+    const SymIter               queryBegin,
+    const SymIter               queryEnd,
+    const SymIter               refBegin,
+    const SymIter               refEnd,
+    const AlignerBand&          band,
+    AlignmentResult<ScoreType>& result) const
+{
+  result.clear();
+
+  const size_t querySize(std::distance(queryBegin, queryEnd));
+  const size_t refSize(std::distance(refBegin, refEnd));
+
+  assert(0 != querySize);
+  assert(0 != refSize);
+
+  BackTrace<ScoreType> btrace;
+  if (not getBandedBacktrace(
+          _cellPolicy, queryBegin, queryEnd, refBegin, refEnd, band, _bandWorkspace, _bandPtrMat, btrace)) {
+    align(queryBegin, queryEnd, refBegin, refEnd, result);
+    return;
+  }
+
+  this->backTraceAlignment(
+      queryBegin, queryEnd, refBegin, refEnd, querySize, refSize, _bandPtrMat, btrace, result);
+}
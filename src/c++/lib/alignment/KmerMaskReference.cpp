@@ -0,0 +1,161 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "alignment/KmerMaskReference.hpp"
+
+#include "blt_util/log.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+//#define DEBUG_KMER
+
+/// \return 2-bit code of an 'ACGT' symbol, or -1 for any other symbol
+static int getBaseCode(const char symbol)
+{
+  switch (symbol) {
+  case 'A':
+    return 0;
+  case 'C':
+    return 1;
+  case 'G':
+    return 2;
+  case 'T':
+    return 3;
+  default:
+    return -1;
+  }
+}
+
+/// \brief Scan all kmers of a sequence with a rolling 2-bit encoding
+///
+/// \p kmerFunc is called with the start offset of each kmer, its encoding, and a flag which is set if the
+/// kmer contains any symbol other than 'ACGT', in which case the encoding is not valid.
+template <typename KmerFunc>
+static void scanKmers(
+    const std::string::const_iterator seqStart, const std::string::const_iterator seqEnd, KmerFunc kmerFunc)
+{
+  static const unsigned merSize(KmerMaskReferenceBuffer::merSize);
+  static const uint32_t codeMask((1u << (2 * merSize)) - 1);
+
+  const int seqSize(seqEnd - seqStart);
+  uint32_t  code(0);
+  int       lastAmbiguousOffset(-1);
+  for (int offset(0); offset < seqSize; ++offset) {
+    int baseCode(getBaseCode(seqStart[offset]));
+    if (baseCode < 0) {
+      lastAmbiguousOffset = offset;
+      baseCode            = 0;
+    }
+    code = ((code << 2) | baseCode) & codeMask;
+
+    const int kmerStart(offset + 1 - static_cast<int>(merSize));
+    if (kmerStart < 0) continue;
+    kmerFunc(kmerStart, code, (lastAmbiguousOffset >= kmerStart));
+  }
+}
+
+/// Index all kmers of \p contig in \p buffer, replacing the previous contig
+static void indexContigKmers(const std::string& contig, KmerMaskReferenceBuffer& buffer)
+{
+  static const unsigned merSize(KmerMaskReferenceBuffer::merSize);
+
+  std::vector<uint64_t>& bits(buffer.contigKmerBits);
+  if (bits.empty()) {
+    bits.resize((1u << (2 * merSize)) / 64, 0);
+  } else {
+    for (const uint32_t code : buffer.contigKmerCodes) {
+      bits[code / 64] = 0;
+    }
+  }
+  buffer.contigKmerCodes.clear();
+  buffer.contigAmbiguousKmers.clear();
+
+  scanKmers(
+      contig.begin(), contig.end(), [&](const int kmerStart, const uint32_t code, const bool isAmbiguous) {
+        if (isAmbiguous) {
+          buffer.contigAmbiguousKmers.insert(contig.substr(kmerStart, merSize));
+        } else {
+          bits[code / 64] |= (uint64_t(1) << (code % 64));
+          buffer.contigKmerCodes.push_back(code);
+        }
+      });
+}
+
+std::string kmerMaskReference(
+    const std::string::const_iterator refSeqStart,
+    const std::string::const_iterator refSeqEnd,
+    const std::string&                contig,
+    const int                         nSpacer,
+    KmerMaskReferenceBuffer&          buffer,
+    std::vector<exclusion_block>&     exclBlocks)
+{
+  typedef std::string::const_iterator SymIter;
+
+  static const int merSize(KmerMaskReferenceBuffer::merSize);
+
+  // Hash all kmers in the contig
+  indexContigKmers(contig, buffer);
+  const std::vector<uint64_t>&           bits(buffer.contigKmerBits);
+  const std::unordered_set<std::string>& ambiguousKmers(buffer.contigAmbiguousKmers);
+
+  // Mask the reference (and keep track of excluded regions for coordinate translation later)
+  static const int minExclusion(1000);
+  static const int padding(50);  // Amount of sequence included around each kmer hit.
+  std::string      maskedRef;
+  const SymIter    maxRef       = std::max(refSeqStart, refSeqEnd - (merSize - 1));
+  SymIter          potExclStart = refSeqStart;
+  SymIter          inclStart    = refSeqStart;
+  scanKmers(refSeqStart, refSeqEnd, [&](const int kmerStart, const uint32_t code, const bool isAmbiguous) {
+    const SymIter refIt(refSeqStart + kmerStart);
+    bool          isMatch(false);
+    if (isAmbiguous) {
+      isMatch =
+          ((!ambiguousKmers.empty()) && (ambiguousKmers.count(std::string(refIt, refIt + merSize)) != 0));
+    } else {
+      isMatch = ((bits[code / 64] >> (code % 64)) & 1);
+    }
+    if (!isMatch) return;
+
+    if ((refIt - potExclStart) > (minExclusion + padding)) {
+      unsigned spacer(0);
+      if (potExclStart > refSeqStart) {
+        maskedRef.append(inclStart, potExclStart);
+        maskedRef.append(nSpacer, 'N');
+        spacer = nSpacer;
+      }
+      inclStart = refIt - padding;
+      exclBlocks.emplace_back(potExclStart - refSeqStart, inclStart - potExclStart, spacer);
+    }
+    potExclStart = refIt + padding;
+  });
+  maskedRef.append(inclStart, std::min(maxRef, potExclStart));
+#ifdef DEBUG_KMER
+  log_os << __FUNCTION__ << "Reduced to " << maskedRef << '\n';
+  log_os << __FUNCTION__ << " exclBlocks\n\t";
+  for (const auto block : exclBlocks)
+    log_os << " " << block.start << ":" << block.length << ":" << block.nSpacer;
+  log_os << "\n";
+#endif
+  if (maskedRef.empty()) maskedRef.append(nSpacer, 'N');
+  return maskedRef;
+}
@@ -0,0 +1,72 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Reduce a reference sequence to the regions sharing kmers with a contig
+///
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// Represents a stretch of reference sequence excluded from alignment by the kmer matcher.
+struct exclusion_block {
+  exclusion_block(const unsigned s, const unsigned l, const unsigned sp) : start(s), length(l), nSpacer(sp) {}
+  unsigned start;    // Start of excluded region
+  unsigned length;   // Nunmber of bp excluded
+  unsigned nSpacer;  // Number of 'N' added in place of excluded sequence
+};
+
+/// \brief Reusable buffers for kmerMaskReference
+///
+/// Contig kmers composed only of 'ACGT' are indexed in a bitmap over all 2-bit encoded kmers, other kmers
+/// are stored as strings. The bitmap is cleared incrementally between contigs, so one object should be
+/// reused (for instance one per thread) for all kmerMaskReference calls.
+///
+struct KmerMaskReferenceBuffer {
+  /// Kmer size used to find reference regions matching the contig
+  static const unsigned merSize = 10;
+
+  /// One bit for each 2-bit encoded kmer, set if the kmer is found in the contig
+  std::vector<uint64_t> contigKmerBits;
+
+  /// Encoded kmers set in contigKmerBits, used to clear the bitmap for the next contig
+  std::vector<uint32_t> contigKmerCodes;
+
+  /// Contig kmers which contain any symbol other than 'ACGT'
+  std::unordered_set<std::string> contigAmbiguousKmers;
+};
+
+/// \brief Returns a reduced reference sequence where long stretches without kmer matches to the contig are
+/// removed
+///
+/// Each excluded stretch is replaced by \p nSpacer 'N' symbols (except at the start of the reference), and is
+/// recorded in \p exclBlocks for coordinate translation of alignments to the reduced reference.
+///
+/// \param[in,out] buffer Reusable kmer index buffers
+std::string kmerMaskReference(
+    const std::string::const_iterator refSeqStart,
+    const std::string::const_iterator refSeqEnd,
+    const std::string&                contig,
+    const int                         nSpacer,
+    KmerMaskReferenceBuffer&          buffer,
+    std::vector<exclusion_block>&     exclBlocks);
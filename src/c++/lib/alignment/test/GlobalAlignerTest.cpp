@@ -23,6 +23,7 @@
 
 #include "blt_util/align_path.hpp"
 
+#include <random>
 #include <string>
 
 BOOST_AUTO_TEST_SUITE(test_GlobalAligner)
@@ -201,4 +202,84 @@ BOOST_AUTO_TEST_CASE(test_GlobalAlignerNoClipEdgeIndel)
   BOOST_REQUIRE_EQUAL(result.align.beginPos, 0);
 }
 
+/// Get a random DNA sequence of length \p size
+static std::string getRandomSequence(std::mt19937& gen, const unsigned size)
+{
+  static const char                       bases[] = "ACGT";
+  std::uniform_int_distribution<unsigned> baseDist(0, 3);
+  std::string                             seq;
+  for (unsigned index(0); index < size; ++index) {
+    seq.push_back(bases[baseDist(gen)]);
+  }
+  return seq;
+}
+
+/// \brief Get a contig from a random segment of \p ref with one deletion, one insertion and substitutions
+///
+/// \param[out] refOffset Reference position of the contig start
+static std::string getVariantContig(
+    std::mt19937& gen, const std::string& ref, const unsigned maxIndelSize, unsigned& refOffset)
+{
+  std::uniform_int_distribution<unsigned> posDist(0, ref.size() - 1);
+  std::uniform_int_distribution<unsigned> indelDist(0, maxIndelSize);
+  unsigned                                begin(posDist(gen));
+  unsigned                                end(posDist(gen));
+  if (begin > end) std::swap(begin, end);
+  refOffset = begin;
+
+  std::string                             contig(ref.substr(begin, end + 1 - begin));
+  std::uniform_int_distribution<unsigned> contigPosDist(0, contig.size());
+  contig.erase(contigPosDist(gen), indelDist(gen));
+  contig.insert(
+      std::min(contigPosDist(gen), static_cast<unsigned>(contig.size())),
+      getRandomSequence(gen, indelDist(gen)));
+
+  std::uniform_int_distribution<unsigned> mutateDist(0, 19);
+  for (char& base : contig) {
+    if (mutateDist(gen) == 0) base = getRandomSequence(gen, 1)[0];
+  }
+  if (contig.empty()) contig = "A";
+  return contig;
+}
+
+/// Test that banded alignment produces the same alignments as the full matrix alignment, for contigs with
+/// indels, unrelated sequences, and both well placed and misplaced bands
+BOOST_AUTO_TEST_CASE(test_GlobalAlignerBanded)
+{
+  // very high penalties are included so that scores fall below the 'bad' state value:
+  const AlignmentScores<int> scoresList[] = {AlignmentScores<int>(2, -8, -12, -1, -1),
+                                             AlignmentScores<int>(2, -4, -5, -1, -4, true),
+                                             AlignmentScores<int>(2, -200, -150, -50, -150)};
+
+  std::mt19937                            gen(42);
+  std::uniform_int_distribution<unsigned> refSizeDist(1, 400);
+  std::uniform_int_distribution<int>      bandOffsetDist(-50, 50);
+
+  for (unsigned scoreIndex(0); scoreIndex < 3; ++scoreIndex) {
+    GlobalAligner<int> aligner(scoresList[scoreIndex]);
+    for (unsigned testIndex(0); testIndex < 300; ++testIndex) {
+      const std::string ref(getRandomSequence(gen, refSizeDist(gen)));
+      unsigned          refOffset(0);
+      const std::string query(
+          (testIndex % 5 == 4) ? getRandomSequence(gen, refSizeDist(gen))
+                               : getVariantContig(gen, ref, 20, refOffset));
+
+      // anchor the first and last query positions at the contig reference positions, and sometimes move
+      // the band away from the true alignment:
+      const int   bandOffset((testIndex % 3 == 2) ? bandOffsetDist(gen) : 0);
+      const int   refEndPos(refOffset + query.size() - 1);
+      AlignerBand band(AlignerBand::getAnchorBand(
+          0, refOffset + bandOffset, query.size() - 1, refEndPos + bandOffset, testIndex % 4));
+
+      AlignmentResult<int> fullResult, bandResult;
+      aligner.align(query.begin(), query.end(), ref.begin(), ref.end(), fullResult);
+      aligner.alignBanded(query.begin(), query.end(), ref.begin(), ref.end(), band, bandResult);
+
+      BOOST_REQUIRE_EQUAL(bandResult.score, fullResult.score);
+      BOOST_REQUIRE_EQUAL(bandResult.align.beginPos, fullResult.align.beginPos);
+      BOOST_REQUIRE_EQUAL(apath_to_cigar(bandResult.align.apath), apath_to_cigar(fullResult.align.apath));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
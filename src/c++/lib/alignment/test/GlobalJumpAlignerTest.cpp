@@ -23,6 +23,7 @@
 
 #include "blt_util/align_path.hpp"
 
+#include <random>
 #include <string>
 
 BOOST_AUTO_TEST_SUITE(test_GlobalJumpAligner)
@@ -329,4 +330,84 @@ BOOST_AUTO_TEST_CASE(test_GlobalJumpAlignerJumpRange)
   BOOST_REQUIRE_EQUAL(result3.jumpRange, 0u);
 }
 
+/// Get a random DNA sequence of length \p size
+static std::string getRandomSequence(std::mt19937& gen, const unsigned size)
+{
+  static const char                       bases[] = "ACGT";
+  std::uniform_int_distribution<unsigned> baseDist(0, 3);
+  std::string                             seq;
+  for (unsigned index(0); index < size; ++index) {
+    seq.push_back(bases[baseDist(gen)]);
+  }
+  return seq;
+}
+
+/// Get a contig with random substitutions spanning a breakend from \p ref1 to \p ref2, with a short insertion
+static std::string getBreakendContig(std::mt19937& gen, const std::string& ref1, const std::string& ref2)
+{
+  std::uniform_int_distribution<unsigned> ref1Dist(0, ref1.size());
+  std::uniform_int_distribution<unsigned> ref2Dist(0, ref2.size());
+  std::uniform_int_distribution<unsigned> insertDist(0, 4);
+  std::string                             contig(
+      ref1.substr(ref1Dist(gen)) + getRandomSequence(gen, insertDist(gen)) + ref2.substr(0, ref2Dist(gen)));
+
+  std::uniform_int_distribution<unsigned> mutateDist(0, 9);
+  for (char& base : contig) {
+    if (mutateDist(gen) == 0) base = getRandomSequence(gen, 1)[0];
+  }
+  if (contig.empty()) contig = "A";
+  return contig;
+}
+
+/// Test that the vectorized matrix fill produces the same alignments as the scalar fill
+BOOST_AUTO_TEST_CASE(test_GlobalJumpAlignerVectorFill)
+{
+  // default spanning aligner scores, and very high penalties so that scores fall below the 'bad' state value:
+  const AlignmentScores<int> scoresList[] = {AlignmentScores<int>(2, -8, -12, -1, -1),
+                                             AlignmentScores<int>(2, -4, -2, 0, -1),
+                                             AlignmentScores<int>(2, -200, -150, -50, -150)};
+  const int                  jumpScores[] = {-100, -3, -300};
+
+  std::mt19937                            gen(42);
+  std::uniform_int_distribution<unsigned> sizeDist(1, 70);
+
+  for (unsigned scoreIndex(0); scoreIndex < 3; ++scoreIndex) {
+    GlobalJumpAligner<int> scalarAligner(scoresList[scoreIndex], jumpScores[scoreIndex]);
+    scalarAligner.setIsa(GlobalJumpAlignerIsa::SCALAR);
+
+    for (unsigned isaIndex(GlobalJumpAlignerIsa::SSE41); isaIndex < GlobalJumpAlignerIsa::SIZE; ++isaIndex) {
+      const auto isa(static_cast<GlobalJumpAlignerIsa::index_t>(isaIndex));
+      if (not GlobalJumpAlignerKernel::isIsaSupported(isa)) continue;
+
+      GlobalJumpAligner<int> vectorAligner(scoresList[scoreIndex], jumpScores[scoreIndex]);
+      vectorAligner.setIsa(isa);
+
+      for (unsigned testIndex(0); testIndex < 200; ++testIndex) {
+        const std::string ref1(getRandomSequence(gen, sizeDist(gen)));
+        const std::string ref2(getRandomSequence(gen, sizeDist(gen)));
+
+        // alternate between unrelated sequences and a breakend contig:
+        const std::string query(
+            (testIndex % 2) ? getRandomSequence(gen, sizeDist(gen)) : getBreakendContig(gen, ref1, ref2));
+
+        JumpAlignmentResult<int> scalarResult, vectorResult;
+        scalarAligner.align(
+            query.begin(), query.end(), ref1.begin(), ref1.end(), ref2.begin(), ref2.end(), scalarResult);
+        vectorAligner.align(
+            query.begin(), query.end(), ref1.begin(), ref1.end(), ref2.begin(), ref2.end(), vectorResult);
+
+        BOOST_REQUIRE_EQUAL(vectorResult.score, scalarResult.score);
+        BOOST_REQUIRE_EQUAL(vectorResult.jumpInsertSize, scalarResult.jumpInsertSize);
+        BOOST_REQUIRE_EQUAL(vectorResult.jumpRange, scalarResult.jumpRange);
+        BOOST_REQUIRE_EQUAL(vectorResult.align1.beginPos, scalarResult.align1.beginPos);
+        BOOST_REQUIRE_EQUAL(vectorResult.align2.beginPos, scalarResult.align2.beginPos);
+        BOOST_REQUIRE_EQUAL(
+            apath_to_cigar(vectorResult.align1.apath), apath_to_cigar(scalarResult.align1.apath));
+        BOOST_REQUIRE_EQUAL(
+            apath_to_cigar(vectorResult.align2.apath), apath_to_cigar(scalarResult.align2.apath));
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "KmerMaskReference.hpp"
+
+#include <random>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(test_KmerMaskReference)
+
+/// Direct string hash implementation of kmerMaskReference, used as the expected result
+static std::string stringHashKmerMaskReference(
+    const std::string&            ref,
+    const std::string&            contig,
+    const int                     nSpacer,
+    std::vector<exclusion_block>& exclBlocks)
+{
+  static const int                merSize(KmerMaskReferenceBuffer::merSize);
+  std::unordered_set<std::string> contigHash;
+  for (unsigned contigMerIndex(0); contigMerIndex < (contig.size() - (merSize - 1)); ++contigMerIndex) {
+    contigHash.insert(contig.substr(contigMerIndex, merSize));
+  }
+  static const int                  minExclusion(1000);
+  static const int                  padding(50);
+  std::string                       maskedRef;
+  const std::string::const_iterator maxRef       = ref.end() - (merSize - 1);
+  std::string::const_iterator       potExclStart = ref.begin();
+  std::string::const_iterator       inclStart    = ref.begin();
+  for (std::string::const_iterator refIt = ref.begin(); refIt != maxRef; refIt++) {
+    if (contigHash.count(std::string(refIt, refIt + merSize)) != 0) {
+      if ((refIt - potExclStart) > (minExclusion + padding)) {
+        unsigned spacer(0);
+        if (potExclStart > ref.begin()) {
+          maskedRef.append(std::string(inclStart, potExclStart));
+          maskedRef.append(nSpacer, 'N');
+          spacer = nSpacer;
+        }
+        inclStart = refIt - padding;
+        exclBlocks.emplace_back(potExclStart - ref.begin(), inclStart - potExclStart, spacer);
+      }
+      potExclStart = refIt + padding;
+    }
+  }
+  maskedRef.append(std::string(inclStart, std::min(maxRef, potExclStart)));
+  if (maskedRef.empty()) maskedRef.append(nSpacer, 'N');
+  return maskedRef;
+}
+
+BOOST_AUTO_TEST_CASE(test_kmerMaskReferenceSimple)
+{
+  // a contig matching two short segments of a long reference should exclude the reference start and the
+  // region between the two segments:
+  std::string ref(5000, 'A');
+  ref.replace(2000, 12, "CGTACGTTGCAC");
+  ref.replace(4000, 12, "GGCATTCAGCTA");
+  const std::string contig("CGTACGTTGCACGGCATTCAGCTA");
+
+  KmerMaskReferenceBuffer      buffer;
+  std::vector<exclusion_block> exclBlocks;
+  const std::string maskedRef(kmerMaskReference(ref.begin(), ref.end(), contig, 5, buffer, exclBlocks));
+
+  BOOST_REQUIRE_EQUAL(exclBlocks.size(), 2u);
+  BOOST_REQUIRE_EQUAL(exclBlocks[0].start, 0u);
+  BOOST_REQUIRE_EQUAL(exclBlocks[0].length, 1950u);
+  BOOST_REQUIRE_EQUAL(exclBlocks[0].nSpacer, 0u);
+  BOOST_REQUIRE_EQUAL(exclBlocks[1].start, 2052u);
+  BOOST_REQUIRE_EQUAL(exclBlocks[1].length, 1898u);
+  BOOST_REQUIRE_EQUAL(exclBlocks[1].nSpacer, 5u);
+  BOOST_REQUIRE_EQUAL(maskedRef, ref.substr(1950, 102) + "NNNNN" + ref.substr(3950, 102));
+}
+
+// Test that the rolling kmer index gives the same masked reference and exclusion blocks as the direct string
+// hash, including kmers with non-ACGT symbols, and with a single buffer reused across contigs
+BOOST_AUTO_TEST_CASE(test_kmerMaskReferenceMatchesStringHash)
+{
+  std::mt19937                       randGen(11);
+  std::uniform_int_distribution<int> baseDist(0, 3);
+  static const char                  bases[] = "ACGT";
+
+  KmerMaskReferenceBuffer buffer;
+  for (unsigned testIndex(0); testIndex < 50; ++testIndex) {
+    const unsigned refSize(std::uniform_int_distribution<unsigned>(10, 30000)(randGen));
+    std::string    ref;
+    for (unsigned i(0); i < refSize; ++i) ref.push_back(bases[baseDist(randGen)]);
+
+    // add a few stretches of N and lowercase reference sequence:
+    for (unsigned i(0); i < 3; ++i) {
+      const unsigned pos(std::uniform_int_distribution<unsigned>(0, refSize - 1)(randGen));
+      const unsigned size(std::min(refSize - pos, 15u));
+      for (unsigned j(0); j < size; ++j) ref[pos + j] = ((i == 0) ? 'a' : 'N');
+    }
+
+    // build a contig from several reference segments, plus some random sequence:
+    std::string contig;
+    for (unsigned segmentIndex(0); segmentIndex < 4; ++segmentIndex) {
+      const unsigned segmentSize(std::min(refSize, 40u));
+      const unsigned pos(std::uniform_int_distribution<unsigned>(0, refSize - segmentSize)(randGen));
+      contig += ref.substr(pos, segmentSize);
+      for (unsigned i(0); i < 20; ++i) contig.push_back(bases[baseDist(randGen)]);
+    }
+    if ((testIndex % 2) == 0) contig += "NNNNNNNNNNNNNNNNNNNN";
+
+    std::vector<exclusion_block> expectBlocks;
+    const std::string            expectRef(stringHashKmerMaskReference(ref, contig, 25, expectBlocks));
+
+    std::vector<exclusion_block> exclBlocks;
+    const std::string maskedRef(kmerMaskReference(ref.begin(), ref.end(), contig, 25, buffer, exclBlocks));
+
+    BOOST_REQUIRE_EQUAL(maskedRef, expectRef);
+    BOOST_REQUIRE_EQUAL(exclBlocks.size(), expectBlocks.size());
+    for (unsigned blockIndex(0); blockIndex < exclBlocks.size(); ++blockIndex) {
+      BOOST_REQUIRE_EQUAL(exclBlocks[blockIndex].start, expectBlocks[blockIndex].start);
+      BOOST_REQUIRE_EQUAL(exclBlocks[blockIndex].length, expectBlocks[blockIndex].length);
+      BOOST_REQUIRE_EQUAL(exclBlocks[blockIndex].nSpacer, expectBlocks[blockIndex].nSpacer);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkDepthBuffer.hpp"
+#include "BenchmarkDepthBufferOptions.hpp"
+
+#include "blt_util/RangeMap.hpp"
+#include "blt_util/depth_buffer.hpp"
+#include "blt_util/time_util.hpp"
+#include "common/Exceptions.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+/// The previous RangeMap-based compressible depth buffer, retained here as the benchmark baseline
+struct RangeMapDepthBuffer {
+  explicit RangeMapDepthBuffer(const unsigned compressionFactor)
+    : _csize(compressionFactor), _halfcsize(_csize / 2)
+  {
+  }
+
+  unsigned val(const pos_t pos) const
+  {
+    return ((_data.getConstRefDefault(pos / _csize, 0) + _halfcsize) / _csize);
+  }
+
+  void inc(pos_t pos, const unsigned posRange)
+  {
+    const pos_t endPos(pos + posRange);
+    pos_t       dataPos(pos / _csize);
+    while (true) {
+      const pos_t blockEndPos(std::min(((dataPos + 1) * static_cast<pos_t>(_csize)), endPos));
+      _data.getRef(dataPos) += (blockEndPos - pos);
+
+      if (blockEndPos == endPos) return;
+      pos = blockEndPos;
+      dataPos++;
+    }
+  }
+
+  void clear_pos(const pos_t pos)
+  {
+    if ((pos % _csize) != (_csize - 1)) return;
+    const pos_t dataPos(pos / _csize);
+    if (_data.isKeyPresent(dataPos)) _data.erase(dataPos);
+  }
+
+private:
+  const unsigned            _csize;
+  const unsigned            _halfcsize;
+  RangeMap<pos_t, unsigned> _data;
+};
+
+}  // namespace
+
+/// Run the EstimateSVLoci depth buffer update pattern over all read positions
+///
+/// \return Sum of depth queried at every read start
+template <typename DepthBuffer>
+static unsigned long runDepthBuffer(
+    const std::vector<pos_t>& readPositions, const unsigned readSize, DepthBuffer& depthBuffer)
+{
+  unsigned long depthSum(0);
+  pos_t         clearPos(0);
+  for (const pos_t pos : readPositions) {
+    for (; clearPos < pos; ++clearPos) depthBuffer.clear_pos(clearPos);
+    depthBuffer.inc(pos, readSize);
+    depthSum += depthBuffer.val(pos);
+  }
+  return depthSum;
+}
+
+static void runBenchmarkDepthBuffer(const BenchmarkDepthBufferOptions& opt)
+{
+  const unsigned long readCount((static_cast<unsigned long>(opt.regionSize) * opt.depth) / opt.readSize);
+
+  std::mt19937                         gen(opt.seed);
+  std::uniform_int_distribution<pos_t> posDist(0, opt.regionSize - 1);
+  std::vector<pos_t>                   readPositions(readCount);
+  for (pos_t& pos : readPositions) pos = posDist(gen);
+  std::sort(readPositions.begin(), readPositions.end());
+
+  std::ostream& os(std::cout);
+  os << "regionSize: " << opt.regionSize << " reads: " << readCount << " readSize: " << opt.readSize
+     << " compression: " << opt.compression << "\n";
+  os << "buffer\tnsPerRead\tspeedup\n";
+
+  unsigned long rangeMapDepthSum(0);
+  double        rangeMapSeconds(0);
+  {
+    RangeMapDepthBuffer depthBuffer(opt.compression);
+    TimeTracker         timer;
+    {
+      TimeScoper scoper(timer);
+      rangeMapDepthSum = runDepthBuffer(readPositions, opt.readSize, depthBuffer);
+    }
+    rangeMapSeconds = timer.getWallSeconds();
+    os << "rangemap\t" << std::fixed << std::setprecision(2) << (rangeMapSeconds * 1e9 / readCount) << "\t"
+       << 1.0 << "\n";
+  }
+
+  {
+    depth_buffer_compressible depthBuffer(opt.compression);
+    unsigned long             depthSum(0);
+    TimeTracker               timer;
+    {
+      TimeScoper scoper(timer);
+      depthSum = runDepthBuffer(readPositions, opt.readSize, depthBuffer);
+    }
+    const double seconds(timer.getWallSeconds());
+    os << "dense\t" << std::fixed << std::setprecision(2) << (seconds * 1e9 / readCount) << "\t"
+       << (rangeMapSeconds / seconds) << "\n";
+
+    if (depthSum != rangeMapDepthSum) {
+      BOOST_THROW_EXCEPTION(illumina::common::GeneralException(
+          "Depth values from the dense depth buffer do not match the sparse map depth buffer"));
+    }
+  }
+}
+
+void BenchmarkDepthBuffer::runInternal(int argc, char* argv[]) const
+{
+  BenchmarkDepthBufferOptions opt;
+
+  parseBenchmarkDepthBufferOptions(*this, argc, argv, opt);
+  runBenchmarkDepthBuffer(opt);
+}
@@ -0,0 +1,39 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Microbenchmark for the read depth buffer
+///
+
+#pragma once
+
+#include "common/Program.hpp"
+
+/// \brief Time the dense depth buffer against the previous sparse map based depth buffer
+///
+/// Reads are simulated at uniformly random sorted positions, and each depth buffer is updated with the same
+/// sliding-window pattern used by EstimateSVLoci: each read increments the buffer over its length, the depth
+/// at the read start is queried, and every position behind the read start is cleared. Depth queries from
+/// both buffers are checked for consistency.
+///
+struct BenchmarkDepthBuffer : public illumina::Program {
+  const char* name() const { return "BenchmarkDepthBuffer"; }
+
+  void runInternal(int argc, char* argv[]) const;
+};
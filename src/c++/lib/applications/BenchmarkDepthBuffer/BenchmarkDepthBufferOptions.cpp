@@ -0,0 +1,108 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkDepthBufferOptions.hpp"
+
+#include "blt_util/log.hpp"
+#include "common/ProgramUtil.hpp"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+static void usage(
+    std::ostream&                                      os,
+    const illumina::Program&                           prog,
+    const boost::program_options::options_description& visible,
+    const char*                                        msg = nullptr)
+{
+  usage(
+      os, prog, visible, "benchmark the dense read depth buffer against a sparse map depth buffer", "", msg);
+}
+
+/// \brief Check BenchmarkDepthBufferOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string
+/// content on input is cleared
+///
+/// \return True if an error occurs while parsing options
+static bool parseOptions(const BenchmarkDepthBufferOptions& opt, std::string& errorMsg)
+{
+  errorMsg.clear();
+  if ((opt.regionSize == 0) || (opt.readSize == 0)) {
+    errorMsg = "Region and read sizes must be greater than zero";
+  } else if (opt.depth == 0) {
+    errorMsg = "Depth must be greater than zero";
+  } else if (opt.compression == 0) {
+    errorMsg = "Compression factor must be greater than zero";
+  }
+  return (not errorMsg.empty());
+}
+
+void parseBenchmarkDepthBufferOptions(
+    const illumina::Program& prog, int argc, char* argv[], BenchmarkDepthBufferOptions& opt)
+{
+  namespace po = boost::program_options;
+  po::options_description req("configuration");
+  // clang-format off
+  req.add_options()
+  ("region-size", po::value(&opt.regionSize)->default_value(opt.regionSize),
+   "length of the simulated chromosome region")
+  ("read-size", po::value(&opt.readSize)->default_value(opt.readSize),
+   "length of each simulated read")
+  ("depth", po::value(&opt.depth)->default_value(opt.depth),
+   "average simulated read depth")
+  ("compression", po::value(&opt.compression)->default_value(opt.compression),
+   "depth buffer compression factor")
+  ("seed", po::value(&opt.seed)->default_value(opt.seed),
+   "random seed used to simulate read positions")
+  ;
+  // clang-format on
+
+  po::options_description help("help");
+  help.add_options()("help,h", "print this message");
+
+  po::options_description visible("options");
+  visible.add(req).add(help);
+
+  bool              po_parse_fail(false);
+  po::variables_map vm;
+  try {
+    po::store(
+        po::parse_command_line(
+            argc, argv, visible, po::command_line_style::unix_style ^ po::command_line_style::allow_short),
+        vm);
+    po::notify(vm);
+  } catch (const boost::program_options::error& e) {
+    log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+    po_parse_fail = true;
+  }
+
+  if ((vm.count("help")) || po_parse_fail) {
+    usage(log_os, prog, visible);
+  }
+
+  std::string errorMsg;
+  if (parseOptions(opt, errorMsg)) {
+    usage(log_os, prog, visible, errorMsg.c_str());
+  }
+}
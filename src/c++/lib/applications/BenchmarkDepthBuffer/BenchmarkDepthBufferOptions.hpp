@@ -0,0 +1,46 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Command-line options for BenchmarkDepthBuffer
+///
+
+#pragma once
+
+#include "common/Program.hpp"
+
+struct BenchmarkDepthBufferOptions {
+  /// Length of the simulated chromosome region
+  unsigned regionSize = 10000000;
+
+  /// Length of each simulated read
+  unsigned readSize = 150;
+
+  /// Average simulated read depth
+  unsigned depth = 30;
+
+  /// Depth buffer compression factor, this matches the factor used in EstimateSVLoci and GetChromDepth
+  unsigned compression = 16;
+
+  /// Random seed used to simulate read positions
+  unsigned seed = 1;
+};
+
+void parseBenchmarkDepthBufferOptions(
+    const illumina::Program& prog, int argc, char* argv[], BenchmarkDepthBufferOptions& opt);
@@ -0,0 +1,142 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkJumpAligner.hpp"
+#include "BenchmarkJumpAlignerOptions.hpp"
+
+#include "alignment/GlobalJumpAligner.hpp"
+#include "blt_util/align_path.hpp"
+#include "blt_util/log.hpp"
+#include "blt_util/time_util.hpp"
+#include "common/Exceptions.hpp"
+#include "options/SVRefinerOptions.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+/// Get a random DNA sequence of length \p size
+static std::string getRandomSequence(std::mt19937& gen, const unsigned size)
+{
+  static const char                       bases[] = "ACGT";
+  std::uniform_int_distribution<unsigned> baseDist(0, 3);
+  std::string                             seq(size, 'N');
+  for (char& base : seq) base = bases[baseDist(gen)];
+  return seq;
+}
+
+/// Simulate a contig spanning the breakend from the end of ref1 to the start of ref2, with a short insertion
+/// and a low rate of substitutions
+static std::string getBreakendContig(
+    std::mt19937& gen, const std::string& ref1, const std::string& ref2, const unsigned contigSize)
+{
+  static const unsigned insertSize(3);
+  const unsigned        flankSize(contigSize > insertSize ? (contigSize - insertSize) : contigSize);
+  const unsigned        ref1FlankSize(std::min(flankSize / 2, static_cast<unsigned>(ref1.size())));
+  const unsigned ref2FlankSize(std::min(flankSize - ref1FlankSize, static_cast<unsigned>(ref2.size())));
+
+  std::string contig(ref1.substr(ref1.size() - ref1FlankSize));
+  contig += getRandomSequence(gen, contigSize - ref1FlankSize - ref2FlankSize);
+  contig += ref2.substr(0, ref2FlankSize);
+
+  std::uniform_int_distribution<unsigned> mutateDist(0, 99);
+  for (char& base : contig) {
+    if (mutateDist(gen) == 0) base = getRandomSequence(gen, 1)[0];
+  }
+  return contig;
+}
+
+static bool isEqualResult(const JumpAlignmentResult<int>& a, const JumpAlignmentResult<int>& b)
+{
+  return (
+      (a.score == b.score) && (a.jumpInsertSize == b.jumpInsertSize) && (a.jumpRange == b.jumpRange) &&
+      (a.align1.beginPos == b.align1.beginPos) && (a.align1.apath == b.align1.apath) &&
+      (a.align2.beginPos == b.align2.beginPos) && (a.align2.apath == b.align2.apath));
+}
+
+static void runBenchmarkJumpAligner(const BenchmarkJumpAlignerOptions& opt)
+{
+  std::mt19937      gen(opt.seed);
+  const std::string ref1(getRandomSequence(gen, opt.refSize));
+  const std::string ref2(getRandomSequence(gen, opt.refSize));
+  const std::string contig(getBreakendContig(gen, ref1, ref2, opt.contigSize));
+
+  const SVRefinerOptions refineOpt;
+  const double           cellCount(static_cast<double>(contig.size()) * (ref1.size() + ref2.size()));
+
+  std::ostream& os(std::cout);
+  os << "contigSize: " << contig.size() << " refSize: " << opt.refSize << " iterations: " << opt.iterations
+     << "\n";
+  os << "isa\tusPerAlignment\tMCellsPerSecond\tspeedup\n";
+
+  JumpAlignmentResult<int> scalarResult;
+  double                   scalarSeconds(0);
+  for (unsigned isaIndex(0); isaIndex < GlobalJumpAlignerIsa::SIZE; ++isaIndex) {
+    const auto isa(static_cast<GlobalJumpAlignerIsa::index_t>(isaIndex));
+    if (not GlobalJumpAlignerKernel::isIsaSupported(isa)) continue;
+
+    GlobalJumpAligner<int> aligner(refineOpt.spanningAlignScores, refineOpt.jumpScore);
+    aligner.setIsa(isa);
+
+    // the first alignment sizes all matrices and is not timed:
+    JumpAlignmentResult<int> result;
+    aligner.align(contig.begin(), contig.end(), ref1.begin(), ref1.end(), ref2.begin(), ref2.end(), result);
+
+    if (isa == GlobalJumpAlignerIsa::SCALAR) {
+      scalarResult = result;
+    } else if (not isEqualResult(result, scalarResult)) {
+      std::ostringstream oss;
+      oss << "Jump alignment with instruction set '" << GlobalJumpAlignerIsa::label(isa)
+          << "' does not match scalar alignment";
+      BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+    }
+
+    TimeTracker timer;
+    {
+      TimeScoper scoper(timer);
+      for (unsigned iteration(0); iteration < opt.iterations; ++iteration) {
+        aligner.align(
+            contig.begin(), contig.end(), ref1.begin(), ref1.end(), ref2.begin(), ref2.end(), result);
+      }
+    }
+    const double seconds(timer.getWallSeconds());
+    if (isa == GlobalJumpAlignerIsa::SCALAR) scalarSeconds = seconds;
+
+    os << GlobalJumpAlignerIsa::label(isa) << "\t" << std::fixed << std::setprecision(1)
+       << (seconds * 1e6 / opt.iterations) << "\t" << (cellCount * opt.iterations / seconds / 1e6) << "\t"
+       << std::setprecision(2) << (scalarSeconds / seconds) << "\n";
+  }
+
+  os << "scalar alignment: score: " << scalarResult.score
+     << " cigar1: " << apath_to_cigar(scalarResult.align1.apath)
+     << " cigar2: " << apath_to_cigar(scalarResult.align2.apath) << "\n";
+}
+
+void BenchmarkJumpAligner::runInternal(int argc, char* argv[]) const
+{
+  BenchmarkJumpAlignerOptions opt;
+
+  parseBenchmarkJumpAlignerOptions(*this, argc, argv, opt);
+  runBenchmarkJumpAligner(opt);
+}
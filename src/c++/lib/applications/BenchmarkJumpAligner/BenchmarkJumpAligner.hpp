@@ -0,0 +1,38 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Microbenchmark for the contig jump aligner
+///
+
+#pragma once
+
+#include "common/Program.hpp"
+
+/// \brief Time the contig jump aligner with each supported instruction set
+///
+/// A breakend-spanning contig is simulated from two random reference segments, and aligned repeatedly with
+/// the scalar and each supported vectorized matrix fill, using the default SV refinement spanning
+/// alignment scores. Alignments from each vectorized fill are checked against the scalar result.
+///
+struct BenchmarkJumpAligner : public illumina::Program {
+  const char* name() const { return "BenchmarkJumpAligner"; }
+
+  void runInternal(int argc, char* argv[]) const;
+};
@@ -0,0 +1,106 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkJumpAlignerOptions.hpp"
+
+#include "blt_util/log.hpp"
+#include "common/ProgramUtil.hpp"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+static void usage(
+    std::ostream&                                      os,
+    const illumina::Program&                           prog,
+    const boost::program_options::options_description& visible,
+    const char*                                        msg = nullptr)
+{
+  usage(
+      os, prog, visible, "benchmark the vectorized contig jump aligner against the scalar aligner", "", msg);
+}
+
+/// \brief Check BenchmarkJumpAlignerOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string
+/// content on input is cleared
+///
+/// \return True if an error occurs while parsing options
+static bool parseOptions(const BenchmarkJumpAlignerOptions& opt, std::string& errorMsg)
+{
+  errorMsg.clear();
+  if ((opt.contigSize == 0) || (opt.refSize == 0)) {
+    errorMsg = "Contig and reference sizes must be greater than zero";
+  } else if (opt.contigSize > (2 * opt.refSize)) {
+    errorMsg = "Contig size can't be greater than the combined reference size";
+  } else if (opt.iterations == 0) {
+    errorMsg = "Iteration count must be greater than zero";
+  }
+  return (not errorMsg.empty());
+}
+
+void parseBenchmarkJumpAlignerOptions(
+    const illumina::Program& prog, int argc, char* argv[], BenchmarkJumpAlignerOptions& opt)
+{
+  namespace po = boost::program_options;
+  po::options_description req("configuration");
+  // clang-format off
+  req.add_options()
+  ("contig-size", po::value(&opt.contigSize)->default_value(opt.contigSize),
+   "length of the simulated breakend-spanning contig")
+  ("ref-size", po::value(&opt.refSize)->default_value(opt.refSize),
+   "length of each simulated reference segment")
+  ("iterations", po::value(&opt.iterations)->default_value(opt.iterations),
+   "number of timed alignments for each instruction set")
+  ("seed", po::value(&opt.seed)->default_value(opt.seed),
+   "random seed used to simulate sequences")
+  ;
+  // clang-format on
+
+  po::options_description help("help");
+  help.add_options()("help,h", "print this message");
+
+  po::options_description visible("options");
+  visible.add(req).add(help);
+
+  bool              po_parse_fail(false);
+  po::variables_map vm;
+  try {
+    po::store(
+        po::parse_command_line(
+            argc, argv, visible, po::command_line_style::unix_style ^ po::command_line_style::allow_short),
+        vm);
+    po::notify(vm);
+  } catch (const boost::program_options::error& e) {
+    log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+    po_parse_fail = true;
+  }
+
+  if ((vm.count("help")) || po_parse_fail) {
+    usage(log_os, prog, visible);
+  }
+
+  std::string errorMsg;
+  if (parseOptions(opt, errorMsg)) {
+    usage(log_os, prog, visible, errorMsg.c_str());
+  }
+}
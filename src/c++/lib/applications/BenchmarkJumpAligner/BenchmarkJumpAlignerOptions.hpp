@@ -18,30 +18,26 @@
 //
 
 /// \file
-/// \author Chris Saunders
+/// \brief Command-line options for BenchmarkJumpAligner
 ///
 
 #pragma once
 
-#include <mutex>
+#include "common/Program.hpp"
 
-#include "boost/noncopyable.hpp"
+struct BenchmarkJumpAlignerOptions {
+  /// Length of the simulated breakend-spanning contig
+  unsigned contigSize = 500;
 
-#include "htsapi/bam_dumper.hpp"
+  /// Length of each of the two simulated reference segments
+  unsigned refSize = 1000;
 
-/// Extends the standard BAM writer to allow synchronized writing to the same file from multiple threads
-class SynchronizedBamWriter : private boost::noncopyable {
-public:
-  SynchronizedBamWriter(const char* filename, const bam_hdr_t& header) : m_bamWriter(filename, header) {}
+  /// Number of timed alignments for each instruction set
+  unsigned iterations = 100;
 
-  /// Add another BAM record to the file. File must not be closed.
-  void put_record(const bam1_t* brec)
-  {
-    std::lock_guard<std::mutex> lock(m_writeMutex);
-    m_bamWriter.put_record(brec);
-  }
-
-private:
-  bam_dumper m_bamWriter;
-  std::mutex m_writeMutex;
+  /// Random seed used to simulate sequences
+  unsigned seed = 1;
 };
+
+void parseBenchmarkJumpAlignerOptions(
+    const illumina::Program& prog, int argc, char* argv[], BenchmarkJumpAlignerOptions& opt);
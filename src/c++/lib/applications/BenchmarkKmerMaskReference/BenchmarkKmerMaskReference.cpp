@@ -0,0 +1,173 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkKmerMaskReference.hpp"
+#include "BenchmarkKmerMaskReferenceOptions.hpp"
+
+#include "alignment/KmerMaskReference.hpp"
+#include "blt_util/time_util.hpp"
+#include "common/Exceptions.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+
+/// The previous string hash implementation of kmerMaskReference, retained here as the benchmark baseline
+static std::string stringHashKmerMaskReference(
+    const std::string::const_iterator refSeqStart,
+    const std::string::const_iterator refSeqEnd,
+    const std::string&                contig,
+    const int                         nSpacer,
+    std::vector<exclusion_block>&     exclBlocks)
+{
+  typedef std::string::const_iterator SymIter;
+
+  static const int                merSize(KmerMaskReferenceBuffer::merSize);
+  std::unordered_set<std::string> contigHash;
+  for (unsigned contigMerIndex(0); contigMerIndex < (contig.size() - (merSize - 1)); ++contigMerIndex) {
+    contigHash.insert(contig.substr(contigMerIndex, merSize));
+  }
+  static const int minExclusion(1000);
+  static const int padding(50);
+  std::string      maskedRef;
+  const SymIter    maxRef       = refSeqEnd - (merSize - 1);
+  SymIter          potExclStart = refSeqStart;
+  SymIter          inclStart    = refSeqStart;
+  for (SymIter refIt = refSeqStart; refIt != maxRef; refIt++) {
+    if (contigHash.count(std::string(refIt, refIt + merSize)) != 0) {
+      if ((refIt - potExclStart) > (minExclusion + padding)) {
+        unsigned spacer(0);
+        if (potExclStart > refSeqStart) {
+          maskedRef.append(std::string(inclStart, potExclStart));
+          maskedRef.append(nSpacer, 'N');
+          spacer = nSpacer;
+        }
+        inclStart = refIt - padding;
+        exclBlocks.emplace_back(potExclStart - refSeqStart, inclStart - potExclStart, spacer);
+      }
+      potExclStart = refIt + padding;
+    }
+  }
+  maskedRef.append(std::string(inclStart, std::min(maxRef, potExclStart)));
+  if (maskedRef.empty()) maskedRef.append(nSpacer, 'N');
+  return maskedRef;
+}
+
+/// Summary of all masked references, used to check that both implementations are consistent
+struct MaskSummary {
+  bool operator==(const MaskSummary& rhs) const
+  {
+    return (
+        (maskedSize == rhs.maskedSize) && (blockCount == rhs.blockCount) && (blockPosSum == rhs.blockPosSum));
+  }
+
+  unsigned long maskedSize  = 0;
+  unsigned long blockCount  = 0;
+  unsigned long blockPosSum = 0;
+};
+
+static void addToSummary(
+    const std::string& maskedRef, const std::vector<exclusion_block>& exclBlocks, MaskSummary& summary)
+{
+  summary.maskedSize += maskedRef.size();
+  summary.blockCount += exclBlocks.size();
+  for (const exclusion_block& block : exclBlocks) {
+    summary.blockPosSum += block.start + block.length + block.nSpacer;
+  }
+}
+
+static void runBenchmarkKmerMaskReference(const BenchmarkKmerMaskReferenceOptions& opt)
+{
+  static const int  nSpacer(25);
+  static const char bases[] = "ACGT";
+
+  std::mt19937                       gen(opt.seed);
+  std::uniform_int_distribution<int> baseDist(0, 3);
+
+  std::string ref(opt.regionSize, 'N');
+  for (char& base : ref) base = bases[baseDist(gen)];
+
+  // build each contig from evenly sized segments of the reference region:
+  const unsigned                          segmentSize(opt.contigSize / opt.segmentCount);
+  std::uniform_int_distribution<unsigned> segmentPosDist(0, opt.regionSize - segmentSize);
+  std::vector<std::string>                contigs(opt.contigCount);
+  for (std::string& contig : contigs) {
+    for (unsigned segmentIndex(0); segmentIndex < opt.segmentCount; ++segmentIndex) {
+      contig += ref.substr(segmentPosDist(gen), segmentSize);
+    }
+  }
+
+  std::ostream& os(std::cout);
+  os << "regionSize: " << opt.regionSize << " contigs: " << opt.contigCount
+     << " contigSize: " << (segmentSize * opt.segmentCount) << " segments: " << opt.segmentCount << "\n";
+  os << "mask\tusPerContig\tspeedup\n";
+
+  MaskSummary stringHashSummary;
+  double      stringHashSeconds(0);
+  {
+    TimeTracker timer;
+    {
+      TimeScoper scoper(timer);
+      for (const std::string& contig : contigs) {
+        std::vector<exclusion_block> exclBlocks;
+        const std::string            maskedRef(
+            stringHashKmerMaskReference(ref.begin(), ref.end(), contig, nSpacer, exclBlocks));
+        addToSummary(maskedRef, exclBlocks, stringHashSummary);
+      }
+    }
+    stringHashSeconds = timer.getWallSeconds();
+    os << "stringhash\t" << std::fixed << std::setprecision(2) << (stringHashSeconds * 1e6 / opt.contigCount)
+       << "\t" << 1.0 << "\n";
+  }
+
+  {
+    MaskSummary             summary;
+    KmerMaskReferenceBuffer buffer;
+    TimeTracker             timer;
+    {
+      TimeScoper scoper(timer);
+      for (const std::string& contig : contigs) {
+        std::vector<exclusion_block> exclBlocks;
+        const std::string            maskedRef(
+            kmerMaskReference(ref.begin(), ref.end(), contig, nSpacer, buffer, exclBlocks));
+        addToSummary(maskedRef, exclBlocks, summary);
+      }
+    }
+    const double seconds(timer.getWallSeconds());
+    os << "bitmap\t" << std::fixed << std::setprecision(2) << (seconds * 1e6 / opt.contigCount) << "\t"
+       << (stringHashSeconds / seconds) << "\n";
+
+    if (!(summary == stringHashSummary)) {
+      BOOST_THROW_EXCEPTION(illumina::common::GeneralException(
+          "Masked references from the kmer bitmap do not match the string hash masked references"));
+    }
+  }
+}
+
+void BenchmarkKmerMaskReference::runInternal(int argc, char* argv[]) const
+{
+  BenchmarkKmerMaskReferenceOptions opt;
+
+  parseBenchmarkKmerMaskReferenceOptions(*this, argc, argv, opt);
+  runBenchmarkKmerMaskReference(opt);
+}
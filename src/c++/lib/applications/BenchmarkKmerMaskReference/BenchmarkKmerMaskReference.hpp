@@ -0,0 +1,38 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Microbenchmark for kmerMaskReference
+///
+
+#pragma once
+
+#include "common/Program.hpp"
+
+/// \brief Time the rolling kmer bitmap reference mask against the previous string hash implementation
+///
+/// A random reference region is simulated, with contigs assembled from short segments of the region, as for
+/// RNA fusion contigs spanning several exons. Each contig is used to mask the full reference region, and the
+/// output of both implementations is checked for consistency.
+///
+struct BenchmarkKmerMaskReference : public illumina::Program {
+  const char* name() const { return "BenchmarkKmerMaskReference"; }
+
+  void runInternal(int argc, char* argv[]) const;
+};
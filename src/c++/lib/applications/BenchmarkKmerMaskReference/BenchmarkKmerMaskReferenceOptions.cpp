@@ -0,0 +1,113 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkKmerMaskReferenceOptions.hpp"
+
+#include "blt_util/log.hpp"
+#include "common/ProgramUtil.hpp"
+
+#include "boost/program_options.hpp"
+
+#include <iostream>
+
+static void usage(
+    std::ostream&                                      os,
+    const illumina::Program&                           prog,
+    const boost::program_options::options_description& visible,
+    const char*                                        msg = nullptr)
+{
+  usage(
+      os,
+      prog,
+      visible,
+      "benchmark the kmer bitmap reference mask against a string hash reference mask",
+      "",
+      msg);
+}
+
+/// \brief Check BenchmarkKmerMaskReferenceOptions
+///
+/// \param[out] errorMsg If an error occurs this is set to an end-user targeted error message. Any string
+/// content on input is cleared
+///
+/// \return True if an error occurs while parsing options
+static bool parseOptions(const BenchmarkKmerMaskReferenceOptions& opt, std::string& errorMsg)
+{
+  errorMsg.clear();
+  if ((opt.regionSize == 0) || (opt.contigCount == 0)) {
+    errorMsg = "Region size and contig count must be greater than zero";
+  } else if ((opt.segmentCount == 0) || (opt.contigSize < (opt.segmentCount * 10))) {
+    errorMsg = "Each contig segment must contain at least 10 bases";
+  } else if (opt.contigSize > opt.regionSize) {
+    errorMsg = "Contig size can't be greater than the region size";
+  }
+  return (not errorMsg.empty());
+}
+
+void parseBenchmarkKmerMaskReferenceOptions(
+    const illumina::Program& prog, int argc, char* argv[], BenchmarkKmerMaskReferenceOptions& opt)
+{
+  namespace po = boost::program_options;
+  po::options_description req("configuration");
+  // clang-format off
+  req.add_options()
+  ("region-size", po::value(&opt.regionSize)->default_value(opt.regionSize),
+   "length of the simulated reference region")
+  ("contig-size", po::value(&opt.contigSize)->default_value(opt.contigSize),
+   "length of each simulated contig")
+  ("segment-count", po::value(&opt.segmentCount)->default_value(opt.segmentCount),
+   "number of reference segments used to build each contig")
+  ("contig-count", po::value(&opt.contigCount)->default_value(opt.contigCount),
+   "number of simulated contigs")
+  ("seed", po::value(&opt.seed)->default_value(opt.seed),
+   "random seed used to simulate the reference and contigs")
+  ;
+  // clang-format on
+
+  po::options_description help("help");
+  help.add_options()("help,h", "print this message");
+
+  po::options_description visible("options");
+  visible.add(req).add(help);
+
+  bool              po_parse_fail(false);
+  po::variables_map vm;
+  try {
+    po::store(
+        po::parse_command_line(
+            argc, argv, visible, po::command_line_style::unix_style ^ po::command_line_style::allow_short),
+        vm);
+    po::notify(vm);
+  } catch (const boost::program_options::error& e) {
+    log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+    po_parse_fail = true;
+  }
+
+  if ((vm.count("help")) || po_parse_fail) {
+    usage(log_os, prog, visible);
+  }
+
+  std::string errorMsg;
+  if (parseOptions(opt, errorMsg)) {
+    usage(log_os, prog, visible, errorMsg.c_str());
+  }
+}
@@ -0,0 +1,212 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "BenchmarkSVLocusScanner.hpp"
+#include "BenchmarkSVLocusScannerOptions.hpp"
+
+#include "blt_util/input_stream_handler.hpp"
+#include "blt_util/log.hpp"
+#include "blt_util/time_util.hpp"
+#include "common/Exceptions.hpp"
+#include "htsapi/bam_header_util.hpp"
+#include "manta/BamStreamerUtils.hpp"
+#include "manta/ReadFilter.hpp"
+#include "manta/SVLocusScanner.hpp"
+#include "manta/SVReferenceUtil.hpp"
+#include "svgraph/GenomeIntervalUtil.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+/// All reads from one region which pass the SV locus graph read filters
+struct RegionReads {
+  reference_contig_segment refSeq;
+  std::vector<bam_record>  reads;
+  std::vector<unsigned>    sampleIndices;
+};
+
+/// Summary of all evidence generated in one pass over the input reads, used to check that each scan mode
+/// produces the same result
+struct ScanSummary {
+  bool operator==(const ScanSummary& rhs) const
+  {
+    return (
+        (evidenceReadCount == rhs.evidenceReadCount) && (recordCount == rhs.recordCount) &&
+        (nodeCount == rhs.nodeCount) && (edgeCount == rhs.edgeCount) && (positionSum == rhs.positionSum));
+  }
+
+  bool operator!=(const ScanSummary& rhs) const { return (not((*this) == rhs)); }
+
+  unsigned long evidenceReadCount = 0;
+  unsigned long recordCount       = 0;
+  unsigned long nodeCount         = 0;
+  unsigned long edgeCount         = 0;
+  long long     positionSum       = 0;
+};
+
+}  // namespace
+
+static void addEvidenceToSummary(const std::vector<SVLocusEvidence>& locusEvidence, ScanSummary& summary)
+{
+  summary.recordCount += locusEvidence.size();
+  for (const SVLocusEvidence& evidence : locusEvidence) {
+    summary.nodeCount += evidence.nodeCount;
+    for (unsigned nodeIndex(0); nodeIndex < evidence.nodeCount; ++nodeIndex) {
+      summary.edgeCount += evidence.edgeCounts[nodeIndex];
+      summary.positionSum += evidence.intervals[nodeIndex].range.begin_pos();
+    }
+  }
+}
+
+/// Load all reads from each benchmark region which would be scanned for SV locus evidence
+static void loadRegionReads(
+    const BenchmarkSVLocusScannerOptions&       opt,
+    const bam_header_info&                      bamHeader,
+    std::vector<std::shared_ptr<bam_streamer>>& bamStreams,
+    std::vector<RegionReads>&                   regionReads)
+{
+  static const unsigned refEdgeBufferSize(500);
+
+  regionReads.clear();
+  regionReads.resize(opt.regions.size());
+  for (unsigned regionIndex(0); regionIndex < opt.regions.size(); ++regionIndex) {
+    const std::string& region(opt.regions[regionIndex]);
+    RegionReads&       regionData(regionReads[regionIndex]);
+
+    resetBamStreamsRegion(region, bamStreams);
+    const GenomeInterval scanRegion(convertSamtoolsRegionToGenomeInterval(bamHeader, region));
+    getIntervalReferenceSegment(
+        opt.referenceFilename, bamHeader, refEdgeBufferSize, scanRegion, regionData.refSeq);
+
+    input_stream_handler sinput(mergeBamStreams(bamStreams));
+    while (sinput.next()) {
+      const input_record_info current(sinput.get_current());
+      const bam_record&       read(*(bamStreams[current.sample_no]->get_record_ptr()));
+      if (isReadUnmappedOrFilteredCore(read)) continue;
+      if (read.map_qual() < opt.scanOpt.minMapq) continue;
+      regionData.reads.push_back(read);
+      regionData.sampleIndices.push_back(current.sample_no);
+    }
+  }
+}
+
+/// Scan all reads, either with an independent analysis for isSVEvidence and getSVLocusEvidence, or with a
+/// single analysis shared between the two calls
+static ScanSummary scanRegionReads(
+    const SVLocusScanner&           readScanner,
+    const bam_header_info&          bamHeader,
+    const std::vector<RegionReads>& regionReads,
+    const bool                      isSharedAnalysis)
+{
+  ScanSummary                  summary;
+  SVLocusScannerReadAnalysis   readAnalysis;
+  std::vector<SVLocusEvidence> locusEvidence;
+  SampleEvidenceCounts         evidenceCounts;
+  for (const RegionReads& regionData : regionReads) {
+    const unsigned readCount(regionData.reads.size());
+    for (unsigned readIndex(0); readIndex < readCount; ++readIndex) {
+      const bam_record& read(regionData.reads[readIndex]);
+      const unsigned    sampleIndex(regionData.sampleIndices[readIndex]);
+      if (isSharedAnalysis) {
+        if (!readScanner.isSVEvidence(read, sampleIndex, regionData.refSeq, readAnalysis)) continue;
+        readScanner.getSVLocusEvidence(
+            read, sampleIndex, bamHeader, regionData.refSeq, readAnalysis, locusEvidence, evidenceCounts);
+      } else {
+        if (!readScanner.isSVEvidence(read, sampleIndex, regionData.refSeq)) continue;
+        readScanner.getSVLocusEvidence(
+            read, sampleIndex, bamHeader, regionData.refSeq, locusEvidence, evidenceCounts);
+      }
+      summary.evidenceReadCount++;
+      addEvidenceToSummary(locusEvidence, summary);
+    }
+  }
+  return summary;
+}
+
+static void runBenchmarkSVLocusScanner(const BenchmarkSVLocusScannerOptions& opt)
+{
+  std::vector<std::shared_ptr<bam_streamer>> bamStreams;
+  openBamStreams(opt.referenceFilename, opt.alignFileOpt, bamStreams);
+  assertCompatibleBamStreams(opt.alignFileOpt.alignmentFilenames, bamStreams);
+
+  // assume bam headers are compatible after running assertCompatibleBamStreams
+  const bam_header_info bamHeader(bamStreams[0]->get_header());
+
+  std::vector<RegionReads> regionReads;
+  loadRegionReads(opt, bamHeader, bamStreams, regionReads);
+
+  unsigned long readCount(0);
+  for (const RegionReads& regionData : regionReads) readCount += regionData.reads.size();
+  if (readCount == 0) {
+    BOOST_THROW_EXCEPTION(illumina::common::GeneralException("No reads found in benchmark regions"));
+  }
+
+  const SVLocusScanner readScanner(opt.scanOpt, opt.statsFilename, opt.alignFileOpt.alignmentFilenames);
+
+  std::ostream& os(std::cout);
+  os << "reads: " << readCount << " iterations: " << opt.iterations << "\n";
+  os << "mode\tusPerRead\tspeedup\n";
+
+  static const char* modeLabels[] = {"independent", "shared"};
+  ScanSummary        independentSummary;
+  double             independentSeconds(0);
+  for (unsigned modeIndex(0); modeIndex < 2; ++modeIndex) {
+    const bool isSharedAnalysis(modeIndex == 1);
+
+    // the first pass sizes all buffers and is not timed:
+    const ScanSummary summary(scanRegionReads(readScanner, bamHeader, regionReads, isSharedAnalysis));
+    if (not isSharedAnalysis) {
+      independentSummary = summary;
+    } else if (summary != independentSummary) {
+      BOOST_THROW_EXCEPTION(illumina::common::GeneralException(
+          "SV locus evidence from shared read analysis does not match independent read analysis"));
+    }
+
+    TimeTracker timer;
+    {
+      TimeScoper scoper(timer);
+      for (unsigned iteration(0); iteration < opt.iterations; ++iteration) {
+        scanRegionReads(readScanner, bamHeader, regionReads, isSharedAnalysis);
+      }
+    }
+    const double seconds(timer.getWallSeconds());
+    if (not isSharedAnalysis) independentSeconds = seconds;
+
+    os << modeLabels[modeIndex] << "\t" << std::fixed << std::setprecision(3)
+       << (seconds * 1e6 / (static_cast<double>(readCount) * opt.iterations)) << "\t" << std::setprecision(2)
+       << (independentSeconds / seconds) << "\n";
+  }
+
+  os << "evidence reads: " << independentSummary.evidenceReadCount
+     << " evidence records: " << independentSummary.recordCount << "\n";
+}
+
+void BenchmarkSVLocusScanner::runInternal(int argc, char* argv[]) const
+{
+  BenchmarkSVLocusScannerOptions opt;
+
+  parseBenchmarkSVLocusScannerOptions(*this, argc, argv, opt);
+  runBenchmarkSVLocusScanner(opt);
+}
@@ -0,0 +1,39 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Microbenchmark for SV locus evidence scanning
+///
+
+#pragma once
+
+#include "common/Program.hpp"
+
+/// \brief Time SV locus evidence scanning of reads from real alignment files
+///
+/// All reads passing the SV locus graph MAPQ filter are loaded from the requested regions, and then scanned
+/// repeatedly with SVLocusScanner::isSVEvidence followed by SVLocusScanner::getSVLocusEvidence, both with
+/// independent per-read analysis and with a single SVLocusScannerReadAnalysis shared between the two calls.
+/// Evidence from both modes is checked for consistency.
+///
+struct BenchmarkSVLocusScanner : public illumina::Program {
+  const char* name() const { return "BenchmarkSVLocusScanner"; }
+
+  void runInternal(int argc, char* argv[]) const;
+};
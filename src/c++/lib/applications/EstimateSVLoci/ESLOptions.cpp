@@ -76,6 +76,8 @@ void parseESLOptions(const illumina::Program& prog, int argc, char* argv[], ESLO
    "samtools formatted region, eg. 'chr1:20-30'. May be supplied more than once but regions must not overlap. At least one entry required.")
   ("rna", po::value(&opt.isRNA)->zero_tokens(),
    "For RNA input. Changes small fragment handling.")
+  ("threads", po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),
+   "Number of threads to use for SV locus graph estimation. The graph is the same for any thread count.")
   ;
   // clang-format on
 
@@ -123,6 +125,8 @@ void parseESLOptions(const illumina::Program& prog, int argc, char* argv[], ESLO
     usage(log_os, prog, visible, "Must specify a fasta reference file");
   } else if (opt.regions.empty()) {
     usage(log_os, prog, visible, "Need at least one samtools formatted region");
+  } else if (opt.workerThreadCount == 0) {
+    usage(log_os, prog, visible, "Thread count must be at least 1");
   }
 
   for (const auto& region : opt.regions) {
@@ -46,6 +46,10 @@ struct ESLOptions {
   std::string              statsFilename;
   std::string              chromDepthFilename;
 
+  /// Number of threads used to scan regions. With more than one thread, the SV evidence analysis of reads is
+  /// split across threads, while reads are still merged into the graph in input order.
+  unsigned workerThreadCount = 1;
+
   /// TODO remove the need for this bool by having a single overlap pair handler
   bool isRNA = false;
 };
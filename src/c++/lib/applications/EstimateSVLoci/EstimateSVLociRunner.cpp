@@ -32,6 +32,11 @@
 #include "manta/SVReferenceUtil.hpp"
 #include "svgraph/GenomeIntervalUtil.hpp"
 
+#include "ctpl_stl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <future>
 #include <iostream>
 #include <vector>
 
@@ -39,7 +44,7 @@
 
 EstimateSVLociRunner::EstimateSVLociRunner(const ESLOptions& opt) : _opt(opt)
 {
-  openBamStreams(_opt.referenceFilename, _opt.alignFileOpt.alignmentFilenames, _bamStreams);
+  openBamStreams(_opt.referenceFilename, _opt.alignFileOpt, _bamStreams);
   assertCompatibleBamStreams(opt.alignFileOpt.alignmentFilenames, _bamStreams);
 
   // assume bam headers are compatible after running assertCompatibleBamStreams
@@ -48,6 +53,195 @@ EstimateSVLociRunner::EstimateSVLociRunner(const ESLOptions& opt) : _opt(opt)
 
   _mergedSetPtr =
       std::make_shared<SVLocusSet>(_opt.graphOpt, bamHeaderInfo, _opt.alignFileOpt.alignmentFilenames);
+
+  if (_opt.workerThreadCount > 1) {
+    _threadPoolPtr.reset(new ctpl::thread_pool(_opt.workerThreadCount));
+    const unsigned sampleCount(_opt.alignFileOpt.alignmentFilenames.size());
+    _threadData.resize(_opt.workerThreadCount);
+    for (ThreadAnalysisData& threadData : _threadData) {
+      threadData.inputEvidenceCount.resize(sampleCount);
+      threadData.evidenceCounts.resize(sampleCount);
+    }
+  }
+}
+
+EstimateSVLociRunner::~EstimateSVLociRunner() = default;
+
+namespace {
+
+/// A read retained for concurrent SV evidence analysis, together with the results of that analysis
+struct BufferedRead {
+  bam_record read;
+  unsigned   sampleIndex = 0;
+
+  /// Record number of the read in its input stream, retained for error messages
+  unsigned recordNo = 0;
+
+  bool                         isLocusEvidence = false;
+  std::vector<SVLocusEvidence> locusEvidence;
+};
+
+/// Provides the same error message detail as bam_streamer for a read which has been copied out of the stream
+struct BufferedReadStateReporter : public stream_state_reporter {
+  BufferedReadStateReporter(const bam_streamer& stream, const BufferedRead& bufferedRead)
+    : _stream(stream), _bufferedRead(bufferedRead)
+  {
+  }
+
+  void report_state(std::ostream& os) const override
+  {
+    const bam_record& read(_bufferedRead.read);
+    os << "\tbam_stream_label: '" << _stream.name() << "'\n";
+    os << "\tbam_stream_record_no: " << _bufferedRead.recordNo << "\n";
+    os << "\tbam_record QNAME/read_number: " << read.qname() << "/" << read.read_no() << "\n";
+    os << "\tbam record RNAME: " << _stream.target_id_to_name(read.target_id()) << "\n";
+    os << "\tbam record POS: " << read.pos() << "\n";
+  }
+
+private:
+  const bam_streamer& _stream;
+  const BufferedRead& _bufferedRead;
+};
+
+/// A batch of reads which is analyzed by the worker threads while the next batch is read from the input
+struct ReadBatch {
+  /// Buffered reads are retained between batches to reuse their allocations, so only the first
+  /// \p readCount entries are part of the current batch
+  std::vector<BufferedRead> reads;
+  unsigned                  readCount = 0;
+
+  /// One analysis task for each contiguous chunk of the batch, in batch order
+  std::vector<std::future<void>> chunkTasks;
+};
+
+/// Wait for all analysis tasks of \p batch to complete
+///
+/// If any task failed, the exception from the earliest chunk of the batch is rethrown, but only after all
+/// tasks have completed so that no task is still using the batch.
+void waitForBatchAnalysis(ReadBatch& batch)
+{
+  for (auto& chunkTask : batch.chunkTasks) chunkTask.wait();
+  std::vector<std::future<void>> chunkTasks;
+  chunkTasks.swap(batch.chunkTasks);
+  for (auto& chunkTask : chunkTasks) chunkTask.get();
+}
+
+}  // namespace
+
+void EstimateSVLociRunner::updateLocusSetFinderConcurrently(SVLocusSetFinder& locusFinder)
+{
+  // Number of reads passing the sequential filters in each batch
+  static const unsigned batchReadCount(8192);
+
+  // Each batch is split into several chunks per thread to balance the analysis load:
+  const unsigned threadCount(_threadData.size());
+  const unsigned chunkCount(threadCount * 4);
+
+  input_stream_handler sinput(mergeBamStreams(_bamStreams));
+  bool                 isInputComplete(false);
+
+  // Read the next batch of reads passing the sequential filters, in input order
+  auto fillBatch = [&](ReadBatch& batch) {
+    batch.readCount = 0;
+    while ((!isInputComplete) && (batch.readCount < batchReadCount)) {
+      if (!sinput.next()) {
+        isInputComplete = true;
+        break;
+      }
+      const input_record_info current(sinput.get_current());
+
+      if (current.itype != INPUT_TYPE::READ) {
+        log_os << "ERROR: invalid input condition.\n";
+        exit(EXIT_FAILURE);
+      }
+
+      const bam_streamer& readStream(*_bamStreams[current.sample_no]);
+      const bam_record&   read(*(readStream.get_record_ptr()));
+
+      if (!locusFinder.isAnalysisCandidate(readStream, read, current.sample_no)) continue;
+
+      if (batch.readCount == batch.reads.size()) batch.reads.emplace_back();
+      BufferedRead& bufferedRead(batch.reads[batch.readCount++]);
+      bufferedRead.read        = read;
+      bufferedRead.sampleIndex = current.sample_no;
+      bufferedRead.recordNo    = readStream.record_no();
+    }
+  };
+
+  // Start the SV evidence analysis of all reads in the batch on the worker threads
+  auto startBatchAnalysis = [&](ReadBatch& batch) {
+    assert(batch.chunkTasks.empty());
+    const unsigned chunkSize(std::max(1u, (batch.readCount + chunkCount - 1) / chunkCount));
+    for (unsigned chunkBegin(0); chunkBegin < batch.readCount; chunkBegin += chunkSize) {
+      const unsigned chunkEnd(std::min(batch.readCount, chunkBegin + chunkSize));
+      batch.chunkTasks.push_back(
+          _threadPoolPtr->push([this, &locusFinder, &batch, chunkBegin, chunkEnd](int threadId) {
+            ThreadAnalysisData& threadData(_threadData[threadId]);
+            for (unsigned readIndex(chunkBegin); readIndex < chunkEnd; ++readIndex) {
+              BufferedRead&                   bufferedRead(batch.reads[readIndex]);
+              const unsigned                  sampleIndex(bufferedRead.sampleIndex);
+              const BufferedReadStateReporter readReporter(*_bamStreams[sampleIndex], bufferedRead);
+              bufferedRead.isLocusEvidence = locusFinder.analyzeRead(
+                  readReporter,
+                  bufferedRead.read,
+                  sampleIndex,
+                  threadData.readAnalysis,
+                  bufferedRead.locusEvidence,
+                  threadData.inputEvidenceCount[sampleIndex],
+                  threadData.evidenceCounts[sampleIndex]);
+            }
+          }));
+    }
+  };
+
+  // Merge the analysis results of the batch into the graph, in input order
+  auto addBatchEvidence = [&](const ReadBatch& batch) {
+    for (unsigned readIndex(0); readIndex < batch.readCount; ++readIndex) {
+      const BufferedRead& bufferedRead(batch.reads[readIndex]);
+      if (!bufferedRead.isLocusEvidence) continue;
+      locusFinder.addReadEvidence(bufferedRead.read, bufferedRead.locusEvidence);
+    }
+  };
+
+  // Double-buffer the batches, so that the next batch is read and filtered while the worker threads analyze
+  // the current batch:
+  ReadBatch  batches[2];
+  ReadBatch* analysisBatchPtr(&batches[0]);
+  ReadBatch* inputBatchPtr(&batches[1]);
+  try {
+    fillBatch(*analysisBatchPtr);
+    startBatchAnalysis(*analysisBatchPtr);
+    while (analysisBatchPtr->readCount > 0) {
+      fillBatch(*inputBatchPtr);
+      waitForBatchAnalysis(*analysisBatchPtr);
+      startBatchAnalysis(*inputBatchPtr);
+      addBatchEvidence(*analysisBatchPtr);
+      std::swap(analysisBatchPtr, inputBatchPtr);
+    }
+  } catch (...) {
+    // Worker tasks must not outlive the batches they are analyzing:
+    for (ReadBatch& batch : batches) {
+      for (auto& chunkTask : batch.chunkTasks) chunkTask.wait();
+    }
+
+    // If the input batch failed while the analysis batch was pending, an analysis failure from the
+    // analysis batch is reported instead, because it comes from an earlier read:
+    waitForBatchAnalysis(*analysisBatchPtr);
+    throw;
+  }
+
+  // Merge the diagnostic counts from each thread into the graph:
+  SVLocusSet&    locusSet(*_mergedSetPtr);
+  const unsigned sampleCount(_opt.alignFileOpt.alignmentFilenames.size());
+  for (ThreadAnalysisData& threadData : _threadData) {
+    for (unsigned sampleIndex(0); sampleIndex < sampleCount; ++sampleIndex) {
+      locusSet.getSampleReadInputCounts(sampleIndex)
+          .evidenceCount.merge(threadData.inputEvidenceCount[sampleIndex]);
+      locusSet.getSampleEvidenceCounts(sampleIndex).merge(threadData.evidenceCounts[sampleIndex]);
+      threadData.inputEvidenceCount[sampleIndex].clear();
+      threadData.evidenceCounts[sampleIndex].clear();
+    }
+  }
 }
 
 void EstimateSVLociRunner::estimateSVLociForSingleRegion(const std::string& region)
@@ -79,20 +273,24 @@ void EstimateSVLociRunner::estimateSVLociForSingleRegion(const std::string& regi
 
   SVLocusSetFinder locusFinder(_opt, scanRegion, refSegmentPtr, _mergedSetPtr);
 
-  // loop through alignments from all samples:
-  input_stream_handler sinput(mergeBamStreams(_bamStreams));
-  while (sinput.next()) {
-    const input_record_info current(sinput.get_current());
+  if (_threadPoolPtr) {
+    updateLocusSetFinderConcurrently(locusFinder);
+  } else {
+    // loop through alignments from all samples:
+    input_stream_handler sinput(mergeBamStreams(_bamStreams));
+    while (sinput.next()) {
+      const input_record_info current(sinput.get_current());
 
-    if (current.itype != INPUT_TYPE::READ) {
-      log_os << "ERROR: invalid input condition.\n";
-      exit(EXIT_FAILURE);
-    }
+      if (current.itype != INPUT_TYPE::READ) {
+        log_os << "ERROR: invalid input condition.\n";
+        exit(EXIT_FAILURE);
+      }
 
-    const bam_streamer& readStream(*_bamStreams[current.sample_no]);
-    const bam_record&   read(*(readStream.get_record_ptr()));
+      const bam_streamer& readStream(*_bamStreams[current.sample_no]);
+      const bam_record&   read(*(readStream.get_record_ptr()));
 
-    locusFinder.update(readStream, read, current.sample_no);
+      locusFinder.update(readStream, read, current.sample_no);
+    }
   }
 
   // finished updating:
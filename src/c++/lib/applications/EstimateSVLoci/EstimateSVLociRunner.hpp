@@ -20,12 +20,19 @@
 #pragma once
 
 #include "ESLOptions.hpp"
+#include "manta/SVLocusScanner.hpp"
 #include "svgraph/SVLocusSet.hpp"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 struct bam_streamer;
+struct SVLocusSetFinder;
+
+namespace ctpl {
+class thread_pool;
+}
 
 /// Provides SV loci estimation methods over multiple regions, and manages the one-time initialization costs
 /// of this process
@@ -33,6 +40,8 @@ struct EstimateSVLociRunner : private boost::noncopyable {
   /// \param[in] opt Options for estimation process
   explicit EstimateSVLociRunner(const ESLOptions& opt);
 
+  ~EstimateSVLociRunner();
+
   /// Run the SVlocus estimation process and the specified region and merge results into \p mergedSet
   ///
   /// \param[in] region Target region for estimation process
@@ -42,10 +51,31 @@ struct EstimateSVLociRunner : private boost::noncopyable {
   const SVLocusSet& getLocusSet() const { return *_mergedSetPtr; }
 
 private:
+  /// Read filtering and evidence analysis state which is used by a single worker thread
+  struct ThreadAnalysisData {
+    SVLocusScannerReadAnalysis readAnalysis;
+
+    /// Diagnostic counts from this thread for each sample, merged into the graph after each region
+    std::vector<SVLocusEvidenceCount> inputEvidenceCount;
+    std::vector<SampleEvidenceCounts> evidenceCounts;
+  };
+
+  /// Push all reads from the current region of \p _bamStreams through \p locusFinder, with the SV evidence
+  /// analysis of each read split across the worker thread pool
+  ///
+  /// Reads are filtered and merged into the graph in their input order, so the graph is the same as that
+  /// produced by calling SVLocusSetFinder::update() on each read.
+  void updateLocusSetFinderConcurrently(SVLocusSetFinder& locusFinder);
+
   const ESLOptions _opt;
 
   std::vector<std::shared_ptr<bam_streamer>> _bamStreams;
 
   /// Estimated SVlocus graph components should be merged into this object
   std::shared_ptr<SVLocusSet> _mergedSetPtr;
+
+  /// Worker threads for read analysis, this is only created if more than one thread is requested
+  std::unique_ptr<ctpl::thread_pool> _threadPoolPtr;
+
+  std::vector<ThreadAnalysisData> _threadData;
 };
@@ -76,7 +76,7 @@ void SVLocusSetFinder::addToDepthBuffer(const bam_record& bamRead)
   _positionReadDepthEstimatePtr->inc(refPos, readSize);
 }
 
-void SVLocusSetFinder::update(
+bool SVLocusSetFinder::isAnalysisCandidate(
     const stream_state_reporter& streamErrorReporter,
     const bam_record&            bamRead,
     const unsigned               defaultReadGroupIndex)
@@ -85,14 +85,14 @@ void SVLocusSetFinder::update(
   //
   // Although unmapped reads themselves are filtered out, reads with unmapped mates are still
   // accepted, because these contribute signal for assembly (indel) regions.
-  if (isReadUnmappedOrFilteredCore(bamRead)) return;
+  if (isReadUnmappedOrFilteredCore(bamRead)) return false;
 
   const bool isTumor(_isAlignmentTumor[defaultReadGroupIndex]);
   if (!isTumor) addToDepthBuffer(bamRead);
 
   // Filter out reads from high-depth chromosome regions
   if (_isMaxDepthFilter) {
-    if (_positionReadDepthEstimatePtr->val(bamRead.pos() - 1) > _maxDepth) return;
+    if (_positionReadDepthEstimatePtr->val(bamRead.pos() - 1) > _maxDepth) return false;
   }
 
   // Verify the input reads conform to BAM input restrictions before testing if they could be input evidence
@@ -111,16 +111,26 @@ void SVLocusSetFinder::update(
     }
   }
 
-  // inputCounts is part of the statistics tracking framework used for
-  // methods diagnostics. It does not impact the graph build.
-  SampleReadInputCounts& inputCounts(_getLocusSet().getSampleReadInputCounts(defaultReadGroupIndex));
-
   // Filter out reads below the minimum MAPQ threshold
   if (bamRead.map_qual() < _readScanner.getMinMapQ()) {
-    inputCounts.minMapq++;
-    return;
+    // inputCounts is part of the statistics tracking framework used for
+    // methods diagnostics. It does not impact the graph build.
+    _getLocusSet().getSampleReadInputCounts(defaultReadGroupIndex).minMapq++;
+    return false;
   }
 
+  return true;
+}
+
+bool SVLocusSetFinder::analyzeRead(
+    const stream_state_reporter&  streamErrorReporter,
+    const bam_record&             bamRead,
+    const unsigned                defaultReadGroupIndex,
+    SVLocusScannerReadAnalysis&   readAnalysis,
+    std::vector<SVLocusEvidence>& locusEvidence,
+    SVLocusEvidenceCount&         inputEvidenceCount,
+    SampleEvidenceCounts&         evidenceCounts) const
+{
   // Filter out reads which are not found to be indicative of an SV
   //
   // For certain types of SV evidence, these tests are designed to be a faster approximation of the
@@ -129,20 +139,34 @@ void SVLocusSetFinder::update(
   // later as non-evidence -- they will not be filtered per se, but rather converted into zero SVLocus
   // objects.
   //
-  if (!_readScanner.isSVEvidence(bamRead, defaultReadGroupIndex, _refSeq(), &(inputCounts.evidenceCount)))
-    return;
+  if (!_readScanner.isSVEvidence(
+          bamRead, defaultReadGroupIndex, _refSeq(), readAnalysis, &inputEvidenceCount))
+    return false;
 
 #ifdef DEBUG_SFINDER
-  log_os << __FUNCTION__ << ": Accepted read. isNonCompressedAnomalous " << isNonCompressedAnomalous
-         << " is Local assm evidence: " << isLocalAssemblyEvidence << " read: " << bamRead << "\n";
+  log_os << __FUNCTION__ << ": Accepted read: " << bamRead << "\n";
 #endif
 
   // check that this read starts in our scan region:
-  if (!_scanRegion.range.is_pos_intersect(bamRead.pos() - 1)) return;
+  if (!_scanRegion.range.is_pos_intersect(bamRead.pos() - 1)) return false;
 
   // QC check of read length
   SVLocusScanner::checkReadSize(streamErrorReporter, bamRead);
 
+  // convert the given read into zero to many SV locus evidence records
+  //
+  // In almost all cases, each read should be converted into one evidence record, and that
+  // record will consist of either one or two SV locus nodes.
+  //
+  _readScanner.getSVLocusEvidence(
+      bamRead, defaultReadGroupIndex, _bamHeader(), _refSeq(), readAnalysis, locusEvidence, evidenceCounts);
+
+  return true;
+}
+
+void SVLocusSetFinder::addReadEvidence(
+    const bam_record& bamRead, const std::vector<SVLocusEvidence>& locusEvidence)
+{
   // update the region manager to move the head pointer forward to the current read's position
   //
   // This may trigger a denoising step or clear buffered information for all positions at a
@@ -150,21 +174,33 @@ void SVLocusSetFinder::update(
   //
   _regionManager.handle_new_pos_value(bamRead.pos() - 1);
 
-  // convert the given read into zero to many SVLocus objects
-  //
-  // In almost all cases, each read should be converted into one SVLocus object, and that
-  // SVLocus will consist of either one or two SVLocusNodes.
-  //
-  std::vector<SVLocus> loci;
+  // merge each evidence record directly into this genome segment graph:
+  for (const SVLocusEvidence& evidence : locusEvidence) {
+    _getLocusSet().merge(evidence);
+  }
+}
 
-  // evidenceCounts is part of the statistics tracking framework used for
-  // methods diagnostics. It does not impact the graph build.
-  SampleEvidenceCounts& evidenceCounts(_getLocusSet().getSampleEvidenceCounts(defaultReadGroupIndex));
-  _readScanner.getSVLoci(bamRead, defaultReadGroupIndex, _bamHeader(), _refSeq(), loci, evidenceCounts);
+void SVLocusSetFinder::update(
+    const stream_state_reporter& streamErrorReporter,
+    const bam_record&            bamRead,
+    const unsigned               defaultReadGroupIndex)
+{
+  if (!isAnalysisCandidate(streamErrorReporter, bamRead, defaultReadGroupIndex)) return;
 
-  // merge each non-empty SV locus into this genome segment graph:
-  for (const SVLocus& locus : loci) {
-    if (locus.empty()) continue;
-    _getLocusSet().merge(locus);
-  }
+  // inputCounts and evidenceCounts are part of the statistics tracking framework used for
+  // methods diagnostics. They do not impact the graph build.
+  SampleReadInputCounts& inputCounts(_getLocusSet().getSampleReadInputCounts(defaultReadGroupIndex));
+  SampleEvidenceCounts&  evidenceCounts(_getLocusSet().getSampleEvidenceCounts(defaultReadGroupIndex));
+
+  if (!analyzeRead(
+          streamErrorReporter,
+          bamRead,
+          defaultReadGroupIndex,
+          _readAnalysis,
+          _locusEvidence,
+          inputCounts.evidenceCount,
+          evidenceCounts))
+    return;
+
+  addReadEvidence(bamRead, _locusEvidence);
 }
@@ -76,6 +76,8 @@ struct SVLocusSetFinder : private boost::noncopyable {
 
   /// \brief Push a new read alignment into the SV graph building process
   ///
+  /// This applies isAnalysisCandidate(), analyzeRead() and addReadEvidence() to \p bamRead in turn.
+  ///
   /// \param[in] streamErrorReporter Reference to the error reporter from the stream which produced
   /// \p bamRead. This is only used to improve the detail of exception messages.
   /// \param[in] bamRead The BAM/CRAM record being pushed into the estimation process.
@@ -87,6 +89,54 @@ struct SVLocusSetFinder : private boost::noncopyable {
       const bam_record&            bamRead,
       const unsigned               defaultReadGroupIndex);
 
+  /// \brief Apply the read filters of update() which depend on the order of input reads
+  ///
+  /// This is the first of the three steps which update() applies to each read. The steps are exposed so that
+  /// the analyzeRead() step can be run for many reads concurrently. This step and addReadEvidence() must
+  /// still be called in input read order.
+  ///
+  /// \param[in] streamErrorReporter Reference to the error reporter from the stream which produced
+  /// \p bamRead. This is only used to improve the detail of exception messages.
+  /// \param[in] bamRead The BAM/CRAM record being pushed into the estimation process.
+  /// \param[in] defaultReadGroupIndex The read group index to use in the absence of a BAM read group (RG)
+  /// tag. This should effectively be the same as the sample index.
+  ///
+  /// \return True if \p bamRead passes these filters and should be passed to analyzeRead()
+  bool isAnalysisCandidate(
+      const stream_state_reporter& streamErrorReporter,
+      const bam_record&            bamRead,
+      const unsigned               defaultReadGroupIndex);
+
+  /// \brief Test a read for SV evidence and convert it into SV locus evidence records
+  ///
+  /// This step does not modify this object, so it can be called concurrently for different reads as long
+  /// as each thread supplies its own \p readAnalysis and count objects.
+  ///
+  /// \param[in] streamErrorReporter Error reporter describing \p bamRead for exception messages
+  /// \param[in] bamRead A read which has passed isAnalysisCandidate()
+  /// \param[in] defaultReadGroupIndex The read group index to use in the absence of a BAM read group (RG)
+  /// tag. This should effectively be the same as the sample index.
+  /// \param[in,out] readAnalysis Scan intermediates buffer for \p bamRead
+  /// \param[out] locusEvidence SV locus evidence records from \p bamRead
+  /// \param[in,out] inputEvidenceCount Diagnostic counts of the SV evidence test
+  /// \param[in,out] evidenceCounts Diagnostic counts of the SV locus evidence generated
+  ///
+  /// \return True if \p locusEvidence should be passed to addReadEvidence()
+  bool analyzeRead(
+      const stream_state_reporter&  streamErrorReporter,
+      const bam_record&             bamRead,
+      const unsigned                defaultReadGroupIndex,
+      SVLocusScannerReadAnalysis&   readAnalysis,
+      std::vector<SVLocusEvidence>& locusEvidence,
+      SVLocusEvidenceCount&         inputEvidenceCount,
+      SampleEvidenceCounts&         evidenceCounts) const;
+
+  /// \brief Merge the SV locus evidence records of a read into the SV locus graph
+  ///
+  /// \param[in] bamRead A read for which analyzeRead() returned true
+  /// \param[in] locusEvidence The SV locus evidence records produced from \p bamRead by analyzeRead()
+  void addReadEvidence(const bam_record& bamRead, const std::vector<SVLocusEvidence>& locusEvidence);
+
   /// \brief Provide const access to the SV locus graph that this object is building.
   const SVLocusSet& getLocusSet() const { return *_svLociPtr; }
 
@@ -134,6 +184,13 @@ private:
 
   SVLocusScanner _readScanner;
 
+  /// Scan intermediates from the current read, shared between the SV evidence test and locus evidence
+  /// generation
+  SVLocusScannerReadAnalysis _readAnalysis;
+
+  /// SV locus evidence records from the current read, retained between reads to avoid reallocation
+  std::vector<SVLocusEvidence> _locusEvidence;
+
   /// If true, then track estimated depth/pos and filter out input from very high depth regions
   /// This would typically be true for WGS and false for targeted sequencing.
   bool _isMaxDepthFilter;
@@ -29,8 +29,14 @@
 #include "test/testFileMakers.hpp"
 #include "test/testUtil.hpp"
 
+#include "boost/filesystem.hpp"
 #include "boost/make_unique.hpp"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
 /// \brief Construct an EstimateSVLociRunner with dummy options and small dummy data files
 struct ConstructTestEstimateSVLociRunner {
   ConstructTestEstimateSVLociRunner()
@@ -68,6 +74,61 @@ private:
   std::unique_ptr<EstimateSVLociRunner> _eslRunnPtr;
 };
 
+/// \brief Write a reference fasta file and its index for the chromosomes in \p bamHeader
+///
+/// Chromosome sequences are generated from a fixed pseudo-random sequence. The fasta and index files are
+/// deleted when this object goes out of scope.
+struct TestReferenceFileMaker {
+  explicit TestReferenceFileMaker(const bam_header_info& bamHeader)
+  {
+    static const unsigned lineSize(60);
+    static const char     bases[] = "ACGT";
+
+    std::ofstream fastaStream(getFilename());
+    std::ofstream indexStream(getIndexFilename());
+    uint32_t      randomState(1);
+    for (const auto& chromData : bamHeader.chrom_data) {
+      fastaStream << '>' << chromData.label << '\n';
+      indexStream << chromData.label << '\t' << chromData.length << '\t' << fastaStream.tellp() << '\t'
+                  << lineSize << '\t' << (lineSize + 1) << '\n';
+      for (unsigned pos(0); pos < chromData.length; ++pos) {
+        randomState = randomState * 1103515245u + 12345u;
+        fastaStream << bases[(randomState >> 16) % 4];
+        if (((pos + 1) % lineSize == 0) || ((pos + 1) == chromData.length)) fastaStream << '\n';
+      }
+    }
+  }
+
+  ~TestReferenceFileMaker()
+  {
+    using namespace boost::filesystem;
+    if (exists(getIndexFilename())) remove(getIndexFilename());
+  }
+
+  const std::string& getFilename() const { return _fastaFilename.getFilename(); }
+
+private:
+  std::string getIndexFilename() const { return getFilename() + ".fai"; }
+
+  TestFilenameMaker _fastaFilename;
+};
+
+static std::string getLocusSetDump(const SVLocusSet& set)
+{
+  std::ostringstream oss;
+  set.dump(oss);
+  return oss.str();
+}
+
+static std::string getSampleReadCountsDump(const SVLocusSet& set)
+{
+  std::ostringstream oss;
+  const auto&        sampleCounts(set.getAllSampleReadCounts().getSampleCounts(0));
+  sampleCounts.input.write(oss);
+  sampleCounts.evidence.write(oss);
+  return oss.str();
+}
+
 BOOST_AUTO_TEST_SUITE(EstimateSVLociRunner_test_suite)
 
 // Test EstimateSVLociRunner's construction of the full SVLocusSet object in its constructor.
@@ -103,4 +164,88 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSampleCounts)
   BOOST_REQUIRE_EQUAL(getValueFromTSVKeyValFile(graphStats.getFilename(), "NotFiltered"), "1");
 }
 
+// Test that the SV locus graph built with multiple threads is identical to the single-threaded graph
+//
+// The chromosomes are long enough for graph denoising to run, and the input is large enough to be analyzed
+// in several read batches when multiple threads are used.
+BOOST_AUTO_TEST_CASE(test_MultithreadedGraphMatchesSingleThreaded)
+{
+  static const int chromSize(40000);
+
+  bam_header_info bamHeader;
+  bamHeader.chrom_data.emplace_back("chrFoo", chromSize);
+  bamHeader.chrom_data.emplace_back("chrBar", chromSize);
+  bamHeader.chrom_to_index.insert(std::make_pair("chrFoo", 0));
+  bamHeader.chrom_to_index.insert(std::make_pair("chrBar", 1));
+
+  const TestReferenceFileMaker referenceFile(bamHeader);
+  BamFilenameMaker             bamFilename;
+  TestStatsFileMaker           statsFileMaker;
+  {
+    // Each read is described by (tid, pos, mateTid, matePos, mapQ):
+    std::vector<std::tuple<int, int, int, int, int>> reads;
+    for (int tid(0); tid < 2; ++tid) {
+      for (int pos(100); pos < (chromSize - 200); pos += 3) {
+        // Non-SV read pairs, with some reads filtered for low mapq:
+        reads.emplace_back(tid, pos, tid, pos + 50, ((pos % 101) == 0) ? 5 : 30);
+      }
+      for (int pos(50); pos < (chromSize - 200); pos += 997) {
+        // Isolated chimeric read pairs, which should be removed by denoising:
+        reads.emplace_back(tid, pos, (1 - tid), pos, 30);
+      }
+      for (int pos(2000); pos < (chromSize - 200); pos += 4000) {
+        // Clusters of chimeric read pairs, which should be retained:
+        for (int clusterIndex(0); clusterIndex < 6; ++clusterIndex) {
+          reads.emplace_back(tid, pos + (clusterIndex * 10), (1 - tid), pos + 100 + (clusterIndex * 10), 30);
+        }
+      }
+    }
+    std::sort(reads.begin(), reads.end());
+
+    std::vector<bam_record> readsToAdd(reads.size());
+    for (unsigned readIndex(0); readIndex < reads.size(); ++readIndex) {
+      const auto& read(reads[readIndex]);
+      buildTestBamRecord(
+          readsToAdd[readIndex],
+          std::get<0>(read),
+          std::get<1>(read),
+          std::get<2>(read),
+          std::get<3>(read),
+          50,
+          std::get<4>(read),
+          "",
+          "",
+          100);
+    }
+    buildTestBamFile(bamHeader, readsToAdd, bamFilename.getFilename());
+  }
+
+  ESLOptions eslOpt;
+  eslOpt.referenceFilename               = referenceFile.getFilename();
+  eslOpt.statsFilename                   = statsFileMaker.getFilename();
+  eslOpt.alignFileOpt.alignmentFilenames = {bamFilename.getFilename()};
+  eslOpt.alignFileOpt.isAlignmentTumor   = {false};
+
+  const std::vector<std::string> regions = {"chrFoo", "chrBar"};
+
+  EstimateSVLociRunner serialRunner(eslOpt);
+  for (const auto& region : regions) {
+    serialRunner.estimateSVLociForSingleRegion(region);
+  }
+  const SVLocusSet& serialSet(serialRunner.getLocusSet());
+  BOOST_REQUIRE_GT(serialSet.nonEmptySize(), 0u);
+
+  for (const unsigned threadCount : {2u, 3u, 4u}) {
+    eslOpt.workerThreadCount = threadCount;
+    EstimateSVLociRunner threadedRunner(eslOpt);
+    for (const auto& region : regions) {
+      threadedRunner.estimateSVLociForSingleRegion(region);
+    }
+    const SVLocusSet& threadedSet(threadedRunner.getLocusSet());
+    threadedSet.checkState(true, true);
+    BOOST_REQUIRE_EQUAL(getLocusSetDump(threadedSet), getLocusSetDump(serialSet));
+    BOOST_REQUIRE_EQUAL(getSampleReadCountsDump(threadedSet), getSampleReadCountsDump(serialSet));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <string>
+
 /// options for SVLocusGraph edge iteration and noise edge filtration
 struct LocusEdgeOptions {
   /// If isLocusIndex, report this locus only
@@ -51,4 +53,11 @@ struct EdgeOptions {
   /// If both nodes of an edge have an edge count higher than this, then skip evaluation of this edge, set to
   /// 0 to turn this filtration off
   unsigned graphNodeMaxEdgeCount = 10;
+
+  /// Maximum number of graph edges held for cost-ordered scheduling, set to 0 to order all edges at once
+  unsigned edgeWindowSize = 1000000;
+
+  /// If non-empty, claim edges dynamically through a counter in this file, which is shared with all other
+  /// processes given the same file and edge selection options. A new file is required for each run.
+  std::string edgeClaimFilename;
 };
@@ -48,6 +48,12 @@ boost::program_options::options_description getOptionsDescription(EdgeOptions& o
    " If this argument is specified then bin-index is ignored."
    " Argument can be one of { locusIndex , locusIndex:nodeIndex , locusIndex:nodeIndex:nodeIndex },"
    " which will run an entire locus, all edges connected to one node in a locus or a single edge, respectively.")
+  ("edge-window-size", po::value(&opt.edgeWindowSize)->default_value(opt.edgeWindowSize),
+   "Maximum number of edges held in memory to be scheduled in order of estimated cost. Set to 0 to order all edges at once.")
+  ("edge-claim-file", po::value(&opt.edgeClaimFilename),
+   "Dynamically claim edges through a counter in this file, shared by all processes given the same file."
+   " Edges are partitioned over these processes, so each should be run with the same graph and edge-selection options."
+   " A new claim file must be used for each run.")
   ;
   // clang-format on
 
@@ -32,7 +32,9 @@ EdgeRuntimeTracker::EdgeRuntimeTracker(std::shared_ptr<SynchronizedOutputStream>
     _candidateCount(0),
     _complexCandidateCount(0),
     _assembledCandidateCount(0),
-    _assembledComplexCandidateCount(0)
+    _assembledComplexCandidateCount(0),
+    _readCacheHitCount(0),
+    _readCacheMissCount(0)
 {
 }
 
@@ -59,6 +61,8 @@ void EdgeRuntimeTracker::stop(const EdgeInfo& edge)
     oss << '\t' << assemblyTime.getWallSeconds();
     oss << '\t' << remoteReadRetrievalTime.getWallSeconds();
     oss << '\t' << scoreTime.getWallSeconds();
+    oss << '\t' << _readCacheHitCount;
+    oss << '\t' << _readCacheMissCount;
     oss << '\n';
     _streamPtr->write(oss.str());
   }
@@ -59,6 +59,8 @@ struct EdgeRuntimeTracker : private boost::noncopyable {
     _complexCandidateCount          = 0;
     _assembledCandidateCount        = 0;
     _assembledComplexCandidateCount = 0;
+    _readCacheHitCount              = 0;
+    _readCacheMissCount             = 0;
   }
 
   void stop(const EdgeInfo& edge);
@@ -81,6 +83,16 @@ struct EdgeRuntimeTracker : private boost::noncopyable {
       _assembledCandidateCount++;
   }
 
+  /// Add region query counts from the decoded alignment record cache
+  ///
+  /// \param hitCount Number of region queries served from cached records
+  /// \param missCount Number of region queries which required decoding records from the alignment file
+  void addReadCacheCounts(const unsigned hitCount, const unsigned missCount)
+  {
+    _readCacheHitCount += hitCount;
+    _readCacheMissCount += missCount;
+  }
+
   TimeTracker candidacyTime;
   TimeTracker assemblyTime;
   TimeTracker scoreTime;
@@ -101,4 +113,6 @@ private:
   unsigned _complexCandidateCount;
   unsigned _assembledCandidateCount;
   unsigned _assembledComplexCandidateCount;
+  unsigned _readCacheHitCount;
+  unsigned _readCacheMissCount;
 };
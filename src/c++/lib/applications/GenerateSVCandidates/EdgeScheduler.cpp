@@ -0,0 +1,139 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "EdgeScheduler.hpp"
+
+#include "common/Exceptions.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+/// Relative cost of a single unit of node evidence, compared to one base of node interval size
+static const uint64_t nodeEvidenceCostWeight(100);
+
+static uint64_t getNodeCostEstimate(const SVLocusNode& node)
+{
+  return (
+      static_cast<uint64_t>(node.getInterval().range.size()) + (nodeEvidenceCostWeight * node.outCount()));
+}
+
+uint64_t getEdgeCostEstimate(const SVLocusSet& set, const EdgeInfo& edge)
+{
+  const SVLocus& locus(set.getLocus(edge.locusIndex));
+  uint64_t       cost(getNodeCostEstimate(locus.getNode(edge.nodeIndex1)));
+  if (!edge.isSelfEdge()) {
+    cost += getNodeCostEstimate(locus.getNode(edge.nodeIndex2));
+  }
+  return cost;
+}
+
+/// Get a key identifying the edge issue order, so that a claim file can only be shared by processes which
+/// compute the same order
+static uint64_t getClaimKey(const SVLocusSet& set, const unsigned windowSize)
+{
+  const uint64_t keyValues[] = {
+      set.size(), set.totalNodeCount(), set.totalEdgeCount(), set.totalObservationCount(), windowSize};
+
+  // 64-bit FNV-1a over the key values:
+  uint64_t key(14695981039346656037ull);
+  for (const uint64_t keyValue : keyValues) {
+    for (unsigned byteIndex(0); byteIndex < 8; ++byteIndex) {
+      key ^= ((keyValue >> (byteIndex * 8)) & 0xff);
+      key *= 1099511628211ull;
+    }
+  }
+  return key;
+}
+
+EdgeScheduler::EdgeScheduler(
+    const SVLocusSet& set, EdgeRetriever& edger, const unsigned windowSize, const std::string& claimFilename)
+  : _set(set), _edger(edger), _windowSize(windowSize)
+{
+  if (claimFilename.empty()) {
+    _blockEndIndex = std::numeric_limits<uint64_t>::max();
+  } else {
+    _claimCounterPtr.reset(new SharedFileCounter(claimFilename, getClaimKey(set, windowSize)));
+
+    // A claim file which has already issued every block is left over from a completed run. Using it would
+    // silently skip all edges:
+    const uint64_t claimBlockLimit(_claimCounterPtr->getLimit());
+    if ((claimBlockLimit > 0) && (_claimCounterPtr->getValue() >= claimBlockLimit)) {
+      std::ostringstream oss;
+      oss << "Edge claim file '" << claimFilename << "' has already claimed all edges of this graph. "
+          << "A new claim file is required for each run.";
+      BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+    }
+  }
+}
+
+bool EdgeScheduler::popWindowEdge(EdgeInfo& edge)
+{
+  while (((_windowSize == 0) || (_window.size() < _windowSize)) && _edger.next()) {
+    const EdgeInfo& retrievedEdge(_edger.getEdge());
+    _window.push_back({getEdgeCostEstimate(_set, retrievedEdge), _retrievedCount++, retrievedEdge});
+    std::push_heap(_window.begin(), _window.end());
+  }
+
+  if (_window.empty()) return false;
+
+  std::pop_heap(_window.begin(), _window.end());
+  edge = _window.back().edge;
+  _window.pop_back();
+  _issuedCount++;
+  return true;
+}
+
+void EdgeScheduler::claimNextBlock()
+{
+  const uint64_t blockIndex(_claimCounterPtr->fetchAndIncrement());
+  _blockBeginIndex = (blockIndex * claimBlockSize);
+  _blockEndIndex   = (_blockBeginIndex + claimBlockSize);
+}
+
+void EdgeScheduler::recordClaimBlockLimit()
+{
+  const uint64_t claimBlockLimit((_issuedCount + claimBlockSize - 1) / claimBlockSize);
+  if (_claimCounterPtr->recordLimit(claimBlockLimit) != claimBlockLimit) {
+    std::ostringstream oss;
+    oss << "Processes sharing an edge claim file found different numbers of edges to process. "
+        << "All processes sharing a claim file must use the same graph and edge selection options.";
+    BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+  }
+}
+
+bool EdgeScheduler::next(EdgeInfo& edge)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  while (!_isComplete) {
+    if (_issuedCount >= _blockEndIndex) claimNextBlock();
+
+    // Edges claimed by other processes are still drawn from the window, so that the issue order is the same
+    // in every process:
+    if (!popWindowEdge(edge)) {
+      _isComplete = true;
+      if (_claimCounterPtr) recordClaimBlockLimit();
+    } else if (_issuedCount > _blockBeginIndex) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,127 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Cost-ordered, thread-safe edge queue shared by all GenerateSVCandidates worker threads
+///
+
+#pragma once
+
+#include "EdgeRetriever.hpp"
+#include "blt_util/SharedFileCounter.hpp"
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// \brief Estimate the relative cost of generating SV candidates for one graph edge
+///
+/// Edge runtime is dominated by the number of reads which must be retrieved and analyzed for the edge's
+/// nodes, so this is approximated from the size of each node's interval and the evidence count on all of its
+/// outgoing edges. Only the relative order of these values is meaningful.
+///
+uint64_t getEdgeCostEstimate(const SVLocusSet& set, const EdgeInfo& edge);
+
+/// \brief Issue graph edges to worker threads in order of decreasing estimated cost
+///
+/// Edges are read lazily from the retriever into a fixed-size window, and the most expensive edge in the
+/// window is issued next. This starts expensive edges early, which prevents a small number of them from
+/// leaving a long tail of single-threaded work, while keeping memory independent of the total edge count.
+/// Worker threads pull the next edge whenever they become idle, so the retriever is only advanced as fast as
+/// edges are consumed.
+///
+/// If a claim file is provided, edges are additionally claimed in small blocks through a counter shared with
+/// all other processes using the same claim file. Each such process must use the same graph, edge selection
+/// and window options, so that they compute an identical edge issue order, in which case every edge is
+/// processed by exactly one process. The claim file is tied to the graph and window size when it is first
+/// used, and the number of claim blocks in the issue order is recorded by the first process to finish. An
+/// exception is thrown if a process is started with a claim file used for a different graph, if processes
+/// find different numbers of edges, or if the claim file has already claimed all edges.
+///
+struct EdgeScheduler : private boost::noncopyable {
+  /// \param windowSize Maximum number of edges held for cost ordering, or 0 to order all edges at once
+  /// \param claimFilename If non-empty, claim edges through a counter shared by all processes using this file
+  EdgeScheduler(
+      const SVLocusSet&  set,
+      EdgeRetriever&     edger,
+      const unsigned     windowSize,
+      const std::string& claimFilename = "");
+
+  /// \brief Get the next edge to process
+  ///
+  /// This method is thread-safe.
+  ///
+  /// \return False when no edges remain for this process
+  bool next(EdgeInfo& edge);
+
+private:
+  /// An edge held in the window, with its estimated cost and its index in the retriever sequence
+  struct CostEdge {
+    /// Order by cost, and then by reverse sequence index so that ties are issued in retriever order
+    bool operator<(const CostEdge& rhs) const
+    {
+      if (cost != rhs.cost) return (cost < rhs.cost);
+      return (sequenceIndex > rhs.sequenceIndex);
+    }
+
+    uint64_t cost;
+    uint64_t sequenceIndex;
+    EdgeInfo edge;
+  };
+
+  /// Issue the most expensive edge in the window, after topping up the window from the retriever
+  ///
+  /// \return False if the retriever and window are both empty
+  bool popWindowEdge(EdgeInfo& edge);
+
+  /// Claim the next block of the edge issue order from the shared counter
+  void claimNextBlock();
+
+  /// Record the number of claim blocks in the complete edge issue order in the claim file, and check that it
+  /// matches the number found by other processes
+  void recordClaimBlockLimit();
+
+  /// Number of consecutive edges claimed by one process in each shared counter update
+  static const unsigned claimBlockSize = 8;
+
+  const SVLocusSet& _set;
+  EdgeRetriever&    _edger;
+  const unsigned    _windowSize;
+
+  std::mutex _mutex;
+
+  /// Max-heap of edges read from the retriever but not yet issued
+  std::vector<CostEdge> _window;
+  uint64_t              _retrievedCount = 0;
+
+  /// Total edges issued from the window so far
+  uint64_t _issuedCount = 0;
+
+  /// Range of the edge issue order which this process may process
+  uint64_t _blockBeginIndex = 0;
+  uint64_t _blockEndIndex   = 0;
+
+  /// True once all edges have been issued
+  bool _isComplete = false;
+
+  std::unique_ptr<SharedFileCounter> _claimCounterPtr;
+};
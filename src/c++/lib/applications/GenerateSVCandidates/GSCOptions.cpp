@@ -32,6 +32,9 @@
 
 #include "boost/program_options.hpp"
 
+#include <algorithm>
+#include <thread>
+
 static void usage(
     std::ostream&                                      os,
     const illumina::Program&                           prog,
@@ -62,6 +65,8 @@ void parseGSCOptions(const illumina::Program& prog, int argc, char* argv[], GSCO
   req.add_options()
   ("threads", po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),
    "Number of threads to use for candidate generation")
+  ("edge-read-cache-mb", po::value(&opt.edgeReadCacheMegabytes)->default_value(opt.edgeReadCacheMegabytes),
+   "Memory limit per thread (in megabytes) for caching decoded alignment records so that they can be reused by all analysis stages of the same graph edge. Set to 0 to disable.")
   ("graph-file", po::value(&opt.graphFilename),
    "sv locus graph file (required)")
   ("align-stats", po::value(&opt.statsFilename),
@@ -104,6 +109,8 @@ void parseGSCOptions(const illumina::Program& prog, int argc, char* argv[], GSCO
    "minimum size for variants which are scored and output following initial candidate generation")
   ("evidence-bam-stub", po::value(&opt.evidenceBamStub)->default_value(opt.evidenceBamStub),
    "Directory and prefix of bams storing the supporting reads of SVs")
+  ("evidence-bam-sort-mb", po::value(&opt.evidenceBamSortMegabytes)->default_value(opt.evidenceBamSortMegabytes),
+   "Memory limit per thread (in megabytes) for sorting evidence bam records before they are spilled to temporary files.")
   ("output-contigs", po::value(&opt.isOutputContig)->zero_tokens(),
    "Output assembled contig sequences in VCF files.")
   ("skip-evidence-signal-filter", po::value(&opt.skipEvidenceSignalFilter)->zero_tokens(),
@@ -214,4 +221,22 @@ void parseGSCOptions(const illumina::Program& prog, int argc, char* argv[], GSCO
       usage(log_os, prog, visible, "For RNA, specify RNA output file and --rna");
     }
   }
+
+  // Alignment decompression threads are limited to the cores left over by the candidate generation workers,
+  // so that the two thread sets never oversubscribe the host:
+  {
+    const unsigned coreCount(std::thread::hardware_concurrency());
+    const unsigned workerCount(std::max(opt.workerThreadCount, 1));
+    if ((coreCount > 0) && (opt.alignFileOpt.decompressThreadCount > 0)) {
+      const unsigned spareCoreCount((coreCount > workerCount) ? (coreCount - workerCount) : 0);
+      if (opt.alignFileOpt.decompressThreadCount > spareCoreCount) {
+        if (opt.isVerbose) {
+          log_os << "INFO: Reducing alignment decompression threads from "
+                 << opt.alignFileOpt.decompressThreadCount << " to " << spareCoreCount << " for "
+                 << workerCount << " worker threads on " << coreCount << " cores\n";
+        }
+        opt.alignFileOpt.decompressThreadCount = spareCoreCount;
+      }
+    }
+  }
 }
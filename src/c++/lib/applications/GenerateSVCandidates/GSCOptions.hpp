@@ -54,6 +54,14 @@ struct GSCOptions {
 
   int workerThreadCount = 1;
 
+  /// Memory limit for the decoded alignment record cache shared by all stages of edge processing on each
+  /// thread, 0 disables the cache
+  unsigned edgeReadCacheMegabytes = 128;
+
+  /// Memory limit for sorting evidence bam records on each thread before they are spilled to a temporary
+  /// file
+  unsigned evidenceBamSortMegabytes = 128;
+
   std::string graphFilename;
   std::string referenceFilename;
   std::string statsFilename;
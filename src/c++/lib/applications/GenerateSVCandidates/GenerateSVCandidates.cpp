@@ -23,11 +23,13 @@
 
 #include "GenerateSVCandidates.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
 #include "EdgeRetrieverBin.hpp"
 #include "EdgeRetrieverLocus.hpp"
+#include "EdgeScheduler.hpp"
 #include "GSCOptions.hpp"
 #include "SVCandidateProcessor.hpp"
 #include "SVEvidenceWriter.hpp"
@@ -142,6 +144,9 @@ struct EdgeThreadLocalData {
   SVCandidateSetData                    svData;
   std::vector<SVCandidate>              svs;
   std::vector<SVMultiJunctionCandidate> mjSVs;
+
+  /// Decoded alignment records shared by all stages of edge processing on this thread
+  BamRegionCacheSet readCaches;
 };
 
 /// Process a single edge on one thread:
@@ -159,6 +164,12 @@ static void processEdge(
   try {
     edgeData.edgeTrackerPtr->start();
 
+    // Reads are only shared within an edge, so the cache is reset here to bound memory for the remaining
+    // edges on this thread:
+    for (auto& readCachePtr : edgeData.readCaches) {
+      readCachePtr->clear();
+    }
+
     if (opt.isVerbose) {
       log_os << __FUNCTION__ << ": starting analysis of edge: ";
       dumpEdgeInfo(edge, cset, log_os);
@@ -197,6 +208,9 @@ static void processEdge(
     throw;
   }
 
+  for (const auto& readCachePtr : edgeData.readCaches) {
+    edgeData.edgeTrackerPtr->addReadCacheCounts(readCachePtr->hitCount(), readCachePtr->missCount());
+  }
   edgeData.edgeTrackerPtr->stop(edge);
   if (opt.isVerbose) {
     log_os << __FUNCTION__ << ": Time to process last edge: ";
@@ -207,6 +221,20 @@ static void processEdge(
   edgeData.edgeStatMan.updateScoredEdgeTime(edge, *(edgeData.edgeTrackerPtr));
 }
 
+/// Process edges from the shared scheduler on one thread until no edges remain or any thread has failed:
+static void processEdges(
+    int                               threadId,
+    const GSCOptions&                 opt,
+    const SVLocusSet&                 cset,
+    std::vector<EdgeThreadLocalData>& edgeDataPool,
+    EdgeScheduler&                    edgeScheduler)
+{
+  EdgeInfo edge;
+  while ((!isWorkerThreadException.load()) && edgeScheduler.next(edge)) {
+    processEdge(threadId, opt, cset, edgeDataPool, edge);
+  }
+}
+
 static void runGSC(const GSCOptions& opt, const char* progName, const char* progVersion)
 {
   const SVLocusScanner readScanner(
@@ -229,16 +257,27 @@ static void runGSC(const GSCOptions& opt, const char* progName, const char* prog
     edgeTrackerStreamPtr.reset(new SynchronizedOutputStream(opt.edgeRuntimeFilename));
   }
 
+  // The read cache memory limit applies per thread, so it is split evenly over all alignment files:
+  const unsigned    alignmentFileCount(opt.alignFileOpt.alignmentFilenames.size());
+  const std::size_t readCacheBytesPerFile(
+      (static_cast<std::size_t>(opt.edgeReadCacheMegabytes) << 20) / std::max(1u, alignmentFileCount));
+
   std::vector<EdgeThreadLocalData> edgeDataPool(opt.workerThreadCount);
   for (auto& edgeData : edgeDataPool) {
     edgeData.edgeTrackerPtr.reset(new EdgeRuntimeTracker(edgeTrackerStreamPtr));
+    if (readCacheBytesPerFile > 0) {
+      for (unsigned fileIndex(0); fileIndex < alignmentFileCount; ++fileIndex) {
+        edgeData.readCaches.push_back(std::make_shared<bam_region_cache>(readCacheBytesPerFile));
+      }
+    }
     edgeData.svFindPtr.reset(new SVFinder(
         opt,
         readScanner,
         bamHeader,
         cset.getAllSampleReadCounts(),
         edgeData.edgeTrackerPtr,
-        edgeData.edgeStatMan));
+        edgeData.edgeStatMan,
+        edgeData.readCaches));
     edgeData.svProcessorPtr.reset(new SVCandidateProcessor(
         opt,
         readScanner,
@@ -246,23 +285,27 @@ static void runGSC(const GSCOptions& opt, const char* progName, const char* prog
         svWriter,
         svEvidenceWriterSharedData,
         edgeData.edgeTrackerPtr,
-        edgeData.edgeStatMan));
+        edgeData.edgeStatMan,
+        edgeData.readCaches));
   }
 
   ctpl::thread_pool pool(opt.workerThreadCount);
 
   // Iterate through graph edges:
   std::unique_ptr<EdgeRetriever> edgerPtr(edgeRFactory(cset, opt.edgeOpt));
-  EdgeRetriever&                 edger(*edgerPtr);
-
-  // Although processEdge doesn't return anything now, the future<void> provides a simple way for worker
-  // thread
-  // exceptions to propogate down to this thread:
-  std::vector<std::future<void>> edgeReturnValues;
+  EdgeScheduler edgeScheduler(cset, *edgerPtr, opt.edgeOpt.edgeWindowSize, opt.edgeOpt.edgeClaimFilename);
 
-  while (edger.next()) {
-    edgeReturnValues.push_back(
-        pool.push(processEdge, std::cref(opt), std::cref(cset), std::ref(edgeDataPool), edger.getEdge()));
+  // Each worker pulls the most expensive edge in the scheduler window whenever it becomes idle, so that
+  // long-running edges start early and no thread is left waiting on a statically assigned backlog. Edges are
+  // only read from the graph as they are consumed, and each worker stops pulling edges as soon as any worker
+  // fails, so memory use is independent of the total edge count.
+  //
+  // Although processEdges doesn't return anything now, the future<void> provides a simple way for worker
+  // thread exceptions to propogate down to this thread:
+  std::vector<std::future<void>> workerReturnValues;
+  for (int threadIndex(0); threadIndex < opt.workerThreadCount; ++threadIndex) {
+    workerReturnValues.push_back(pool.push(
+        processEdges, std::cref(opt), std::cref(cset), std::ref(edgeDataPool), std::ref(edgeScheduler)));
   }
 
   pool.stop(true);
@@ -271,14 +314,15 @@ static void runGSC(const GSCOptions& opt, const char* progName, const char* prog
   //
   // Note that we don't catch them here, just throw down to the bottom- level handler for
   // GenerateSVCandidates:
-  for (auto& edgeReturnValue : edgeReturnValues) {
-    edgeReturnValue.get();
+  for (auto& workerReturnValue : workerReturnValues) {
+    workerReturnValue.get();
   }
 
   GSCEdgeStats mergedStats;
   for (auto& edgeData : edgeDataPool) {
     mergedStats.merge(edgeData.edgeStatMan.returnStats());
   }
+  mergedStats.edgeData.decodedAlignmentRecordCount = bam_streamer::getTotalDecodedRecordCount();
 
   if (!opt.edgeStatsFilename.empty()) {
     mergedStats.save(opt.edgeStatsFilename.c_str());
@@ -286,6 +330,10 @@ static void runGSC(const GSCOptions& opt, const char* progName, const char* prog
   if (!opt.edgeStatsReportFilename.empty()) {
     mergedStats.report(opt.edgeStatsReportFilename.c_str());
   }
+
+  // Release all thread-local evidence record buffers before the sorted evidence bam files are written:
+  edgeDataPool.clear();
+  svEvidenceWriterSharedData->close();
 }
 
 void GenerateSVCandidates::runInternal(int argc, char* argv[]) const
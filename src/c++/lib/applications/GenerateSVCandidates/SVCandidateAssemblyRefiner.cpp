@@ -27,7 +27,7 @@
 #include "SVCandidateAssemblyRefiner.hpp"
 
 #include <iostream>
-#include <unordered_set>
+#include <unordered_map>
 
 #include "alignment/AlignmentScoringUtil.hpp"
 #include "alignment/AlignmentUtil.hpp"
@@ -1010,7 +1010,8 @@ SVCandidateAssemblyRefiner::SVCandidateAssemblyRefiner(
     const GSCOptions&                   opt,
     const bam_header_info&              header,
     const AllSampleReadCounts&          counts,
-    std::shared_ptr<EdgeRuntimeTracker> edgeTrackerPtr)
+    std::shared_ptr<EdgeRuntimeTracker> edgeTrackerPtr,
+    const BamRegionCacheSet&            regionCaches)
   : _opt(opt),
     _header(header),
     _smallSVAssembler(
@@ -1023,7 +1024,8 @@ SVCandidateAssemblyRefiner::SVCandidateAssemblyRefiner(
         header,
         counts,
         opt.isRNA,
-        edgeTrackerPtr->remoteReadRetrievalTime),
+        edgeTrackerPtr->remoteReadRetrievalTime,
+        regionCaches),
     _spanningAssembler(
         opt.scanOpt,
         (opt.isRNA ? opt.refineOpt.RNAspanningAssembleOpt : opt.refineOpt.spanningAssembleOpt),
@@ -1034,7 +1036,8 @@ SVCandidateAssemblyRefiner::SVCandidateAssemblyRefiner(
         header,
         counts,
         opt.isRNA,
-        edgeTrackerPtr->remoteReadRetrievalTime),
+        edgeTrackerPtr->remoteReadRetrievalTime,
+        regionCaches),
     _largeSVAligner(opt.refineOpt.largeSVAlignScores, opt.refineOpt.largeGapOpenScore),
     _largeInsertEdgeAligner(opt.refineOpt.largeInsertEdgeAlignScores),
     _largeInsertCompleteAligner(opt.refineOpt.largeInsertCompleteAlignScores),
@@ -1078,14 +1081,6 @@ void SVCandidateAssemblyRefiner::getCandidateAssemblyData(
   }
 }
 
-/// Represents a stretch of reference sequence excluded from alignment by the kmer matcher.
-struct exclusion_block {
-  exclusion_block(const unsigned s, const unsigned l, const unsigned sp) : start(s), length(l), nSpacer(sp) {}
-  unsigned start;    // Start of excluded region
-  unsigned length;   // Nunmber of bp excluded
-  unsigned nSpacer;  // Number of 'N' added in place of excluded sequence
-};
-
 /// Translate a reduced reference position to the original reference coordinates
 static unsigned translateMaskedPos(const std::vector<exclusion_block>& exclBlocks, const unsigned maskedPos)
 {
@@ -1132,59 +1127,6 @@ static bool translateMaskedAlignment(Alignment& align, const std::vector<exclusi
   return true;
 }
 
-namespace {
-
-/// Returns a reduced reference sequence where long stretches without kmer matches to the contig are removed
-template <typename SymIter>
-std::string kmerMaskReference(
-    const SymIter                 refSeqStart,
-    const SymIter                 refSeqEnd,
-    const std::string&            contig,
-    const int                     nSpacer,
-    std::vector<exclusion_block>& exclBlocks)
-{
-  // Hash all kmers in the contig
-  static const int                merSize(10);
-  std::unordered_set<std::string> contigHash;
-  for (unsigned contigMerIndex(0); contigMerIndex < (contig.size() - (merSize - 1)); ++contigMerIndex) {
-    contigHash.insert(contig.substr(contigMerIndex, merSize));
-  }
-  // Mask the reference (and keep track of excluded regions for coordinate translation later)
-  static const int minExclusion(1000);
-  static const int padding(50);  // Amount of sequence included around each kmer hit.
-  std::string      maskedRef;
-  const SymIter    maxRef       = refSeqEnd - (merSize - 1);
-  SymIter          potExclStart = refSeqStart;
-  SymIter          inclStart    = refSeqStart;
-  for (SymIter refIt = refSeqStart; refIt != maxRef; refIt++) {
-    if (contigHash.count(std::string(refIt, refIt + merSize)) != 0) {
-      if ((refIt - potExclStart) > (minExclusion + padding)) {
-        unsigned spacer(0);
-        if (potExclStart > refSeqStart) {
-          maskedRef.append(std::string(inclStart, potExclStart));
-          maskedRef.append(nSpacer, 'N');
-          spacer = nSpacer;
-        }
-        inclStart = refIt - padding;
-        exclBlocks.emplace_back(potExclStart - refSeqStart, inclStart - potExclStart, spacer);
-      }
-      potExclStart = refIt + padding;
-    }
-  }
-  maskedRef.append(std::string(inclStart, std::min(maxRef, potExclStart)));
-#ifdef DEBUG_KMER
-  log_os << __FUNCTION__ << "Reduced to " << maskedRef << '\n';
-  log_os << __FUNCTION__ << " exclBlocks\n\t";
-  for (const auto block : exclBlocks)
-    log_os << " " << block.start << ":" << block.length << ":" << block.nSpacer;
-  log_os << "\n";
-#endif
-  if (maskedRef.empty()) maskedRef.append(nSpacer, 'N');
-  return maskedRef;
-}
-
-}  // namespace
-
 /// Convert jump alignment results into an SVCandidate
 ///
 static void generateRefinedSVCandidateFromJumpAlignment(
@@ -1527,6 +1469,7 @@ void static alignJumpContigs(
     const GlobalJumpAligner<int>&       spanningAligner,
     const GlobalJumpIntronAligner<int>& RNASpanningAligner,
     AlignData&                          alignData,
+    KmerMaskReferenceBuffer&            kmerMaskBuffer,
     SVCandidateAssemblyData&            assemblyData)
 {
   BPOrientation& bporient(assemblyData.bporient);
@@ -1591,6 +1534,7 @@ void static alignJumpContigs(
           align1RefStrPtr->end() - alignData.align1TrailingCut,
           contig.seq,
           nSpacer,
+          kmerMaskBuffer,
           exclBlocks1);
       std::vector<exclusion_block> exclBlocks2;
       const std::string            cutRef2 = kmerMaskReference(
@@ -1598,6 +1542,7 @@ void static alignJumpContigs(
           align2RefStrPtr->end() - alignData.align2TrailingCut,
           contig.seq,
           nSpacer,
+          kmerMaskBuffer,
           exclBlocks2);
 #ifdef DEBUG_REFINER
       log_os << __FUNCTION__ << " Kmer-masked references\n";
@@ -1819,7 +1764,7 @@ void SVCandidateAssemblyRefiner::getJumpAssembly(
   if (!isAssemblySuccess) return;
 
   // Align candidate contigs back to reference
-  alignJumpContigs(_opt, sv, _spanningAligner, _RNASpanningAligner, alignData, assemblyData);
+  alignJumpContigs(_opt, sv, _spanningAligner, _RNASpanningAligner, alignData, _kmerMaskBuffer, assemblyData);
 
   // Select the contig with the highest alignment score
   bool isContigSelected(false);
@@ -1981,15 +1926,25 @@ void SVCandidateAssemblyRefiner::getSmallSVAssembly(
     // original breakend region)
     //
     // New reference span reflected in adjusted*Cut values below
+    //
+    // The contig positions of the same two kmer matches are used as anchors to seed a banded alignment
     pos_t adjustedLeadingCut(leadingCut);
     pos_t adjustedTrailingCut(trailingCut);
+    bool  isAnchored(false);
+    int   leadingAnchorContigPos(0);
+    int   trailingAnchorContigPos(0);
+    pos_t trailingAnchorRefPos(0);
     {
       // Pick a relatively low value for k because this is just a simple runtime optimization
-      static const int                merSize(10);
-      std::unordered_set<std::string> contigHash;
-      const unsigned                  contigSize(contig.seq.size());
+      static const int merSize(10);
+
+      // map of contig kmers to their first and last contig positions:
+      std::unordered_map<std::string, std::pair<unsigned, unsigned>> contigHash;
+      const unsigned                                                 contigSize(contig.seq.size());
       for (unsigned contigMerIndex(0); contigMerIndex < (contigSize - (merSize - 1)); ++contigMerIndex) {
-        contigHash.insert(contig.seq.substr(contigMerIndex, merSize));
+        const auto insertVal(contigHash.emplace(
+            contig.seq.substr(contigMerIndex, merSize), std::make_pair(contigMerIndex, contigMerIndex)));
+        insertVal.first->second.second = contigMerIndex;
       }
 
       const pos_t refSize(align1RefStr.size());
@@ -1998,14 +1953,26 @@ void SVCandidateAssemblyRefiner::getSmallSVAssembly(
 
       const pos_t maxFwdRefIndex(std::min(maxLeadingCut, maxRefIndex));
       pos_t       refIndex = minRefIndex;
+      bool        isLeadingAnchor(false);
       for (refIndex = minRefIndex; refIndex <= maxFwdRefIndex; refIndex++) {
-        if (contigHash.count(align1RefStr.substr(refIndex, merSize)) != 0) break;
+        const auto hashIter(contigHash.find(align1RefStr.substr(refIndex, merSize)));
+        if (hashIter != contigHash.end()) {
+          isLeadingAnchor        = true;
+          leadingAnchorContigPos = hashIter->second.first;
+          break;
+        }
       }
       adjustedLeadingCut = refIndex;
 
       const pos_t minRevRefIndex(std::max(minRefIndex, refSize - maxTrailingCut));
       for (refIndex = (maxRefIndex); refIndex >= minRevRefIndex; refIndex--) {
-        if (contigHash.count(align1RefStr.substr(refIndex, merSize)) != 0) break;
+        const auto hashIter(contigHash.find(align1RefStr.substr(refIndex, merSize)));
+        if (hashIter != contigHash.end()) {
+          isAnchored              = isLeadingAnchor;
+          trailingAnchorContigPos = hashIter->second.second;
+          trailingAnchorRefPos    = refIndex;
+          break;
+        }
       }
       adjustedTrailingCut = (refSize - (refIndex + merSize));
     }
@@ -2029,12 +1996,30 @@ void SVCandidateAssemblyRefiner::getSmallSVAssembly(
 
     // Use a universal aligner to discover any small/large indels in the contig/reference alignment.
     {
-      _largeSVAligner.align(
-          contig.seq.begin(),
-          contig.seq.end(),
-          align1RefStr.begin() + adjustedLeadingCut,
-          align1RefStr.end() - adjustedTrailingCut,
-          alignment);
+      if (isAnchored) {
+        // The band only needs to be near the optimal alignment, the aligner widens it as required:
+        static const unsigned bandWidth(16);
+        const AlignerBand     band(AlignerBand::getAnchorBand(
+            leadingAnchorContigPos,
+            0,
+            trailingAnchorContigPos,
+            trailingAnchorRefPos - adjustedLeadingCut,
+            bandWidth));
+        _largeSVAligner.alignBanded(
+            contig.seq.begin(),
+            contig.seq.end(),
+            align1RefStr.begin() + adjustedLeadingCut,
+            align1RefStr.end() - adjustedTrailingCut,
+            band,
+            alignment);
+      } else {
+        _largeSVAligner.align(
+            contig.seq.begin(),
+            contig.seq.end(),
+            align1RefStr.begin() + adjustedLeadingCut,
+            align1RefStr.end() - adjustedTrailingCut,
+            alignment);
+      }
       alignment.align.beginPos += adjustedLeadingCut;
       getExtendedContig(alignment, contig.seq, align1RefStr, extendedContig);
 
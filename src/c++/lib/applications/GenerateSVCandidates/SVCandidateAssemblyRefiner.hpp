@@ -25,6 +25,7 @@
 #include "alignment/GlobalJumpAligner.hpp"
 #include "alignment/GlobalJumpIntronAligner.hpp"
 #include "alignment/GlobalLargeIndelAligner.hpp"
+#include "alignment/KmerMaskReference.hpp"
 #include "htsapi/bam_header_info.hpp"
 #include "manta/SVCandidate.hpp"
 #include "manta/SVCandidateAssembler.hpp"
@@ -43,7 +44,8 @@ struct SVCandidateAssemblyRefiner {
       const GSCOptions&                   opt,
       const bam_header_info&              header,
       const AllSampleReadCounts&          counts,
-      std::shared_ptr<EdgeRuntimeTracker> edgeTrackerPtr);
+      std::shared_ptr<EdgeRuntimeTracker> edgeTrackerPtr,
+      const BamRegionCacheSet&            regionCaches = BamRegionCacheSet());
 
   /// \brief Given a low-resolution SV candidate, compute a possible base-level refinement via assembly
   ///
@@ -96,4 +98,7 @@ private:
 
   /// Keeps track of all regions which have already been assembled while processing spanning SVs
   mutable GenomeIntervalTracker _spanToComplexAssmRegions;
+
+  /// Reusable contig kmer index used to reduce the reference for RNA contig alignment
+  mutable KmerMaskReferenceBuffer _kmerMaskBuffer;
 };
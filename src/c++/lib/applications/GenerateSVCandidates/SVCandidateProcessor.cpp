@@ -38,15 +38,16 @@ SVCandidateProcessor::SVCandidateProcessor(
     const SVWriter&                             svWriter,
     std::shared_ptr<SVEvidenceWriterSharedData> svEvidenceWriterSharedData,
     std::shared_ptr<EdgeRuntimeTracker>         edgeTrackerPtr,
-    GSCEdgeStatsManager&                        edgeStatMan)
+    GSCEdgeStatsManager&                        edgeStatMan,
+    const BamRegionCacheSet&                    regionCaches)
   : _opt(opt),
     _cset(cset),
     _svWriter(svWriter),
     _svEvidenceWriter(opt, svEvidenceWriterSharedData),
     _edgeTrackerPtr(edgeTrackerPtr),
     _edgeStatMan(edgeStatMan),
-    _svRefine(opt, cset.getBamHeader(), cset.getAllSampleReadCounts(), _edgeTrackerPtr),
-    _svScorer(opt, readScanner, cset.getBamHeader()),
+    _svRefine(opt, cset.getBamHeader(), cset.getAllSampleReadCounts(), _edgeTrackerPtr, regionCaches),
+    _svScorer(opt, readScanner, cset.getBamHeader(), regionCaches),
     _svEvidenceWriterData(opt.alignFileOpt.alignmentFilenames.size())
 {
 }
@@ -43,7 +43,8 @@ struct SVCandidateProcessor {
       const SVWriter&                             svWriter,
       std::shared_ptr<SVEvidenceWriterSharedData> svEvidenceWriterSharedData,
       std::shared_ptr<EdgeRuntimeTracker>         edgeTrackerPtr,
-      GSCEdgeStatsManager&                        edgeStatMan);
+      GSCEdgeStatsManager&                        edgeStatMan,
+      const BamRegionCacheSet&                    regionCaches = BamRegionCacheSet());
 
   /// Refine initial low-resolution candidates using an assembly step, then score and output final SVs
   void evaluateCandidates(
@@ -23,6 +23,7 @@
 
 #include "SVEvidenceWriter.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "manta/BamStreamerUtils.hpp"
@@ -72,7 +73,7 @@ void SVEvidenceWriter::processBamRecords(
     bam_streamer&              origBamStream,
     const GenomeInterval&      interval,
     const support_fragments_t& supportFrags,
-    SynchronizedBamWriter&     bamWriter)
+    SortedBamRunBuffer&        bamWriter)
 {
 #ifdef DEBUG_SUPPORT
   log_os << __FUNCTION__ << "  target interval: " << interval << "\n";
@@ -135,7 +136,7 @@ void SVEvidenceWriter::processBamRecords(
 void SVEvidenceWriter::writeSupportBam(
     const bam_streamer_ptr&           origBamStreamPtr,
     const SVEvidenceWriterSampleData& svSupportFrags,
-    SynchronizedBamWriter&            bamWriter)
+    SortedBamRunBuffer&               bamWriter)
 {
   std::vector<SVEvidenceWriterRead> supportReads;
   const support_fragments_t&        supportFrags(svSupportFrags.supportFrags);
@@ -174,14 +175,24 @@ SVEvidenceWriterSharedData::SVEvidenceWriterSharedData(const GSCOptions& opt)
 {
   if (!opt.isGenerateEvidenceBam()) return;
 
-  const unsigned sampleSize(opt.alignFileOpt.alignmentFilenames.size());
+  // The sort memory limit applies per thread, so it is split evenly over all alignment files:
+  const unsigned    sampleSize(opt.alignFileOpt.alignmentFilenames.size());
+  const std::size_t maxRunMemoryBytes(
+      (static_cast<std::size_t>(opt.evidenceBamSortMegabytes) << 20) / std::max(1u, sampleSize));
   for (unsigned sampleIndex(0); sampleIndex < sampleSize; ++sampleIndex) {
     const std::string  evidenceBamName(opt.evidenceBamStub + ".bam_" + std::to_string(sampleIndex) + ".bam");
     const bam_streamer bamStreamer(
         opt.alignFileOpt.alignmentFilenames[sampleIndex].c_str(), opt.referenceFilename.c_str());
 
     m_evidenceBamWriterPtrs.push_back(
-        std::make_shared<SynchronizedBamWriter>(evidenceBamName.c_str(), bamStreamer.get_header()));
+        std::make_shared<SortedBamWriter>(evidenceBamName, bamStreamer.get_header(), maxRunMemoryBytes));
+  }
+}
+
+void SVEvidenceWriterSharedData::close()
+{
+  for (const auto& bamWriterPtr : m_evidenceBamWriterPtrs) {
+    bamWriterPtr->close();
   }
 }
 
@@ -193,8 +204,12 @@ SVEvidenceWriter::SVEvidenceWriter(
 {
   if (!m_isGenerateEvidenceBam) return;
 
-  openBamStreams(opt.referenceFilename, opt.alignFileOpt.alignmentFilenames, m_origBamStreamPtrs);
+  openBamStreams(opt.referenceFilename, opt.alignFileOpt, m_origBamStreamPtrs);
   assert(m_origBamStreamPtrs.size() == m_sampleSize);
+
+  for (unsigned sampleIndex(0); sampleIndex < m_sampleSize; ++sampleIndex) {
+    m_bamRunBufferPtrs.emplace_back(new SortedBamRunBuffer(m_sharedData->getBamWriter(sampleIndex)));
+  }
 }
 
 void SVEvidenceWriter::write(const SVEvidenceWriterData& svEvidenceWriterData)
@@ -205,6 +220,6 @@ void SVEvidenceWriter::write(const SVEvidenceWriterData& svEvidenceWriterData)
     writeSupportBam(
         m_origBamStreamPtrs[sampleIndex],
         svEvidenceWriterData.sampleData[sampleIndex],
-        m_sharedData->getBamWriter(sampleIndex));
+        *(m_bamRunBufferPtrs[sampleIndex]));
   }
 }
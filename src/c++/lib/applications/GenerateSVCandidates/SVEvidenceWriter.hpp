@@ -29,7 +29,7 @@
 #include <vector>
 
 #include "GSCOptions.hpp"
-#include "SynchronizedBamWriter.hpp"
+#include "SortedBamWriter.hpp"
 #include "htsapi/bam_streamer.hpp"
 #include "manta/SVCandidateSetData.hpp"
 
@@ -178,15 +178,21 @@ class SVEvidenceWriterSharedData {
 public:
   explicit SVEvidenceWriterSharedData(const GSCOptions& opt);
 
-  SynchronizedBamWriter& getBamWriter(const unsigned bamIndex)
+  SortedBamWriter& getBamWriter(const unsigned bamIndex)
   {
     assert(bamIndex < m_evidenceBamWriterPtrs.size());
     assert(m_evidenceBamWriterPtrs[bamIndex]);
     return *(m_evidenceBamWriterPtrs[bamIndex]);
   }
 
+  /// Merge and index all evidence bam files
+  ///
+  /// All SVEvidenceWriter objects using this data must be destroyed first, so that their buffered records
+  /// are included.
+  void close();
+
 private:
-  std::vector<std::shared_ptr<SynchronizedBamWriter>> m_evidenceBamWriterPtrs;
+  std::vector<std::shared_ptr<SortedBamWriter>> m_evidenceBamWriterPtrs;
 };
 
 /// \brief Coordinate all bookkeeping and data structures required to output evidence BAMs
@@ -208,16 +214,20 @@ public:
       bam_streamer&              origBamStream,
       const GenomeInterval&      interval,
       const support_fragments_t& supportFrags,
-      SynchronizedBamWriter&     bamWriter);
+      SortedBamRunBuffer&        bamWriter);
 
   static void writeSupportBam(
       const bam_streamer_ptr&           origBamStream,
       const SVEvidenceWriterSampleData& svSupportFrags,
-      SynchronizedBamWriter&            bamWriter);
+      SortedBamRunBuffer&               bamWriter);
 
 private:
   bool                                        m_isGenerateEvidenceBam;
   unsigned                                    m_sampleSize;
   std::vector<bam_streamer_ptr>               m_origBamStreamPtrs;
   std::shared_ptr<SVEvidenceWriterSharedData> m_sharedData;
+
+  /// Thread-local buffers of evidence records for each sample, these must be destroyed before
+  /// m_sharedData
+  std::vector<std::unique_ptr<SortedBamRunBuffer>> m_bamRunBufferPtrs;
 };
@@ -73,7 +73,8 @@ SVFinder::SVFinder(
     const bam_header_info&              bamHeader,
     const AllSampleReadCounts&          readCounts,
     std::shared_ptr<EdgeRuntimeTracker> edgeTrackerPtr,
-    GSCEdgeStatsManager&                edgeStatMan)
+    GSCEdgeStatsManager&                edgeStatMan,
+    const BamRegionCacheSet&            regionCaches)
   : _scanOpt(opt.scanOpt),
     _isAlignmentTumor(opt.alignFileOpt.isAlignmentTumor),
     _readScanner(readScanner),
@@ -88,7 +89,8 @@ SVFinder::SVFinder(
   _dFilterPtr.reset(new ChromDepthFilterUtil(opt.chromDepthFilename, _scanOpt.maxDepthFactor, bamHeader));
 
   // setup regionless bam_streams:
-  openBamStreams(opt.referenceFilename, opt.alignFileOpt.alignmentFilenames, _bamStreams);
+  openBamStreams(opt.referenceFilename, opt.alignFileOpt, _bamStreams);
+  setBamStreamsRegionCache(regionCaches, _bamStreams);
 
   const unsigned bamCount(_bamStreams.size());
   {
@@ -128,7 +130,9 @@ static void addSVNodeRead(
     const bool                                 isLocalNodeGraphEdgeNode1,
     const bool                                 isGatherSubmapped,
     SVCandidateSetSequenceFragmentSampleGroup& svDataGroup,
-    SampleEvidenceCounts&                      eCounts)
+    SampleEvidenceCounts&                      eCounts,
+    SVLocusScannerReadAnalysis&                readAnalysis,
+    std::vector<SVLocusEvidence>&              locusEvidence)
 {
   using namespace illumina::common;
 
@@ -139,7 +143,7 @@ static void addSVNodeRead(
 
   svDataGroup.increment(isSubMapped);
 
-  if (!scanner.isSVEvidence(bamRead, bamIndex, refSeq)) return;
+  if (!scanner.isSVEvidence(bamRead, bamIndex, refSeq, readAnalysis)) return;
 
   // finally, check to see if the svDataGroup is full... for now, we allow a very large
   // number of reads to be stored in the hope that we never reach this limit, but just in
@@ -157,34 +161,29 @@ static void addSVNodeRead(
   // run an initial screen to make sure at least one candidate from this read matches the regions for this
   // edge:
   //
-  typedef std::vector<SVLocus> loci_t;
-  loci_t                       loci;
-  scanner.getSVLoci(bamRead, bamIndex, bamHeader, refSeq, loci, eCounts);
-
-  for (const SVLocus& locus : loci) {
-    const unsigned locusSize(locus.size());
-    assert((locusSize >= 1) && (locusSize <= 2));
+  scanner.getSVLocusEvidence(bamRead, bamIndex, bamHeader, refSeq, readAnalysis, locusEvidence, eCounts);
 
+  for (const SVLocusEvidence& evidence : locusEvidence) {
     unsigned readLocalIndex(0);
-    if (locusSize == 2) {
+    if (!evidence.isSelfEdge()) {
       unsigned readRemoteIndex(1);
-      if (!locus.getNode(readLocalIndex).isOutCount()) {
+      if (0 == evidence.edgeCounts[readLocalIndex]) {
         std::swap(readLocalIndex, readRemoteIndex);
       }
 
-      if (!locus.getNode(readLocalIndex).isOutCount()) {
+      if (0 == evidence.edgeCounts[readLocalIndex]) {
         std::ostringstream oss;
         oss << "Unexpected svlocus counts from bam record: " << bamRead << "\n"
-            << "\tlocus: " << locus << "\n";
+            << "\tlocus intervals: " << evidence.intervals[0] << " " << evidence.intervals[1] << "\n";
         BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
       }
-      if (!locus.getNode(readRemoteIndex).getInterval().isIntersect(remoteNode.getInterval()))
+      if (!evidence.intervals[readRemoteIndex].isIntersect(remoteNode.getInterval()))
         continue;  // todo should this intersect be checked in swapped orientation?
     } else {
-      if (!locus.getNode(readLocalIndex).getInterval().isIntersect(remoteNode.getInterval())) continue;
+      if (!evidence.intervals[readLocalIndex].isIntersect(remoteNode.getInterval())) continue;
     }
 
-    if (!locus.getNode(readLocalIndex).getInterval().isIntersect(localNode.getInterval()))
+    if (!evidence.intervals[readLocalIndex].isIntersect(localNode.getInterval()))
       continue;  // todo should this intersect be checked in swapped orientation?
 
     svDataGroup.add(bamHeader, bamRead, isExpectRepeat, isLocalNodeGraphEdgeNode1, isSubMapped);
@@ -324,7 +323,9 @@ void SVFinder::addSVNodeData(
           isLocalNodeGraphEdgeNode1,
           isGatherSubmapped,
           svDataGroup,
-          _eCounts);
+          _eCounts,
+          _readAnalysis,
+          _locusEvidence);
     }
     ++bamIndex;
   }
@@ -32,6 +32,7 @@
 #include "GSCOptions.hpp"
 #include "appstats/SVFinderStats.hpp"
 #include "htsapi/bam_streamer.hpp"
+#include "manta/BamStreamerUtils.hpp"
 #include "manta/ChromDepthFilterUtil.hpp"
 #include "manta/SVCandidateSetData.hpp"
 #include "manta/SVLocusScanner.hpp"
@@ -45,7 +46,8 @@ struct SVFinder {
       const bam_header_info&              bamHeader,
       const AllSampleReadCounts&          readCounts,
       std::shared_ptr<EdgeRuntimeTracker> edgeTrackerPtr,
-      GSCEdgeStatsManager&                edgeStatMan);
+      GSCEdgeStatsManager&                edgeStatMan,
+      const BamRegionCacheSet&            regionCaches = BamRegionCacheSet());
 
   ~SVFinder();
 
@@ -147,6 +149,10 @@ private:
   /// this is only here as syscall cache:
   std::vector<SVObservation> _readCandidates;
 
+  /// per-read scan intermediates and locus evidence, retained between reads to avoid reallocation
+  SVLocusScannerReadAnalysis   _readAnalysis;
+  std::vector<SVLocusEvidence> _locusEvidence;
+
   /// throwaway stats tracker...
   SampleEvidenceCounts _eCounts;
 
@@ -46,7 +46,11 @@
 #define ANY_DEBUG_SCORE
 #endif
 
-SVScorer::SVScorer(const GSCOptions& opt, const SVLocusScanner& readScanner, const bam_header_info& header)
+SVScorer::SVScorer(
+    const GSCOptions&        opt,
+    const SVLocusScanner&    readScanner,
+    const bam_header_info&   header,
+    const BamRegionCacheSet& regionCaches)
   : _isAlignmentTumor(opt.alignFileOpt.isAlignmentTumor),
     _isRNA(opt.isRNA),
     _callOpt(opt.callOpt),
@@ -64,7 +68,8 @@ SVScorer::SVScorer(const GSCOptions& opt, const SVLocusScanner& readScanner, con
     _readScanner(readScanner),
     _header(header)
 {
-  openBamStreams(opt.referenceFilename, opt.alignFileOpt.alignmentFilenames, _bamStreams);
+  openBamStreams(opt.referenceFilename, opt.alignFileOpt, _bamStreams);
+  setBamStreamsRegionCache(regionCaches, _bamStreams);
 
   _sampleCount        = opt.alignFileOpt.isAlignmentTumor.size();
   _diploidSampleCount = opt.alignFileOpt.diploidSampleCount();
@@ -89,11 +94,11 @@ static void addReadToDepthEst(const bam_record& bamRead, const pos_t beginPos, s
     if (refPos >= endPos) return;
 
     if (is_segment_align_match(ps.type)) {
-      for (pos_t pos(refPos); pos < (refPos + static_cast<pos_t>(ps.length)); ++pos) {
-        if (pos >= beginPos) {
-          if (pos >= endPos) return;
-          depth[pos - beginPos]++;
-        }
+      // clip the segment to the depth range first, so that the increment loop is branch-free:
+      const pos_t segmentBeginPos(std::max(refPos, beginPos));
+      const pos_t segmentEndPos(std::min(refPos + static_cast<pos_t>(ps.length), endPos));
+      for (pos_t pos(segmentBeginPos); pos < segmentEndPos; ++pos) {
+        depth[pos - beginPos]++;
       }
     }
     if (is_segment_type_ref_length(ps.type)) refPos += ps.length;
@@ -35,6 +35,7 @@
 #include "blt_util/qscore_snp.hpp"
 #include "htsapi/bam_header_info.hpp"
 #include "htsapi/bam_streamer.hpp"
+#include "manta/BamStreamerUtils.hpp"
 #include "manta/ChromDepthFilterUtil.hpp"
 #include "manta/SVCandidateAssemblyData.hpp"
 #include "manta/SVCandidateSetData.hpp"
@@ -123,7 +124,11 @@ private:
 /// Implements SV scoring/genotyping process
 ///
 struct SVScorer {
-  SVScorer(const GSCOptions& opt, const SVLocusScanner& readScanner, const bam_header_info& header);
+  SVScorer(
+      const GSCOptions&        opt,
+      const SVLocusScanner&    readScanner,
+      const bam_header_info&   header,
+      const BamRegionCacheSet& regionCaches = BamRegionCacheSet());
 
   /// Gather supporting read evidence and generate:
   /// 1. diploid quality score and genotype for SV candidate
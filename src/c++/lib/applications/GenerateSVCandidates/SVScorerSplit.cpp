@@ -127,6 +127,24 @@ static void incrementSplitReadEvidence(
   }
 }
 
+/// Split read alignment targets for all breakends and alleles of a candidate SV
+///
+/// The targets are encoded once and then shared by all reads scored against the candidate.
+struct SVSplitReadTargets {
+  explicit SVSplitReadTargets(const SVAlignmentInfo& svAlignInfo)
+    : bp1Contig(svAlignInfo.bp1ContigSeq()),
+      bp2Contig(svAlignInfo.bp2ContigSeq()),
+      bp1Reference(svAlignInfo.bp1ReferenceSeq()),
+      bp2Reference(svAlignInfo.bp2ReferenceSeq())
+  {
+  }
+
+  const SplitReadTarget bp1Contig;
+  const SplitReadTarget bp2Contig;
+  const SplitReadTarget bp1Reference;
+  const SplitReadTarget bp2Reference;
+};
+
 /// Score a single split read for one breakend of a candidate SV in one sample
 static void getReadSplitScore(
     const CallOptionsSharedDeriv&   dopt,
@@ -134,6 +152,7 @@ static void getReadSplitScore(
     const SVId&                     svId,
     const SVBreakend&               bp,
     const SVAlignmentInfo&          svAlignInfo,
+    const SVSplitReadTargets&       splitReadTargets,
     const reference_contig_segment& bpRef,
     const bool                      isBP1,
     const unsigned                  minMapQ,
@@ -185,45 +204,23 @@ static void getReadSplitScore(
   setReadEvidence(minMapQ, minTier2MapQ, bamRead, isShadow, evidenceRead);
 
   // align the read to the alt allele contig
-  SRAlignmentInfo altBp1SR;
-  SRAlignmentInfo altBp2SR;
+  SRAlignmentInfo      altBp1SR;
+  SRAlignmentInfo      altBp2SR;
+  const SplitReadQuery altQuery(readSeq, dopt.altQ, qual);
   splitReadAligner(
-      flankScoreSize,
-      readSeq,
-      dopt.altQ,
-      qual,
-      svAlignInfo.bp1ContigSeq(),
-      svAlignInfo.bp1ContigOffset,
-      altBp1SR);
+      flankScoreSize, altQuery, splitReadTargets.bp1Contig, svAlignInfo.bp1ContigOffset, altBp1SR);
   splitReadAligner(
-      flankScoreSize,
-      readSeq,
-      dopt.altQ,
-      qual,
-      svAlignInfo.bp2ContigSeq(),
-      svAlignInfo.bp2ContigOffset,
-      altBp2SR);
+      flankScoreSize, altQuery, splitReadTargets.bp2Contig, svAlignInfo.bp2ContigOffset, altBp2SR);
 
   // align the read to reference regions
   SRAlignmentInfo refBp1SR;
   SRAlignmentInfo refBp2SR;
   if (!isRNA) {
+    const SplitReadQuery refQuery(readSeq, dopt.refQ, qual);
     splitReadAligner(
-        flankScoreSize,
-        readSeq,
-        dopt.refQ,
-        qual,
-        svAlignInfo.bp1ReferenceSeq(),
-        svAlignInfo.bp1RefOffset,
-        refBp1SR);
+        flankScoreSize, refQuery, splitReadTargets.bp1Reference, svAlignInfo.bp1RefOffset, refBp1SR);
     splitReadAligner(
-        flankScoreSize,
-        readSeq,
-        dopt.refQ,
-        qual,
-        svAlignInfo.bp2ReferenceSeq(),
-        svAlignInfo.bp2RefOffset,
-        refBp2SR);
+        flankScoreSize, refQuery, splitReadTargets.bp2Reference, svAlignInfo.bp2RefOffset, refBp2SR);
   } else {
     if (isBP1)
       getRefAlignment(bamRead, bpRef, bp.interval.range, dopt.refQ, refBp1SR);
@@ -303,6 +300,8 @@ static void scoreSplitReads(
   // We are not looking for remote reads, (semialigned-) reads mapping near this breakpoint, but not across it
   // or any other kind of additional reads used for assembly.
 
+  const SVSplitReadTargets splitReadTargets(svAlignInfo);
+
   readStream.resetRegion(
       bp.interval.tid,
       std::max(0, bp.interval.range.begin_pos() - extendedSearchRange),
@@ -331,6 +330,7 @@ static void scoreSplitReads(
           svId,
           bp,
           svAlignInfo,
+          splitReadTargets,
           bpRef,
           isBP1,
           minMapQ,
@@ -391,6 +391,7 @@ static void scoreSplitReads(
           svId,
           bp,
           svAlignInfo,
+          splitReadTargets,
           bpRef,
           isBP1,
           minMapQ,
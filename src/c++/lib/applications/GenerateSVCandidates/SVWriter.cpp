@@ -32,7 +32,7 @@ static std::vector<std::string> getSampleNamesFromBamFiles(const GSCOptions& opt
   std::vector<std::string> sampleNames;
 
   std::vector<std::shared_ptr<bam_streamer>> bamStreams;
-  openBamStreams(opt.referenceFilename, opt.alignFileOpt.alignmentFilenames, bamStreams);
+  openBamStreams(opt.referenceFilename, opt.alignFileOpt, bamStreams);
 
   // initialize sampleNames from all bam headers (assuming 1 sample per bam for now)
   const unsigned bamCount(bamStreams.size());
@@ -0,0 +1,245 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "SortedBamWriter.hpp"
+
+#include "blt_util/log.hpp"
+#include "common/Exceptions.hpp"
+#include "htsapi/bam_dumper.hpp"
+#include "htsapi/bam_region_cache.hpp"
+#include "htsapi/bam_streamer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <queue>
+#include <sstream>
+
+/// True if \p lhs is written before \p rhs in the sorted output
+static bool isSortedBefore(const bam_record& lhs, const bam_record& rhs)
+{
+  const bam1_core_t& lhsCore(lhs.get_data()->core);
+  const bam1_core_t& rhsCore(rhs.get_data()->core);
+
+  // Unmapped records without a reference contig (tid -1) are sorted after all others:
+  const uint32_t lhsTid(static_cast<uint32_t>(lhsCore.tid));
+  const uint32_t rhsTid(static_cast<uint32_t>(rhsCore.tid));
+  if (lhsTid != rhsTid) return (lhsTid < rhsTid);
+  if (lhsCore.pos != rhsCore.pos) return (lhsCore.pos < rhsCore.pos);
+  if (lhs.is_fwd_strand() != rhs.is_fwd_strand()) return lhs.is_fwd_strand();
+
+  const int qnameCompare(strcmp(lhs.qname(), rhs.qname()));
+  if (qnameCompare != 0) return (qnameCompare < 0);
+  return (lhsCore.flag < rhsCore.flag);
+}
+
+namespace {
+
+/// One sorted run in the final merge, read either from a temporary file or from memory
+struct MergeRun {
+  /// Advance to the next record of the run
+  ///
+  /// \return False if there are no more records in the run
+  bool next()
+  {
+    if (streamPtr) {
+      if (!streamPtr->next()) return false;
+      recordPtr = streamPtr->get_record_ptr();
+      return true;
+    }
+
+    assert(sortedRecordsPtr != nullptr);
+    if (nextIndex >= sortedRecordsPtr->size()) return false;
+    recordPtr = (*sortedRecordsPtr)[nextIndex++];
+    return true;
+  }
+
+  std::unique_ptr<bam_streamer>         streamPtr;
+  const std::vector<const bam_record*>* sortedRecordsPtr = nullptr;
+  std::size_t                           nextIndex        = 0;
+  const bam_record*                     recordPtr        = nullptr;
+};
+
+/// Priority queue order of run indices, such that the top run has the first record in output order
+struct MergeRunOrder {
+  explicit MergeRunOrder(const std::vector<MergeRun>& runs) : _runs(runs) {}
+
+  bool operator()(const unsigned lhs, const unsigned rhs) const
+  {
+    const bam_record& lhsRecord(*_runs[lhs].recordPtr);
+    const bam_record& rhsRecord(*_runs[rhs].recordPtr);
+    if (isSortedBefore(rhsRecord, lhsRecord)) return true;
+    if (isSortedBefore(lhsRecord, rhsRecord)) return false;
+    return (lhs > rhs);
+  }
+
+private:
+  const std::vector<MergeRun>& _runs;
+};
+
+}  // namespace
+
+SortedBamWriter::SortedBamWriter(
+    const std::string& filename, const bam_hdr_t& header, const std::size_t maxRunMemoryBytes)
+  : _filename(filename), _header(bam_hdr_dup(&header)), _maxRunMemoryBytes(maxRunMemoryBytes)
+{
+  // Test that the output file can be written before any work is done:
+  bam_dumper testOutput(_filename.c_str(), *_header);
+}
+
+SortedBamWriter::~SortedBamWriter()
+{
+  try {
+    close();
+  } catch (const std::exception& e) {
+    log_os << "ERROR: Failed to write sorted BAM file: '" << _filename << "' " << e.what() << "\n";
+  }
+  removeSpillFiles();
+  bam_hdr_destroy(_header);
+}
+
+void SortedBamWriter::spillRun(const std::vector<const bam_record*>& sortedRecords)
+{
+  std::string spillFilename;
+  {
+    std::lock_guard<std::mutex> lock(_runMutex);
+    spillFilename = _filename + ".tmp_run" + std::to_string(_spillFileCount++) + ".bam";
+    _spillFilenames.push_back(spillFilename);
+  }
+
+  // Temporary runs are only read once, so they are written with fast compression:
+  bam_dumper spillOutput(spillFilename.c_str(), *_header, "wb1");
+  for (const bam_record* recordPtr : sortedRecords) {
+    spillOutput.put_record(recordPtr->get_data());
+  }
+  spillOutput.close();
+}
+
+void SortedBamWriter::addMemoryRun(MemoryRun& run)
+{
+  std::lock_guard<std::mutex> lock(_runMutex);
+  _memoryRuns.emplace_back();
+
+  // Swapping the deque keeps all sorted record pointers valid:
+  _memoryRuns.back().records.swap(run.records);
+  _memoryRuns.back().sortedRecords.swap(run.sortedRecords);
+  run.records.clear();
+  run.sortedRecords.clear();
+}
+
+void SortedBamWriter::removeSpillFiles()
+{
+  for (const std::string& spillFilename : _spillFilenames) {
+    std::remove(spillFilename.c_str());
+  }
+  _spillFilenames.clear();
+}
+
+void SortedBamWriter::close()
+{
+  if (_isClosed) return;
+  _isClosed = true;
+
+  std::vector<MergeRun> runs(_spillFilenames.size() + _memoryRuns.size());
+  for (unsigned spillIndex(0); spillIndex < _spillFilenames.size(); ++spillIndex) {
+    runs[spillIndex].streamPtr.reset(new bam_streamer(_spillFilenames[spillIndex].c_str(), nullptr));
+  }
+  for (unsigned memoryIndex(0); memoryIndex < _memoryRuns.size(); ++memoryIndex) {
+    runs[_spillFilenames.size() + memoryIndex].sortedRecordsPtr = &(_memoryRuns[memoryIndex].sortedRecords);
+  }
+
+  {
+    std::priority_queue<unsigned, std::vector<unsigned>, MergeRunOrder> runQueue((MergeRunOrder(runs)));
+    for (unsigned runIndex(0); runIndex < runs.size(); ++runIndex) {
+      if (runs[runIndex].next()) runQueue.push(runIndex);
+    }
+
+    bam_dumper output(_filename.c_str(), *_header);
+    while (!runQueue.empty()) {
+      const unsigned runIndex(runQueue.top());
+      runQueue.pop();
+      output.put_record(runs[runIndex].recordPtr->get_data());
+      if (runs[runIndex].next()) runQueue.push(runIndex);
+    }
+    output.close();
+  }
+
+  runs.clear();
+  removeSpillFiles();
+  _memoryRuns.clear();
+
+  const int indexStatus(bam_index_build(_filename.c_str(), 0));
+  if (indexStatus < 0) {
+    std::ostringstream oss;
+    oss << "Failed to build index for BAM file: '" << _filename
+        << "'. bam_index_build return code: " << indexStatus;
+    BOOST_THROW_EXCEPTION(illumina::common::GeneralException(oss.str()));
+  }
+}
+
+SortedBamRunBuffer::~SortedBamRunBuffer()
+{
+  try {
+    flush();
+  } catch (const std::exception& e) {
+    log_os << "ERROR: Failed to flush BAM records for sorted BAM file: '" << _writer.filename() << "' "
+           << e.what() << "\n";
+  }
+}
+
+void SortedBamRunBuffer::put_record(const bam1_t* brec)
+{
+  _run.records.emplace_back();
+  bam_record& record(_run.records.back());
+  bam_copy1(record.get_data(), brec);
+  _memoryBytes += getBamRecordMemoryBytes(record);
+
+  if (_memoryBytes > _writer.maxRunMemoryBytes()) {
+    sortRecords();
+    _writer.spillRun(_run.sortedRecords);
+    _run.records.clear();
+    _run.sortedRecords.clear();
+    _memoryBytes = 0;
+  }
+}
+
+void SortedBamRunBuffer::flush()
+{
+  if (_run.records.empty()) return;
+  sortRecords();
+  _writer.addMemoryRun(_run);
+  _memoryBytes = 0;
+}
+
+void SortedBamRunBuffer::sortRecords()
+{
+  _run.sortedRecords.clear();
+  for (const bam_record& record : _run.records) {
+    _run.sortedRecords.push_back(&record);
+  }
+  std::sort(
+      _run.sortedRecords.begin(), _run.sortedRecords.end(), [](const bam_record* lhs, const bam_record* rhs) {
+        return isSortedBefore(*lhs, *rhs);
+      });
+}
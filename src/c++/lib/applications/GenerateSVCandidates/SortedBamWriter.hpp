@@ -0,0 +1,123 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Write BAM records from multiple threads to one coordinate sorted and indexed BAM file
+///
+
+#pragma once
+
+#include "htsapi/bam_record.hpp"
+
+#include "boost/noncopyable.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// \brief Write BAM records from multiple threads to one coordinate sorted and indexed BAM file
+///
+/// Records are not added to this object directly, instead each thread collects records in its own
+/// SortedBamRunBuffer, so that no lock is taken per record. Each buffer sorts its records into runs. Runs
+/// which exceed the buffer memory limit are spilled to temporary BAM files next to the output file, and the
+/// final run of each buffer is held in memory. When the writer is closed, all runs are merged into the
+/// output BAM file, which is then indexed.
+///
+/// Records are sorted by reference position as in 'samtools sort', with unmapped records last. Ties are
+/// resolved by strand, read name and flag so that the output is independent of the order in which threads
+/// add records.
+///
+class SortedBamWriter : private boost::noncopyable {
+public:
+  /// \param maxRunMemoryBytes The memory limit of each thread's run buffer, used to decide when records
+  ///                          are spilled to a temporary file
+  SortedBamWriter(const std::string& filename, const bam_hdr_t& header, const std::size_t maxRunMemoryBytes);
+
+  /// Closes the writer if it has not already been closed, any error is logged
+  ~SortedBamWriter();
+
+  /// \brief Merge all runs into the output BAM file and index it
+  ///
+  /// All run buffers writing to this object must be flushed first. This has no effect if the writer is
+  /// already closed.
+  void close();
+
+  const std::string& filename() const { return _filename; }
+
+  std::size_t maxRunMemoryBytes() const { return _maxRunMemoryBytes; }
+
+private:
+  friend class SortedBamRunBuffer;
+
+  /// Records in a deque, and pointers to them in sorted order
+  struct MemoryRun {
+    std::deque<bam_record>         records;
+    std::vector<const bam_record*> sortedRecords;
+  };
+
+  /// Write a sorted run of records to a new temporary file
+  void spillRun(const std::vector<const bam_record*>& sortedRecords);
+
+  /// Keep a sorted run of records in memory until the writer is closed, \p run is cleared
+  void addMemoryRun(MemoryRun& run);
+
+  void removeSpillFiles();
+
+  const std::string _filename;
+  bam_hdr_t*        _header;
+  const std::size_t _maxRunMemoryBytes;
+  bool              _isClosed = false;
+
+  std::mutex               _runMutex;
+  unsigned                 _spillFileCount = 0;
+  std::vector<std::string> _spillFilenames;
+
+  /// A deque is used so that runs are never copied when more runs are added, which would invalidate the
+  /// sorted record pointers of each run
+  std::deque<MemoryRun> _memoryRuns;
+};
+
+/// \brief Collect records added from a single thread into sorted runs for a SortedBamWriter
+///
+/// This object is not thread-safe, each thread adding records to the same SortedBamWriter requires its own
+/// buffer.
+///
+class SortedBamRunBuffer : private boost::noncopyable {
+public:
+  explicit SortedBamRunBuffer(SortedBamWriter& writer) : _writer(writer) {}
+
+  /// Flushes the buffer, any error is logged
+  ~SortedBamRunBuffer();
+
+  /// Add a record to the buffer, and spill all buffered records if the memory limit is exceeded
+  void put_record(const bam1_t* brec);
+
+  /// Hand all buffered records to the writer as one sorted run
+  void flush();
+
+private:
+  /// Sort all buffered records in the order of the output BAM file
+  void sortRecords();
+
+  SortedBamWriter&           _writer;
+  SortedBamWriter::MemoryRun _run;
+  std::size_t                _memoryBytes = 0;
+};
@@ -28,6 +28,10 @@
 #include <cmath>
 #include <iostream>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "blt_util/blt_types.hpp"
 #include "blt_util/log.hpp"
 #include "blt_util/seq_printer.hpp"
@@ -91,6 +95,217 @@ static float getLnLhood(
   return lnLhood;
 }
 
+SplitReadQuery::SplitReadQuery(
+    const std::string& initSeq, const qscore_snp& initQualConvert, const uint8_t* initQual)
+  : seq(initSeq), qualConvert(initQualConvert), qual(initQual), isQualValid(true)
+{
+  // These terms are computed with the same expressions and types as getLnLhood, so that a likelihood
+  // accumulated from them is identical to the getLnLhood result:
+  static const float ln_one_third(std::log(1 / 3.f));
+  static const float lnRandomBase(-std::log(4.f));
+
+  const unsigned querySize(seq.size());
+  lnMatch.resize(querySize);
+  lnMismatch.resize(querySize);
+  for (unsigned i(0); i < querySize; i++) {
+    if (seq[i] == 'N') {
+      lnMatch[i]    = lnRandomBase;
+      lnMismatch[i] = lnRandomBase;
+    } else {
+      const int baseQual(std::max(2, static_cast<int>(qual[i])));
+      if (baseQual > qphred_cache::MAX_QSCORE) {
+        isQualValid = false;
+        lnMatch.clear();
+        lnMismatch.clear();
+        return;
+      }
+      lnMatch[i]    = qualConvert.qphred_to_ln_comp_error_prob(baseQual);
+      lnMismatch[i] = qualConvert.qphred_to_ln_error_prob(baseQual) + ln_one_third;
+    }
+  }
+}
+
+SplitReadTarget::SplitReadTarget(const std::string& initSeq) : seq(initSeq)
+{
+  code.assign(seq.begin(), seq.end());
+  code.resize(seq.size() + laneCount, 0);
+}
+
+/// Find the target offset in [scanStart, scanEnd] where the query alignment has the highest likelihood,
+/// using the first such offset in case of ties
+///
+/// This is the scalar reference implementation.
+///
+static void scanBestOffset(
+    const SplitReadQuery&   query,
+    const SplitReadTarget&  target,
+    const unsigned          scanStart,
+    const unsigned          scanEnd,
+    const known_pos_range2& scoreRange,
+    float&                  bestLnLhood,
+    unsigned&               bestPos)
+{
+  bool isBest(false);
+  for (unsigned i = scanStart; i <= scanEnd; i++) {
+    const float lnLhood(
+        getLnLhood(query.seq, query.qualConvert, query.qual, target.seq, i, scoreRange, isBest, bestLnLhood));
+
+#ifdef DEBUG_SRA
+    log_os << __FUNCTION__ << "scanning: " << i << " lhood: " << lnLhood << " bestLnLhood " << bestLnLhood
+           << " isBest " << isBest << " bestPos " << bestPos << '\n';
+#endif
+    if ((!isBest) || (lnLhood > bestLnLhood)) {
+      bestLnLhood = lnLhood;
+      bestPos     = i;
+      isBest      = true;
+    }
+  }
+  assert(isBest);
+}
+
+#ifdef __SSE2__
+/// Add one log-likelihood term to two float accumulators held in double lanes
+///
+/// The sum is computed in double precision and rounded back to float, which replicates the scalar
+/// 'float += double' update in getLnLhood.
+///
+static __m128d addLnLhoodTerm(
+    const __m128d acc,
+    const __m128i isMatch,
+    const __m128i isTargetN,
+    const __m128i isScored,
+    const __m128d matchTerm,
+    const __m128d mismatchTerm,
+    const __m128d randomBaseTerm)
+{
+  const __m128d isMatchMask(_mm_castsi128_pd(isMatch));
+  const __m128d isTargetNMask(_mm_castsi128_pd(isTargetN));
+  __m128d       term(_mm_or_pd(_mm_and_pd(isMatchMask, matchTerm), _mm_andnot_pd(isMatchMask, mismatchTerm)));
+  term = _mm_or_pd(_mm_and_pd(isTargetNMask, randomBaseTerm), _mm_andnot_pd(isTargetNMask, term));
+  term = _mm_and_pd(_mm_castsi128_pd(isScored), term);
+  return _mm_cvtps_pd(_mm_cvtpd_ps(_mm_add_pd(acc, term)));
+}
+
+/// Vectorized version of scanBestOffset
+///
+/// Blocks of SplitReadTarget::laneCount consecutive target offsets are scored together, with one offset per
+/// vector lane. Each lane accumulates the query terms in the same order and precision as getLnLhood, and the
+/// best offset is selected from each block in scan order, so the result is identical to scanBestOffset.
+///
+/// In place of the per-offset early break used in getLnLhood, a block is abandoned once all of its lanes
+/// score below the best likelihood found in previous blocks. Because every term is non-positive this can't
+/// change the selected offset.
+///
+static void scanBestOffsetVectorized(
+    const SplitReadQuery&   query,
+    const SplitReadTarget&  target,
+    const unsigned          scanStart,
+    const unsigned          scanEnd,
+    const known_pos_range2& scoreRange,
+    float&                  bestLnLhood,
+    unsigned&               bestPos)
+{
+  static const unsigned laneCount(SplitReadTarget::laneCount);
+  static_assert(laneCount == 4, "Unexpected split read target lane count");
+
+  // number of query positions between checks for an abandoned block:
+  static const int pruneCheckInterval(4);
+
+  static const float lnRandomBase(-std::log(4.f));
+
+  const int      querySize(query.seq.size());
+  const int      scoreBegin(scoreRange.begin_pos());
+  const int      scoreEnd(scoreRange.end_pos());
+  const int32_t* targetCode(target.code.data());
+
+  const __m128i laneIndex(_mm_setr_epi32(0, 1, 2, 3));
+  const __m128i one(_mm_set1_epi32(1));
+  const __m128i targetN(_mm_set1_epi32('N'));
+  const __m128i scoreBeginVec(_mm_set1_epi32(scoreBegin));
+  const __m128i scoreEndVec(_mm_set1_epi32(scoreEnd + 1));
+  const __m128d randomBaseTerm(_mm_set1_pd(lnRandomBase));
+
+  bool isBest(false);
+  for (unsigned blockStart(scanStart); blockStart <= scanEnd; blockStart += laneCount) {
+    // restrict the query positions to those which are scored in at least one lane:
+    const int queryBegin(std::max(0, scoreBegin + 1 - static_cast<int>(blockStart + laneCount - 1)));
+    const int queryEnd(std::min(querySize, scoreEnd + 1 - static_cast<int>(blockStart)));
+
+    __m128i       targetPos(_mm_add_epi32(_mm_set1_epi32(blockStart + queryBegin), laneIndex));
+    __m128d       accLow(_mm_setzero_pd());
+    __m128d       accHigh(_mm_setzero_pd());
+    const __m128d bestVec(_mm_set1_pd(bestLnLhood));
+    bool          isPruned(false);
+    for (int queryIndex(queryBegin); queryIndex < queryEnd; queryIndex++) {
+      const __m128i code(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(targetCode + blockStart + queryIndex)));
+      const __m128i isMatch(_mm_cmpeq_epi32(code, _mm_set1_epi32(query.seq[queryIndex])));
+      const __m128i isTargetN(_mm_cmpeq_epi32(code, targetN));
+      const __m128i isScored(
+          _mm_and_si128(_mm_cmpgt_epi32(targetPos, scoreBeginVec), _mm_cmpgt_epi32(scoreEndVec, targetPos)));
+      targetPos = _mm_add_epi32(targetPos, one);
+
+      const __m128d matchTerm(_mm_set1_pd(query.lnMatch[queryIndex]));
+      const __m128d mismatchTerm(_mm_set1_pd(query.lnMismatch[queryIndex]));
+      accLow = addLnLhoodTerm(
+          accLow,
+          _mm_unpacklo_epi32(isMatch, isMatch),
+          _mm_unpacklo_epi32(isTargetN, isTargetN),
+          _mm_unpacklo_epi32(isScored, isScored),
+          matchTerm,
+          mismatchTerm,
+          randomBaseTerm);
+      accHigh = addLnLhoodTerm(
+          accHigh,
+          _mm_unpackhi_epi32(isMatch, isMatch),
+          _mm_unpackhi_epi32(isTargetN, isTargetN),
+          _mm_unpackhi_epi32(isScored, isScored),
+          matchTerm,
+          mismatchTerm,
+          randomBaseTerm);
+
+      if (isBest && (((queryIndex - queryBegin) % pruneCheckInterval) == (pruneCheckInterval - 1))) {
+        const int isLowBelow(_mm_movemask_pd(_mm_cmplt_pd(accLow, bestVec)));
+        const int isHighBelow(_mm_movemask_pd(_mm_cmplt_pd(accHigh, bestVec)));
+        if ((isLowBelow & isHighBelow) == 0x3) {
+          isPruned = true;
+          break;
+        }
+      }
+    }
+    if (isPruned) continue;
+
+    double lnLhoods[laneCount];
+    _mm_storeu_pd(lnLhoods, accLow);
+    _mm_storeu_pd(lnLhoods + 2, accHigh);
+
+    const unsigned laneEnd(std::min(laneCount, (scanEnd + 1) - blockStart));
+    for (unsigned lane(0); lane < laneEnd; lane++) {
+      const float lnLhood(lnLhoods[lane]);
+      if ((!isBest) || (lnLhood > bestLnLhood)) {
+        bestLnLhood = lnLhood;
+        bestPos     = blockStart + lane;
+        isBest      = true;
+      }
+    }
+  }
+  assert(isBest);
+}
+#else
+/// The vectorized scan is not available for this build
+static void scanBestOffsetVectorized(
+    const SplitReadQuery&   query,
+    const SplitReadTarget&  target,
+    const unsigned          scanStart,
+    const unsigned          scanEnd,
+    const known_pos_range2& scoreRange,
+    float&                  bestLnLhood,
+    unsigned&               bestPos)
+{
+  scanBestOffset(query, target, scanStart, scanEnd, scoreRange, bestLnLhood, bestPos);
+}
+#endif
+
 static void calculateAlignScore(
     const std::string& querySeq,
     const std::string& targetSeq,
@@ -222,15 +437,17 @@ void getRefAlignment(
 
 void splitReadAligner(
     const unsigned          flankScoreSize,
-    const std::string&      querySeq,
-    const qscore_snp&       qualConvert,
-    const uint8_t*          queryQual,
-    const std::string&      targetSeq,
+    const SplitReadQuery&   query,
+    const SplitReadTarget&  target,
     const known_pos_range2& targetBpOffsetRange,
-    SRAlignmentInfo&        alignment)
+    SRAlignmentInfo&        alignment,
+    const bool              isVectorized)
 {
   using namespace illumina::common;
 
+  const std::string& querySeq(query.seq);
+  const std::string& targetSeq(target.seq);
+
   const unsigned querySize  = querySeq.size();
   const unsigned targetSize = targetSeq.size();
   if (querySize >= targetSize) {
@@ -275,23 +492,10 @@ void splitReadAligner(
   // later:
   float    bestLnLhood(0);
   unsigned bestPos(0);
-  {
-    bool isBest(false);
-    for (unsigned i = scanStart; i <= scanEnd; i++) {
-      const float lnLhood(
-          getLnLhood(querySeq, qualConvert, queryQual, targetSeq, i, scoreRange, isBest, bestLnLhood));
-
-#ifdef DEBUG_SRA
-      log_os << __FUNCTION__ << "scanning: " << i << " lhood: " << lnLhood << " bestLnLhood " << bestLnLhood
-             << " isBest " << isBest << " bestPos " << bestPos << '\n';
-#endif
-      if ((!isBest) || (lnLhood > bestLnLhood)) {
-        bestLnLhood = lnLhood;
-        bestPos     = i;
-        isBest      = true;
-      }
-    }
-    assert(isBest);
+  if (isVectorized && query.isQualValid) {
+    scanBestOffsetVectorized(query, target, scanStart, scanEnd, scoreRange, bestLnLhood, bestPos);
+  } else {
+    scanBestOffset(query, target, scanStart, scanEnd, scoreRange, bestLnLhood, bestPos);
   }
 
   assert(static_cast<pos_t>(bestPos) <= (targetBpOffsetRange.end_pos() + 1));
@@ -348,3 +552,17 @@ void splitReadAligner(
   log_os << targetSeq << "\n";
 #endif
 }
+
+void splitReadAligner(
+    const unsigned          flankScoreSize,
+    const std::string&      querySeq,
+    const qscore_snp&       qualConvert,
+    const uint8_t*          queryQual,
+    const std::string&      targetSeq,
+    const known_pos_range2& targetBpOffsetRange,
+    SRAlignmentInfo&        alignment)
+{
+  const SplitReadQuery  query(querySeq, qualConvert, queryQual);
+  const SplitReadTarget target(targetSeq);
+  splitReadAligner(flankScoreSize, query, target, targetBpOffsetRange, alignment);
+}
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 #include "blt_util/known_pos_range2.hpp"
 #include "blt_util/qscore_snp.hpp"
@@ -50,6 +51,58 @@ struct SRAlignmentInfo {
 
 std::ostream& operator<<(std::ostream& os, const SRAlignmentInfo& info);
 
+/// A split read query sequence, with per-base log-likelihood terms precomputed for one quality conversion
+///
+/// The query sequence and qualities are referenced, not copied, so they must outlive this object.
+///
+struct SplitReadQuery {
+  SplitReadQuery(const std::string& initSeq, const qscore_snp& initQualConvert, const uint8_t* initQual);
+
+  const std::string& seq;
+  const qscore_snp&  qualConvert;
+  const uint8_t*     qual;
+
+  /// False if any non-N base quality can't be converted, in which case the precomputed terms below are not
+  /// set
+  bool isQualValid;
+
+  /// Log-likelihood term for each query base if it matches or mismatches a non-N target base
+  std::vector<double> lnMatch;
+  std::vector<double> lnMismatch;
+};
+
+/// A split read alignment target sequence, encoded so that it can be scanned by many queries
+///
+/// The target sequence is referenced, not copied, so it must outlive this object.
+///
+struct SplitReadTarget {
+  explicit SplitReadTarget(const std::string& initSeq);
+
+  /// Number of vector lanes used to scan target offsets
+  static const unsigned laneCount = 4;
+
+  const std::string& seq;
+
+  /// One 32 bit value per target base, padded with laneCount trailing zeros
+  std::vector<int32_t> code;
+};
+
+/// Align \p query to \p target and return alignment details in \p alignment
+///
+/// This is the same as the sequence-based splitReadAligner below, but allows the query to be reused across
+/// several targets and the target to be reused across many queries.
+///
+/// \param[in] isVectorized If true, scan all candidate target offsets with a vectorized likelihood
+/// computation when this is supported by the build. Results are identical to the scalar scan.
+///
+void splitReadAligner(
+    const unsigned          flankScoreSize,
+    const SplitReadQuery&   query,
+    const SplitReadTarget&  target,
+    const known_pos_range2& targetBpOffsetRange,
+    SRAlignmentInfo&        alignment,
+    const bool              isVectorized = true);
+
 /// Align \p querySeq to \p targetSeq and return alignment details in \p alignment
 ///
 /// \param[in] flankScoreSize the number of bases to score past the end of microhomology range
@@ -0,0 +1,194 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+#include "boost/test/unit_test.hpp"
+
+#include "EdgeRetrieverBin.hpp"
+#include "EdgeScheduler.hpp"
+
+#include "svgraph/SVLocusSet.hpp"
+#include "test/testFileMakers.hpp"
+#include "test/testSVLocusUtil.hpp"
+
+#include <set>
+#include <vector>
+
+/// Create a graph of \p locusCount single-edge loci, where the edge cost estimate increases with locus index
+static void getIncreasingCostLocusSet(const unsigned locusCount, SVLocusSet& set)
+{
+  for (unsigned locusIndex(0); locusIndex < locusCount; ++locusIndex) {
+    SVLocus locus;
+    locusAddPair(locus, 2 * locusIndex, 10, 20, 2 * locusIndex + 1, 30, 40, false, locusIndex + 1);
+    set.merge(locus);
+  }
+  set.checkState(true, true);
+}
+
+BOOST_AUTO_TEST_SUITE(EdgeScheduler_test_suite)
+
+BOOST_AUTO_TEST_CASE(test_EdgeCostEstimate)
+{
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet set(sopt);
+
+  SVLocus locus1;
+  locusAddPair(locus1, 1, 10, 20, 2, 30, 40, false, 1);
+  SVLocus locus2;
+  locusAddPair(locus2, 3, 10, 20, 4, 30, 40, false, 5);
+  SVLocus locus3;
+  locusAddPair(locus3, 5, 10, 1000, 6, 30, 40, false, 1);
+  set.merge(locus1);
+  set.merge(locus2);
+  set.merge(locus3);
+  set.checkState(true, true);
+
+  EdgeInfo edge;
+  edge.nodeIndex2 = 1;
+  edge.locusIndex = 0;
+  const uint64_t cost1(getEdgeCostEstimate(set, edge));
+  edge.locusIndex = 1;
+  const uint64_t cost2(getEdgeCostEstimate(set, edge));
+  edge.locusIndex = 2;
+  const uint64_t cost3(getEdgeCostEstimate(set, edge));
+
+  // Both higher evidence count and larger node size should increase the cost estimate:
+  BOOST_REQUIRE_GT(cost2, cost1);
+  BOOST_REQUIRE_GT(cost3, cost1);
+
+  // A self-edge only includes the cost of one node:
+  edge.nodeIndex2 = 0;
+  BOOST_REQUIRE_LT(getEdgeCostEstimate(set, edge), cost3);
+}
+
+BOOST_AUTO_TEST_CASE(test_EdgeSchedulerOrder)
+{
+  static const unsigned locusCount(5);
+
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet set(sopt);
+  getIncreasingCostLocusSet(locusCount, set);
+
+  EdgeRetrieverBin edger(set, 0, 1, 0);
+  EdgeScheduler    scheduler(set, edger, 0);
+
+  // Test that edges are issued in order of decreasing cost:
+  EdgeInfo edge;
+  for (unsigned edgeIndex(0); edgeIndex < locusCount; ++edgeIndex) {
+    BOOST_REQUIRE(scheduler.next(edge));
+    BOOST_REQUIRE_EQUAL(edge.locusIndex, (locusCount - 1) - edgeIndex);
+    BOOST_REQUIRE_EQUAL(edge.nodeIndex1, 0u);
+    BOOST_REQUIRE_EQUAL(edge.nodeIndex2, 1u);
+  }
+  BOOST_REQUIRE(!scheduler.next(edge));
+}
+
+BOOST_AUTO_TEST_CASE(test_EdgeSchedulerWindow)
+{
+  static const unsigned locusCount(5);
+
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet set(sopt);
+  getIncreasingCostLocusSet(locusCount, set);
+
+  // With a window of 2 edges, the lowest cost edge is held in the window until the retriever is exhausted:
+  EdgeRetrieverBin edger(set, 0, 1, 0);
+  EdgeScheduler    scheduler(set, edger, 2);
+
+  const std::vector<unsigned> expectedLocusIndices = {1, 2, 3, 4, 0};
+  EdgeInfo                    edge;
+  for (const unsigned expectedLocusIndex : expectedLocusIndices) {
+    BOOST_REQUIRE(scheduler.next(edge));
+    BOOST_REQUIRE_EQUAL(edge.locusIndex, expectedLocusIndex);
+  }
+  BOOST_REQUIRE(!scheduler.next(edge));
+}
+
+BOOST_AUTO_TEST_CASE(test_EdgeSchedulerClaimFile)
+{
+  static const unsigned locusCount(20);
+
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet set(sopt);
+  getIncreasingCostLocusSet(locusCount, set);
+
+  // Two schedulers sharing a claim file stand in for two GenerateSVCandidates processes:
+  TestFilenameMaker claimFile;
+  EdgeRetrieverBin  edger1(set, 0, 1, 0);
+  EdgeScheduler     scheduler1(set, edger1, 4, claimFile.getFilename());
+  EdgeRetrieverBin  edger2(set, 0, 1, 0);
+  EdgeScheduler     scheduler2(set, edger2, 4, claimFile.getFilename());
+
+  std::set<unsigned> locusIndices1;
+  std::set<unsigned> locusIndices2;
+  EdgeInfo           edge;
+  bool               isEdge1(true);
+  bool               isEdge2(true);
+  while (isEdge1 || isEdge2) {
+    isEdge1 = scheduler1.next(edge);
+    if (isEdge1) locusIndices1.insert(edge.locusIndex);
+    isEdge2 = scheduler2.next(edge);
+    if (isEdge2) locusIndices2.insert(edge.locusIndex);
+  }
+
+  // Test that each edge is processed exactly once over both schedulers:
+  BOOST_REQUIRE(!locusIndices1.empty());
+  BOOST_REQUIRE(!locusIndices2.empty());
+  BOOST_REQUIRE_EQUAL(locusIndices1.size() + locusIndices2.size(), locusCount);
+  for (const unsigned locusIndex : locusIndices1) {
+    BOOST_REQUIRE_EQUAL(locusIndices2.count(locusIndex), 0u);
+  }
+
+  // The most expensive edge in the first window is claimed first:
+  BOOST_REQUIRE_EQUAL(locusIndices1.count(3), 1u);
+}
+
+// Test that a claim file can't be reused for a different graph, or after all of its edges have been claimed
+BOOST_AUTO_TEST_CASE(test_EdgeSchedulerStaleClaimFile)
+{
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet set(sopt);
+  getIncreasingCostLocusSet(20, set);
+  SVLocusSet otherSet(sopt);
+  getIncreasingCostLocusSet(10, otherSet);
+
+  TestFilenameMaker claimFile;
+  {
+    EdgeRetrieverBin edger(set, 0, 1, 0);
+    EdgeScheduler    scheduler(set, edger, 4, claimFile.getFilename());
+
+    // A different graph can't join a run in progress:
+    EdgeRetrieverBin otherEdger(otherSet, 0, 1, 0);
+    BOOST_REQUIRE_THROW(EdgeScheduler(otherSet, otherEdger, 4, claimFile.getFilename()), std::exception);
+
+    EdgeInfo edge;
+    unsigned edgeCount(0);
+    while (scheduler.next(edge)) edgeCount++;
+    BOOST_REQUIRE_EQUAL(edgeCount, 20u);
+  }
+
+  // Rerunning the same graph with the completed claim file would skip every edge:
+  EdgeRetrieverBin edger(set, 0, 1, 0);
+  BOOST_REQUIRE_THROW(EdgeScheduler(set, edger, 4, claimFile.getFilename()), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
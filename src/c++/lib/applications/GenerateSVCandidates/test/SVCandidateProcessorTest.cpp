@@ -680,15 +680,15 @@ BOOST_AUTO_TEST_CASE(test_Somatic)
   std::ifstream diploidFile(options.diploidOutputFilename);
   std::string   line;
   int           count(0);
-  // Following records are expected:
-  // Record-1:    chrFoo	41	MantaBND:0:0:1:0:0:0:0	C	C[chrBar:66[	.	.
-  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:1;CIPOS=0,9;HOMLEN=9;HOMSEQ=TCCATGCAT;BND_PAIR_COUNT=0;PAIR_COUNT=1
-  // Record-2:    chrBar	66	MantaBND:0:0:1:0:0:0:1	T	]chrFoo:41]T	.	.
-  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:0;CIPOS=0,9;HOMLEN=9;HOMSEQ=ATCCTTCTT;BND_PAIR_COUNT=0;PAIR_COUNT=1
-  // Record-3:    chrFoo	11	MantaBND:0:0:1:0:0:0:0	C	C]chrBar:110]	0
+  // Following records are expected, in sorted VCF order:
+  // Record-1:    chrFoo	11	MantaBND:0:0:1:0:0:0:0	C	C]chrBar:110]	0
   // MinQUAL;NoPairSupport;SampleFT
   //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:1;CIPOS=0,9;HOMLEN=9;HOMSEQ=TATCACCCT;BND_DEPTH=3;MATE_BND_DEPTH=3
   //              GT:FT:GQ:PL:PR:SR	0/0:HomRef:48:0,0,0:0,0:0,0
+  // Record-2:    chrFoo	41	MantaBND:0:0:1:0:0:0:0	C	C[chrBar:66[	.	.
+  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:1;CIPOS=0,9;HOMLEN=9;HOMSEQ=TCCATGCAT;BND_PAIR_COUNT=0;PAIR_COUNT=1
+  // Record-3:    chrBar	66	MantaBND:0:0:1:0:0:0:1	T	]chrFoo:41]T	.	.
+  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:0;CIPOS=0,9;HOMLEN=9;HOMSEQ=ATCCTTCTT;BND_PAIR_COUNT=0;PAIR_COUNT=1
   // Record-4:    chrBar	101	MantaBND:0:0:1:0:0:0:1	G	G]chrFoo:20]	0
   // MinQUAL;NoPairSupport;SampleFT
   //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:0;CIPOS=0,9;HOMLEN=9;HOMSEQ=CAGATGCCA;BND_DEPTH=3;MATE_BND_DEPTH=3
@@ -702,13 +702,13 @@ BOOST_AUTO_TEST_CASE(test_Somatic)
       if (count >= 1) {
         switch (count) {
         case 1:
-          BOOST_REQUIRE(line.find("C[chrBar:66[") != std::string::npos);
+          BOOST_REQUIRE(line.find("C]chrBar:110]") != std::string::npos);
           break;
         case 2:
-          BOOST_REQUIRE(line.find("]chrFoo:41]T") != std::string::npos);
+          BOOST_REQUIRE(line.find("C[chrBar:66[") != std::string::npos);
           break;
         case 3:
-          BOOST_REQUIRE(line.find("C]chrBar:110]") != std::string::npos);
+          BOOST_REQUIRE(line.find("]chrFoo:41]T") != std::string::npos);
           break;
         case 4:
           BOOST_REQUIRE(line.find("G]chrFoo:20]") != std::string::npos);
@@ -726,15 +726,15 @@ BOOST_AUTO_TEST_CASE(test_Somatic)
 
   std::ifstream somaticFile(options.somaticOutputFilename);
   count = 0;
-  // Following records are expected:
-  // Record-1:    chrFoo	41	MantaBND:0:0:1:0:0:0:0	C	C[chrBar:66[	.	.
-  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:1;CIPOS=0,9;HOMLEN=9;HOMSEQ=TCCATGCAT;BND_PAIR_COUNT=0;PAIR_COUNT=1
-  // Record-2:    chrBar	66	MantaBND:0:0:1:0:0:0:1	T	]chrFoo:41]T	.	.
-  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:0;CIPOS=0,9;HOMLEN=9;HOMSEQ=ATCCTTCTT;BND_PAIR_COUNT=0;PAIR_COUNT=1
-  // Record-3:    chrFoo	11	MantaBND:0:0:1:0:0:0:0	C	C]chrBar:110]	0
+  // Following records are expected, in sorted VCF order:
+  // Record-1:    chrFoo	11	MantaBND:0:0:1:0:0:0:0	C	C]chrBar:110]	0
   // MinQUAL;NoPairSupport;SampleFT
   //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:1;CIPOS=0,9;HOMLEN=9;HOMSEQ=TATCACCCT;BND_DEPTH=3;MATE_BND_DEPTH=3
   //              GT:FT:GQ:PL:PR:SR	0/0:HomRef:48:0,0,0:0,0:0,0
+  // Record-2:    chrFoo	41	MantaBND:0:0:1:0:0:0:0	C	C[chrBar:66[	.	.
+  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:1;CIPOS=0,9;HOMLEN=9;HOMSEQ=TCCATGCAT;BND_PAIR_COUNT=0;PAIR_COUNT=1
+  // Record-3:    chrBar	66	MantaBND:0:0:1:0:0:0:1	T	]chrFoo:41]T	.	.
+  //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:0;CIPOS=0,9;HOMLEN=9;HOMSEQ=ATCCTTCTT;BND_PAIR_COUNT=0;PAIR_COUNT=1
   // Record-4:    chrBar	101	MantaBND:0:0:1:0:0:0:1	G	G]chrFoo:20]	0
   // MinQUAL;NoPairSupport;SampleFT
   //              SVTYPE=BND;MATEID=MantaBND:0:0:1:0:0:0:0;CIPOS=0,9;HOMLEN=9;HOMSEQ=CAGATGCCA;BND_DEPTH=3;MATE_BND_DEPTH=3
@@ -747,13 +747,13 @@ BOOST_AUTO_TEST_CASE(test_Somatic)
       if (count >= 1) {
         switch (count) {
         case 1:
-          BOOST_REQUIRE(line.find("C[chrBar:66[") != std::string::npos);
+          BOOST_REQUIRE(line.find("C]chrBar:110]") != std::string::npos);
           break;
         case 2:
-          BOOST_REQUIRE(line.find("]chrFoo:41]T") != std::string::npos);
+          BOOST_REQUIRE(line.find("C[chrBar:66[") != std::string::npos);
           break;
         case 3:
-          BOOST_REQUIRE(line.find("C]chrBar:110]") != std::string::npos);
+          BOOST_REQUIRE(line.find("]chrFoo:41]T") != std::string::npos);
           break;
         case 4:
           BOOST_REQUIRE(line.find("G]chrFoo:20]") != std::string::npos);
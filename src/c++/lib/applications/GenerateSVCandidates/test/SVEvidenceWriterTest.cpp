@@ -17,6 +17,7 @@
 //
 //
 
+#include "boost/filesystem.hpp"
 #include "boost/make_unique.hpp"
 #include "boost/test/unit_test.hpp"
 #include "manta/BamStreamerUtils.hpp"
@@ -64,6 +65,8 @@ private:
 
 BOOST_FIXTURE_TEST_SUITE(SVSupports_test_suite, BamStream)
 
+static const std::size_t maxRunMemoryBytes(1000000);
+
 // check the evidence bam whether datas are as expected. Need to verify the following two fields:
 // 1. Read ID
 // 2. ZM tag : SV information for that read
@@ -298,32 +301,32 @@ BOOST_AUTO_TEST_CASE(test_ProcessRecords)
 
   {
     // this code block forces bamWriter to flush at block end:
-    SynchronizedBamWriter bamWriter(bamFileName.c_str(), bamHeaderManager.get());
+    SortedBamWriter    bamWriter(bamFileName, bamHeaderManager.get(), maxRunMemoryBytes);
+    SortedBamRunBuffer bamRunBuffer(bamWriter);
     // Process the bam record and add ZM tag for all reads which are intersection to genomeInterval1
     SVEvidenceWriter::processBamRecords(
-        bamStream.operator*(), genomeInterval1, suppFragments.supportFrags, bamWriter);
+        bamStream.operator*(), genomeInterval1, suppFragments.supportFrags, bamRunBuffer);
+    bamRunBuffer.flush();
   }
 
-  // create bam index
-  const int indexStatus1 = bam_index_build(bamFileName.c_str(), 0);
-  // check whether .bai file for bam file is build successfully or not.
-  BOOST_REQUIRE(indexStatus1 >= 0);
+  // the bam index is built by bamWriter, check that it exists:
+  BOOST_REQUIRE(boost::filesystem::exists(bamFileName + ".bai"));
 
   // check the evidence bam for bamRecord1 as genomeInterval1 intersects with bamRecord1.
   checkEvidenceBam(genomeInterval1, bamFileName, "INS_1|PR", "bamRecord1");
 
   {
     // this code block forces bamWriter to flush at block end:
-    SynchronizedBamWriter bamWriter(bamFileName.c_str(), bamHeaderManager.get());
+    SortedBamWriter    bamWriter(bamFileName, bamHeaderManager.get(), maxRunMemoryBytes);
+    SortedBamRunBuffer bamRunBuffer(bamWriter);
     // Process the bam record and add ZM tag for all reads which are intersection to genomeInterval2
     SVEvidenceWriter::processBamRecords(
-        bamStream.operator*(), genomeInterval1, suppFragments.supportFrags, bamWriter);
+        bamStream.operator*(), genomeInterval1, suppFragments.supportFrags, bamRunBuffer);
+    bamRunBuffer.flush();
   }
 
-  // create bam index
-  const int indexStatus2 = bam_index_build(bamFileName.c_str(), 0);
-  // check whether .bai file for bam file is build successfully or not.
-  BOOST_REQUIRE(indexStatus2 >= 0);
+  // the bam index is built by bamWriter, check that it exists:
+  BOOST_REQUIRE(boost::filesystem::exists(bamFileName + ".bai"));
 
   // check the evidence bam for bamRecord2 as genomeInterval2 intersects with bamRecord2.
   checkEvidenceBam(genomeInterval2, bamFileName, "DEL_1|PR", "bamRecord2");
@@ -353,14 +356,14 @@ BOOST_AUTO_TEST_CASE(test_writeEvidenceBam)
 
   {
     // this code block forces bamWriter to flush at block end:
-    SynchronizedBamWriter bamWriter(bamFileName.c_str(), bamHeaderManager.get());
-    SVEvidenceWriter::writeSupportBam(bamStream, suppFragments, bamWriter);
+    SortedBamWriter    bamWriter(bamFileName, bamHeaderManager.get(), maxRunMemoryBytes);
+    SortedBamRunBuffer bamRunBuffer(bamWriter);
+    SVEvidenceWriter::writeSupportBam(bamStream, suppFragments, bamRunBuffer);
+    bamRunBuffer.flush();
   }
 
-  // create bam index
-  const int indexStatus = bam_index_build(bamFileName.c_str(), 0);
-  // check whether .bai file for bam file is build successfully or not.
-  BOOST_REQUIRE(indexStatus >= 0);
+  // the bam index is built by bamWriter, check that it exists:
+  BOOST_REQUIRE(boost::filesystem::exists(bamFileName + ".bai"));
 
   // check the evidence bam as mentioned in the doc in test_ProcessRecords
   checkEvidenceBam(genomeInterval1, bamFileName, "INS_1|PR", "bamRecord1");
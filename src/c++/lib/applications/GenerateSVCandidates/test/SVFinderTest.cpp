@@ -83,6 +83,8 @@ BOOST_AUTO_TEST_CASE(test_AddSVNodeRead)
   const bam_header_info           bamHeader(buildTestBamHeader());
   std::unique_ptr<SVLocusScanner> scanner(buildTestSVLocusScanner(bamHeader));
   SampleEvidenceCounts            eCounts;
+  SVLocusScannerReadAnalysis      readAnalysis;
+  std::vector<SVLocusEvidence>    locusEvidence;
 
   const unsigned                 defaultReadGroupIndex(0);
   const reference_contig_segment refSeq;
@@ -120,7 +122,9 @@ BOOST_AUTO_TEST_CASE(test_AddSVNodeRead)
       true,
       false,
       svDatagroup,
-      eCounts);
+      eCounts,
+      readAnalysis,
+      locusEvidence);
   BOOST_REQUIRE_EQUAL(svDatagroup.size(), 1u);
 
   // This read is part of the anomalous read pair although there is a large insertion,
@@ -147,7 +151,9 @@ BOOST_AUTO_TEST_CASE(test_AddSVNodeRead)
       true,
       false,
       svDatagroup,
-      eCounts);
+      eCounts,
+      readAnalysis,
+      locusEvidence);
   BOOST_REQUIRE_EQUAL(svDatagroup.size(), 1u);
 
   // test a read is overlapping with the locus node (mentioned above) when localnode's coordinate is
@@ -165,7 +171,9 @@ BOOST_AUTO_TEST_CASE(test_AddSVNodeRead)
       true,
       false,
       svDatagroup,
-      eCounts);
+      eCounts,
+      readAnalysis,
+      locusEvidence);
   BOOST_REQUIRE_EQUAL(svDatagroup.size(), 2u);
 }
 
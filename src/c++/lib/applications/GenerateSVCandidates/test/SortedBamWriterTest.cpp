@@ -0,0 +1,131 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/filesystem.hpp"
+#include "boost/test/unit_test.hpp"
+
+#include "htsapi/bam_streamer.hpp"
+#include "test/testAlignmentDataUtil.hpp"
+#include "test/testFileMakers.hpp"
+
+#include "SortedBamWriter.hpp"
+
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(SortedBamWriter_test_suite)
+
+/// Build records in an unsorted order, with some records sharing the same position
+static std::vector<bam_record> getUnsortedTestRecords()
+{
+  std::vector<bam_record> records(40);
+  for (unsigned recordIndex(0); recordIndex < records.size(); ++recordIndex) {
+    const int tid((recordIndex % 3) == 0 ? 1 : 0);
+    const int pos(100 + ((recordIndex * 37) % 11) * 10);
+    buildTestBamRecord(records[recordIndex], tid, pos, tid, pos + 200, 50, 15, "50M");
+    records[recordIndex].set_qname(("read" + std::to_string(recordIndex)).c_str());
+  }
+  return records;
+}
+
+/// Write \p records to a sorted bam file, using one run buffer on each of \p threadCount threads
+static void writeSortedBam(
+    const std::string&             bamFilename,
+    const std::vector<bam_record>& records,
+    const unsigned                 threadCount,
+    const std::size_t              maxRunMemoryBytes)
+{
+  const bam_header_info        bamHeader(buildTestBamHeader());
+  const HtslibBamHeaderManager bamHeaderManager(bamHeader.chrom_data);
+  SortedBamWriter              bamWriter(bamFilename, bamHeaderManager.get(), maxRunMemoryBytes);
+
+  std::vector<std::thread> threads;
+  for (unsigned threadIndex(0); threadIndex < threadCount; ++threadIndex) {
+    threads.emplace_back([&, threadIndex]() {
+      SortedBamRunBuffer bamRunBuffer(bamWriter);
+      for (unsigned recordIndex(threadIndex); recordIndex < records.size(); recordIndex += threadCount) {
+        bamRunBuffer.put_record(records[recordIndex].get_data());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  bamWriter.close();
+}
+
+/// Read the name of all records in \p bamFilename in file order, and check that the file is sorted
+static std::vector<std::string> readSortedBamQnames(const std::string& bamFilename)
+{
+  std::vector<std::string> qnames;
+  bam_streamer             bamStream(bamFilename.c_str(), nullptr);
+  int                      lastTid(0);
+  int                      lastPos(0);
+  while (bamStream.next()) {
+    const bam_record& record(*bamStream.get_record_ptr());
+    BOOST_REQUIRE((record.target_id() > lastTid) || (record.pos() >= lastPos));
+    BOOST_REQUIRE(record.target_id() >= lastTid);
+    lastTid = record.target_id();
+    lastPos = record.pos();
+    qnames.push_back(record.qname());
+  }
+  return qnames;
+}
+
+/// Test that records added from multiple threads, including records spilled to temporary files, are
+/// written to a single sorted and indexed bam file
+BOOST_AUTO_TEST_CASE(test_SortedBamWriterSpill)
+{
+  const std::vector<bam_record> records(getUnsortedTestRecords());
+  const BamFilenameMaker        bamFilenameMaker;
+  const std::string&            bamFilename(bamFilenameMaker.getFilename());
+
+  // A memory limit of one byte spills every record to its own temporary file:
+  writeSortedBam(bamFilename, records, 4, 1);
+
+  const std::vector<std::string> qnames(readSortedBamQnames(bamFilename));
+  BOOST_REQUIRE_EQUAL(qnames.size(), records.size());
+  BOOST_REQUIRE(boost::filesystem::exists(bamFilename + ".bai"));
+  BOOST_REQUIRE(!boost::filesystem::exists(bamFilename + ".tmp_run0.bam"));
+
+  // Test that the index can be used for a region query:
+  bam_streamer bamStream(bamFilename.c_str(), nullptr);
+  bamStream.resetRegion(1, 0, 1000);
+  unsigned regionRecordCount(0);
+  while (bamStream.next()) {
+    BOOST_REQUIRE_EQUAL(bamStream.get_record_ptr()->target_id(), 1);
+    regionRecordCount++;
+  }
+  BOOST_REQUIRE_EQUAL(regionRecordCount, 14u);
+}
+
+/// Test that the output record order does not depend on the thread count or run memory limit
+BOOST_AUTO_TEST_CASE(test_SortedBamWriterDeterminism)
+{
+  const std::vector<bam_record> records(getUnsortedTestRecords());
+  const BamFilenameMaker        bamFilenameMaker1;
+  const BamFilenameMaker        bamFilenameMaker2;
+  writeSortedBam(bamFilenameMaker1.getFilename(), records, 1, 1000000);
+  writeSortedBam(bamFilenameMaker2.getFilename(), records, 3, 1000);
+
+  const std::vector<std::string> qnames1(readSortedBamQnames(bamFilenameMaker1.getFilename()));
+  const std::vector<std::string> qnames2(readSortedBamQnames(bamFilenameMaker2.getFilename()));
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(qnames1.begin(), qnames1.end(), qnames2.begin(), qnames2.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
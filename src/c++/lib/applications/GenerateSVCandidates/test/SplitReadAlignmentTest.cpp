@@ -22,6 +22,7 @@
 ///
 
 #include <iostream>
+#include <random>
 
 #include "boost/test/unit_test.hpp"
 
@@ -427,4 +428,68 @@ BOOST_AUTO_TEST_CASE(test_Exception)
   BOOST_REQUIRE_EQUAL(alignmentInfo2.alignScore, 7);
 }
 
+// Test that the vectorized offset scan finds exactly the same alignment as the scalar scan, including the
+// likelihood value and the tie-breaking between offsets, over random queries, targets and breakend ranges.
+BOOST_AUTO_TEST_CASE(test_VectorizedScanMatchesScalar)
+{
+  CallOptionsShared optionsShared;
+  qscore_snp        qscoreSnp(optionsShared.snpPrior);
+
+  std::mt19937                       randGen(42);
+  std::uniform_int_distribution<int> baseDist(0, 19);
+  std::uniform_int_distribution<int> qualDist(0, 45);
+
+  // mostly repetitive sequence with a few Ns, to create likelihood ties between offsets:
+  auto randomBase = [&]() {
+    static const char bases[] = "ACACACACACGGTTTTTTTN";
+    return bases[baseDist(randGen)];
+  };
+
+  for (unsigned testIndex(0); testIndex < 500; ++testIndex) {
+    const unsigned querySize(std::uniform_int_distribution<unsigned>(10, 150)(randGen));
+    const unsigned targetSize(querySize + std::uniform_int_distribution<unsigned>(1, 400)(randGen));
+
+    std::string targetSeq;
+    for (unsigned i(0); i < targetSize; ++i) targetSeq.push_back(randomBase());
+
+    // sample the query from the target with some mutations:
+    const unsigned queryStart(std::uniform_int_distribution<unsigned>(0, targetSize - querySize)(randGen));
+    std::string    querySeq(targetSeq.substr(queryStart, querySize));
+    for (unsigned i(0); i < querySize; ++i) {
+      if (baseDist(randGen) == 0) querySeq[i] = randomBase();
+    }
+
+    std::vector<uint8_t> qual(querySize);
+    for (unsigned i(0); i < querySize; ++i) qual[i] = qualDist(randGen);
+
+    const int        bpBegin(std::uniform_int_distribution<int>(0, targetSize - 1)(randGen));
+    const int        bpEnd(bpBegin + std::uniform_int_distribution<int>(0, 5)(randGen));
+    known_pos_range2 bpRange(bpBegin, bpEnd);
+    const unsigned   flankScoreSize(std::uniform_int_distribution<unsigned>(0, 60)(randGen));
+
+    const SplitReadQuery  query(querySeq, qscoreSnp, qual.data());
+    const SplitReadTarget target(targetSeq);
+
+    SRAlignmentInfo scalarAlignment;
+    SRAlignmentInfo vectorAlignment;
+    try {
+      splitReadAligner(flankScoreSize, query, target, bpRange, scalarAlignment, false);
+    } catch (const illumina::common::GeneralException&) {
+      BOOST_CHECK_THROW(
+          splitReadAligner(flankScoreSize, query, target, bpRange, vectorAlignment, true),
+          illumina::common::GeneralException);
+      continue;
+    }
+    splitReadAligner(flankScoreSize, query, target, bpRange, vectorAlignment, true);
+
+    BOOST_REQUIRE_EQUAL(vectorAlignment.alignPos, scalarAlignment.alignPos);
+    BOOST_REQUIRE_EQUAL(vectorAlignment.alignLnLhood, scalarAlignment.alignLnLhood);
+    BOOST_REQUIRE_EQUAL(vectorAlignment.leftSize, scalarAlignment.leftSize);
+    BOOST_REQUIRE_EQUAL(vectorAlignment.homSize, scalarAlignment.homSize);
+    BOOST_REQUIRE_EQUAL(vectorAlignment.rightSize, scalarAlignment.rightSize);
+    BOOST_REQUIRE_EQUAL(vectorAlignment.alignScore, scalarAlignment.alignScore);
+    BOOST_REQUIRE_EQUAL(vectorAlignment.evidence, scalarAlignment.evidence);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
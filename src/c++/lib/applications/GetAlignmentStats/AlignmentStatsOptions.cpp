@@ -49,6 +49,14 @@ static bool parseOptions(
   if (parseOptions(vm, opt.alignFileOpt, errorMsg)) return true;
   if (checkAndStandardizeRequiredInputFilePath(opt.referenceFilename, "reference fasta", errorMsg))
     return true;
+  if (opt.outputFilename.empty() && opt.outputBinaryFilename.empty()) {
+    errorMsg = "Must specify at least one of the XML or binary stats output files";
+    return true;
+  }
+  if (opt.workerThreadCount == 0) {
+    errorMsg = "Thread count must be at least 1";
+    return true;
+  }
   return false;
 }
 
@@ -61,11 +69,15 @@ void parseAlignmentStatsOptions(
   // clang-format off
   req.add_options()
   ("output-file", po::value(&opt.outputFilename),
-   "write stats to filename (default: stdout)")
+   "write stats to filename in XML format")
+  ("output-binary-file", po::value(&opt.outputBinaryFilename),
+   "write stats to filename in binary format, which is faster to load for SV calling")
   ("ref", po::value(&opt.referenceFilename),
    "fasta reference sequence (required)")
   ("default-stats-file", po::value(&opt.defaultStatsFilename),
    "file containing default stats to use if minimum number of high-confidence read pairs cannot be reached for stats estimation (default: None)")
+  ("threads", po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),
+   "number of threads used to sample chunks of each alignment file")
   ;
   // clang-format on
 
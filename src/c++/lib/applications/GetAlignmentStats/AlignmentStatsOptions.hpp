@@ -27,7 +27,12 @@ struct AlignmentStatsOptions {
 
   std::string referenceFilename;
   std::string outputFilename;
+  std::string outputBinaryFilename;
   std::string defaultStatsFilename;
+
+  /// Number of threads used to sample alignment file chunks. Results are reproducible for a given thread
+  /// count, but may differ slightly between thread counts.
+  unsigned workerThreadCount = 1;
 };
 
 void parseAlignmentStatsOptions(
@@ -43,10 +43,16 @@ static void runAlignmentStats(const AlignmentStatsOptions& opt)
 
   for (const std::string& alignmentFilename : opt.alignFileOpt.alignmentFilenames) {
     extractReadGroupStatsFromAlignmentFile(
-        opt.referenceFilename, alignmentFilename, opt.defaultStatsFilename, rstats);
+        opt.referenceFilename,
+        alignmentFilename,
+        opt.defaultStatsFilename,
+        opt.workerThreadCount,
+        opt.alignFileOpt.decompressThreadCount,
+        rstats);
   }
 
-  rstats.save(opt.outputFilename.c_str());
+  if (!opt.outputFilename.empty()) rstats.save(opt.outputFilename.c_str());
+  if (!opt.outputBinaryFilename.empty()) rstats.saveBinary(opt.outputBinaryFilename.c_str());
 }
 
 void GetAlignmentStats::runInternal(int argc, char* argv[]) const
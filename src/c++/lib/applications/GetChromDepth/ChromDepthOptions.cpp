@@ -27,6 +27,7 @@
 
 #include <iostream>
 
+typedef std::vector<std::string> align_files_t;
 typedef std::vector<std::string> chroms_t;
 
 static void usage(
@@ -47,7 +48,18 @@ static void usage(
 static bool parseOptions(
     const boost::program_options::variables_map& vm, ChromDepthOptions& opt, std::string& errorMsg)
 {
-  if (checkAndStandardizeRequiredInputFilePath(opt.alignmentFilename, "alignment", errorMsg)) return true;
+  if (vm.count("align-file")) {
+    opt.alignmentFilenames = (boost::any_cast<align_files_t>(vm["align-file"].value()));
+  }
+
+  if (opt.alignmentFilenames.empty()) {
+    errorMsg = "Need at least one alignment file";
+    return true;
+  }
+
+  for (std::string& alignmentFilename : opt.alignmentFilenames) {
+    if (checkAndStandardizeRequiredInputFilePath(alignmentFilename, "alignment", errorMsg)) return true;
+  }
   if (checkAndStandardizeRequiredInputFilePath(opt.referenceFilename, "reference fasta", errorMsg))
     return true;
 
@@ -66,6 +78,11 @@ static bool parseOptions(
     return true;
   }
 
+  if (opt.workerThreadCount == 0) {
+    errorMsg = "Thread count must be at least 1";
+    return true;
+  }
+
   return false;
 }
 
@@ -75,14 +92,18 @@ void parseChromDepthOptions(const illumina::Program& prog, int argc, char* argv[
   po::options_description req("configuration");
   // clang-format off
   req.add_options()
-  ("align-file", po::value(&opt.alignmentFilename),
-   "alignment file in BAM or CRAM format")
+  ("align-file", po::value<align_files_t>(),
+   "alignment file in BAM or CRAM format. May be supplied more than once, depth is summed over all files. At least one entry required.")
   ("chrom", po::value<chroms_t>(),
    "chromosome name. May be supplied more than once. At least one entry required.")
   ("output-file", po::value(&opt.outputFilename),
    "write stats to filename (default: stdout)")
   ("ref", po::value(&opt.referenceFilename),
    "fasta reference sequence (required)")
+  ("threads", po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),
+   "number of threads used to estimate chromosome depth")
+  ("decompress-threads", po::value(&opt.decompressThreadCount)->default_value(opt.decompressThreadCount),
+   "number of additional threads for BAM/CRAM decompression and decoding (0 decodes on the reading thread)")
   ;
   // clang-format on
 
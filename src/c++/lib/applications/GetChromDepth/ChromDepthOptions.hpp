@@ -25,11 +25,17 @@
 #include <vector>
 
 struct ChromDepthOptions {
-  std::string              alignmentFilename;
+  std::vector<std::string> alignmentFilenames;
   std::vector<std::string> chromNames;
 
   std::string referenceFilename;
   std::string outputFilename;
+
+  /// Number of worker threads used to estimate chromosome depth
+  unsigned workerThreadCount = 1;
+
+  /// Size of the htslib thread pool used to decode the alignment files
+  unsigned decompressThreadCount = 0;
 };
 
 void parseChromDepthOptions(const illumina::Program& prog, int argc, char* argv[], ChromDepthOptions& opt);
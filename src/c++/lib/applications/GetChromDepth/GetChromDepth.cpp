@@ -36,18 +36,19 @@ static void getChromDepth(const ChromDepthOptions& opt)
     OutStream outs(opt.outputFilename);
   }
 
-  std::vector<double> chromDepth;
-  for (const std::string& chromName : opt.chromNames) {
-    chromDepth.push_back(
-        readChromDepthFromAlignment(opt.referenceFilename, opt.alignmentFilename, chromName));
-  }
+  const std::vector<double> chromDepth(readChromDepthFromAlignments(
+      opt.referenceFilename,
+      opt.alignmentFilenames,
+      opt.chromNames,
+      opt.workerThreadCount,
+      opt.decompressThreadCount));
 
   OutStream     outs(opt.outputFilename);
   std::ostream& os(outs.getStream());
 
   const unsigned chromCount(opt.chromNames.size());
   for (unsigned chromIndex(0); chromIndex < chromCount; ++chromIndex) {
-    os << opt.chromNames[chromIndex] << "\t" << std::fixed << std::setprecision(2) << chromDepth[chromIndex]
+    os << opt.chromNames[chromIndex] << "\t" << std::fixed << std::setprecision(3) << chromDepth[chromIndex]
        << "\n";
   }
 }
@@ -33,7 +33,12 @@
 #include "manta/ReadFilter.hpp"
 #include "manta/SVLocusScanner.hpp"
 
+#include "ctpl_stl.h"
+
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <sstream>
 
 //#define DEBUG_DPS
@@ -64,7 +69,8 @@ struct DepthTracker {
       _isRegionInit = true;
     }
 
-    for (; _maxPos < pos; ++_maxPos) flushPos(_maxPos);
+    if (_maxPos < pos) flushPosRange(_maxPos, pos);
+    _maxPos = std::max(_maxPos, pos);
     _depth.inc(pos, readSize);
     _count++;
   }
@@ -75,11 +81,21 @@ struct DepthTracker {
 
 private:
   // flush position from depth tracker
-  void flushPos(const pos_t pos)
+  void flushPos(const pos_t pos) { flushPosRange(pos, pos + 1); }
+
+  /// flush all positions in [beginPos,endPos) from depth tracker
+  ///
+  /// All positions in the same compressed depth bin have the same depth value, so each bin is added to the
+  /// median tracker with a single call.
+  void flushPosRange(pos_t beginPos, const pos_t endPos)
   {
-    const unsigned depth(_depth.val(pos));
-    _mtrack.addObs(depth);
-    _depth.clear_pos(pos);
+    const pos_t binSize(_depth.compression_factor());
+    while (beginPos < endPos) {
+      const pos_t binEndPos(std::min(((beginPos / binSize) + 1) * binSize, endPos));
+      _mtrack.addObs(_depth.val(beginPos), (binEndPos - beginPos));
+      _depth.clear_pos(binEndPos - 1);
+      beginPos = binEndPos;
+    }
   }
 
   /// track depth for the purpose of filtering high-depth regions
@@ -272,26 +288,15 @@ static void getChromSegments(
   }
 }
 
-double readChromDepthFromAlignment(
-    const std::string& referenceFile, const std::string& alignmentFile, const std::string& chromName)
+/// Estimate the depth of a single chromosome from an alignment file stream
+///
+/// \param[in,out] read_stream Alignment file stream, the stream region is reset by this function
+/// \param[in] chromIndex Index of the chromosome in the alignment file header
+///
+/// \return average chromosome depth
+static double readChromDepthFromStream(
+    bam_streamer& read_stream, const bam_header_info& bamHeader, const int32_t chromIndex)
 {
-  bam_streamer read_stream(alignmentFile.c_str(), referenceFile.c_str());
-
-  const bam_hdr_t&      header(read_stream.get_header());
-  const bam_header_info bamHeader(header);
-
-  const auto& chromToIndex(bamHeader.chrom_to_index);
-  const auto  chromIter(chromToIndex.find(chromName));
-  if (chromIter == chromToIndex.end()) {
-    using namespace illumina::common;
-
-    std::ostringstream oss;
-    oss << "Can't find chromosome name '" << chromName << "' in BAM/CRAM file: '" << alignmentFile << "'";
-    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
-  }
-
-  const int32_t chromIndex(chromIter->second);
-
   const unsigned        chromSize(bamHeader.chrom_data[chromIndex].length);
   unsigned              segmentSize(2000000);
   std::vector<unsigned> segmentStartPos;
@@ -408,3 +413,114 @@ double readChromDepthFromAlignment(
 
   return cdTracker.getDepth();
 }
+
+/// Find the index of each chromosome name in the alignment file header
+///
+/// An exception is thrown if any chromosome name is not found.
+static void getChromIndices(
+    const bam_header_info&          bamHeader,
+    const std::string&              alignmentFile,
+    const std::vector<std::string>& chromNames,
+    std::vector<int32_t>&           chromIndices)
+{
+  chromIndices.clear();
+  const auto& chromToIndex(bamHeader.chrom_to_index);
+  for (const std::string& chromName : chromNames) {
+    const auto chromIter(chromToIndex.find(chromName));
+    if (chromIter == chromToIndex.end()) {
+      using namespace illumina::common;
+
+      std::ostringstream oss;
+      oss << "Can't find chromosome name '" << chromName << "' in BAM/CRAM file: '" << alignmentFile << "'";
+      BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+    chromIndices.push_back(chromIter->second);
+  }
+}
+
+std::vector<double> readChromDepthFromAlignments(
+    const std::string&              referenceFile,
+    const std::vector<std::string>& alignmentFiles,
+    const std::vector<std::string>& chromNames,
+    const unsigned                  threadCount,
+    const unsigned                  decompressThreadCount)
+{
+  assert(threadCount > 0);
+
+  const unsigned alignmentFileCount(alignmentFiles.size());
+  const unsigned chromCount(chromNames.size());
+
+  // Resolve chromosome names for every alignment file up front, so that any missing chromosome is reported
+  // before depth estimation starts:
+  std::vector<bam_header_info>      bamHeaders;
+  std::vector<std::vector<int32_t>> chromIndices(alignmentFileCount);
+  for (unsigned fileIndex(0); fileIndex < alignmentFileCount; ++fileIndex) {
+    const bam_streamer read_stream(alignmentFiles[fileIndex].c_str(), referenceFile.c_str());
+    bamHeaders.emplace_back(read_stream.get_header());
+    getChromIndices(bamHeaders.back(), alignmentFiles[fileIndex], chromNames, chromIndices[fileIndex]);
+  }
+
+  // Each (alignment file, chromosome) pair is an independent work item. Items are submitted in order of
+  // decreasing chromosome size so that the largest chromosomes don't finish last on a single thread:
+  std::vector<std::pair<unsigned, unsigned>> workItems;
+  for (unsigned fileIndex(0); fileIndex < alignmentFileCount; ++fileIndex) {
+    for (unsigned chromIndex(0); chromIndex < chromCount; ++chromIndex) {
+      workItems.emplace_back(fileIndex, chromIndex);
+    }
+  }
+  const auto getChromSize = [&](const std::pair<unsigned, unsigned>& workItem) {
+    return bamHeaders[workItem.first].chrom_data[chromIndices[workItem.first][workItem.second]].length;
+  };
+  std::stable_sort(
+      workItems.begin(),
+      workItems.end(),
+      [&](const std::pair<unsigned, unsigned>& a, const std::pair<unsigned, unsigned>& b) {
+        return (getChromSize(a) > getChromSize(b));
+      });
+
+  // Alignment file streams are opened lazily by each worker thread and reused for all of its work items:
+  std::vector<std::vector<std::unique_ptr<bam_streamer>>> threadStreams(threadCount);
+  for (auto& streams : threadStreams) streams.resize(alignmentFileCount);
+
+  std::vector<std::vector<double>> fileChromDepth(alignmentFileCount, std::vector<double>(chromCount, 0));
+  {
+    ctpl::thread_pool pool(threadCount);
+    std::atomic<bool> isWorkerThreadException(false);
+
+    std::vector<std::future<void>> workItemReturnValues;
+    for (const auto& workItem : workItems) {
+      workItemReturnValues.push_back(pool.push([&, workItem](int threadId) {
+        if (isWorkerThreadException.load()) return;
+        try {
+          const unsigned                 fileIndex(workItem.first);
+          std::unique_ptr<bam_streamer>& streamPtr(threadStreams[threadId][fileIndex]);
+          if (not streamPtr) {
+            streamPtr.reset(new bam_streamer(alignmentFiles[fileIndex].c_str(), referenceFile.c_str()));
+            streamPtr->setThreadPool(hts_thread_pool::getShared(decompressThreadCount));
+          }
+          fileChromDepth[fileIndex][workItem.second] = readChromDepthFromStream(
+              *streamPtr, bamHeaders[fileIndex], chromIndices[fileIndex][workItem.second]);
+        } catch (...) {
+          isWorkerThreadException = true;
+          throw;
+        }
+      }));
+    }
+
+    pool.stop(true);
+
+    // Rethrow any worker thread exceptions:
+    for (auto& workItemReturnValue : workItemReturnValues) {
+      workItemReturnValue.get();
+    }
+  }
+
+  // Sum depth over all alignment files in a fixed order, so that the result does not depend on thread count:
+  std::vector<double> chromDepth(chromCount, 0);
+  for (unsigned fileIndex(0); fileIndex < alignmentFileCount; ++fileIndex) {
+    for (unsigned chromIndex(0); chromIndex < chromCount; ++chromIndex) {
+      chromDepth[chromIndex] += fileChromDepth[fileIndex][chromIndex];
+    }
+  }
+  return chromDepth;
+}
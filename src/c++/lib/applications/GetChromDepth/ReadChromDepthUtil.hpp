@@ -24,9 +24,22 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 /// Fast chrom depth estimator for BAM/CRAM files
 ///
-/// return average chromosome depth
-double readChromDepthFromAlignment(
-    const std::string& referenceFile, const std::string& alignmentFile, const std::string& chromName);
+/// Depth is estimated independently for every chromosome of every alignment file, on a pool of worker
+/// threads. Within each chromosome, reads are sampled from a set of spaced chunks until the median depth
+/// converges.
+///
+/// \param threadCount Number of worker threads used to estimate chromosome depth, must be at least 1
+/// \param decompressThreadCount Size of the htslib thread pool used to decode the alignment files, zero
+/// decodes each file on the worker thread reading it
+///
+/// return average depth of each chromosome in \p chromNames, summed over all alignment files
+std::vector<double> readChromDepthFromAlignments(
+    const std::string&              referenceFile,
+    const std::vector<std::string>& alignmentFiles,
+    const std::vector<std::string>& chromNames,
+    const unsigned                  threadCount,
+    const unsigned                  decompressThreadCount);
@@ -42,7 +42,8 @@ static void mergeAlignmentStats(const MergeAlignmentStatsOptions& opt)
     all_rstats.merge(rstats);
   }
 
-  all_rstats.save(opt.outputFilename.c_str());
+  if (!opt.outputFilename.empty()) all_rstats.save(opt.outputFilename.c_str());
+  if (!opt.outputBinaryFilename.empty()) all_rstats.saveBinary(opt.outputBinaryFilename.c_str());
 }
 
 void MergeAlignmentStats::runInternal(int argc, char* argv[]) const
@@ -56,7 +56,9 @@ void parseMergeAlignmentStatsOptions(
   ("align-stats-file", po::value<files_t>(),
    "stats output of 'GetAlignmentStats' (may be specified multiple times)")
   ("output-file", po::value(&opt.outputFilename),
-   "write merged stats to filename (default: stdout)");
+   "write merged stats to filename in XML format")
+  ("output-binary-file", po::value(&opt.outputBinaryFilename),
+   "write merged stats to filename in binary format, which is faster to load for SV calling");
   // clang-format on
 
   po::options_description help("help");
@@ -116,6 +118,10 @@ void parseMergeAlignmentStatsOptions(
         nameCheck.insert(afile);
       }
     }
+
+    if (errorMsg.empty() && opt.outputFilename.empty() && opt.outputBinaryFilename.empty()) {
+      errorMsg = "Must specify at least one of the XML or binary stats output files";
+    }
   }
 
   if (!errorMsg.empty()) {
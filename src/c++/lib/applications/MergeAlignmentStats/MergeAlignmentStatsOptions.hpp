@@ -26,6 +26,7 @@
 struct MergeAlignmentStatsOptions {
   std::vector<std::string> statsFiles;
   std::string              outputFilename;
+  std::string              outputBinaryFilename;
 };
 
 void parseMergeAlignmentStatsOptions(
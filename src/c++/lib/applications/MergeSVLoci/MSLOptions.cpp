@@ -57,6 +57,11 @@ void parseMSLOptions(const illumina::Program& prog, int argc, char* argv[], MSLO
    "merged output sv locus graph file")
   ("verbose", po::value(&opt.isVerbose)->zero_tokens(),
    "provide additional progress logging")
+  ("flat-output", po::value(&opt.isFlatOutput)->zero_tokens(),
+   "write the merged graph in the flat graph file format, which loads faster but is only readable by "
+   "graph consumers of this version or later")
+  ("threads", po::value(&opt.workerThreadCount)->default_value(opt.workerThreadCount),
+   "number of threads to use for loading and merging graph files")
   ;
   // clang-format om
 
@@ -140,5 +145,10 @@ void parseMSLOptions(const illumina::Program& prog, int argc, char* argv[], MSLO
     {
         usage(log_os,prog,visible, "Must specify a graph output file");
     }
+
+    if (opt.workerThreadCount == 0)
+    {
+        usage(log_os,prog,visible, "Thread count must be at least 1");
+    }
 }
 
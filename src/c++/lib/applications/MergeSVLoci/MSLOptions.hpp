@@ -29,12 +29,18 @@
 #include <vector>
 
 struct MSLOptions {
-  MSLOptions() : isVerbose(false) {}
+  MSLOptions() : isVerbose(false), isFlatOutput(false), workerThreadCount(1) {}
 
   std::vector<std::string> graphFilename;
   std::string              graphFilenameList;
   std::string              outputFilename;
   bool                     isVerbose;
+
+  /// If true, write the merged graph in the flat file format instead of the serialized graph format
+  bool isFlatOutput;
+
+  /// Number of threads used to load and merge input graphs
+  unsigned workerThreadCount;
 };
 
 void parseMSLOptions(const illumina::Program& prog, int argc, char* argv[], MSLOptions& opt);
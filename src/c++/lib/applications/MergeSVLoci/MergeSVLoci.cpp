@@ -27,52 +27,79 @@
 #include "blt_util/log.hpp"
 #include "common/OutStream.hpp"
 #include "svgraph/SVLocusSet.hpp"
+#include "svgraph/SVLocusSetMergeUtil.hpp"
+
+#include <vector>
 
 static void runMSL(const MSLOptions& opt)
 {
   TimeTracker timer;
   timer.resume();
+
   {
     // early test that we have permission to write to output file
     OutStream outs(opt.outputFilename);
   }
 
   const unsigned graphFileCount(opt.graphFilename.size());
+
   // This should already be enforced by the arg parsing interface:
   assert(graphFileCount > 0);
 
+  // Load and merge input graphs pairwise in a balanced tree, holding at most one block of workerThreadCount
+  // input graphs plus one partially merged graph per tree level in memory. The result depends only on the
+  // order of the input files, so it is the same for any thread count:
   if (opt.isVerbose) {
-    log_os << "INFO: Initializing from file: '" << opt.graphFilename[0] << "'\n";
+    log_os << "INFO: Merging " << graphFileCount << " graph files\n";
   }
 
-  SVLocusSet mergedSet(opt.graphFilename[0].c_str());
+  const auto loadGraph = [&opt](const unsigned graphFileIndex) {
+    return std::make_shared<SVLocusSet>(opt.graphFilename[graphFileIndex].c_str());
+  };
 
-  if (opt.isVerbose) {
-    log_os << "INFO: Finished initializing from file: '" << opt.graphFilename[0] << "'\n";
-  }
-
-  for (unsigned graphFileIndex(1); graphFileIndex < graphFileCount; ++graphFileIndex) {
-    const std::string& graphFile(opt.graphFilename[graphFileIndex]);
-
-    if (opt.isVerbose) {
-      log_os << "INFO: Merging file: '" << graphFile << "'\n";
-    }
+  std::vector<CpuTimes>             levelTimes;
+  const std::shared_ptr<SVLocusSet> mergedSetPtr(
+      mergeLocusSetStreamInTree(graphFileCount, loadGraph, opt.workerThreadCount, &levelTimes));
+  SVLocusSet& mergedSet(*mergedSetPtr);
 
-    const SVLocusSet inputSet(graphFile.c_str());
-    mergedSet.merge(inputSet);
+  timer.stop();
 
+  // Report the merge time of each tree level, and the remaining time spent loading the input graphs:
+  CpuTimes       loadTimes(timer.getTimes());
+  const unsigned levelCount(levelTimes.size());
+  for (unsigned levelIndex(0); levelIndex < levelCount; ++levelIndex) {
+    mergedSet.addMergeTime(levelTimes[levelIndex]);
+    loadTimes.difference(levelTimes[levelIndex]);
     if (opt.isVerbose) {
-      log_os << "INFO: Finished merging file: '" << graphFile << "'\n";
+      log_os << "INFO: Finished merging graph tree level " << (levelIndex + 1) << " of " << levelCount
+             << ". Time: ";
+      levelTimes[levelIndex].reportSec(log_os);
+      log_os << "\n";
     }
   }
+  mergedSet.addMergeTime(loadTimes);
+  if (opt.isVerbose) {
+    log_os << "INFO: Finished loading graph files. Time: ";
+    loadTimes.reportSec(log_os);
+    log_os << "\n";
+  }
+
+  timer.clear();
+  timer.resume();
 
   mergedSet.finalize();
   if (opt.isVerbose) {
     log_os << "INFO: Finished cleaning merged graph.\n";
   }
+
   timer.stop();
   mergedSet.addMergeTime(timer.getTimes());
-  mergedSet.save(opt.outputFilename.c_str());
+
+  if (opt.isFlatOutput) {
+    mergedSet.saveFlat(opt.outputFilename.c_str());
+  } else {
+    mergedSet.save(opt.outputFilename.c_str());
+  }
 }
 
 void MergeSVLoci::runInternal(int argc, char* argv[]) const
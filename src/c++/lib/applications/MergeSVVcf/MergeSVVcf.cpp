@@ -0,0 +1,79 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "MergeSVVcf.hpp"
+#include "MergeSVVcfOptions.hpp"
+#include "SVVcfMerger.hpp"
+
+#include "blt_util/blt_exception.hpp"
+
+#include "htslib/bgzf.h"
+#include "htslib/tbx.h"
+
+#include <iostream>
+#include <sstream>
+
+static void writeFileError(const std::string& outputFilename)
+{
+  std::ostringstream oss;
+  oss << "Failed to write to bgzip output file: '" << outputFilename << "'";
+  throw blt_exception(oss.str().c_str());
+}
+
+/// Write the merged vcf in bgzip format and build its tabix index
+static void mergeToIndexedFile(const MergeSVVcfOptions& opt)
+{
+  BGZF* bgzfPtr(bgzf_open(opt.outputFilename.c_str(), "w"));
+  if (bgzfPtr == nullptr) writeFileError(opt.outputFilename);
+
+  try {
+    mergeSortedSVVcfFiles(opt.vcfFilenames, opt.isPrintAll, [&](const std::string& line) {
+      if (bgzf_write(bgzfPtr, line.data(), line.size()) < 0) writeFileError(opt.outputFilename);
+    });
+  } catch (...) {
+    bgzf_close(bgzfPtr);
+    throw;
+  }
+  if (bgzf_close(bgzfPtr) != 0) writeFileError(opt.outputFilename);
+
+  if (tbx_index_build(opt.outputFilename.c_str(), 0, &tbx_conf_vcf) != 0) {
+    std::ostringstream oss;
+    oss << "Failed to build tabix index for vcf file: '" << opt.outputFilename << "'";
+    throw blt_exception(oss.str().c_str());
+  }
+}
+
+static void runMergeSVVcf(const MergeSVVcfOptions& opt)
+{
+  if (opt.outputFilename.empty()) {
+    mergeSortedSVVcfFiles(
+        opt.vcfFilenames, opt.isPrintAll, [](const std::string& line) { std::cout << line; });
+    std::cout.flush();
+  } else {
+    mergeToIndexedFile(opt);
+  }
+}
+
+void MergeSVVcf::runInternal(int argc, char* argv[]) const
+{
+  MergeSVVcfOptions opt;
+
+  parseMergeSVVcfOptions(*this, argc, argv, opt);
+  runMergeSVVcf(opt);
+}
@@ -0,0 +1,123 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "MergeSVVcfOptions.hpp"
+
+#include "blt_util/log.hpp"
+#include "common/ProgramUtil.hpp"
+
+#include "boost/filesystem.hpp"
+#include "boost/program_options.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+static void usage(
+    std::ostream&                                      os,
+    const illumina::Program&                           prog,
+    const boost::program_options::options_description& visible,
+    const char*                                        msg = nullptr)
+{
+  usage(os, prog, visible, "merge sorted SV vcf files", "", msg);
+}
+
+void parseMergeSVVcfOptions(const illumina::Program& prog, int argc, char* argv[], MergeSVVcfOptions& opt)
+{
+  namespace po = boost::program_options;
+  po::options_description req("configuration");
+  // clang-format off
+  req.add_options()
+  ("vcf", po::value(&opt.vcfFilenames),
+   "input sorted vcf file (may be specified multiple times)")
+  ("vcf-list", po::value(&opt.vcfFilenameList),
+   "file listing all input sorted vcf files, one filename per line (specified only once)")
+  ("output-file", po::value(&opt.outputFilename),
+   "write merged vcf to a bgzip compressed and tabix indexed file (default: uncompressed vcf to stdout)")
+  ("print-all", po::value(&opt.isPrintAll)->zero_tokens(),
+   "write all vcf records without removing duplicates");
+  // clang-format on
+
+  po::options_description help("help");
+  help.add_options()("help,h", "print this message");
+
+  po::options_description visible("options");
+  visible.add(req).add(help);
+
+  bool              po_parse_fail(false);
+  po::variables_map vm;
+  try {
+    po::store(
+        po::parse_command_line(
+            argc, argv, visible, po::command_line_style::unix_style ^ po::command_line_style::allow_short),
+        vm);
+    po::notify(vm);
+  } catch (const boost::program_options::error& e) {
+    // todo:: find out what is the more specific exception class thrown by program options
+    log_os << "\nERROR: Exception thrown by option parser: " << e.what() << "\n";
+    po_parse_fail = true;
+  }
+
+  if ((argc <= 1) || (vm.count("help")) || po_parse_fail) {
+    usage(log_os, prog, visible);
+  }
+
+  // read vcf file names from a user-defined file
+  if (!opt.vcfFilenameList.empty()) {
+    std::ifstream listFile(opt.vcfFilenameList.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!listFile.good()) {
+      std::ostringstream oss;
+      oss << "VCF file list does not exist: '" << opt.vcfFilenameList << "'";
+      usage(log_os, prog, visible, oss.str().c_str());
+    }
+
+    std::string lineIn;
+    while (getline(listFile, lineIn)) {
+      if (lineIn.size() == 0) continue;
+      const unsigned sm1(lineIn.size() - 1);
+      if (lineIn[sm1] == '\r') {
+        if (sm1 == 0) continue;
+        lineIn.resize(sm1);
+      }
+      opt.vcfFilenames.push_back(lineIn);
+    }
+  }
+
+  // fast check of config state:
+  if (opt.vcfFilenames.empty()) {
+    usage(log_os, prog, visible, "Must specify at least 1 input vcf file");
+  }
+
+  std::set<std::string> dupCheck;
+  for (const std::string& vcfFilename : opt.vcfFilenames) {
+    if (!boost::filesystem::exists(vcfFilename)) {
+      std::ostringstream oss;
+      oss << "VCF file does not exist: '" << vcfFilename << "'";
+      usage(log_os, prog, visible, oss.str().c_str());
+    }
+
+    if (dupCheck.find(vcfFilename) != dupCheck.end()) {
+      std::ostringstream oss;
+      oss << "Same VCF file submitted multiple times: '" << vcfFilename << "'";
+      usage(log_os, prog, visible, oss.str().c_str());
+    }
+    dupCheck.insert(vcfFilename);
+  }
+}
@@ -0,0 +1,39 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#pragma once
+
+#include "common/Program.hpp"
+
+#include <string>
+#include <vector>
+
+struct MergeSVVcfOptions {
+  std::vector<std::string> vcfFilenames;
+  std::string              vcfFilenameList;
+
+  /// If non-empty, write the merged VCF to this file in bgzip format with a tabix index. Otherwise write
+  /// uncompressed VCF to stdout.
+  std::string outputFilename;
+
+  /// If true, write all VCF records without removing duplicates
+  bool isPrintAll = false;
+};
+
+void parseMergeSVVcfOptions(const illumina::Program& prog, int argc, char* argv[], MergeSVVcfOptions& opt);
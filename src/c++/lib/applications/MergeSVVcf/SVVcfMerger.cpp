@@ -0,0 +1,296 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "SVVcfMerger.hpp"
+
+#include "common/Exceptions.hpp"
+#include "format/SVVcfRecord.hpp"
+
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <unordered_set>
+
+namespace {
+
+/// Read the header lines and contig order of a VCF file
+void readVcfHeader(
+    const std::string& vcfFile, std::vector<std::string>& header, SVVcfRecord::contig_index_t& contigIndex)
+{
+  using namespace illumina::common;
+
+  std::ifstream is(vcfFile.c_str());
+  if (!is) {
+    std::ostringstream oss;
+    oss << "Can't open VCF file: '" << vcfFile << "'";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || (line[0] != '#')) break;
+    addVcfHeaderContig(line, contigIndex);
+    header.push_back(line + '\n');
+  }
+}
+
+/// Read the records of one sorted VCF file, skipping all header lines
+struct SortedVcfReader {
+  SortedVcfReader(const std::string& vcfFile, const SVVcfRecord::contig_index_t& contigIndex)
+    : _vcfFile(vcfFile), _contigIndex(contigIndex), _is(vcfFile.c_str())
+  {
+    using namespace illumina::common;
+
+    if (!_is) {
+      std::ostringstream oss;
+      oss << "Can't open VCF file: '" << vcfFile << "'";
+      BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+    }
+  }
+
+  /// Advance to the next record
+  ///
+  /// \return False if there are no more records in the file
+  bool next()
+  {
+    using namespace illumina::common;
+
+    while (std::getline(_is, _line)) {
+      if (_line.empty() || (_line[0] == '#')) continue;
+
+      _line.push_back('\n');
+      if (_isRecord) std::swap(_record, _lastRecord);
+      _record.parse(_line, _contigIndex);
+      if (_isRecord && (_record < _lastRecord)) {
+        std::ostringstream oss;
+        oss << "Input VCF file is not sorted: '" << _vcfFile << "'. Out of order record: '" << _line << "'";
+        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+      }
+      _isRecord = true;
+      return true;
+    }
+    return false;
+  }
+
+  const SVVcfRecord& record() const { return _record; }
+
+private:
+  const std::string                  _vcfFile;
+  const SVVcfRecord::contig_index_t& _contigIndex;
+  std::ifstream                      _is;
+  std::string                        _line;
+  bool                               _isRecord = false;
+  SVVcfRecord                        _record;
+  SVVcfRecord                        _lastRecord;
+};
+
+typedef std::vector<std::unique_ptr<SortedVcfReader>> readers_t;
+
+/// Priority queue order of reader indices, such that the top reader has the lowest record, with ties
+/// resolved by input file order
+struct ReaderOrder {
+  explicit ReaderOrder(const readers_t& readers) : _readers(readers) {}
+
+  bool operator()(const unsigned lhs, const unsigned rhs) const
+  {
+    const SVVcfRecord& lhsRecord(_readers[lhs]->record());
+    const SVVcfRecord& rhsRecord(_readers[rhs]->record());
+    if (rhsRecord < lhsRecord) return true;
+    if (lhsRecord < rhsRecord) return false;
+    return (lhs > rhs);
+  }
+
+private:
+  const readers_t& _readers;
+};
+
+/// Run \p recordFunc on every record of all input files in merged sort order
+///
+/// The record reference passed to \p recordFunc is only valid for the duration of the call.
+template <typename RecordFunc>
+void mergeRecords(
+    const std::vector<std::string>&    vcfFiles,
+    const SVVcfRecord::contig_index_t& contigIndex,
+    RecordFunc&                        recordFunc)
+{
+  readers_t                                                         readers;
+  std::priority_queue<unsigned, std::vector<unsigned>, ReaderOrder> readerQueue((ReaderOrder(readers)));
+  for (const std::string& vcfFile : vcfFiles) {
+    readers.emplace_back(new SortedVcfReader(vcfFile, contigIndex));
+    if (readers.back()->next()) readerQueue.push(readers.size() - 1);
+  }
+
+  while (!readerQueue.empty()) {
+    const unsigned readerIndex(readerQueue.top());
+    readerQueue.pop();
+    recordFunc(readers[readerIndex]->record());
+    if (readers[readerIndex]->next()) readerQueue.push(readerIndex);
+  }
+}
+
+/// True if \p alt is an assembled insertion sequence which can match an <INS> allele
+bool isInsertionMatch(const std::string& alt)
+{
+  static const unsigned minInsertionMatchSize(80);
+  if (alt.empty() || (alt[0] == '<')) return false;
+  return (alt.size() >= minInsertionMatchSize);
+}
+
+/// True if two records describe the same variant, in which case only one of them is written to the output
+bool isEqualRecord(const SVVcfRecord& record1, const SVVcfRecord& record2)
+{
+  if (record1.chrom != record2.chrom) return false;
+  if (record1.pos != record2.pos) return false;
+  if (record1.ref != record2.ref) return false;
+  if (record1.endPos != record2.endPos) return false;
+  if (record1.invState != record2.invState) return false;
+
+  // Special handling to find duplications when alt is the only difference:
+  if (record1.alt != record2.alt) {
+    static const std::string insAlt("<INS>");
+    if (record1.alt == insAlt) return isInsertionMatch(record2.alt);
+    if (record2.alt == insAlt) return isInsertionMatch(record1.alt);
+    return false;
+  }
+  return true;
+}
+
+bool isAssembled(const SVVcfRecord& record)
+{
+  return ((!record.alt.empty()) && (record.alt[0] != '<'));
+}
+
+typedef std::unordered_set<std::string> id_set_t;
+
+/// Find the best record in each set of consecutive equal records, and track the IDs of records which must
+/// be removed from the output because their mate record has been removed
+///
+/// If an output writer is provided, each selected record is written unless its ID is found in the set of
+/// IDs to remove from a previous pass over the same records.
+struct DuplicateRecordResolver {
+  DuplicateRecordResolver(const id_set_t* finalIdsToRemovePtr, const vcf_line_writer_t* writeLinePtr)
+    : _finalIdsToRemovePtr(finalIdsToRemovePtr), _writeLinePtr(writeLinePtr)
+  {
+  }
+
+  void operator()(const SVVcfRecord& record)
+  {
+    // Remove a variant if its mate is already removed, this ensures that consistent BND pairs are
+    // selected:
+    if (idsToRemove.count(record.id) != 0) return;
+
+    if ((!_recordEqualSet.empty()) && (!isEqualRecord(_recordEqualSet.back(), record))) {
+      resolveRecordEqualSet();
+    }
+    _recordEqualSet.push_back(record);
+  }
+
+  /// Resolve the final set of equal records, this must be called after the last record
+  void finish() { resolveRecordEqualSet(); }
+
+  /// IDs of records to be removed because their mate record has been removed
+  id_set_t idsToRemove;
+
+private:
+  void resolveRecordEqualSet()
+  {
+    if (_recordEqualSet.empty()) return;
+
+    // The best record is PASS, then has the highest quality, then is assembled:
+    unsigned bestIndex(0);
+    double   bestQual(0);
+    bool     bestIsPass(false);
+    bool     bestIsAssembled(false);
+    for (unsigned recordIndex(0); recordIndex < _recordEqualSet.size(); ++recordIndex) {
+      const SVVcfRecord& record(_recordEqualSet[recordIndex]);
+      const bool         isNewPass((!bestIsPass) && record.isPass);
+      const bool         isHighQual((bestIsPass == record.isPass) && (record.qual > bestQual));
+      const bool         isNewAssembled((!bestIsAssembled) && isAssembled(record));
+      if (isNewPass || isHighQual || isNewAssembled) {
+        bestIndex       = recordIndex;
+        bestQual        = record.qual;
+        bestIsPass      = record.isPass;
+        bestIsAssembled = isAssembled(record);
+      }
+    }
+
+    for (unsigned recordIndex(0); recordIndex < _recordEqualSet.size(); ++recordIndex) {
+      const SVVcfRecord& record(_recordEqualSet[recordIndex]);
+      if ((recordIndex != bestIndex) && (!record.mateId.empty())) {
+        idsToRemove.insert(record.mateId);
+      }
+    }
+
+    if (_writeLinePtr != nullptr) {
+      // Remove records which were selected here but have a mate removed later in the merged records:
+      const SVVcfRecord& bestRecord(_recordEqualSet[bestIndex]);
+      if (_finalIdsToRemovePtr->count(bestRecord.id) == 0) (*_writeLinePtr)(bestRecord.line);
+    }
+    _recordEqualSet.clear();
+  }
+
+  const id_set_t*          _finalIdsToRemovePtr;
+  const vcf_line_writer_t* _writeLinePtr;
+  std::vector<SVVcfRecord> _recordEqualSet;
+};
+
+/// Write every merged record without de-duplication
+struct RecordWriter {
+  explicit RecordWriter(const vcf_line_writer_t& writeLine) : _writeLine(writeLine) {}
+
+  void operator()(const SVVcfRecord& record) { _writeLine(record.line); }
+
+private:
+  const vcf_line_writer_t& _writeLine;
+};
+
+}  // namespace
+
+void mergeSortedSVVcfFiles(
+    const std::vector<std::string>& vcfFiles, const bool isPrintAll, const vcf_line_writer_t& writeLine)
+{
+  if (vcfFiles.empty()) return;
+
+  std::vector<std::string>    header;
+  SVVcfRecord::contig_index_t contigIndex;
+  readVcfHeader(vcfFiles.front(), header, contigIndex);
+  for (const std::string& line : header) {
+    writeLine(line);
+  }
+
+  if (isPrintAll) {
+    RecordWriter recordWriter(writeLine);
+    mergeRecords(vcfFiles, contigIndex, recordWriter);
+    return;
+  }
+
+  // The first pass only finds the final set of IDs to remove:
+  DuplicateRecordResolver idResolver(nullptr, nullptr);
+  mergeRecords(vcfFiles, contigIndex, idResolver);
+  idResolver.finish();
+
+  // The second pass repeats the same selection and writes the output:
+  DuplicateRecordResolver outputResolver(&idResolver.idsToRemove, &writeLine);
+  mergeRecords(vcfFiles, contigIndex, outputResolver);
+  outputResolver.finish();
+}
@@ -0,0 +1,52 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Merge sorted SV VCF files into a single sorted and de-duplicated VCF
+///
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Function used to write each output VCF line, every line includes its trailing newline
+typedef std::function<void(const std::string&)> vcf_line_writer_t;
+
+/// \brief Merge VCF files which are each sorted into one sorted VCF
+///
+/// The header and contig order of the merged output are taken from the first input file, the headers of all
+/// other input files are skipped. Records are merged with a k-way merge of all input files, so only the
+/// current record of each file and the current set of duplicate records are held in memory. Records which
+/// compare equal keep the order of the input file list. An exception is thrown if any input file is not
+/// sorted.
+///
+/// Unless \p isPrintAll is set, records describing the same variant are de-duplicated using the same
+/// rules as the former sortVcf.py script: among each set of equal records the record which is PASS,
+/// highest quality and assembled (in that priority) is kept, and the MATEID partners of all other records
+/// in the set are removed from the output. To apply the mate removal to records which have already been
+/// kept, the inputs are read twice, the first pass finds the IDs to remove and the second pass writes the
+/// output.
+///
+/// \param[in] vcfFiles Input VCF files, each must be sorted in the contig order of the first file's header
+/// \param[in] isPrintAll If true, write all records without de-duplication
+/// \param[in] writeLine Function used to write each header and record line of the merged VCF
+void mergeSortedSVVcfFiles(
+    const std::vector<std::string>& vcfFiles, const bool isPrintAll, const vcf_line_writer_t& writeLine);
@@ -0,0 +1,111 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "applications/MergeSVVcf/SVVcfMerger.hpp"
+#include "common/Exceptions.hpp"
+#include "test/testFileMakers.hpp"
+
+#include <fstream>
+
+BOOST_AUTO_TEST_SUITE(SVVcfMerger_test_suite)
+
+static const char* testHeader =
+    "##fileformat=VCFv4.1\n"
+    "##contig=<ID=chrB,length=1000>\n"
+    "##contig=<ID=chrA,length=1000>\n"
+    "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\n";
+
+static void writeTestVcf(const std::string& filename, const std::string& records)
+{
+  std::ofstream os(filename.c_str());
+  os << testHeader << records;
+}
+
+static std::string mergeTestVcfs(const std::vector<std::string>& vcfFiles, const bool isPrintAll)
+{
+  std::string merged;
+  mergeSortedSVVcfFiles(vcfFiles, isPrintAll, [&](const std::string& line) { merged += line; });
+  return merged;
+}
+
+/// Test that records from multiple sorted files are merged in header contig order, with equal records
+/// kept in input file order
+BOOST_AUTO_TEST_CASE(test_mergeSortedSVVcfFiles_order)
+{
+  const TestFilenameMaker vcf1, vcf2;
+  const std::string       rec1("chrB\t10\tA1\tA\t<DEL>\t10\tPASS\tEND=50\n");
+  const std::string       rec2("chrB\t10\tB1\tA\t<DEL>\t20\tPASS\tEND=50\n");
+  const std::string       rec3("chrB\t20\tB2\tA\t<DEL>\t10\tPASS\tEND=30\n");
+  const std::string       rec4("chrA\t5\tA2\tA\t<DUP>\t10\tPASS\tEND=40\n");
+  const std::string       rec5("chrC\t5\tB3\tA\t<DUP>\t10\tPASS\tEND=40\n");
+  writeTestVcf(vcf1.getFilename(), rec1 + rec4);
+  writeTestVcf(vcf2.getFilename(), rec2 + rec3 + rec5);
+
+  const std::vector<std::string> vcfFiles = {vcf1.getFilename(), vcf2.getFilename()};
+  BOOST_REQUIRE_EQUAL(
+      mergeTestVcfs(vcfFiles, true), std::string(testHeader) + rec1 + rec2 + rec3 + rec4 + rec5);
+
+  // Without print-all only the higher quality of the two equal deletions is written:
+  BOOST_REQUIRE_EQUAL(mergeTestVcfs(vcfFiles, false), std::string(testHeader) + rec2 + rec3 + rec4 + rec5);
+}
+
+/// Test selection among equal records and removal of the mates of non-selected records
+BOOST_AUTO_TEST_CASE(test_mergeSortedSVVcfFiles_duplicates)
+{
+  const TestFilenameMaker vcf1, vcf2;
+
+  // The PASS record is selected over a higher quality filtered record, and the mate of the filtered record
+  // is removed even though it is earlier in the merged output:
+  const std::string mate1("chrB\t5\tM1\tA\tA]chrB:100]\t10\tPASS\tMATEID=X1\n");
+  const std::string mate2("chrB\t6\tM2\tA\tA]chrB:101]\t10\tPASS\tMATEID=X2\n");
+  const std::string rec1("chrB\t100\tX1\tA\t[chrB:5[A\t90\tMinQUAL\tMATEID=M1\n");
+  const std::string rec2("chrB\t100\tX2\tA\t[chrB:5[A\t10\tPASS\tMATEID=M2\n");
+
+  // An assembled insertion of at least 80 bases is selected over an equal <INS> record:
+  const std::string insSeq(std::string("A") + std::string(80, 'T'));
+  const std::string rec3("chrB\t200\tI1\tA\t<INS>\t10\tPASS\tEND=200\n");
+  const std::string rec4("chrB\t200\tI2\tA\t" + insSeq + "\t10\tPASS\tEND=200\n");
+
+  // Records with different inversion states are not equal:
+  const std::string rec5("chrB\t300\tV1\tA\t<INV>\t10\tPASS\tEND=400;INV3\n");
+  const std::string rec6("chrB\t300\tV2\tA\t<INV>\t10\tPASS\tEND=400;INV5\n");
+  writeTestVcf(vcf1.getFilename(), mate1 + mate2 + rec1 + rec3 + rec5);
+  writeTestVcf(vcf2.getFilename(), rec2 + rec4 + rec6);
+
+  const std::vector<std::string> vcfFiles = {vcf1.getFilename(), vcf2.getFilename()};
+  BOOST_REQUIRE_EQUAL(
+      mergeTestVcfs(vcfFiles, false), std::string(testHeader) + mate2 + rec2 + rec4 + rec5 + rec6);
+}
+
+/// Test that an unsorted input file is rejected
+BOOST_AUTO_TEST_CASE(test_mergeSortedSVVcfFiles_unsorted)
+{
+  const TestFilenameMaker vcf1;
+  writeTestVcf(
+      vcf1.getFilename(),
+      "chrA\t10\tA1\tA\t<DEL>\t10\tPASS\tEND=50\n"
+      "chrB\t10\tA2\tA\t<DEL>\t10\tPASS\tEND=50\n");
+
+  const std::vector<std::string> vcfFiles = {vcf1.getFilename()};
+  BOOST_REQUIRE_THROW(mergeTestVcfs(vcfFiles, true), illumina::common::GeneralException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
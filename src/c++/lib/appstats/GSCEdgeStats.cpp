@@ -118,6 +118,10 @@ void GSCEdgeStatsData::report(std::ostream& os) const
   os << "NonEdgeHours\t";
   nonEdge.reportHr(os);
   os << "\n";
+  // lifeTime is summed over all worker threads, so decode throughput is given per worker thread second:
+  os << "DecodedAlignmentRecords\t" << decodedAlignmentRecordCount << "\n";
+  os << "DecodedAlignmentRecordsPerThreadSec\t"
+     << ((lifeTime.wall > 0.) ? (decodedAlignmentRecordCount / lifeTime.wall) : 0.) << "\n";
   os << "\n[AllEdges]\n";
   all.report(os);
   os << "\n[RemoteEdges]\n";
@@ -139,6 +139,7 @@ struct GSCEdgeStatsData {
   void merge(const GSCEdgeStatsData& rhs)
   {
     lifeTime.merge(rhs.lifeTime);
+    decodedAlignmentRecordCount += rhs.decodedAlignmentRecordCount;
     selfEdges.merge(rhs.selfEdges);
     remoteEdges.merge(rhs.remoteEdges);
   }
@@ -148,11 +149,15 @@ struct GSCEdgeStatsData {
   template <class Archive>
   void serialize(Archive& ar, const unsigned /* version */)
   {
-    ar& BOOST_SERIALIZATION_NVP(lifeTime) & BOOST_SERIALIZATION_NVP(selfEdges) &
-        BOOST_SERIALIZATION_NVP(remoteEdges);
+    ar& BOOST_SERIALIZATION_NVP(lifeTime) & BOOST_SERIALIZATION_NVP(decodedAlignmentRecordCount) &
+        BOOST_SERIALIZATION_NVP(selfEdges) & BOOST_SERIALIZATION_NVP(remoteEdges);
   }
 
-  CpuTimes          lifeTime;
+  CpuTimes lifeTime;
+
+  /// Alignment records decoded from all input alignment files
+  uint64_t decodedAlignmentRecordCount = 0;
+
   GSCEdgeGroupStats selfEdges;
   GSCEdgeGroupStats remoteEdges;
 };
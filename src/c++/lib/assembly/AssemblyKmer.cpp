@@ -0,0 +1,173 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "assembly/AssemblyKmer.hpp"
+
+#include <cassert>
+#include <limits>
+
+KmerCodec::KmerCodec(const std::string& symbols, const unsigned wordLength)
+  : _symbols(symbols), _wordLength(wordLength), _symbolBits(1)
+{
+  assert(_wordLength > 0);
+
+  // sort symbols in std::string comparison order:
+  std::sort(_symbols.begin(), _symbols.end(), [](const char a, const char b) {
+    return (static_cast<unsigned char>(a) < static_cast<unsigned char>(b));
+  });
+  _symbols.erase(std::unique(_symbols.begin(), _symbols.end()), _symbols.end());
+  assert(!_symbols.empty());
+
+  while ((1u << _symbolBits) < _symbols.size()) _symbolBits *= 2;
+  _symbolMask = ((1u << _symbolBits) - 1);
+
+  std::fill(std::begin(_symbolCodes), std::end(_symbolCodes), -1);
+  const unsigned symbolCount(_symbols.size());
+  for (unsigned code(0); code < symbolCount; ++code) {
+    _symbolCodes[static_cast<unsigned char>(_symbols[code])] = code;
+  }
+
+  const unsigned wordBits(_wordLength * _symbolBits);
+  _blockCount = ((wordBits + blockBits - 1) / blockBits);
+  const unsigned topBlockBits(wordBits - ((_blockCount - 1) * blockBits));
+  _topBlockMask =
+      ((topBlockBits == blockBits) ? std::numeric_limits<block_t>::max()
+                                   : ((static_cast<block_t>(1) << topBlockBits) - 1));
+}
+
+void KmerCodec::encodeWord(const std::string& word, block_t* key) const
+{
+  assert(word.size() == _wordLength);
+  std::fill(key, key + _blockCount, 0);
+  for (const char symbol : word) {
+    const int code(getSymbolCode(symbol));
+    assert(code >= 0);
+    pushBack(key, code);
+  }
+}
+
+std::string KmerCodec::decodeWord(const block_t* key) const
+{
+  std::string word(_wordLength, ' ');
+  for (unsigned wordPos(0); wordPos < _wordLength; ++wordPos) {
+    word[wordPos] = _symbols[getSymbolCodeAt(key, wordPos)];
+  }
+  return word;
+}
+
+const unsigned KmerTable::noWord(std::numeric_limits<unsigned>::max());
+
+void KmerTable::clear(const unsigned blockCount)
+{
+  static const unsigned initialSlotCount(64);
+
+  assert(blockCount > 0);
+  _blockCount = blockCount;
+  _wordCount  = 0;
+  _keys.clear();
+  _slots.assign(initialSlotCount, noWord);
+  _slotMask = (initialSlotCount - 1);
+}
+
+uint64_t KmerTable::getHash(const block_t* key) const
+{
+  uint64_t hash(0x9e3779b97f4a7c15ULL);
+  for (unsigned blockIndex(0); blockIndex < _blockCount; ++blockIndex) {
+    hash ^= key[blockIndex];
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= (hash >> 32);
+  }
+  return hash;
+}
+
+bool KmerTable::isKeyEqual(const unsigned wordId, const block_t* key) const
+{
+  return std::equal(key, key + _blockCount, getKey(wordId));
+}
+
+unsigned KmerTable::find(const block_t* key) const
+{
+  for (uint64_t slotIndex(getHash(key) & _slotMask);; slotIndex = ((slotIndex + 1) & _slotMask)) {
+    const unsigned wordId(_slots[slotIndex]);
+    if ((wordId == noWord) || isKeyEqual(wordId, key)) return wordId;
+  }
+}
+
+std::pair<unsigned, bool> KmerTable::insert(const block_t* key)
+{
+  uint64_t slotIndex(getHash(key) & _slotMask);
+  for (;; slotIndex = ((slotIndex + 1) & _slotMask)) {
+    const unsigned wordId(_slots[slotIndex]);
+    if (wordId == noWord) break;
+    if (isKeyEqual(wordId, key)) return std::make_pair(wordId, false);
+  }
+
+  const unsigned wordId(_wordCount++);
+  _keys.insert(_keys.end(), key, key + _blockCount);
+  _slots[slotIndex] = wordId;
+
+  // keep the load factor at or below 1/2:
+  if ((_wordCount * 2) > _slots.size()) grow();
+  return std::make_pair(wordId, true);
+}
+
+void KmerTable::grow()
+{
+  _slots.assign(_slots.size() * 2, noWord);
+  _slotMask = (_slots.size() - 1);
+  for (unsigned wordId(0); wordId < _wordCount; ++wordId) {
+    uint64_t slotIndex(getHash(getKey(wordId)) & _slotMask);
+    while (_slots[slotIndex] != noWord) slotIndex = ((slotIndex + 1) & _slotMask);
+    _slots[slotIndex] = wordId;
+  }
+}
+
+std::vector<unsigned> KmerTable::getSortedWordIds() const
+{
+  std::vector<unsigned> wordIds(_wordCount);
+  for (unsigned wordId(0); wordId < _wordCount; ++wordId) wordIds[wordId] = wordId;
+
+  std::sort(wordIds.begin(), wordIds.end(), [&](const unsigned a, const unsigned b) {
+    const block_t* aKey(getKey(a));
+    const block_t* bKey(getKey(b));
+    return std::lexicographical_compare(aKey, aKey + _blockCount, bKey, bKey + _blockCount);
+  });
+  return wordIds;
+}
+
+std::string getAssemblySymbols(const std::string& alphabet, const AssemblyReadInput& reads)
+{
+  bool isSymbol[256] = {false};
+  for (const char symbol : alphabet) isSymbol[static_cast<unsigned char>(symbol)] = true;
+  for (const std::string& read : reads) {
+    for (const char symbol : read) isSymbol[static_cast<unsigned char>(symbol)] = true;
+  }
+
+  // words with 'N' are filtered out of the assembly:
+  assert(alphabet.find('N') == std::string::npos);
+  isSymbol[static_cast<unsigned char>('N')] = false;
+
+  std::string symbols;
+  for (unsigned symbolIndex(0); symbolIndex < 256; ++symbolIndex) {
+    if (isSymbol[symbolIndex]) symbols.push_back(static_cast<char>(symbolIndex));
+  }
+  return symbols;
+}
@@ -0,0 +1,290 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Packed k-mer representation and hash table shared by the de-bruijn graph assemblers
+///
+
+#pragma once
+
+#include "assembly/AssemblyReadInfo.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \brief Packs words of a fixed length into multi-block integers
+///
+/// Each symbol is stored in the smallest power of two bit count which can code all symbols, so words over
+/// "ACGT" are stored with 2 bits per base. Symbol codes follow the symbol sort order and the first word
+/// symbol is stored in the most significant bits, so packed words compare in the same order as the
+/// corresponding word strings.
+///
+/// Packed words are stored as getBlockCount() blocks, most significant block first.
+///
+struct KmerCodec {
+  typedef uint64_t block_t;
+
+  /// \param symbols All symbols which can occur in a packed word, in any order
+  /// \param wordLength Length of all packed words
+  KmerCodec(const std::string& symbols, const unsigned wordLength);
+
+  unsigned getWordLength() const { return _wordLength; }
+
+  unsigned getBlockCount() const { return _blockCount; }
+
+  /// \return Code of \p symbol, or -1 if \p symbol can't be packed
+  int getSymbolCode(const char symbol) const { return _symbolCodes[static_cast<unsigned char>(symbol)]; }
+
+  /// \return Code of the symbol at \p wordPos in \p key
+  unsigned getSymbolCodeAt(const block_t* key, const unsigned wordPos) const
+  {
+    const unsigned bitOffset(getBitOffset(wordPos));
+    return ((key[getBlockIndex(bitOffset)] >> (bitOffset % blockBits)) & _symbolMask);
+  }
+
+  /// Replace the symbol at \p wordPos in \p key with \p code
+  void setSymbolCodeAt(block_t* key, const unsigned wordPos, const unsigned code) const
+  {
+    const unsigned bitOffset(getBitOffset(wordPos));
+    const unsigned shift(bitOffset % blockBits);
+    block_t&       block(key[getBlockIndex(bitOffset)]);
+    block = ((block & ~(static_cast<block_t>(_symbolMask) << shift)) | (static_cast<block_t>(code) << shift));
+  }
+
+  /// Drop the first symbol of \p key and append the symbol \p code
+  void pushBack(block_t* key, const unsigned code) const
+  {
+    const unsigned lastBlockIndex(_blockCount - 1);
+    for (unsigned blockIndex(0); blockIndex < lastBlockIndex; ++blockIndex) {
+      key[blockIndex] =
+          ((key[blockIndex] << _symbolBits) | (key[blockIndex + 1] >> (blockBits - _symbolBits)));
+    }
+    key[lastBlockIndex] = ((key[lastBlockIndex] << _symbolBits) | code);
+    key[0] &= _topBlockMask;
+  }
+
+  /// Drop the last symbol of \p key and prepend the symbol \p code
+  void pushFront(block_t* key, const unsigned code) const
+  {
+    shiftRight(key);
+    setSymbolCodeAt(key, 0, code);
+  }
+
+  /// \brief Get the word of all symbols from \p key except the first (isSuffix is true) or last (otherwise)
+  ///
+  /// The shortened word is packed into the low bits of \p trunkKey, which has the same block count as \p key,
+  /// so equal trunks have equal keys whichever end they are taken from.
+  void getTrunk(const block_t* key, const bool isSuffix, block_t* trunkKey) const
+  {
+    std::copy(key, key + _blockCount, trunkKey);
+    if (isSuffix) {
+      setSymbolCodeAt(trunkKey, 0, 0);
+    } else {
+      shiftRight(trunkKey);
+    }
+  }
+
+  /// Pack \p word, which must have length getWordLength() and consist of codable symbols only
+  void encodeWord(const std::string& word, block_t* key) const;
+
+  std::string decodeWord(const block_t* key) const;
+
+  /// Number of bits per block
+  static const unsigned blockBits = 64;
+
+private:
+  /// Offset of the symbol at \p wordPos from the least significant bit of the packed word
+  unsigned getBitOffset(const unsigned wordPos) const { return ((_wordLength - 1 - wordPos) * _symbolBits); }
+
+  unsigned getBlockIndex(const unsigned bitOffset) const
+  {
+    return (_blockCount - 1 - (bitOffset / blockBits));
+  }
+
+  void shiftRight(block_t* key) const
+  {
+    for (unsigned blockIndex(_blockCount - 1); blockIndex > 0; --blockIndex) {
+      key[blockIndex] =
+          ((key[blockIndex] >> _symbolBits) | (key[blockIndex - 1] << (blockBits - _symbolBits)));
+    }
+    key[0] >>= _symbolBits;
+  }
+
+  std::string _symbols;
+  unsigned    _wordLength;
+  unsigned    _symbolBits;
+  unsigned    _symbolMask;
+  unsigned    _blockCount;
+  block_t     _topBlockMask;
+  int         _symbolCodes[256];
+};
+
+/// \brief Iterates through the packed keys of all words in a sequence
+///
+/// Words containing a symbol which can't be packed by the codec, such as 'N', are skipped.
+///
+struct KmerSequenceScanner {
+  typedef KmerCodec::block_t block_t;
+
+  explicit KmerSequenceScanner(const KmerCodec& codec) : _codec(codec), _key(codec.getBlockCount()) {}
+
+  /// Start iterating through the words of \p seq, which must be kept valid during iteration
+  void reset(const std::string& seq)
+  {
+    _seq        = &seq;
+    _seqPos     = 0;
+    _validCount = 0;
+  }
+
+  /// Advance to the next word
+  ///
+  /// \return False if there are no more words in the sequence
+  bool next()
+  {
+    const unsigned seqSize(_seq->size());
+    const unsigned wordLength(_codec.getWordLength());
+    while (_seqPos < seqSize) {
+      const int code(_codec.getSymbolCode((*_seq)[_seqPos]));
+      _seqPos++;
+      if (code < 0) {
+        _validCount = 0;
+        continue;
+      }
+      _codec.pushBack(_key.data(), code);
+      _validCount++;
+      if (_validCount >= wordLength) return true;
+    }
+    return false;
+  }
+
+  /// Position of the current word in the sequence
+  unsigned getWordPos() const { return (_seqPos - _codec.getWordLength()); }
+
+  /// Packed key of the current word
+  const block_t* getKey() const { return _key.data(); }
+
+private:
+  const KmerCodec&     _codec;
+  const std::string*   _seq        = nullptr;
+  unsigned             _seqPos     = 0;
+  unsigned             _validCount = 0;
+  std::vector<block_t> _key;
+};
+
+/// \brief Open-addressing hash set of packed words
+///
+/// Each word is assigned a dense integer id in insertion order, which can be used to index any per-word
+/// data.
+///
+struct KmerTable {
+  typedef KmerCodec::block_t block_t;
+
+  /// Id returned for words which are not in the table
+  static const unsigned noWord;
+
+  explicit KmerTable(const unsigned blockCount) { clear(blockCount); }
+
+  /// Remove all words, and set the block count of subsequently inserted words
+  void clear(const unsigned blockCount);
+
+  unsigned size() const { return _wordCount; }
+
+  /// \return Id of the word with packed key \p key, or noWord if the word is not in the table
+  unsigned find(const block_t* key) const;
+
+  /// Add the word with packed key \p key if it is not already in the table
+  ///
+  /// \return A pair of the word id, and a bool set to true if the word is new
+  std::pair<unsigned, bool> insert(const block_t* key);
+
+  const block_t* getKey(const unsigned wordId) const { return (_keys.data() + (wordId * _blockCount)); }
+
+  /// Ids of all words in the table, sorted in word string order
+  std::vector<unsigned> getSortedWordIds() const;
+
+private:
+  uint64_t getHash(const block_t* key) const;
+
+  bool isKeyEqual(const unsigned wordId, const block_t* key) const;
+
+  /// Double the slot count and re-insert all words
+  void grow();
+
+  unsigned              _blockCount = 0;
+  unsigned              _wordCount  = 0;
+  uint64_t              _slotMask   = 0;
+  std::vector<block_t>  _keys;
+  std::vector<unsigned> _slots;
+};
+
+/// \brief Count and supporting reads of each word of one length found in the assembly reads
+///
+/// All per-word data is indexed by the word id from \p table.
+///
+struct AssemblyWords {
+  /// \param symbols All symbols which can occur in any word, see getAssemblySymbols
+  AssemblyWords(const std::string& symbols, const unsigned wordLength)
+    : codec(symbols, wordLength), table(codec.getBlockCount())
+  {
+  }
+
+  /// Add the word with packed key \p key if it is not already in the table
+  ///
+  /// \return Id of the word
+  unsigned insert(const KmerCodec::block_t* key)
+  {
+    const auto val(table.insert(key));
+    if (val.second) {
+      counts.push_back(0);
+      supportReads.emplace_back();
+    }
+    return val.first;
+  }
+
+  /// Record that read \p readIndex contains word \p wordId
+  ///
+  /// Reads must be added in increasing read index order.
+  ///
+  /// \return False if the read has already been recorded for this word
+  bool addReadWord(const unsigned wordId, const unsigned readIndex, const unsigned countAdd)
+  {
+    std::vector<unsigned>& wordReads(supportReads[wordId]);
+    if ((!wordReads.empty()) && (wordReads.back() == readIndex)) return false;
+    counts[wordId] += countAdd;
+    wordReads.push_back(readIndex);
+    return true;
+  }
+
+  KmerCodec codec;
+  KmerTable table;
+
+  /// Number of reads containing each word
+  std::vector<unsigned> counts;
+
+  /// Sorted indices of all reads containing each word
+  std::vector<std::vector<unsigned>> supportReads;
+};
+
+/// \brief Get all symbols which can occur in the assembly words for a given read set
+///
+/// This includes all read symbols except 'N', and all symbols in \p alphabet used to extend contigs. Words
+/// containing 'N' are never packed, so that KmerSequenceScanner skips them.
+std::string getAssemblySymbols(const std::string& alphabet, const AssemblyReadInput& reads);
@@ -16,34 +16,33 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 //
-
 /// \file
 /// \author Xiaoyu Chen
 /// \author Ole Schulz-Trieglaff
 ///
 
 #include "assembly/IterativeAssembler.hpp"
+#include "assembly/AssemblyKmer.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <set>
-#include <unordered_map>
 #include <vector>
 
 #include "boost/foreach.hpp"
 
-#include "blt_util/set_util.hpp"
-
 // compile with this macro to get verbose output:
 //#define DEBUG_ASBL
 //#define DEBUG_WALK
 
 // stream used by DEBUG_ASBL:
-#ifdef DEBUG_ASBL
+#if defined(DEBUG_ASBL) || defined(DEBUG_WALK)
 #include <iostream>
 #include "blt_util/log.hpp"
 
-static void print_unsignSet(const std::set<unsigned>& unsignSet)
+template <typename ReadSet>
+static void print_unsignSet(const ReadSet& unsignSet)
 {
   log_os << "[";
   for (const unsigned us : unsignSet) {
@@ -51,93 +50,27 @@ static void print_unsignSet(const std::set<unsigned>& unsignSet)
   }
   log_os << "]\n";
 }
-
-static void print_stringSet(const std::set<std::string>& strSet)
-{
-  log_os << "[";
-  for (const std::string& str : strSet) {
-    log_os << str << ",";
-  }
-  log_os << "]\n";
-}
 #endif
 
-// maps kmers to positions in read
-typedef std::unordered_map<std::string, unsigned> str_uint_map_t;
-// maps kmers to supporting reads
-typedef std::unordered_map<std::string, std::set<unsigned>>            str_set_uint_map_t;
-typedef std::unordered_map<std::string, std::pair<unsigned, unsigned>> str_pair_uint_map_t;
-
-/// Adds base @p base to the end (isEnd is true) or start (otherwise) of the contig.
-///
-/// \return the extended contig.
-static std::string addBase(const std::string& contig, const char base, const bool isEnd)
-{
-  if (isEnd)
-    return contig + base;
-  else
-    return base + contig;
-}
-
-/// Returns a suffix (isEnd is true) or prefix (otherwise) of the input contig with the specified length.
-static std::string getEnd(const std::string& contig, const unsigned length, const bool isEnd)
-{
-  const unsigned csize(contig.size());
-  assert(length <= csize);
+typedef KmerCodec::block_t                    block_t;
+typedef std::vector<block_t>                  kmer_key_t;
+typedef std::vector<unsigned>                 read_vec_t;
+typedef std::back_insert_iterator<read_vec_t> read_vec_inserter_t;
 
-  if (isEnd)
-    return contig.substr((csize - length), length);
-  else
-    return contig.substr(0, length);
-}
+/// Words which can still be used as the seed of a new contig
+struct UnusedWords {
+  bool empty() const { return (count == 0); }
 
-#if 0
-/// adapt Ole's function to represent word hash as a graph:
-///
-void
-wordHashToDot(
-    const str_uint_map_t& wordCount,
-    std::ostream& os)
-{
-    static const unsigned MIN_KMER_FREQ(1);
-
-    // kmer nodes with coverage higher than this get a different color
-    //static const int lowCovGraphVisThreshold(3);
-    static const unsigned lowCovGraphVisThreshold(MIN_KMER_FREQ);
-    static const std::string lowCovNodeColor("red");
-    static const std::string highCovNodeColor("green");
-
-    os << "graph {\n";
-    os << "node [ style = filled ];\n";
-    str_uint_map_t aliasH;
-    unsigned n(0);
-    for (const str_uint_map_t::value_type& val : wordCount)
-    {
-        const std::string& word(val.first);
-        const unsigned cov(val.second);
-        aliasH[word] = n++;
-        const std::string& color(cov>lowCovGraphVisThreshold ? highCovNodeColor : lowCovNodeColor);
-        os << word << "[label=\"cov" << cov << "\" color=" << color << "]\n";
-    }
+  void erase(const unsigned wordId)
+  {
+    if ((wordId >= isUnused.size()) || (!isUnused[wordId])) return;
+    isUnused[wordId] = false;
+    count--;
+  }
 
-    // need to add edges here
-    static const bool isEnd(true);
-    for (const str_uint_map_t::value_type& val : wordCount)
-    {
-        const std::string& word(val.first);
-        const std::string tmp(getEnd(word,word.size()-1,isEnd));
-        for (const char symbol : alphabet)
-        {
-            const std::string newKey(addBase(tmp,symbol,isEnd));
-            if (wordCount.find(newKey) != wordCount.end())
-            {
-                os << aliasH[word] << " -- " << aliasH[newKey] << ";\n";
-            }
-        }
-    }
-    os << "}\n";
-}
-#endif
+  std::vector<bool> isUnused;
+  unsigned          count = 0;
+};
 
 /// Construct a contig from the seed provided
 ///
@@ -148,30 +81,34 @@ wordHashToDot(
 /// \return True if the contig runs into a repeatitive k-mer when extending in either mode
 static bool walk(
     const IterativeAssemblerOptions& opt,
-    const std::string&               seed,
-    const unsigned                   wordLength,
-    const str_uint_map_t&            wordCount,
-    const str_set_uint_map_t&        wordReads,
-    const std::set<std::string>&     repeatWords,
-    std::set<std::string>&           unusedWords,
+    const unsigned                   seed,
+    const AssemblyWords&             words,
+    const std::vector<bool>&         isRepeatWord,
+    UnusedWords&                     unusedWords,
     AssembledContig&                 contig)
 {
-  const str_uint_map_t::const_iterator     wordCountEnd(wordCount.cend());
-  const str_set_uint_map_t::const_iterator wordReadsEnd(wordReads.cend());
+  const KmerCodec& codec(words.codec);
+  const KmerTable& table(words.table);
+  const unsigned   wordLength(codec.getWordLength());
+  const unsigned   blockCount(codec.getBlockCount());
+
+  const block_t*   seedKey(table.getKey(seed));
+  const kmer_key_t seedWord(seedKey, seedKey + blockCount);
 
 #ifdef DEBUG_WALK
-  log_os << "\nSeed: " << seed << "\n";
+  log_os << "\nSeed: " << codec.decodeWord(seedKey) << "\n";
 #endif
   // we start with the seed
-  str_set_uint_map_t::const_iterator wordReadsIter(wordReads.find(seed));
-  assert(wordReadsIter != wordReadsEnd);
-  contig.supportReads = wordReadsIter->second;
-  contig.seq          = seed;
+  {
+    const read_vec_t& seedReads(words.supportReads[seed]);
+    contig.supportReads.insert(seedReads.begin(), seedReads.end());
+  }
+  contig.seq = codec.decodeWord(seedKey);
   unusedWords.erase(seed);
 
-  if (repeatWords.find(seed) != repeatWords.end()) {
+  if (isRepeatWord[seed]) {
 #ifdef DEBUG_WALK
-    log_os << "The seed is a repeat word " << seed << ". Stop walk.\n";
+    log_os << "The seed is a repeat word " << contig.seq << ". Stop walk.\n";
 #endif
     contig.conservativeRange.set_begin_pos(0);
     contig.conservativeRange.set_end_pos(wordLength);
@@ -179,24 +116,28 @@ static bool walk(
   }
 
   // collecting words used to build the contig
-  std::set<std::string> wordsInContig;
+  std::set<unsigned> wordsInContig;
   wordsInContig.insert(seed);
 
-  const std::string tmpTrunk = getEnd(seed, wordLength - 1, false);
+  kmer_key_t newKey(blockCount);
+
   // collecting rejecting reads for the seed from the unselected branches
+  const unsigned seedLastCode(codec.getSymbolCodeAt(seedKey, wordLength - 1));
   for (const char symbol : opt.alphabet) {
     // the seed itself
-    if (symbol == seed[wordLength - 1]) continue;
+    const unsigned symbolCode(codec.getSymbolCode(symbol));
+    if (symbolCode == seedLastCode) continue;
 
     // add rejecting reads from an unselected word/branch
-    const std::string newKey(addBase(tmpTrunk, symbol, true));
+    newKey = seedWord;
+    codec.setSymbolCodeAt(newKey.data(), wordLength - 1, symbolCode);
 #ifdef DEBUG_WALK
-    log_os << "Extending the seed trunk: base " << symbol << " " << newKey << "\n";
+    log_os << "Extending the seed trunk: base " << symbol << " " << codec.decodeWord(newKey.data()) << "\n";
 #endif
 
-    wordReadsIter = wordReads.find(newKey);
-    if (wordReadsIter == wordReadsEnd) continue;
-    const std::set<unsigned>& unselectedReads(wordReadsIter->second);
+    const unsigned newWord(table.find(newKey.data()));
+    if (newWord == KmerTable::noWord) continue;
+    const read_vec_t& unselectedReads(words.supportReads[newWord]);
 #ifdef DEBUG_WALK
     log_os << "Supporting reads for the non-seed word : ";
     print_unsignSet(unselectedReads);
@@ -211,17 +152,25 @@ static bool walk(
 
   bool isRepeatFound(false);
 
+  // the last word of the contig in the current walk direction
+  kmer_key_t previousWord(blockCount);
+
+  // contig extension to the left, in reverse order
+  std::string leftExtension;
+
   // 0 => walk to the right, 1 => walk to the left
   for (unsigned mode(0); mode < 2; ++mode) {
     const bool isEnd(mode == 0);
     unsigned   conservativeEndOffset(0);
 
+    previousWord = seedWord;
+
     while (true) {
-      const std::string previousWord = getEnd(contig.seq, wordLength, isEnd);
-      const std::string trunk(getEnd(contig.seq, wordLength - 1, isEnd));
+      // the trunk is the contig end shared by all candidate extension words:
+      const unsigned trunkPos(isEnd ? 0 : (wordLength - 1));
 #ifdef DEBUG_WALK
-      log_os << "# current contig : " << contig.seq << " size : " << contig.seq.size() << "\n"
-             << " getEnd : " << trunk << "\n";
+      log_os << "# current contig size : " << (contig.seq.size() + leftExtension.size()) << "\n"
+             << " getEnd : " << codec.decodeWord(previousWord.data()) << "\n";
       log_os << "contig rejecting reads : ";
       print_unsignSet(contig.rejectReads);
       log_os << "contig supporting reads : ";
@@ -231,43 +180,48 @@ static bool walk(
       unsigned           maxBaseCount(0);
       unsigned           maxContigWordReadCount(0);
       char               maxBase(opt.alphabet[0]);
-      std::string        maxWord;
-      std::set<unsigned> maxWordReads;
-      std::set<unsigned> maxContigWordReads;
-      std::set<unsigned> previousWordReads;
+      unsigned           maxWord(KmerTable::noWord);
+      read_vec_t         maxWordReads;
+      read_vec_t         maxContigWordReads;
+      read_vec_t         previousWordReads;
       std::set<unsigned> supportReads2Remove;
       std::set<unsigned> rejectReads2Add;
 
+      read_vec_t contigWordReads;
+      read_vec_t sharedReads;
+      read_vec_t readDiff;
+
       for (const char symbol : opt.alphabet) {
-        const std::string newKey(addBase(trunk, symbol, isEnd));
+        newKey = previousWord;
+        if (isEnd)
+          codec.pushBack(newKey.data(), codec.getSymbolCode(symbol));
+        else
+          codec.pushFront(newKey.data(), codec.getSymbolCode(symbol));
 #ifdef DEBUG_WALK
-        log_os << "Extending end : base " << symbol << " " << newKey << "\n";
+        log_os << "Extending end : base " << symbol << " " << codec.decodeWord(newKey.data()) << "\n";
 #endif
-        const str_uint_map_t::const_iterator wordCountIter(wordCount.find(newKey));
-        if (wordCountIter == wordCountEnd) continue;
-        const unsigned currWordCount(wordCountIter->second);
-
-        wordReadsIter = wordReads.find(newKey);
-        if (wordReadsIter == wordReadsEnd) continue;
-        const std::set<unsigned>& currWordReads(wordReadsIter->second);
+        const unsigned newWord(table.find(newKey.data()));
+        if (newWord == KmerTable::noWord) continue;
+        const unsigned    currWordCount(words.counts[newWord]);
+        const read_vec_t& currWordReads(words.supportReads[newWord]);
 
         // get the shared supporting reads between the contig and the current word
-        std::set<unsigned> contigWordReads;
+        contigWordReads.clear();
         std::set_intersection(
             contig.supportReads.begin(),
             contig.supportReads.end(),
             currWordReads.begin(),
             currWordReads.end(),
-            std::inserter(contigWordReads, contigWordReads.begin()));
+            read_vec_inserter_t(contigWordReads));
 
         // get the shared supporting reads across two alleles
-        std::set<unsigned> sharedReads;
+        sharedReads.clear();
         std::set_intersection(
             maxContigWordReads.begin(),
             maxContigWordReads.end(),
             currWordReads.begin(),
             currWordReads.end(),
-            std::inserter(sharedReads, sharedReads.begin()));
+            read_vec_inserter_t(sharedReads));
 #ifdef DEBUG_WALK
         log_os << "Word supporting reads : ";
         print_unsignSet(currWordReads);
@@ -284,54 +238,54 @@ static bool walk(
           // the old shared reads support an unselected allele if they don't support the new word
           // remove them from the contig's supporting reads
           if (!maxContigWordReads.empty()) {
-            std::set<unsigned> toRemove;
+            readDiff.clear();
             std::set_difference(
                 maxContigWordReads.begin(),
                 maxContigWordReads.end(),
                 sharedReads.begin(),
                 sharedReads.end(),
-                std::inserter(toRemove, toRemove.begin()));
-            if (!toRemove.empty()) supportReads2Remove.insert(toRemove.begin(), toRemove.end());
+                read_vec_inserter_t(readDiff));
+            supportReads2Remove.insert(readDiff.begin(), readDiff.end());
           }
 
           // the old supporting reads is for an unselected allele if they don't support the new word
           // they become rejecting reads for the currently selected allele
           if (!maxWordReads.empty()) {
-            std::set<unsigned> toAdd;
+            readDiff.clear();
             std::set_difference(
                 maxWordReads.begin(),
                 maxWordReads.end(),
                 sharedReads.begin(),
                 sharedReads.end(),
-                std::inserter(toAdd, toAdd.begin()));
-            if (!toAdd.empty()) rejectReads2Add.insert(toAdd.begin(), toAdd.end());
+                read_vec_inserter_t(readDiff));
+            rejectReads2Add.insert(readDiff.begin(), readDiff.end());
           }
           // new supporting reads for the currently selected allele
           maxWordReads = currWordReads;
 
           maxContigWordReadCount = contigWordReadCount;
-          maxContigWordReads     = contigWordReads;
-          maxBaseCount           = currWordCount;
-          maxBase                = symbol;
-          maxWord                = newKey;
+          maxContigWordReads.swap(contigWordReads);
+          maxBaseCount = currWordCount;
+          maxBase      = symbol;
+          maxWord      = newWord;
         } else {
-          std::set<unsigned> toRemove;
+          readDiff.clear();
           std::set_difference(
               contigWordReads.begin(),
               contigWordReads.end(),
               sharedReads.begin(),
               sharedReads.end(),
-              std::inserter(toRemove, toRemove.begin()));
-          if (!toRemove.empty()) supportReads2Remove.insert(toRemove.begin(), toRemove.end());
+              read_vec_inserter_t(readDiff));
+          supportReads2Remove.insert(readDiff.begin(), readDiff.end());
 
-          std::set<unsigned> toAdd;
+          readDiff.clear();
           std::set_difference(
               currWordReads.begin(),
               currWordReads.end(),
               sharedReads.begin(),
               sharedReads.end(),
-              std::inserter(toAdd, toAdd.begin()));
-          if (!toAdd.empty()) rejectReads2Add.insert(toAdd.begin(), toAdd.end());
+              read_vec_inserter_t(readDiff));
+          rejectReads2Add.insert(readDiff.begin(), readDiff.end());
         }
       }
 
@@ -351,19 +305,19 @@ static bool walk(
       // stop walk in the current mode after seeing one repeat word
       if (wordsInContig.find(maxWord) != wordsInContig.end()) {
 #ifdef DEBUG_WALK
-        log_os << "Seen a repeat word " << maxWord << ".\n Stop walk in the current mode " << mode << "\n";
+        log_os << "Seen a repeat word.\n Stop walk in the current mode " << mode << "\n";
 #endif
         isRepeatFound = true;
         break;
       }
 
 #ifdef DEBUG_WALK
-      log_os << "Adding base " << contig.seq << " " << maxBase << " " << mode << "\n";
-#endif
-      contig.seq = addBase(contig.seq, maxBase, isEnd);
-#ifdef DEBUG_WALK
-      log_os << "New contig : " << contig.seq << "\n";
+      log_os << "Adding base " << maxBase << " " << mode << "\n";
 #endif
+      if (isEnd)
+        contig.seq.push_back(maxBase);
+      else
+        leftExtension.push_back(maxBase);
 
       if ((conservativeEndOffset != 0) || (maxBaseCount < opt.minConservativeCoverage))
         conservativeEndOffset += 1;
@@ -375,47 +329,48 @@ static bool walk(
       {
         // walk backwards for one step at a branching point
         if (maxWordReads != previousWordReads) {
-          const char tmpSymbol = (isEnd ? previousWord[0] : previousWord[wordLength - 1]);
+          const unsigned tmpSymbolCode(codec.getSymbolCodeAt(previousWord.data(), trunkPos));
           for (const char symbol : opt.alphabet) {
             // the selected branch: skip the backward word itself
-            if (symbol == tmpSymbol) continue;
+            const unsigned symbolCode(codec.getSymbolCode(symbol));
+            if (symbolCode == tmpSymbolCode) continue;
 
             // add rejecting reads from an unselected branch
-            const std::string newKey(addBase(trunk, symbol, !isEnd));
+            newKey = previousWord;
+            codec.setSymbolCodeAt(newKey.data(), trunkPos, symbolCode);
 #ifdef DEBUG_WALK
-            log_os << "Extending end backwards: base " << symbol << " " << newKey << "\n";
+            log_os << "Extending end backwards: base " << symbol << " " << codec.decodeWord(newKey.data())
+                   << "\n";
 #endif
-            // the selected branch: skip the word just extended
-            if (newKey == maxWord) continue;
+            const unsigned backWord(table.find(newKey.data()));
+            if (backWord == KmerTable::noWord) continue;
 
-            wordReadsIter = wordReads.find(newKey);
-            if (wordReadsIter == wordReadsEnd) continue;
+            // the selected branch: skip the word just extended
+            if (backWord == maxWord) continue;
 
-            const std::set<unsigned>& backWordReads(wordReadsIter->second);
+            const read_vec_t& backWordReads(words.supportReads[backWord]);
 #ifdef DEBUG_WALK
             log_os << "Supporting reads for the backwards word : ";
             print_unsignSet(backWordReads);
 #endif
             // get the shared supporting reads across two alleles
-            std::set<unsigned> sharedReads;
+            sharedReads.clear();
             std::set_intersection(
                 maxContigWordReads.begin(),
                 maxContigWordReads.end(),
                 backWordReads.begin(),
                 backWordReads.end(),
-                std::inserter(sharedReads, sharedReads.begin()));
+                read_vec_inserter_t(sharedReads));
 
-            std::set<unsigned> toUpdate;
+            readDiff.clear();
             std::set_difference(
                 backWordReads.begin(),
                 backWordReads.end(),
                 sharedReads.begin(),
                 sharedReads.end(),
-                std::inserter(toUpdate, toUpdate.begin()));
-            if (!toUpdate.empty()) {
-              rejectReads2Add.insert(toUpdate.begin(), toUpdate.end());
-              supportReads2Remove.insert(toUpdate.begin(), toUpdate.end());
-            }
+                read_vec_inserter_t(readDiff));
+            rejectReads2Add.insert(readDiff.begin(), readDiff.end());
+            supportReads2Remove.insert(readDiff.begin(), readDiff.end());
 
 #ifdef DEBUG_WALK
             log_os << "rejectReads2Add upated : ";
@@ -482,6 +437,12 @@ static bool walk(
       unusedWords.erase(maxWord);
       // collect the words used to build the contig
       wordsInContig.insert(maxWord);
+
+      // the extended word becomes the new contig end
+      if (isEnd)
+        codec.pushBack(previousWord.data(), codec.getSymbolCode(maxBase));
+      else
+        codec.pushFront(previousWord.data(), codec.getSymbolCode(maxBase));
     }
 
     // set conservative coverage range for the contig
@@ -495,6 +456,7 @@ static bool walk(
 #endif
   }
 
+  contig.seq.insert(contig.seq.begin(), leftExtension.rbegin(), leftExtension.rend());
   contig.conservativeRange.set_end_pos(contig.seq.size() - contig.conservativeRange.end_pos());
 
   return isRepeatFound;
@@ -507,32 +469,15 @@ static void getKmerCounts(
     const IterativeAssemblerOptions& opt,
     const AssemblyReadInput&         reads,
     AssemblyReadOutput&              readInfo,
-    const unsigned                   wordLength,
-    str_uint_map_t&                  wordCount,
-    str_set_uint_map_t&              wordSupportReads)
+    AssemblyWords&                   words)
 {
   const unsigned readCount(reads.size());
 
-  for (unsigned readIndex(0); readIndex < readCount; ++readIndex) {
-    // stores the index of a kmer in a read sequence
-    const std::string& seq(reads[readIndex]);
-    const unsigned     readLen(seq.size());
-
-    // this read is unusable for assembly:
-    if (readLen < wordLength) continue;
-
-    // track all words from the read, including repetitive words
-    std::set<std::string> readWords;
-    for (unsigned j(0); j <= (readLen - wordLength); ++j) {
-      const std::string word(seq.substr(j, wordLength));
-
-      // filter words with "N" (either directly from input alignment
-      // or marked due to low basecall quality:
-      if (word.find('N') != std::string::npos) continue;
-
-      readWords.insert(word);
-    }
+  // filter words with "N" (either directly from input alignment
+  // or marked due to low basecall quality:
+  KmerSequenceScanner scanner(words.codec);
 
+  for (unsigned readIndex(0); readIndex < readCount; ++readIndex) {
     AssemblyReadInfo& rinfo(readInfo[readIndex]);
     unsigned          wordCountAdd = 1;
     // pseudo reads must have passed coverage check with smaller kmers
@@ -540,11 +485,11 @@ static void getKmerCounts(
     // where coverage is as low as minCoverage and reads overlap is small
     if (rinfo.isPseudo) wordCountAdd = opt.minCoverage;
 
-    // total occurrences from this read
-    for (const std::string& word : readWords) {
-      wordCount[word] += wordCountAdd;
-      // record the supporting read
-      wordSupportReads[word].insert(readIndex);
+    // total occurrences from this read, each repetitive word is only counted once
+    scanner.reset(reads[readIndex]);
+    while (scanner.next()) {
+      const unsigned word(words.insert(scanner.getKey()));
+      words.addReadWord(word, readIndex, wordCountAdd);
     }
   }
 }
@@ -552,45 +497,49 @@ static void getKmerCounts(
 /// Identify repetitive k-mers
 /// i.e. k-mers that form a circular subgraph
 ///
+/// \param[in] successors the id of each word's successor for each alphabet symbol
+///
 static unsigned searchRepeats(
-    const IterativeAssemblerOptions& opt,
-    const unsigned                   index,
-    const std::string&               word,
-    str_pair_uint_map_t&             wordIndices,
-    std::vector<std::string>&        wordStack,
-    std::set<std::string>&           repeatWords)
+    const unsigned                              symbolCount,
+    const std::vector<unsigned>&                successors,
+    const unsigned                              index,
+    const unsigned                              word,
+    std::vector<std::pair<unsigned, unsigned>>& wordIndices,
+    std::vector<unsigned>&                      wordStack,
+    std::vector<bool>&                          isWordInStack,
+    std::vector<bool>&                          isRepeatWord)
 {
   // set the depth index for the current word to the smallest unused index
   wordIndices[word]  = std::pair<unsigned, unsigned>(index, index);
   unsigned nextIndex = index + 1;
   wordStack.push_back(word);
+  isWordInStack[word] = true;
 
-  const std::string tmp(getEnd(word, word.size() - 1, true));
-  for (const char symbol : opt.alphabet) {
+  for (unsigned symbolIndex(0); symbolIndex < symbolCount; ++symbolIndex) {
     // candidate successor of the current word
-    const std::string nextWord(addBase(tmp, symbol, true));
+    const unsigned nextWord(successors[(word * symbolCount) + symbolIndex]);
 
     // homopolymer
     if (word == nextWord) {
-      repeatWords.insert(word);
+      isRepeatWord[word] = true;
       continue;
     }
 
     // the successor word does not exist in the reads
-    if (wordIndices.count(nextWord) == 0) continue;
+    if (nextWord == KmerTable::noWord) continue;
 
     const unsigned nextWordIdx = wordIndices[nextWord].first;
     if (nextWordIdx == 0) {
       // the successor word has not been visited
       // recurse on it
-      nextIndex = searchRepeats(opt, nextIndex, nextWord, wordIndices, wordStack, repeatWords);
+      nextIndex = searchRepeats(
+          symbolCount, successors, nextIndex, nextWord, wordIndices, wordStack, isWordInStack, isRepeatWord);
       // update the current word's lowlink
       const unsigned wordLowLink     = wordIndices[word].second;
       const unsigned nextWordLowLink = wordIndices[nextWord].second;
       wordIndices[word].second       = std::min(wordLowLink, nextWordLowLink);
     } else {
-      const bool isContained(std::find(wordStack.begin(), wordStack.end(), nextWord) != wordStack.end());
-      if (isContained) {
+      if (isWordInStack[nextWord]) {
         // the successor word is in stack and therefore in the current circle of words
         // only update the current word's lowlink
         const unsigned wordLowLink = wordIndices[word].second;
@@ -601,20 +550,22 @@ static unsigned searchRepeats(
 
   // if the current word is a root node,
   if (wordIndices[word].second == index) {
-    const std::string& lastWord(wordStack.back());
+    const unsigned lastWord(wordStack.back());
     // exclude singletons
     bool isSingleton(lastWord == word);
     if (isSingleton) {
       wordStack.pop_back();
+      isWordInStack[word] = false;
     } else {
       // record identified repeat words (i.e. words in the current circle) if the circle is small
 
       const unsigned lastWordIndex(wordIndices[lastWord].first);
       const bool     isSmallCircle((lastWordIndex - index) <= 50);
       while (true) {
-        const std::string repeatWd = wordStack.back();
-        if (isSmallCircle) repeatWords.insert(repeatWd);
+        const unsigned repeatWd = wordStack.back();
+        if (isSmallCircle) isRepeatWord[repeatWd] = true;
         wordStack.pop_back();
+        isWordInStack[repeatWd] = false;
 
         if (repeatWd == word) break;
       }
@@ -624,20 +575,65 @@ static unsigned searchRepeats(
   return nextIndex;
 }
 
+/// \brief Get the order in which repeat detection starts a depth-first search from each word
+///
+/// Repeat detection results depend on this order, because it decides which circles pass the small circle
+/// limit. Words are searched in decreasing count order, so that searches start from the best supported
+/// words, and words with equal counts are searched in packed word key order. The order only depends on the
+/// words and their counts.
+///
+/// \param[in] sortedWords all word ids in packed word key order
+///
+static std::vector<unsigned> getRepeatSearchOrder(
+    const AssemblyWords& words, const std::vector<unsigned>& sortedWords)
+{
+  std::vector<unsigned> searchOrder(sortedWords);
+  std::stable_sort(searchOrder.begin(), searchOrder.end(), [&words](const unsigned a, const unsigned b) {
+    return (words.counts[a] > words.counts[b]);
+  });
+  return searchOrder;
+}
+
+/// \param[in] searchOrder word ids in the order used to start each depth-first search, see
+/// getRepeatSearchOrder
+///
+/// \param[out] isRepeatWord true for each repetitive word id
+///
 static void getRepeatKmers(
-    const IterativeAssemblerOptions& opt, const str_uint_map_t& wordCount, std::set<std::string>& repeatWords)
+    const IterativeAssemblerOptions& opt,
+    const AssemblyWords&             words,
+    const std::vector<unsigned>&     searchOrder,
+    std::vector<bool>&               isRepeatWord)
 {
-  str_pair_uint_map_t wordIndices;
-  for (const str_uint_map_t::value_type& wdct : wordCount) {
-    wordIndices[wdct.first] = std::pair<unsigned, unsigned>(0, 0);
+  const KmerCodec& codec(words.codec);
+  const KmerTable& table(words.table);
+  const unsigned   wordCount(table.size());
+  const unsigned   blockCount(codec.getBlockCount());
+  const unsigned   symbolCount(opt.alphabet.size());
+
+  // find the successor of each word for each symbol of the alphabet:
+  std::vector<unsigned> successors(wordCount * symbolCount);
+  kmer_key_t            nextKey(blockCount);
+  for (unsigned word(0); word < wordCount; ++word) {
+    const block_t* key(table.getKey(word));
+    for (unsigned symbolIndex(0); symbolIndex < symbolCount; ++symbolIndex) {
+      std::copy(key, key + blockCount, nextKey.begin());
+      codec.pushBack(nextKey.data(), codec.getSymbolCode(opt.alphabet[symbolIndex]));
+      successors[(word * symbolCount) + symbolIndex] = table.find(nextKey.data());
+    }
   }
 
-  unsigned                 index = 1;
-  std::vector<std::string> wordStack;
-  for (const str_pair_uint_map_t::value_type& wdidx : wordIndices) {
-    const std::string word    = wdidx.first;
-    const unsigned    wordIdx = wdidx.second.first;
-    if (wordIdx == 0) index = searchRepeats(opt, index, word, wordIndices, wordStack, repeatWords);
+  isRepeatWord.assign(wordCount, false);
+  std::vector<std::pair<unsigned, unsigned>> wordIndices(wordCount, std::pair<unsigned, unsigned>(0, 0));
+  std::vector<bool>                          isWordInStack(wordCount, false);
+
+  unsigned              index = 1;
+  std::vector<unsigned> wordStack;
+  for (const unsigned word : searchOrder) {
+    const unsigned wordIdx = wordIndices[word].first;
+    if (wordIdx == 0)
+      index = searchRepeats(
+          symbolCount, successors, index, word, wordIndices, wordStack, isWordInStack, isRepeatWord);
   }
 }
 
@@ -659,46 +655,49 @@ static bool buildContigs(
   contigs.clear();
   bool isAssemblySuccess(true);
 
-  // counts the number of occurrences for each kmer in all reads
-  str_uint_map_t wordCount;
-  // records the supporting reads for each kmer
-  str_set_uint_map_t wordSupportReads;
-  // get counts and supporting reads for each kmer
-  getKmerCounts(opt, reads, readInfo, wordLength, wordCount, wordSupportReads);
+  // counts the number of occurrences and records the supporting reads for each kmer
+  AssemblyWords words(getAssemblySymbols(opt.alphabet, reads), wordLength);
+  getKmerCounts(opt, reads, readInfo, words);
+
+  const std::vector<unsigned> sortedWords(words.table.getSortedWordIds());
 
   // identify repeat kmers (i.e. circles from the de bruijn graph)
-  std::set<std::string> repeatWords;
-  getRepeatKmers(opt, wordCount, repeatWords);
+  std::vector<bool> isRepeatWord;
+  getRepeatKmers(opt, words, getRepeatSearchOrder(words, sortedWords), isRepeatWord);
 #ifdef DEBUG_ASBL
-  log_os << logtag << "Identified " << repeatWords.size() << " repeat words.\n";
-  print_stringSet(repeatWords);
+  log_os << logtag << "Identified " << std::count(isRepeatWord.begin(), isRepeatWord.end(), true)
+         << " repeat words.\n";
 #endif
 
   // track kmers can be used as seeds for searching for the next contig
-  std::set<std::string> unusedWords;
-  for (const str_uint_map_t::value_type& wdct : wordCount) {
+  UnusedWords unusedWords;
+  unusedWords.isUnused.resize(words.table.size());
+  for (const unsigned word : sortedWords) {
     // filter out kmers with too few coverage
-    if (wdct.second >= opt.minCoverage) unusedWords.insert(wdct.first);
+    if (words.counts[word] >= opt.minCoverage) {
+      unusedWords.isUnused[word] = true;
+      unusedWords.count++;
+    }
   }
 
   // limit the number of contigs generated for the seek of speed
   while ((!unusedWords.empty()) && (contigs.size() < 2 * opt.maxAssemblyCount)) {
-    std::string maxWord;
-    unsigned    maxWordCount(0);
+    unsigned maxWord(KmerTable::noWord);
+    unsigned maxWordCount(0);
     // get the kmers corresponding the highest count
-    for (const std::string& word : unusedWords) {
-      assert(wordCount.count(word) > 0);
-      const unsigned currWordCount = wordCount.at(word);
+    for (const unsigned word : sortedWords) {
+      if (!unusedWords.isUnused[word]) continue;
+      const unsigned currWordCount = words.counts[word];
       if (currWordCount > maxWordCount) {
         maxWord      = word;
         maxWordCount = currWordCount;
       }
     }
+    assert(maxWord != KmerTable::noWord);
 
     // solve for a best contig in the graph by a heuristic greedy maxflow-ish criteria
     AssembledContig contig;
-    bool            isRepeatFound =
-        walk(opt, maxWord, wordLength, wordCount, wordSupportReads, repeatWords, unusedWords, contig);
+    bool            isRepeatFound = walk(opt, maxWord, words, isRepeatWord, unusedWords, contig);
     if (isRepeatFound) isAssemblySuccess = false;
 
 #ifdef DEBUG_ASBL
@@ -712,10 +711,6 @@ static bool buildContigs(
     contigs.push_back(contig);
   }
 
-  // done with this now
-  wordCount.clear();
-  wordSupportReads.clear();
-
   return isAssemblySuccess;
 }
 
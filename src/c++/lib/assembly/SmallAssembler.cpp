@@ -16,19 +16,18 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 //
-
 /// \file
 /// \author Ole Schulz-Trieglaff and Xiaoyu Chen
 ///
 
 #include "assembly/SmallAssembler.hpp"
-#include "blt_util/set_util.hpp"
+#include "assembly/AssemblyKmer.hpp"
 
 #include <cassert>
 
+#include <algorithm>
 #include <iterator>
-#include <unordered_map>
-#include <unordered_set>
+#include <set>
 #include <vector>
 
 // compile with this macro to get verbose output:
@@ -39,7 +38,8 @@
 #include <iostream>
 #include "blt_util/log.hpp"
 
-static void print_readSet(const std::set<unsigned>& readSet)
+template <typename ReadSet>
+static void print_readSet(const ReadSet& readSet)
 {
   bool isFirst(true);
 
@@ -53,127 +53,57 @@ static void print_readSet(const std::set<unsigned>& readSet)
 }
 #endif
 
-// maps kmers to positions in read
-typedef std::unordered_map<std::string, unsigned> str_uint_map_t;
-// maps kmers to supporting reads
-typedef std::unordered_map<std::string, std::set<unsigned>> str_set_uint_map_t;
-
-typedef std::unordered_set<std::string> str_set_t;
-
-/**
- * Adds base @p base to the end (isEnd is true) or start (otherwise) of the contig.
- *
- *	@return The extended contig.
- */
-static std::string addBase(const std::string& contig, const char base, const bool isEnd)
-{
-  if (isEnd)
-    return contig + base;
-  else
-    return base + contig;
-}
-
-/**
- * Returns a suffix (isEnd is true) or prefix (otherwise) of @p contig with length @p length.
- *
- *	@return The suffix or prefix.
- */
-static std::string getEnd(const std::string& contig, const unsigned length, const bool isEnd)
-{
-  const unsigned csize(contig.size());
-  assert(length <= csize);
-
-  if (isEnd)
-    return contig.substr((csize - length), length);
-  else
-    return contig.substr(0, length);
-}
-
-#if 0
-/// adapt Ole's function to represent word hash as a graph:
-///
-void
-wordHashToDot(
-    const str_uint_map_t& wordCount,
-    std::ostream& os)
-{
-    static const unsigned MIN_KMER_FREQ(1);
-
-    // kmer nodes with coverage higher than this get a different color
-    //static const int lowCovGraphVisThreshold(3);
-    static const unsigned lowCovGraphVisThreshold(MIN_KMER_FREQ);
-    static const std::string lowCovNodeColor("red");
-    static const std::string highCovNodeColor("green");
-
-    os << "graph {\n";
-    os << "node [ style = filled ];\n";
-    str_uint_map_t aliasH;
-    unsigned n(0);
-    for (const str_uint_map_t::value_type& val : wordCount)
-    {
-        const std::string& word(val.first);
-        const unsigned cov(val.second);
-        aliasH[word] = n++;
-        const std::string& color(cov>lowCovGraphVisThreshold ? highCovNodeColor : lowCovNodeColor);
-        os << word << "[label=\"cov" << cov << "\" color=" << color << "]\n";
-    }
-
-    // need to add edges here
-    static const bool isEnd(true);
-    for (const str_uint_map_t::value_type& val : wordCount)
-    {
-        const std::string& word(val.first);
-        const std::string tmp(getEnd(word,word.size()-1,isEnd));
-        for (const char symbol : alphabet)
-        {
-            const std::string newKey(addBase(tmp,symbol,isEnd));
-            if (wordCount.find(newKey) != wordCount.end())
-            {
-                os << aliasH[word] << " -- " << aliasH[newKey] << ";\n";
-            }
-        }
-    }
-    os << "}\n";
-}
-#endif
+typedef KmerCodec::block_t                    block_t;
+typedef std::vector<block_t>                  kmer_key_t;
+typedef std::vector<unsigned>                 read_vec_t;
+typedef std::back_insert_iterator<read_vec_t> read_vec_inserter_t;
 
 /**
  * Extends the seed contig (aka most frequent k-mer)
  *
+ * @param[in,out] isSeenEdge set to true for the seed and all k-mers encountered during extension
  */
 static void walk(
     const SmallAssemblerOptions& opt,
-    const std::string&           seed,
-    const unsigned               wordLength,
-    const str_uint_map_t&        wordCount,
-    const str_set_uint_map_t&    wordReads,
-    std::set<std::string>&       seenEdgeBefore,
+    const unsigned               seed,
+    const AssemblyWords&         words,
+    std::vector<bool>&           isSeenEdge,
     AssembledContig&             contig)
 {
-  const str_uint_map_t::const_iterator     wordCountEnd(wordCount.end());
-  const str_set_uint_map_t::const_iterator wordReadsEnd(wordReads.end());
+  const KmerCodec& codec(words.codec);
+  const KmerTable& table(words.table);
+  const unsigned   wordLength(codec.getWordLength());
+  const unsigned   blockCount(codec.getBlockCount());
+
+  const block_t*   seedKey(table.getKey(seed));
+  const kmer_key_t seedWord(seedKey, seedKey + blockCount);
 
   // we start with the seed
-  str_set_uint_map_t::const_iterator wordReadsIter(wordReads.find(seed));
-  assert(wordReadsIter != wordReadsEnd);
-  contig.supportReads = wordReadsIter->second;
-  contig.seq          = seed;
+  {
+    const read_vec_t& seedReads(words.supportReads[seed]);
+    contig.supportReads.insert(seedReads.begin(), seedReads.end());
+  }
+  contig.seq = codec.decodeWord(seedKey);
+
+  kmer_key_t newKey(blockCount);
 
   // collecting rejecting reads for the seed from the unselected branches
+  const unsigned seedLastCode(codec.getSymbolCodeAt(seedKey, wordLength - 1));
   for (const char symbol : opt.alphabet) {
     // the seed itself
-    if (symbol == seed[wordLength - 1]) continue;
+    const unsigned symbolCode(codec.getSymbolCode(symbol));
+    if (symbolCode == seedLastCode) continue;
 
     // add rejecting reads from an unselected word/branch
-    const std::string tmpBack = getEnd(seed, wordLength - 1, false);
-    const std::string newKey(addBase(tmpBack, symbol, true));
+    newKey = seedWord;
+    codec.setSymbolCodeAt(newKey.data(), wordLength - 1, symbolCode);
 #ifdef DEBUG_ASBL
-    log_os << "Extending end backwords: base " << symbol << " " << newKey << "\n";
+    log_os << "Extending end backwords: base " << symbol << " " << codec.decodeWord(newKey.data()) << "\n";
 #endif
 
-    wordReadsIter = wordReads.find(newKey);
-    if (wordReadsIter == wordReadsEnd) continue;
-    const std::set<unsigned>& unselectedReads(wordReadsIter->second);
+    const unsigned newWord(table.find(newKey.data()));
+    if (newWord == KmerTable::noWord) continue;
+    const read_vec_t& unselectedReads(words.supportReads[newWord]);
 #ifdef DEBUG_ASBL
     log_os << "Supporting reads for the backwards word : ";
     print_readSet(unselectedReads);
@@ -186,10 +116,17 @@ static void walk(
 #endif
   }
 
-  seenEdgeBefore.clear();
-  seenEdgeBefore.insert(seed);
+  isSeenEdge[seed] = true;
+
+  // trunks are stored with the same block count as full words, see KmerCodec::getTrunk
+  KmerTable  seenVertexBefore(blockCount);
+  kmer_key_t trunk(blockCount);
 
-  str_set_t seenVertexBefore;
+  // the last word of the contig in the current walk direction
+  kmer_key_t previousWord(blockCount);
+
+  // contig extension to the left, in reverse order
+  std::string leftExtension;
 
   // 0 => walk to the right, 1 => walk to the left
   for (unsigned mode(0); mode < 2; ++mode) {
@@ -197,59 +134,61 @@ static void walk(
 
     const bool isEnd(mode == 0);
 
+    previousWord = seedWord;
+
     while (true) {
-      const std::string previousWord = getEnd(contig.seq, wordLength, isEnd);
-      const std::string trunk(getEnd(contig.seq, wordLength - 1, isEnd));
+      codec.getTrunk(previousWord.data(), isEnd, trunk.data());
 
 #ifdef DEBUG_ASBL
-      log_os << "# current contig : " << contig.seq << " size : " << contig.seq.size() << "\n"
-             << " getEnd : " << trunk << "\n";
+      log_os << "# current contig size : " << (contig.seq.size() + leftExtension.size()) << "\n"
+             << " getEnd : " << codec.decodeWord(previousWord.data()) << "\n";
       log_os << "contig rejecting reads : ";
       print_readSet(contig.rejectReads);
       log_os << "contig supporting reads : ";
       print_readSet(contig.supportReads);
 #endif
 
-      if (seenVertexBefore.count(trunk)) {
+      if (!seenVertexBefore.insert(trunk.data()).second) {
 #ifdef DEBUG_ASBL
-        log_os << "Seen word " << trunk << " before on this walk, terminating"
+        log_os << "Seen word trunk before on this walk, terminating"
                << "\n";
 #endif
         break;
       }
 
-      seenVertexBefore.insert(trunk);
-
       unsigned           maxBaseCount(0);
       unsigned           maxSharedReadCount(0);
       char               maxBase(opt.alphabet[0]);
-      std::set<unsigned> maxWordReads;
-      std::set<unsigned> maxSharedReads;
-      std::set<unsigned> previousWordReads;
+      read_vec_t         maxWordReads;
+      read_vec_t         maxSharedReads;
+      read_vec_t         previousWordReads;
       std::set<unsigned> supportReads2Remove;
       std::set<unsigned> rejectReads2Add;
 
+      read_vec_t sharedReads;
+
       for (const char symbol : opt.alphabet) {
-        const std::string newKey(addBase(trunk, symbol, isEnd));
+        newKey = previousWord;
+        if (isEnd)
+          codec.pushBack(newKey.data(), codec.getSymbolCode(symbol));
+        else
+          codec.pushFront(newKey.data(), codec.getSymbolCode(symbol));
 #ifdef DEBUG_ASBL
-        log_os << "Extending end : base " << symbol << " " << newKey << "\n";
+        log_os << "Extending end : base " << symbol << " " << codec.decodeWord(newKey.data()) << "\n";
 #endif
-        const str_uint_map_t::const_iterator wordCountIter(wordCount.find(newKey));
-        if (wordCountIter == wordCountEnd) continue;
-        const unsigned currWordCount(wordCountIter->second);
-
-        wordReadsIter = wordReads.find(newKey);
-        if (wordReadsIter == wordReadsEnd) continue;
-        const std::set<unsigned>& currWordReads(wordReadsIter->second);
+        const unsigned newWord(table.find(newKey.data()));
+        if (newWord == KmerTable::noWord) continue;
+        const unsigned    currWordCount(words.counts[newWord]);
+        const read_vec_t& currWordReads(words.supportReads[newWord]);
 
         // get the shared supporting reads between the contig and the current word
-        std::set<unsigned> sharedReads;
+        sharedReads.clear();
         std::set_intersection(
             contig.supportReads.begin(),
             contig.supportReads.end(),
             currWordReads.begin(),
             currWordReads.end(),
-            std::inserter(sharedReads, sharedReads.begin()));
+            read_vec_inserter_t(sharedReads));
 #ifdef DEBUG_ASBL
         log_os << "Word supporting reads : ";
         print_readSet(currWordReads);
@@ -271,9 +210,9 @@ static void walk(
           // new supporting reads for the currently selected allele
           maxWordReads       = currWordReads;
           maxSharedReadCount = sharedReadCount;
-          maxSharedReads     = sharedReads;
-          maxBaseCount       = currWordCount;
-          maxBase            = symbol;
+          maxSharedReads.swap(sharedReads);
+          maxBaseCount = currWordCount;
+          maxBase      = symbol;
         } else {
           supportReads2Remove.insert(sharedReads.begin(), sharedReads.end());
           rejectReads2Add.insert(currWordReads.begin(), currWordReads.end());
@@ -296,41 +235,48 @@ static void walk(
       /// double check that word exists in reads at least once:
       if (maxBaseCount == 0) break;
 
-      {
-        const std::string newEdge(addBase(trunk, maxBase, isEnd));
-        seenEdgeBefore.insert(newEdge);
-      }
+      // record the selected extension word as an edge seen on this walk, and make it the new contig end:
+      const unsigned maxBaseCode(codec.getSymbolCode(maxBase));
+      newKey = previousWord;
+      if (isEnd)
+        codec.pushBack(newKey.data(), maxBaseCode);
+      else
+        codec.pushFront(newKey.data(), maxBaseCode);
+      isSeenEdge[table.find(newKey.data())] = true;
 
 #ifdef DEBUG_ASBL
-      log_os << "Adding base " << contig.seq << " " << maxBase << " " << mode << "\n";
+      log_os << "Adding base " << maxBase << " " << mode << "\n";
 #endif
-      contig.seq = addBase(contig.seq, maxBase, isEnd);
+      if (isEnd)
+        contig.seq.push_back(maxBase);
+      else
+        leftExtension.push_back(maxBase);
 
       if ((conservativeEndOffset != 0) || (maxBaseCount < opt.minConservativeCoverage)) {
         conservativeEndOffset += 1;
       }
 
-#ifdef DEBUG_ASBL
-      log_os << "New contig : " << contig.seq << "\n";
-#endif
-
       // TODO: can add threshold for the count or percentage of shared reads
       {
         // walk backwards for one step at a branching point
         if (maxWordReads != previousWordReads) {
-          const char tmpSymbol = (isEnd ? previousWord[0] : previousWord[wordLength - 1]);
+          const unsigned trunkPos(isEnd ? 0 : (wordLength - 1));
+          const unsigned tmpSymbolCode(codec.getSymbolCodeAt(previousWord.data(), trunkPos));
           for (const char symbol : opt.alphabet) {
             // the selected branch
-            if (symbol == tmpSymbol) continue;
+            const unsigned symbolCode(codec.getSymbolCode(symbol));
+            if (symbolCode == tmpSymbolCode) continue;
 
             // add rejecting reads from an unselected branch
-            const std::string newKey(addBase(trunk, symbol, !isEnd));
+            kmer_key_t backKey(previousWord);
+            codec.setSymbolCodeAt(backKey.data(), trunkPos, symbolCode);
 #ifdef DEBUG_ASBL
-            log_os << "Extending end backwords: base " << symbol << " " << newKey << "\n";
+            log_os << "Extending end backwords: base " << symbol << " " << codec.decodeWord(backKey.data())
+                   << "\n";
 #endif
-            wordReadsIter = wordReads.find(newKey);
-            if (wordReadsIter == wordReadsEnd) continue;
-            const std::set<unsigned>& backWordReads(wordReadsIter->second);
+            const unsigned backWord(table.find(backKey.data()));
+            if (backWord == KmerTable::noWord) continue;
+            const read_vec_t& backWordReads(words.supportReads[backWord]);
 #ifdef DEBUG_ASBL
             log_os << "Supporting reads for the backwards word : ";
             print_readSet(backWordReads);
@@ -393,6 +339,8 @@ static void walk(
         print_readSet(contig.supportReads);
 #endif
       }
+
+      previousWord.swap(newKey);
     }
 
     if (mode == 0) {
@@ -406,49 +354,40 @@ static void walk(
 #endif
   }
 
+  contig.seq.insert(contig.seq.begin(), leftExtension.rbegin(), leftExtension.rend());
   contig.conservativeRange.set_end_pos(contig.seq.size() - contig.conservativeRange.end_pos());
 }
 
 /// \param isFindRepeatReads if true record all reads with repeated words
 ///
 static bool getKmerCounts(
-    const AssemblyReadInput&     reads,
-    const AssemblyReadOutput&    readInfo,
-    const unsigned               wordLength,
-    const bool                   isFindRepeatReads,
-    std::vector<int>&            repeatReads,
-    str_uint_map_t&              wordCount,
-    str_set_uint_map_t&          wordSupportReads,
-    std::vector<str_uint_map_t>& readWordOffsets)
+    const AssemblyReadInput&  reads,
+    const AssemblyReadOutput& readInfo,
+    const bool                isFindRepeatReads,
+    std::vector<int>&         repeatReads,
+    AssemblyWords&            words)
 {
   const unsigned readCount(reads.size());
   repeatReads.clear();
 
+  // filter words with "N" (either directly from input alignment
+  // or marked due to low basecall quality:
+  KmerSequenceScanner scanner(words.codec);
+
   for (unsigned readIndex(0); readIndex < readCount; ++readIndex) {
     const AssemblyReadInfo& rinfo(readInfo[readIndex]);
 
     // skip reads used in a previous iteration
     if (rinfo.isUsed) continue;
 
-    // stores the index of a kmer in a read sequence
-    const std::string& seq(reads[readIndex]);
-    const unsigned     readLen(seq.size());
-
-    // this read is unusable for assembly:
-    if (readLen < wordLength) continue;
-
-    str_uint_map_t& readWordOffset(readWordOffsets[readIndex]);
-
-    for (unsigned j(0); j <= (readLen - wordLength); ++j) {
-      const std::string word(seq.substr(j, wordLength));
-
-      // filter words with "N" (either directly from input alignment
-      // or marked due to low basecall quality:
-      if (word.find('N') != std::string::npos) continue;
-
-      if (readWordOffset.find(word) != readWordOffset.end()) {
+    // record the supporting read for each word, a second occurrence of any word in the read is a repeat
+    scanner.reset(reads[readIndex]);
+    while (scanner.next()) {
+      const unsigned word(words.insert(scanner.getKey()));
+      if (!words.addReadWord(word, readIndex, 1)) {
 #ifdef DEBUG_ASBL
-        log_os << __FUNCTION__ << ": word " << word << " repeated in read " << readIndex << "\n";
+        log_os << __FUNCTION__ << ": word " << words.codec.decodeWord(scanner.getKey())
+               << " repeated in read " << readIndex << "\n";
 #endif
         if (isFindRepeatReads) {
           repeatReads.push_back(readIndex);
@@ -458,17 +397,6 @@ static bool getKmerCounts(
           return false;
         }
       }
-
-      // record (0-indexed) start point for word in read
-      //cout << "Recording " << word << " at " << j << "\n";
-      readWordOffset[word] = j;
-    }
-
-    // total occurrences from this read:
-    for (const str_uint_map_t::value_type& offset : readWordOffset) {
-      wordCount[offset.first]++;
-      // record the supporting read
-      wordSupportReads[offset.first].insert(readIndex);
     }
   }
 
@@ -496,16 +424,11 @@ static bool buildContigs(
   }
 #endif
 
-  // a set of read hashes; each read hash stores the starting positions of all kmers in the read
-  std::vector<str_uint_map_t> readWordOffsets(readCount);
-  // counts the number of occurrences for each kmer in all reads
-  str_uint_map_t wordCount;
-  // records the supporting reads for each kmer
-  str_set_uint_map_t wordSupportReads;
+  // counts the number of occurrences and records the supporting reads for each kmer
+  AssemblyWords words(getAssemblySymbols(opt.alphabet, reads), wordLength);
 
   std::vector<int> repeatReads;
-  const bool       isGoodKmerCount(getKmerCounts(
-      reads, readInfo, wordLength, isLastWord, repeatReads, wordCount, wordSupportReads, readWordOffsets));
+  const bool       isGoodKmerCount(getKmerCounts(reads, readInfo, isLastWord, repeatReads, words));
   if (!isGoodKmerCount) {
     if (isLastWord) {
       for (const int readIndex : repeatReads) {
@@ -518,17 +441,19 @@ static bool buildContigs(
   }
 
   // get the kmers corresponding the highest count
-  std::set<std::string> maxWords;
+  std::vector<unsigned> maxWords;
   {
-    unsigned maxWordCount(0);
-    for (const auto& val : wordCount) {
-      if (val.second < maxWordCount) continue;
-      if (val.second > maxWordCount) {
+    const unsigned wordCount(words.table.size());
+    unsigned       maxWordCount(0);
+    for (unsigned word(0); word < wordCount; ++word) {
+      const unsigned count(words.counts[word]);
+      if (count < maxWordCount) continue;
+      if (count > maxWordCount) {
         maxWords.clear();
-        maxWordCount = val.second;
+        maxWordCount = count;
       }
 
-      maxWords.insert(val.first);
+      maxWords.push_back(word);
     }
 
     if (maxWordCount < opt.minCoverage) {
@@ -537,37 +462,42 @@ static bool buildContigs(
 #endif
       return false;
     }
+
+    // seeds are tried in word string order:
+    std::sort(maxWords.begin(), maxWords.end(), [&](const unsigned a, const unsigned b) {
+      const KmerCodec::block_t* aKey(words.table.getKey(a));
+      const KmerCodec::block_t* bKey(words.table.getKey(b));
+      return std::lexicographical_compare(
+          aKey, aKey + words.codec.getBlockCount(), bKey, bKey + words.codec.getBlockCount());
+    });
   }
 
   // solve for a best contig in the graph by a heuristic greedy maxflow-ish criteria
   AssembledContig contig;
-  std::string     maxWord;
+  unsigned        maxWord(KmerTable::noWord);
   {
     // consider multiple possible most frequent seeding k-mers to find the one associated with the longest
     // contig:
     //
-    std::set<std::string> seenEdgeBefore;  // records k-mers already encountered during extension
+    // records k-mers already encountered during extension
+    std::vector<bool> isSeenEdge(words.table.size(), false);
+
+    for (const unsigned seed : maxWords) {
+      // skip seeds already encountered during extension from a previous seed
+      if (isSeenEdge[seed]) continue;
 
-    while (!maxWords.empty()) {
-      maxWord = (*maxWords.begin());
-      maxWords.erase(maxWords.begin());
+      maxWord = seed;
 #ifdef DEBUG_ASBL
-      log_os << logtag << "Seeding kmer : " << maxWord << "\n";
+      log_os << logtag << "Seeding kmer : " << words.codec.decodeWord(words.table.getKey(maxWord)) << "\n";
 #endif
 
       AssembledContig newContig;
-      walk(opt, maxWord, wordLength, wordCount, wordSupportReads, seenEdgeBefore, newContig);
+      walk(opt, maxWord, words, isSeenEdge, newContig);
 
       if (newContig.seq.size() > contig.seq.size()) {
         contig = newContig;
       }
-
-      // subtract seenBefore from maxWords
-      inplaceSetSubtract(seenEdgeBefore, maxWords);
     }
-
-    // done with this now
-    wordCount.clear();
   }
 
 #ifdef DEBUG_ASBL
@@ -580,13 +510,10 @@ static bool buildContigs(
 #endif
 
   // WHY CHECK THIS AFTER WALK???
-  // increment number of reads containing the seeding kmer
+  // number of reads containing the seeding kmer
   //
-  // TODO isn't this equal to maxWordCount? Do we need to sum it here?
-  for (unsigned readIndex(0); readIndex < readCount; ++readIndex) {
-    const str_uint_map_t& readWordOffset(readWordOffsets[readIndex]);
-    if (readWordOffset.count(maxWord)) ++contig.seedReadCount;
-  }
+  // TODO isn't this equal to maxWordCount?
+  contig.seedReadCount = words.supportReads[maxWord].size();
 
 #ifdef DEBUG_ASBL
   log_os << logtag << "final seeding reading count: " << contig.seedReadCount << "\n";
@@ -612,9 +539,6 @@ static bool buildContigs(
     }
   }
 
-  // don't need this anymore:
-  readWordOffsets.clear();
-
   contigs.push_back(contig);
   return true;
 }
@@ -0,0 +1,127 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+#include "boost/test/unit_test.hpp"
+
+#include "assembly/AssemblyKmer.hpp"
+
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE(test_AssemblyKmer)
+
+typedef std::vector<KmerCodec::block_t> kmer_key_t;
+
+/// Test packing over "ACGT" with words spanning multiple blocks
+BOOST_AUTO_TEST_CASE(test_KmerCodecMultiBlock)
+{
+  static const std::string word("ACGTTGCAAACCGGTTACGTACGTTTTGGGCCCAAAACGTAGCTAGCTAGCATCGATCGATCGATGCATGCATG");
+  const unsigned           wordLength(word.size());
+
+  const KmerCodec codec("TGCA", wordLength);
+  BOOST_REQUIRE_EQUAL(codec.getBlockCount(), 3u);
+
+  kmer_key_t key(codec.getBlockCount());
+  codec.encodeWord(word, key.data());
+  BOOST_REQUIRE_EQUAL(codec.decodeWord(key.data()), word);
+  BOOST_REQUIRE_EQUAL(codec.getSymbolCodeAt(key.data(), 0), 0u);
+  BOOST_REQUIRE_EQUAL(codec.getSymbolCodeAt(key.data(), 3), 3u);
+
+  // roll the word in both directions:
+  kmer_key_t rollKey(key);
+  codec.pushBack(rollKey.data(), codec.getSymbolCode('G'));
+  BOOST_REQUIRE_EQUAL(codec.decodeWord(rollKey.data()), word.substr(1) + "G");
+  codec.pushFront(rollKey.data(), codec.getSymbolCode('A'));
+  BOOST_REQUIRE_EQUAL(codec.decodeWord(rollKey.data()), word);
+  BOOST_REQUIRE(rollKey == key);
+
+  codec.setSymbolCodeAt(rollKey.data(), 40, codec.getSymbolCode('T'));
+  BOOST_REQUIRE_EQUAL(codec.decodeWord(rollKey.data()), word.substr(0, 40) + "T" + word.substr(41));
+
+  // the same trunk is found from either end of a word:
+  kmer_key_t suffixTrunk(codec.getBlockCount());
+  kmer_key_t prefixTrunk(codec.getBlockCount());
+  codec.getTrunk(key.data(), true, suffixTrunk.data());
+  codec.pushBack(key.data(), codec.getSymbolCode('C'));
+  codec.getTrunk(key.data(), false, prefixTrunk.data());
+  BOOST_REQUIRE(suffixTrunk == prefixTrunk);
+}
+
+/// Test that packed words sort in string order, and that unpackable symbols are skipped during scanning
+BOOST_AUTO_TEST_CASE(test_KmerSequenceScanner)
+{
+  const AssemblyReadInput reads = {"GATTACANCCAT1A"};
+  const KmerCodec         codec(getAssemblySymbols("ACGT", reads), 3);
+  BOOST_REQUIRE_EQUAL(codec.getSymbolCode('N'), -1);
+  BOOST_REQUIRE(codec.getSymbolCode('1') >= 0);
+
+  KmerTable                table(codec.getBlockCount());
+  std::vector<std::string> scanWords;
+  KmerSequenceScanner      scanner(codec);
+  scanner.reset(reads[0]);
+  while (scanner.next()) {
+    const std::string word(codec.decodeWord(scanner.getKey()));
+    BOOST_REQUIRE_EQUAL(word, reads[0].substr(scanner.getWordPos(), 3));
+    scanWords.push_back(word);
+    table.insert(scanner.getKey());
+  }
+
+  const std::vector<std::string> expectWords = {
+      "GAT", "ATT", "TTA", "TAC", "ACA", "CCA", "CAT", "AT1", "T1A"};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(scanWords.begin(), scanWords.end(), expectWords.begin(), expectWords.end());
+
+  std::vector<std::string> sortedWords;
+  for (const unsigned wordId : table.getSortedWordIds()) {
+    sortedWords.push_back(codec.decodeWord(table.getKey(wordId)));
+  }
+  std::vector<std::string> expectSortedWords(expectWords);
+  std::sort(expectSortedWords.begin(), expectSortedWords.end());
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(
+      sortedWords.begin(), sortedWords.end(), expectSortedWords.begin(), expectSortedWords.end());
+}
+
+/// Test that table lookups are consistent as the table grows
+BOOST_AUTO_TEST_CASE(test_KmerTable)
+{
+  const KmerCodec codec("ACGT", 9);
+  KmerTable       table(codec.getBlockCount());
+
+  static const unsigned wordCount(1000);
+  kmer_key_t            key(codec.getBlockCount(), 0);
+  for (unsigned wordIndex(0); wordIndex < wordCount; ++wordIndex) {
+    key[0] = (wordIndex * 7);
+    BOOST_REQUIRE_EQUAL(table.find(key.data()), KmerTable::noWord);
+    const auto val(table.insert(key.data()));
+    BOOST_REQUIRE(val.second);
+    BOOST_REQUIRE_EQUAL(val.first, wordIndex);
+  }
+  BOOST_REQUIRE_EQUAL(table.size(), wordCount);
+
+  for (unsigned wordIndex(0); wordIndex < wordCount; ++wordIndex) {
+    key[0] = (wordIndex * 7);
+    BOOST_REQUIRE_EQUAL(table.find(key.data()), wordIndex);
+    const auto val(table.insert(key.data()));
+    BOOST_REQUIRE(!val.second);
+    BOOST_REQUIRE_EQUAL(val.first, wordIndex);
+  }
+
+  table.clear(codec.getBlockCount());
+  BOOST_REQUIRE_EQUAL(table.size(), 0u);
+  BOOST_REQUIRE_EQUAL(table.find(key.data()), KmerTable::noWord);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,39 +25,53 @@
 
 #include "IterativeAssembler.cpp"
 
+#include <random>
+
 BOOST_AUTO_TEST_SUITE(test_IterativeAssembler)
 
 BOOST_AUTO_TEST_CASE(test_CircleDetector)
 {
   IterativeAssemblerOptions assembleOpt;
-  str_uint_map_t            wordCount;
-  std::set<std::string>     repeatWords;
-
-  wordCount["TACCA"] = 3;
-  wordCount["CCACC"] = 3;
-  wordCount["CACCA"] = 3;
-  wordCount["ACCAC"] = 3;
-  wordCount["CCACA"] = 3;
-  wordCount["CACAC"] = 3;
-  wordCount["ACACA"] = 3;
-  wordCount["AAAAA"] = 2;
-
-  getRepeatKmers(assembleOpt, wordCount, repeatWords);
+  AssemblyWords             words(assembleOpt.alphabet, 5);
+  std::vector<bool>         isRepeatWord;
+
+  std::vector<KmerCodec::block_t> key(words.codec.getBlockCount());
+  auto                            addWord = [&](const std::string& word, const unsigned count) {
+    words.codec.encodeWord(word, key.data());
+    words.counts[words.insert(key.data())] = count;
+  };
+  auto getRepeatWordCount = [&](const std::string& word) {
+    words.codec.encodeWord(word, key.data());
+    const unsigned wordId(words.table.find(key.data()));
+    BOOST_REQUIRE(wordId != KmerTable::noWord);
+    return (isRepeatWord[wordId] ? 1u : 0u);
+  };
+
+  addWord("TACCA", 3);
+  addWord("CCACC", 3);
+  addWord("CACCA", 3);
+  addWord("ACCAC", 3);
+  addWord("CCACA", 3);
+  addWord("CACAC", 3);
+  addWord("ACACA", 3);
+  addWord("AAAAA", 2);
+
+  getRepeatKmers(assembleOpt, words, words.table.getSortedWordIds(), isRepeatWord);
 
   // the first circle
-  BOOST_REQUIRE_EQUAL(repeatWords.count("ACCAC"), 1u);
-  BOOST_REQUIRE_EQUAL(repeatWords.count("CACCA"), 1u);
-  BOOST_REQUIRE_EQUAL(repeatWords.count("CCACC"), 1u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("ACCAC"), 1u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("CACCA"), 1u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("CCACC"), 1u);
 
-  BOOST_REQUIRE_EQUAL(repeatWords.count("TACCA"), 0u);
-  BOOST_REQUIRE_EQUAL(repeatWords.count("CCACA"), 0u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("TACCA"), 0u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("CCACA"), 0u);
 
   // the second circle
-  BOOST_REQUIRE_EQUAL(repeatWords.count("CACAC"), 1u);
-  BOOST_REQUIRE_EQUAL(repeatWords.count("ACACA"), 1u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("CACAC"), 1u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("ACACA"), 1u);
 
   // homopolymer: self-circle
-  BOOST_REQUIRE_EQUAL(repeatWords.count("AAAAA"), 1u);
+  BOOST_REQUIRE_EQUAL(getRepeatWordCount("AAAAA"), 1u);
 }
 
 BOOST_AUTO_TEST_CASE(test_BasicAssembler)
@@ -204,4 +218,117 @@ BOOST_AUTO_TEST_CASE(test_branching_iterative)
   BOOST_REQUIRE_EQUAL(readInfo[2].contigIds[0], 1u);
 }
 
+/// Generate reads from a short tandem repeat with random flanks, with a substitution in some reads
+static void getTandemRepeatReads(const unsigned seed, AssemblyReadInput& reads)
+{
+  // use the generator output directly, so that read sets don't depend on the standard library
+  // implementation:
+  std::mt19937      generator(seed);
+  static const char bases[]      = "ACGT";
+  auto              getRandomSeq = [&](const unsigned length) {
+    std::string seq;
+    for (unsigned i(0); i < length; ++i) seq.push_back(bases[generator() % 4]);
+    return seq;
+  };
+
+  const std::string repeatUnit(getRandomSeq(2 + generator() % 9));
+  const unsigned    repeatLength(40 + generator() % 80);
+  std::string       repeat;
+  while (repeat.size() < repeatLength) repeat += repeatUnit;
+  const std::string ref(getRandomSeq(50) + repeat + getRandomSeq(50));
+
+  static const unsigned readLength(60);
+  const unsigned        readCount(20 + generator() % 20);
+  reads.clear();
+  for (unsigned readIndex(0); readIndex < readCount; ++readIndex) {
+    std::string read(ref.substr(generator() % (ref.size() - readLength + 1), readLength));
+    if ((generator() % 4) == 0) read[generator() % readLength] = bases[generator() % 4];
+    reads.push_back(read);
+  }
+}
+
+/// Test the contigs assembled from tandem repeat reads
+///
+/// Repeat detection output depends on the order of the words from which each search starts. The read sets
+/// include cases where visiting these words in packed word key order alone, without first ordering by word
+/// count, would change the contigs.
+BOOST_AUTO_TEST_CASE(test_TandemRepeatContigs)
+{
+  struct ExpectedContig {
+    const char* seq;
+    unsigned    supportReadCount;
+  };
+  struct ExpectedAssembly {
+    unsigned                    seed;
+    std::vector<ExpectedContig> contigs;
+  };
+
+  // clang-format off
+  const std::vector<ExpectedAssembly> expectedAssemblies = {
+    {0, {
+      {"CTCTCATTTTCTCTCATTTTCTCTCATTTTCTCTCATTTT", 15},
+      {"ACCGAACTACGGTACCTCCTGTTGGTAGTCACGATAGATTATATCATTTTCTCTCATTTTCTCTCATTTTCTCATGAAAGCGTTGACCCCACATATCGTTAGTACTCTTGTACCCTATGATTG", 9},
+    }},
+    {2, {
+      {"CTCTCTCTCTCTCTCTCTCTCTCTCTCTCTCT", 17},
+      {"GGAAGGAGACGCGGGTAGTCTCTCTCTCTCCCTCTCTCTCTCTCTCTCTCTCTCTCTCTCTCGTGTATGCTTCTTTGAAACTTGAGTTTGGCGATTCAAGGTTCT", 8},
+      {"GAGCGTCCATCGAGCCCCGAGGTATAGGAAGGAGACGCGGGTAGTCTCTCTCTCTCTCTCTCTCTCTCTCTCTCTC", 11},
+    }},
+    {3, {
+      {"ATGAACGATCAATCCGCCCCCTGTAATTATAAAGGTTATCCGACCACAACTAAAACTAAAACTAAAACTAAAACTAAACTGTCCGCTGAAACTGAGCGGGGTACTGCAGCCGATGTATCTTACAGC", 16},
+      {"GATCAATGCGCCCCCTGTAATTATAAAGGTTATCCGACCACAACTAAAACTAAAACTAAAACTAAAACTAAAACTAA", 11},
+    }},
+    {4, {
+      {"GTCCATGTCCATGTCCATGTCCATGTCCATGTCCAT", 19},
+      {"GTCTGCACCCTAATGGGTGGTTAGGTCGTCGTCTACGTATTTTACCATGGTCCATGTCCATGTCCATGTCAATGTCCATGTCCATGTCCATGTCC", 7},
+      {"TCCATGTCCATGTCTATGTCCATGTCCATGTCCATGTCCATGCGATCGTTCAAGAGGGATATCCCGCGAGGCGACGGTAATGCCAGCATGT", 6},
+      {"TCCATGTCCATGTCCATGTCCATGTCCATGTCCATGCGATCGTTCAAGAGGGATATCCCGCGAGGCGACGGTAATGCCAGCATGT", 11},
+    }},
+    {5, {
+      {"TGTCGGACAATGTCGGACAATGTCGGACAATGTCGGACAA", 15},
+      {"GTCGGACAATGTCGGACAATGTCGGACAATGTCGGACAATTAGATATCCTATACTCTGAGCGGCCGCCGCGTAGCGAAAGACTTTGAGCT", 11},
+      {"ACGGTTTACTTTGTCCCCTAGGGTCGTACGCTACGTATAAACGTGTCGGACAATGTCGGACAATGTCGGACAATCAGATATCCTATACTCTGAGCGGCCGCCGCGTAGCT", 5},
+    }},
+    {6, {
+      {"CTAGCTGAGCCTAGCTGAGCCTAGCTGAGCC", 25},
+      {"GAGCCAAGCTGAGCCTAGCTGAGCCTAGCTGAGCCTAGCTGAGCTCCGTCAGACAGAATTGCCGTCGGTCCCACGAGTGTTCAATCCGGGTACG", 7},
+      {"GGTGTCTCGTGCTCAAGTTATACAGACTCTCCTGCCAACGACCCTGGCCACTAGCTGAGCCTAGCTGAGCCTAGCTGGGCCTAGCTGAGCTCCGTCAGACAGAATTGCCGTCGGTCCCACGAGTGTTCAATCCGGGTACG", 6},
+    }},
+    {10, {
+      {"GTGATAGACTGAGTATCGTTACAGAAACATAAGAGGATCATCGGCGGTAACATACTACATACTACATACTACATACTACACCGACAGAGATAATTGATGGCAAGCTGCCCTCGCAGGGCACTC", 14},
+      {"CATACTACATACTACATACTACATACTACATACTACACCGACAGAGATAATTGATGGCAAGCTGCCCTCGCAGGGGACT", 11},
+      {"GTGATAGACTGAGTATCGTTACAGAAACATAAGAGGATCATCGGCGGTAACATACTACATACTACATACTACATACTACATACCACATACTACA", 7},
+    }},
+    {16, {
+      {"AGCCCTAGCCCTAGCCCTAGCCCTAGCCCTA", 19},
+      {"AAGACGACAGCATTCCGTTGCACTAGACTGCCAGGTAATAGACTATTTTGGCCCTAGCCCTAGCCCTAGCCCTAGCCCTAGCCCTA", 11},
+      {"GCCCTAGCCCTAGCCCTAGCCCTAGCCCTAGCCCTATACAAGAGGGAACTGGAGCCACAAGTATAGCCACAATAGCTGTTTCTG", 7},
+    }},
+  };
+  // clang-format on
+
+  IterativeAssemblerOptions assembleOpt;
+  assembleOpt.minWordLength = 11;
+  assembleOpt.maxWordLength = 31;
+  assembleOpt.wordStepSize  = 5;
+  assembleOpt.minCoverage   = 1;
+
+  for (const ExpectedAssembly& expected : expectedAssemblies) {
+    AssemblyReadInput reads;
+    getTandemRepeatReads(expected.seed, reads);
+
+    AssemblyReadOutput readInfo;
+    Assembly           contigs;
+    runIterativeAssembler(assembleOpt, reads, readInfo, contigs);
+
+    BOOST_TEST_MESSAGE("Checking tandem repeat read set with seed: " << expected.seed);
+    BOOST_REQUIRE_EQUAL(contigs.size(), expected.contigs.size());
+    for (unsigned contigIndex(0); contigIndex < contigs.size(); ++contigIndex) {
+      BOOST_REQUIRE_EQUAL(contigs[contigIndex].seq, expected.contigs[contigIndex].seq);
+      BOOST_REQUIRE_EQUAL(
+          contigs[contigIndex].supportReads.size(), expected.contigs[contigIndex].supportReadCount);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
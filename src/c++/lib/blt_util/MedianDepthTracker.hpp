@@ -31,15 +31,16 @@
 ///
 /// Note that by design depth=0 is excluded from the median
 struct MedianDepthTracker {
-  void addObs(const unsigned val)
+  /// \brief Add \p count observations of depth \p val
+  void addObs(const unsigned val, const unsigned count = 1)
   {
     auto iter(_cmap.find(val));
     if (iter == _cmap.end()) {
-      _cmap[val] = 1;
+      _cmap[val] = count;
     } else {
-      iter->second++;
+      iter->second += count;
     }
-    _total++;
+    _total += count;
   }
 
   double getMedian() const
@@ -0,0 +1,180 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "blt_util/SharedFileCounter.hpp"
+#include "blt_util/blt_exception.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
+#include <sstream>
+
+static void throwCounterError(const std::string& filename, const char* action)
+{
+  std::ostringstream oss;
+  oss << "Failed to " << action << " shared counter file '" << filename << "': " << std::strerror(errno);
+  throw blt_exception(oss.str().c_str());
+}
+
+#ifndef _WIN32
+
+SharedFileCounter::SharedFileCounter(const std::string& filename, const uint64_t key)
+  : _filename(filename), _fd(-1)
+{
+  _fd = open(_filename.c_str(), O_RDWR | O_CREAT, 0666);
+  if (_fd < 0) throwCounterError(_filename, "open");
+
+  setLock(F_WRLCK);
+  CounterData data(readData());
+  if ((data.value == 0) && (data.key == 0) && (data.limit == 0)) {
+    data.key = key;
+    writeData(data);
+  }
+  setLock(F_UNLCK);
+
+  if (data.key != key) {
+    std::ostringstream oss;
+    oss << "Shared counter file '" << _filename << "' is already in use for a different purpose or input";
+    throw blt_exception(oss.str().c_str());
+  }
+}
+
+SharedFileCounter::~SharedFileCounter()
+{
+  if (_fd >= 0) close(_fd);
+}
+
+void SharedFileCounter::setLock(const short lockType)
+{
+  struct flock lock;
+  std::memset(&lock, 0, sizeof(lock));
+  lock.l_type   = lockType;
+  lock.l_whence = SEEK_SET;
+  lock.l_start  = 0;
+  lock.l_len    = 0;
+
+  while (fcntl(_fd, F_SETLKW, &lock) == -1) {
+    if (errno != EINTR) throwCounterError(_filename, "lock");
+  }
+}
+
+SharedFileCounter::CounterData SharedFileCounter::readData()
+{
+  CounterData   data;
+  const ssize_t readSize(pread(_fd, &data, sizeof(data), 0));
+  if ((readSize != 0) && (readSize != sizeof(data))) {
+    throwCounterError(_filename, "read");
+  }
+  return data;
+}
+
+void SharedFileCounter::writeData(const CounterData& data)
+{
+  if (pwrite(_fd, &data, sizeof(data), 0) != sizeof(data)) {
+    throwCounterError(_filename, "write");
+  }
+}
+
+uint64_t SharedFileCounter::fetchAndIncrement()
+{
+  setLock(F_WRLCK);
+  CounterData    data(readData());
+  const uint64_t value(data.value);
+  data.value++;
+  writeData(data);
+  setLock(F_UNLCK);
+  return value;
+}
+
+uint64_t SharedFileCounter::getValue()
+{
+  setLock(F_RDLCK);
+  const CounterData data(readData());
+  setLock(F_UNLCK);
+  return data.value;
+}
+
+uint64_t SharedFileCounter::getLimit()
+{
+  setLock(F_RDLCK);
+  const CounterData data(readData());
+  setLock(F_UNLCK);
+  return data.limit;
+}
+
+uint64_t SharedFileCounter::recordLimit(const uint64_t limit)
+{
+  setLock(F_WRLCK);
+  CounterData data(readData());
+  if (data.limit == 0) {
+    data.limit = limit;
+    writeData(data);
+  }
+  setLock(F_UNLCK);
+  return data.limit;
+}
+
+#else
+
+SharedFileCounter::SharedFileCounter(const std::string& filename, const uint64_t)
+  : _filename(filename), _fd(-1)
+{
+  throw blt_exception("Shared file counters are not supported on this platform");
+}
+
+SharedFileCounter::~SharedFileCounter() {}
+
+void SharedFileCounter::setLock(const short) {}
+
+SharedFileCounter::CounterData SharedFileCounter::readData()
+{
+  return CounterData();
+}
+
+void SharedFileCounter::writeData(const CounterData&) {}
+
+uint64_t SharedFileCounter::fetchAndIncrement()
+{
+  return 0;
+}
+
+uint64_t SharedFileCounter::getValue()
+{
+  return 0;
+}
+
+uint64_t SharedFileCounter::getLimit()
+{
+  return 0;
+}
+
+uint64_t SharedFileCounter::recordLimit(const uint64_t limit)
+{
+  return limit;
+}
+
+#endif
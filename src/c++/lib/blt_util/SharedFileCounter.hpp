@@ -0,0 +1,84 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Integer counter stored in a file, which can be shared by multiple processes
+///
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+#include <string>
+
+/// A counter shared by all processes opening the same file
+///
+/// Each increment is made under an exclusive POSIX record lock on the file, so that concurrent processes
+/// always receive distinct counter values. A missing or empty file is treated as a counter value of zero.
+///
+/// The file also stores a key identifying what the counter is used for, and an optional limit on the useful
+/// counter value, so that a file left over from an unrelated or completed run can be detected.
+///
+/// Locks are held per-process, so a single object must not be used concurrently from multiple threads.
+///
+struct SharedFileCounter : private boost::noncopyable {
+  /// \param filename Counter file, this is created if it does not already exist
+  /// \param key Identifies the use of this counter. The key is stored in a new or empty file, and an
+  ///            exception is thrown if an existing file holds a different key.
+  explicit SharedFileCounter(const std::string& filename, const uint64_t key = 0);
+
+  ~SharedFileCounter();
+
+  /// Atomically increment the counter across all processes
+  ///
+  /// \return The counter value before the increment
+  uint64_t fetchAndIncrement();
+
+  /// \return The current counter value
+  uint64_t getValue();
+
+  /// \return The counter limit stored by recordLimit, or zero if no limit has been stored
+  uint64_t getLimit();
+
+  /// Store the counter limit if no limit has been stored yet
+  ///
+  /// \return The stored counter limit, which differs from \p limit if another process stored a different
+  /// value first
+  uint64_t recordLimit(const uint64_t limit);
+
+private:
+  /// Counter file contents, in native byte order
+  struct CounterData {
+    uint64_t value = 0;
+    uint64_t key   = 0;
+    uint64_t limit = 0;
+  };
+
+  void setLock(const short lockType);
+
+  /// Read the counter file, which must already be locked
+  CounterData readData();
+
+  /// Write the counter file, which must already be locked
+  void writeData(const CounterData& data);
+
+  std::string _filename;
+  int         _fd;
+};
@@ -27,8 +27,10 @@
 
 #include "boost/foreach.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 //#define DEBUG_RPS
@@ -63,7 +65,11 @@ void SizeDistribution::calcStats() const
          << "numOfSized=" << _sizeMap.size() << "\n";
 #endif
   _isStatsComputed = true;
-  if (_sizeMap.empty()) return;
+  if (_sizeMap.empty()) {
+    // clear any quantiles left from earlier observations, or from a distribution loaded into the same object:
+    std::fill(_quantiles.begin(), _quantiles.end(), 0);
+    return;
+  }
 
   populateCdfQuantiles(_sizeMap, _totalCount, _quantiles);
 }
@@ -83,8 +89,19 @@ int SizeDistribution::quantile(const float prob) const
 
 float SizeDistribution::cdf(const int size) const
 {
+  if (_isFrozen && (!_cdfTable.empty())) {
+    if (size < _tableMinSize) return 0;
+    const unsigned tableIndex(static_cast<unsigned>(size) - static_cast<unsigned>(_tableMinSize));
+    if (tableIndex >= _cdfTable.size()) return _cdfTable.back();
+    return _cdfTable[tableIndex];
+  }
+
   if (!_isStatsComputed) calcStats();
+  return cdfFromMap(size);
+}
 
+float SizeDistribution::cdfFromMap(const int size) const
+{
   // map uses greater<int> for comp, so lower bound is "first element not greater than" size, from a list
   // sorted high->low
   const map_type::const_iterator sizeIter(_sizeMap.lower_bound(size));
@@ -94,9 +111,19 @@ float SizeDistribution::cdf(const int size) const
 
 float SizeDistribution::pdf(const int size) const
 {
-  if (!_isStatsComputed) calcStats();
+  if (_isFrozen && (!_pdfTable.empty())) {
+    if (size < _tableMinSize) return edgePdf(size, _lowEdgeSize, _lowEdgeCount);
+    const unsigned tableIndex(static_cast<unsigned>(size) - static_cast<unsigned>(_tableMinSize));
+    if (tableIndex >= _pdfTable.size()) return edgePdf(size, _highEdgeSize, _highEdgeCount);
+    return _pdfTable[tableIndex];
+  }
 
-  static const unsigned targetSampleSize(5);
+  return pdfFromMap(size);
+}
+
+float SizeDistribution::pdfFromMap(const int size) const
+{
+  static const unsigned targetSampleSize(_pdfSampleSize);
 
   unsigned count(0);
   int      minSize(size);
@@ -159,6 +186,70 @@ float SizeDistribution::pdf(const int size) const
   return count / (static_cast<float>(_totalCount) * static_cast<float>(1 + maxSize - minSize));
 }
 
+void SizeDistribution::freeze()
+{
+  // don't tabulate distributions with an unusually large size range, these fall back to (thread-safe) size
+  // map queries once the statistics are computed:
+  static const unsigned maxTableSize(1 << 24);
+
+  if (!_isStatsComputed) calcStats();
+
+  _cdfTable.clear();
+  _pdfTable.clear();
+  _isFrozen = true;
+  if (_sizeMap.empty()) return;
+
+  // the size map is sorted from high to low:
+  const int      maxSize(_sizeMap.begin()->first);
+  const int      minSize(_sizeMap.rbegin()->first);
+  const unsigned tableSize(static_cast<unsigned>(static_cast<int64_t>(maxSize) - minSize + 1));
+  if (tableSize > maxTableSize) return;
+
+  _tableMinSize = minSize;
+  _cdfTable.resize(tableSize);
+  _pdfTable.resize(tableSize);
+  for (unsigned tableIndex(0); tableIndex < tableSize; ++tableIndex) {
+    const int size(minSize + static_cast<int>(tableIndex));
+    _cdfTable[tableIndex] = cdfFromMap(size);
+    _pdfTable[tableIndex] = pdfFromMap(size);
+  }
+
+  // outside of the observed range, the pdf smoothing window is always made of the _pdfSampleSize
+  // observed sizes closest to that end of the distribution:
+  _lowEdgeCount = 0;
+  unsigned sampleIndex(0);
+  for (auto iter(_sizeMap.rbegin()); (iter != _sizeMap.rend()) && (sampleIndex < _pdfSampleSize);
+       ++iter, ++sampleIndex) {
+    _lowEdgeSize = iter->first;
+    _lowEdgeCount += iter->second.count;
+  }
+
+  _highEdgeCount = 0;
+  sampleIndex    = 0;
+  for (auto iter(_sizeMap.begin()); (iter != _sizeMap.end()) && (sampleIndex < _pdfSampleSize);
+       ++iter, ++sampleIndex) {
+    _highEdgeSize = iter->first;
+    _highEdgeCount += iter->second.count;
+  }
+}
+
+void SizeDistribution::loadPrecomputed(
+    const unsigned totalCount, const std::vector<std::pair<int, SizeData>>& sizeData, const int* quantiles)
+{
+  _totalCount = totalCount;
+  _sizeMap.clear();
+
+  // the size map is sorted from high to low, so each new size is inserted at the front:
+  for (const std::pair<int, SizeData>& sizeValue : sizeData) {
+    assert(_sizeMap.empty() || (sizeValue.first > _sizeMap.begin()->first));
+    _sizeMap.emplace_hint(_sizeMap.begin(), sizeValue);
+  }
+  _quantiles.assign(quantiles, quantiles + _quantileNum);
+
+  _isStatsComputed = true;
+  freeze();
+}
+
 void SizeDistribution::filterObservationsOverQuantile(const float prob)
 {
   const int                maxSize(quantile(prob));
@@ -175,6 +266,7 @@ void SizeDistribution::filterObservationsOverQuantile(const float prob)
   _sizeMap.erase(sizeBegin, sizeEnd);
 
   _isStatsComputed = false;
+  _isFrozen        = false;
 }
 
 std::ostream& operator<<(std::ostream& os, const SizeDistribution& sd)
@@ -28,9 +28,11 @@
 #include "boost/serialization/nvp.hpp"
 #include "boost/serialization/split_member.hpp"
 
+#include <cstdlib>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <utility>
 #include <vector>
 
 struct SizeData {
@@ -60,8 +62,13 @@ BOOST_CLASS_IMPLEMENTATION(SizeMapXmlElement, object_serializable)
 
 /// \brief Accumulate size observations and provide cdf/quantile/smoothed-pdf for the distribution
 ///
+/// Distribution statistics are computed lazily on first query, so concurrent queries are only safe after
+/// freeze() has been called. Any update to the observations reverts the distribution to the lazy state.
+///
 struct SizeDistribution {
-  SizeDistribution() : _isStatsComputed(false), _totalCount(0), _quantiles(_quantileNum, 0) {}
+  SizeDistribution() : _isStatsComputed(false), _isFrozen(false), _totalCount(0), _quantiles(_quantileNum, 0)
+  {
+  }
 
   /// \brief Implements the quantile function for this distribution
   ///
@@ -79,6 +86,7 @@ struct SizeDistribution {
   void addObservation(const int size)
   {
     _isStatsComputed = false;
+    _isFrozen        = false;
     _totalCount++;
     _sizeMap[size].count++;
   }
@@ -86,11 +94,60 @@ struct SizeDistribution {
   /// filter high value outliers:
   void filterObservationsOverQuantile(const float prob);
 
+  /// \brief Compute all distribution statistics and tabulate cdf and pdf values over the observed size range
+  ///
+  /// After this call, quantile, cdf and pdf are constant time lookups which don't modify the object, so they
+  /// can be called concurrently. Results are identical to those from the lazily computed statistics.
+  void freeze();
+
+  bool isFrozen() const { return _isFrozen; }
+
   typedef std::map<int, SizeData, std::greater<int>> map_type;
 
+  /// Number of entries in the quantile table
+  static unsigned quantileCount() { return _quantileNum; }
+
+  /// \return Observed sizes with their count and cumulative probability, sorted from high to low size
+  const map_type& getSizeMap() const
+  {
+    if (!_isStatsComputed) calcStats();
+    return _sizeMap;
+  }
+
+  /// \return Quantile table of quantileCount() entries
+  const std::vector<int>& getQuantiles() const
+  {
+    if (!_isStatsComputed) calcStats();
+    return _quantiles;
+  }
+
+  /// \brief Restore a distribution from precomputed statistics and freeze it
+  ///
+  /// This skips the statistics computation when the distribution was saved with the values returned by
+  /// getSizeMap and getQuantiles, so that results are identical to those of the original distribution.
+  ///
+  /// \param[in] sizeData Observed sizes with their count and cumulative probability, sorted from low to high
+  /// size
+  /// \param[in] quantiles Quantile table of quantileCount() entries
+  void loadPrecomputed(
+      const unsigned totalCount, const std::vector<std::pair<int, SizeData>>& sizeData, const int* quantiles);
+
 private:
   void calcStats() const;
 
+  /// cdf computed from the size map, requires calcStats
+  float cdfFromMap(const int size) const;
+
+  /// pdf computed from the size map
+  float pdfFromMap(const int size) const;
+
+  /// pdf of a size outside of the tabulated range, where the smoothing window is the \p edgeCount
+  /// observations at the nearest end of the distribution, extended from \p edgeSize to \p size
+  float edgePdf(const int size, const int edgeSize, const unsigned edgeCount) const
+  {
+    return edgeCount / (static_cast<float>(_totalCount) * static_cast<float>(1 + std::abs(size - edgeSize)));
+  }
+
   friend class boost::serialization::access;
   template <class Archive>
   void save(Archive& ar, const unsigned /*version*/) const
@@ -123,6 +180,7 @@ private:
       _sizeMap[xe.size].count = xe.count;
     }
     _isStatsComputed = false;
+    _isFrozen        = false;
   }
 
   BOOST_SERIALIZATION_SPLIT_MEMBER()
@@ -131,10 +189,25 @@ private:
 
   static const int _quantileNum = 1000;
 
+  /// Number of observed sizes summed in the pdf smoothing window
+  static const unsigned _pdfSampleSize = 5;
+
   mutable bool             _isStatsComputed;
+  bool                     _isFrozen;
   unsigned                 _totalCount;
   mutable std::vector<int> _quantiles;
   mutable map_type         _sizeMap;
+
+  // frozen lookup tables, indexed from the smallest observed size:
+  int                _tableMinSize = 0;
+  std::vector<float> _cdfTable;
+  std::vector<float> _pdfTable;
+
+  // pdf smoothing window for sizes below and above the observed range:
+  int      _lowEdgeSize   = 0;
+  unsigned _lowEdgeCount  = 0;
+  int      _highEdgeSize  = 0;
+  unsigned _highEdgeCount = 0;
 };
 
 BOOST_CLASS_IMPLEMENTATION(SizeDistribution, object_serializable)
@@ -23,29 +23,101 @@
 
 #pragma once
 
-#include "blt_util/RangeMap.hpp"
 #include "blt_util/blt_types.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 /// base object for depth_buffers, do not call this directly
+///
+/// Counts are stored in a dense circular buffer covering the window of keys [_beginKey,_endKey). Every buffer
+/// entry outside of this window is zero. When keys are incremented and cleared in approximately sorted order,
+/// the window slides along with the input and stays small, so no allocation is needed in the steady state.
+/// Any access order is still handled correctly, by growing the buffer to the required window size.
+///
 struct depth_buffer_base {
-  void clear() { _data.clear(); }
+  void clear()
+  {
+    for (pos_t key(_beginKey); key < _endKey; ++key) _data[getIndex(key)] = 0;
+    _beginKey = 0;
+    _endKey   = 0;
+  }
 
 protected:
-  unsigned _val(const pos_t pos) const { return _data.getConstRefDefault(pos, 0); }
+  unsigned _val(const pos_t key) const
+  {
+    if ((key < _beginKey) || (key >= _endKey)) return 0;
+    return _data[getIndex(key)];
+  }
 
-  /// increment range [pos,pos+range) by one
-  void _inc(const pos_t pos, const unsigned incVal) { _data.getRef(pos) += incVal; }
+  void _inc(const pos_t key, const unsigned incVal) { _incRange(key, key + 1, incVal); }
+
+  /// increment all keys in [beginKey,endKey) by incVal
+  void _incRange(const pos_t beginKey, const pos_t endKey, const unsigned incVal)
+  {
+    assert(beginKey < endKey);
+    expandWindow(beginKey, endKey);
+
+    // split the key range into at most two contiguous buffer segments, so that each increment loop can be
+    // vectorized:
+    const unsigned beginIndex(getIndex(beginKey));
+    const unsigned size(endKey - beginKey);
+    const unsigned size1(std::min(size, static_cast<unsigned>(_data.size()) - beginIndex));
+    unsigned*      data(_data.data());
+    for (unsigned i(0); i < size1; ++i) data[beginIndex + i] += incVal;
+    for (unsigned i(0); i < (size - size1); ++i) data[i] += incVal;
+  }
 
-  void _clear(const pos_t pos)
+  void _clear(const pos_t key)
   {
-    if (_data.isKeyPresent(pos)) _data.erase(pos);
+    if ((key < _beginKey) || (key >= _endKey)) return;
+    _data[getIndex(key)] = 0;
+
+    // slide the window start past all leading zero counts:
+    if (key != _beginKey) return;
+    while ((_beginKey < _endKey) && (_data[getIndex(_beginKey)] == 0)) _beginKey++;
   }
 
 private:
-  typedef RangeMap<pos_t, unsigned> count_t;
-  count_t                           _data;
+  unsigned getIndex(const pos_t key) const
+  {
+    return (static_cast<unsigned>(key) & static_cast<unsigned>(_data.size() - 1));
+  }
+
+  /// extend the key window to include [beginKey,endKey), growing the buffer if required
+  void expandWindow(const pos_t beginKey, const pos_t endKey)
+  {
+    if (_beginKey == _endKey) {
+      _beginKey = beginKey;
+      _endKey   = beginKey;
+    }
+
+    const pos_t newBeginKey(std::min(_beginKey, beginKey));
+    const pos_t newEndKey(std::max(_endKey, endKey));
+    const auto  windowSize(static_cast<std::size_t>(newEndKey - newBeginKey));
+    if (windowSize > _data.size()) {
+      // buffer size must be a power of two so that keys can be mapped to buffer indices with a mask:
+      std::size_t newSize(std::max(_data.size(), minBufferSize));
+      while (newSize < windowSize) newSize *= 2;
+
+      std::vector<unsigned> newData(newSize, 0);
+      const auto            newMask(static_cast<unsigned>(newSize - 1));
+      for (pos_t key(_beginKey); key < _endKey; ++key) {
+        newData[static_cast<unsigned>(key) & newMask] = _data[getIndex(key)];
+      }
+      _data.swap(newData);
+    }
+
+    _beginKey = newBeginKey;
+    _endKey   = newEndKey;
+  }
+
+  static const std::size_t minBufferSize = 1024;
+
+  pos_t                 _beginKey = 0;
+  pos_t                 _endKey   = 0;
+  std::vector<unsigned> _data;
 };
 
 /// simple map of position to depth
@@ -89,19 +161,21 @@ struct depth_buffer_compressible : public depth_buffer_base {
   unsigned val(const pos_t pos) const { return ((_val(pos / _csize) + _halfcsize) / _csize); }
 
   /// increment range [pos,pos+range) by one
-  void inc(pos_t pos, const unsigned posRange = 1)
+  void inc(const pos_t pos, const unsigned posRange = 1)
   {
     assert(posRange >= 1);
     const pos_t endPos(pos + posRange);
-    pos_t       dataPos(pos / _csize);
-    while (true) {
-      const pos_t blockEndPos(std::min(((dataPos + 1) * static_cast<pos_t>(_csize)), endPos));
-      _inc(dataPos, (blockEndPos - pos));
-
-      if (blockEndPos == endPos) return;
-      pos = blockEndPos;
-      dataPos++;
+    const pos_t beginDataPos(pos / _csize);
+    const pos_t lastDataPos((endPos - 1) / _csize);
+    if (beginDataPos == lastDataPos) {
+      _inc(beginDataPos, posRange);
+      return;
     }
+
+    // partial leading and trailing blocks, with all complete blocks in between incremented as one range:
+    _inc(beginDataPos, ((beginDataPos + 1) * static_cast<pos_t>(_csize)) - pos);
+    if ((beginDataPos + 1) < lastDataPos) _incRange(beginDataPos + 1, lastDataPos, _csize);
+    _inc(lastDataPos, endPos - (lastDataPos * static_cast<pos_t>(_csize)));
   }
 
   /// if compressionFactor is gt 1, pos arguments must be ordered to prevent surprising behavior
@@ -113,6 +187,8 @@ struct depth_buffer_compressible : public depth_buffer_base {
     _clear(dataPos);
   }
 
+  unsigned compression_factor() const { return _csize; }
+
 private:
   const unsigned _csize;
   const unsigned _halfcsize;
@@ -0,0 +1,107 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "boost/test/unit_test.hpp"
+
+#include "SharedFileCounter.hpp"
+#include "blt_util/blt_exception.hpp"
+#include "test/testFileMakers.hpp"
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <cstdlib>
+
+BOOST_AUTO_TEST_SUITE(test_SharedFileCounter)
+
+BOOST_AUTO_TEST_CASE(test_SharedFileCounterSequential)
+{
+  TestFilenameMaker counterFile;
+
+  SharedFileCounter counter1(counterFile.getFilename());
+  SharedFileCounter counter2(counterFile.getFilename());
+
+  BOOST_REQUIRE_EQUAL(counter1.fetchAndIncrement(), 0u);
+  BOOST_REQUIRE_EQUAL(counter2.fetchAndIncrement(), 1u);
+  BOOST_REQUIRE_EQUAL(counter1.fetchAndIncrement(), 2u);
+}
+
+// Test that a counter file can only be shared by counters with the same key
+BOOST_AUTO_TEST_CASE(test_SharedFileCounterKey)
+{
+  TestFilenameMaker counterFile;
+
+  SharedFileCounter counter1(counterFile.getFilename(), 7);
+  BOOST_REQUIRE_EQUAL(counter1.fetchAndIncrement(), 0u);
+
+  SharedFileCounter counter2(counterFile.getFilename(), 7);
+  BOOST_REQUIRE_EQUAL(counter2.fetchAndIncrement(), 1u);
+
+  BOOST_REQUIRE_THROW(SharedFileCounter(counterFile.getFilename(), 8), blt_exception);
+}
+
+// Test that the first recorded counter limit is kept
+BOOST_AUTO_TEST_CASE(test_SharedFileCounterLimit)
+{
+  TestFilenameMaker counterFile;
+
+  SharedFileCounter counter1(counterFile.getFilename());
+  SharedFileCounter counter2(counterFile.getFilename());
+  BOOST_REQUIRE_EQUAL(counter1.getLimit(), 0u);
+  BOOST_REQUIRE_EQUAL(counter1.recordLimit(3), 3u);
+  BOOST_REQUIRE_EQUAL(counter2.recordLimit(4), 3u);
+  BOOST_REQUIRE_EQUAL(counter2.getLimit(), 3u);
+
+  counter1.fetchAndIncrement();
+  BOOST_REQUIRE_EQUAL(counter2.getValue(), 1u);
+}
+
+#ifndef _WIN32
+// Test that concurrent processes never receive the same counter value
+BOOST_AUTO_TEST_CASE(test_SharedFileCounterMultiProcess)
+{
+  TestFilenameMaker     counterFile;
+  static const unsigned incrementCount(200);
+
+  const pid_t childPid(fork());
+  BOOST_REQUIRE(childPid >= 0);
+  if (childPid == 0) {
+    SharedFileCounter childCounter(counterFile.getFilename());
+    for (unsigned incrementIndex(0); incrementIndex < incrementCount; ++incrementIndex) {
+      childCounter.fetchAndIncrement();
+    }
+    _exit(EXIT_SUCCESS);
+  }
+
+  SharedFileCounter counter(counterFile.getFilename());
+  for (unsigned incrementIndex(0); incrementIndex < incrementCount; ++incrementIndex) {
+    counter.fetchAndIncrement();
+  }
+
+  int childStatus(0);
+  BOOST_REQUIRE_EQUAL(waitpid(childPid, &childStatus, 0), childPid);
+  BOOST_REQUIRE(WIFEXITED(childStatus) && (WEXITSTATUS(childStatus) == EXIT_SUCCESS));
+
+  BOOST_REQUIRE_EQUAL(counter.fetchAndIncrement(), (2 * incrementCount));
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
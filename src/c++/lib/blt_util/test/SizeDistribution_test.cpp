@@ -22,6 +22,8 @@
 
 #include "blt_util/SizeDistribution.cpp"
 
+#include <random>
+
 BOOST_AUTO_TEST_SUITE(test_SizeDistribution)
 
 BOOST_AUTO_TEST_CASE(test_EmptySizeDistribution)
@@ -103,4 +105,40 @@ BOOST_AUTO_TEST_CASE(test_SizeDistributionPdf)
   BOOST_REQUIRE_CLOSE(sd.pdf(11), expect2, tol);
 }
 
+// Test that frozen lookup tables give exactly the same cdf, pdf and quantile values as the lazily computed
+// distribution, both within and outside of the observed size range
+BOOST_AUTO_TEST_CASE(test_SizeDistributionFreeze)
+{
+  std::mt19937 randGen(7);
+
+  for (unsigned testIndex(0); testIndex < 20; ++testIndex) {
+    SizeDistribution sd;
+
+    // use a sparse, skewed distribution so that the pdf smoothing window varies across the size range:
+    std::lognormal_distribution<float> sizeDist(5.5, 0.2 + 0.05 * testIndex);
+    const unsigned                     observationCount(1 + testIndex * testIndex * 20);
+    for (unsigned observationIndex(0); observationIndex < observationCount; ++observationIndex) {
+      sd.addObservation(static_cast<int>(sizeDist(randGen)));
+    }
+
+    SizeDistribution frozenSd(sd);
+    frozenSd.freeze();
+    BOOST_REQUIRE(frozenSd.isFrozen());
+
+    for (int size(-10); size < 3000; ++size) {
+      BOOST_REQUIRE_EQUAL(frozenSd.cdf(size), sd.cdf(size));
+      BOOST_REQUIRE_EQUAL(frozenSd.pdf(size), sd.pdf(size));
+    }
+    for (unsigned probIndex(0); probIndex <= 1000; ++probIndex) {
+      const float prob(probIndex / 1000.f);
+      BOOST_REQUIRE_EQUAL(frozenSd.quantile(prob), sd.quantile(prob));
+    }
+
+    // any update should revert to lazy stats computation:
+    frozenSd.addObservation(10);
+    BOOST_REQUIRE(!frozenSd.isFrozen());
+    BOOST_REQUIRE_EQUAL(frozenSd.totalObservations(), observationCount + 1);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,8 @@
 
 #include "depth_buffer.hpp"
 
+#include <map>
+
 BOOST_AUTO_TEST_SUITE(test_depth_buffer)
 
 /// return buffer loaded with simple test pattern
@@ -96,4 +98,44 @@ BOOST_AUTO_TEST_CASE(test_depth_buffer_compressible_clear)
   BOOST_REQUIRE_EQUAL(static_cast<int>(db.val(109)), 0);
 }
 
+/// Test depth values against a simple map while the depth window slides far enough to wrap the circular
+/// buffer, and jumps backward to force the buffer to grow
+BOOST_AUTO_TEST_CASE(test_depth_buffer_compressible_sliding)
+{
+  static const unsigned     compressionLevel(4);
+  depth_buffer_compressible db(compressionLevel);
+  std::map<pos_t, unsigned> expect;
+
+  const auto checkVal = [&](const pos_t pos) {
+    const auto     iter(expect.find(pos / compressionLevel));
+    const unsigned expectVal(
+        (iter == expect.end()) ? 0 : ((iter->second + (compressionLevel / 2)) / compressionLevel));
+    BOOST_REQUIRE_EQUAL(db.val(pos), expectVal);
+  };
+
+  const auto incRange = [&](const pos_t pos, const unsigned posRange) {
+    db.inc(pos, posRange);
+    for (pos_t i(pos); i < (pos + static_cast<pos_t>(posRange)); ++i) expect[i / compressionLevel]++;
+  };
+
+  static const pos_t readSize(100);
+  for (pos_t pos(0); pos < 20000; pos += 7) {
+    incRange(pos, readSize);
+    checkVal(pos);
+
+    // clear all positions which can no longer change:
+    for (pos_t clearPos(std::max(0, pos - 7)); clearPos < pos; ++clearPos) {
+      db.clear_pos(clearPos);
+      if ((clearPos % compressionLevel) == (compressionLevel - 1)) expect.erase(clearPos / compressionLevel);
+    }
+  }
+
+  // jump back far behind the current window:
+  incRange(10, 50);
+  for (pos_t pos(0); pos < 20200; ++pos) checkVal(pos);
+
+  db.clear();
+  for (pos_t pos(0); pos < 20200; pos += 13) BOOST_REQUIRE_EQUAL(db.val(pos), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "format/SVVcfRecord.hpp"
+
+#include "common/Exceptions.hpp"
+#include "htsapi/vcf_util.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+/// \brief Find the value of \p key in VCF INFO field \p info
+///
+/// \return True if \p key is found, in which case \p value is set to the key's value, or the empty string for
+/// a flag
+static bool getInfoValue(const std::string& info, const char* key, std::string& value)
+{
+  const unsigned         keySize(strlen(key));
+  std::string::size_type fieldStart(0);
+  while (fieldStart <= info.size()) {
+    std::string::size_type fieldEnd(info.find(';', fieldStart));
+    if (fieldEnd == std::string::npos) fieldEnd = info.size();
+
+    if ((0 == info.compare(fieldStart, keySize, key)) &&
+        (((fieldStart + keySize) == fieldEnd) || (info[fieldStart + keySize] == '='))) {
+      const std::string::size_type valueStart(std::min(fieldStart + keySize + 1, fieldEnd));
+      value.assign(info, valueStart, fieldEnd - valueStart);
+      return true;
+    }
+    fieldStart = fieldEnd + 1;
+  }
+  return false;
+}
+
+static void parseError(const std::string& line, const char* message)
+{
+  using namespace illumina::common;
+
+  std::ostringstream oss;
+  oss << "Can't parse SV VCF record, " << message << ". Record: '" << line << "'";
+  BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+}
+
+static int64_t parseInt64(const std::string& line, const std::string& s, const char* label)
+{
+  char*         end(nullptr);
+  const int64_t val(std::strtoll(s.c_str(), &end, 10));
+  if (s.empty() || (*end != '\0')) {
+    std::ostringstream oss;
+    oss << "invalid " << label << " value '" << s << "'";
+    parseError(line, oss.str().c_str());
+  }
+  return val;
+}
+
+void SVVcfRecord::parse(const std::string& initLine, const contig_index_t& contigIndex)
+{
+  line = initLine;
+
+  // Split the first VCF columns, up to and including INFO:
+  std::string            fields[VCFID::INFO + 1];
+  std::string::size_type fieldStart(0);
+  std::string::size_type lineEnd(line.size());
+  if ((lineEnd > 0) && (line[lineEnd - 1] == '\n')) lineEnd--;
+  for (unsigned fieldIndex(0); fieldIndex <= VCFID::INFO; ++fieldIndex) {
+    if (fieldStart > lineEnd) parseError(line, "too few columns");
+    std::string::size_type fieldEnd(line.find('\t', fieldStart));
+    if ((fieldEnd == std::string::npos) || (fieldEnd > lineEnd)) fieldEnd = lineEnd;
+    fields[fieldIndex].assign(line, fieldStart, fieldEnd - fieldStart);
+    fieldStart = fieldEnd + 1;
+  }
+
+  chrom = fields[VCFID::CHROM];
+  const auto contigIter(contigIndex.find(chrom));
+  contigOrder =
+      ((contigIter == contigIndex.end()) ? static_cast<int32_t>(contigIndex.size()) : contigIter->second);
+  pos = parseInt64(line, fields[VCFID::POS], "POS");
+  id  = fields[VCFID::ID];
+  ref = fields[VCFID::REF];
+  alt = fields[VCFID::ALT];
+
+  char* qualEnd(nullptr);
+  qual = std::strtod(fields[VCFID::QUAL].c_str(), &qualEnd);
+  if (fields[VCFID::QUAL].empty() || (*qualEnd != '\0')) qual = 0;
+  isPass = (fields[VCFID::FILT] == "PASS");
+
+  const std::string& info(fields[VCFID::INFO]);
+  std::string        value;
+  if (getInfoValue(info, "END", value)) {
+    endPos = parseInt64(line, value, "END");
+  } else {
+    endPos = pos + static_cast<int64_t>(ref.size()) - 1;
+  }
+
+  const bool isInv3(getInfoValue(info, "INV3", value));
+  const bool isInv5(getInfoValue(info, "INV5", value));
+  if (isInv3 && isInv5) parseError(line, "both INV3 and INV5 are set");
+  invState = (isInv3 ? INV3 : (isInv5 ? INV5 : NONE));
+
+  if (!getInfoValue(info, "MATEID", mateId)) mateId.clear();
+}
+
+void addVcfHeaderContig(const std::string& headerLine, SVVcfRecord::contig_index_t& contigIndex)
+{
+  static const std::string contigPrefix("##contig=<ID=");
+  if (0 != headerLine.compare(0, contigPrefix.size(), contigPrefix)) return;
+
+  const std::string::size_type idEnd(headerLine.find_first_of(",>", contigPrefix.size()));
+  if (idEnd == std::string::npos) return;
+
+  const std::string contig(headerLine, contigPrefix.size(), idEnd - contigPrefix.size());
+  contigIndex.insert(std::make_pair(contig, static_cast<int32_t>(contigIndex.size())));
+}
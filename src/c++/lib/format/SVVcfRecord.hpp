@@ -0,0 +1,81 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Minimal parsed form of Manta SV VCF records used to sort and merge VCF output
+///
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+/// \brief A single SV VCF record line with the fields used to sort and deduplicate Manta VCF output
+///
+/// Records are sorted by contig (in VCF header order, with any contigs missing from the header following in
+/// lexicographical order), then POS, END, REF, ALT and ID.
+///
+struct SVVcfRecord {
+  typedef std::map<std::string, int32_t> contig_index_t;
+
+  /// \brief Parse \p line into this record
+  ///
+  /// \param[in] line A VCF record line, the trailing newline is optional and is stored if present
+  /// \param[in] contigIndex Map from each contig name to its order in the VCF header
+  void parse(const std::string& line, const contig_index_t& contigIndex);
+
+  bool operator<(const SVVcfRecord& rhs) const
+  {
+    if (contigOrder != rhs.contigOrder) return (contigOrder < rhs.contigOrder);
+    if (chrom != rhs.chrom) return (chrom < rhs.chrom);
+    if (pos != rhs.pos) return (pos < rhs.pos);
+    if (endPos != rhs.endPos) return (endPos < rhs.endPos);
+    if (ref != rhs.ref) return (ref < rhs.ref);
+    if (alt != rhs.alt) return (alt < rhs.alt);
+    return (id < rhs.id);
+  }
+
+  enum inversion_t { NONE, INV3, INV5 };
+
+  std::string line;
+
+  int32_t     contigOrder = 0;
+  std::string chrom;
+  int64_t     pos = 0;
+  std::string id;
+  std::string ref;
+  std::string alt;
+
+  /// QUAL value, or zero if the QUAL field is not a number
+  double qual   = 0;
+  bool   isPass = false;
+
+  /// INFO END value, or the last REF position if END is not present
+  int64_t endPos = 0;
+
+  inversion_t invState = NONE;
+
+  /// INFO MATEID value, or empty if MATEID is not present
+  std::string mateId;
+};
+
+/// \brief Add the contig ID from a VCF '##contig' header line to \p contigIndex in header order
+///
+/// Lines other than '##contig' header lines are ignored.
+void addVcfHeaderContig(const std::string& headerLine, SVVcfRecord::contig_index_t& contigIndex);
@@ -0,0 +1,78 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "format/SortedVcfOutputStream.hpp"
+
+#include "blt_util/blt_exception.hpp"
+#include "blt_util/log.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+SortedVcfOutputStream::SortedVcfOutputStream(
+    const std::string& outputFile, const SVVcfRecord::contig_index_t& contigIndex)
+  : _contigIndex(contigIndex)
+{
+  if (outputFile.empty()) {
+    throw blt_exception("No output file specified to SortedVcfOutputStream");
+  }
+  _os.open(outputFile.c_str());
+  if (!_os) {
+    std::ostringstream oss;
+    oss << "Can't open output file: '" << outputFile << "'";
+    throw blt_exception(oss.str().c_str());
+  }
+}
+
+SortedVcfOutputStream::~SortedVcfOutputStream()
+{
+  try {
+    flush();
+  } catch (const std::exception& e) {
+    log_os << "ERROR: Failed to write sorted VCF records: " << e.what() << "\n";
+  }
+}
+
+void SortedVcfOutputStream::writeHeader(const std::string& header)
+{
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  _os << header;
+}
+
+void SortedVcfOutputStream::writeRecord(const std::string& recordLine)
+{
+  SVVcfRecord record;
+  record.parse(recordLine, _contigIndex);
+
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  _records.push_back(std::move(record));
+}
+
+void SortedVcfOutputStream::flush()
+{
+  std::lock_guard<std::mutex> lock(_writeMutex);
+  std::stable_sort(_records.begin(), _records.end());
+  for (const SVVcfRecord& record : _records) {
+    _os << record.line;
+  }
+  _records.clear();
+  _os.flush();
+}
@@ -0,0 +1,60 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Thread-safe VCF output stream which writes records in sorted order
+///
+
+#pragma once
+
+#include "format/SVVcfRecord.hpp"
+
+#include "boost/noncopyable.hpp"
+
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// \brief Thread-safe VCF output stream which writes all records in SVVcfRecord order
+///
+/// The header is written immediately, while records are buffered in memory until the stream is flushed or
+/// destroyed. Records with the same sort key are written in the order they were added.
+///
+class SortedVcfOutputStream : private boost::noncopyable {
+public:
+  /// \param contigIndex Map from each contig name to its order in the VCF header
+  SortedVcfOutputStream(const std::string& outputFile, const SVVcfRecord::contig_index_t& contigIndex);
+
+  ~SortedVcfOutputStream();
+
+  /// Write VCF header lines, these must be written before any records are flushed
+  void writeHeader(const std::string& header);
+
+  /// Add one VCF record line to the output buffer
+  void writeRecord(const std::string& recordLine);
+
+  /// Sort and write all buffered records
+  void flush();
+
+private:
+  const SVVcfRecord::contig_index_t& _contigIndex;
+  std::ofstream                      _os;
+  std::vector<SVVcfRecord>           _records;
+  std::mutex                         _writeMutex;
+};
@@ -50,7 +50,7 @@ VcfWriterSV::VcfWriterSV(
     const bool&            isOutputContig)
   : _referenceFilename(referenceFilename),
     _isOutputContig(isOutputContig),
-    _stream(outputFilename),
+    _stream(outputFilename, bamHeaderInfo.chrom_to_index),
     _header(bamHeaderInfo)
 {
 }
@@ -61,7 +61,7 @@ void VcfWriterSV::writeHeader(
   std::ostringstream oss;
   writeHeaderPrefix(progName, progVersion, oss);
   writeHeaderColumnKey(sampleNames, oss);
-  _stream.write(oss.str());
+  _stream.writeHeader(oss.str());
 }
 
 void VcfWriterSV::writeHeaderPrefix(const char* progName, const char* progVersion, std::ostream& os) const
@@ -412,7 +412,7 @@ void VcfWriterSV::writeTransloc(
   makeInfoField(infoTags, oss);            // INFO
   makeFormatSampleField(sampleTags, oss);  // FORMAT + SAMPLE
   oss << '\n';
-  _stream.write(oss.str());
+  _stream.writeRecord(oss.str());
 }
 
 void VcfWriterSV::writeTranslocPair(
@@ -632,7 +632,7 @@ void VcfWriterSV::writeIndel(
   makeInfoField(infoTags, oss);            // INFO
   makeFormatSampleField(sampleTags, oss);  // FORMAT + SAMPLE
   oss << '\n';
-  _stream.write(oss.str());
+  _stream.writeRecord(oss.str());
 }
 
 static bool isAcceptedSVType(const EXTENDED_SV_TYPE::index_t svType)
@@ -25,7 +25,7 @@
 
 #include "boost/any.hpp"
 
-#include "blt_util/io_util.hpp"
+#include "format/SortedVcfOutputStream.hpp"
 #include "htsapi/bam_header_info.hpp"
 #include "manta/EventInfo.hpp"
 #include "manta/JunctionIdGenerator.hpp"
@@ -141,9 +141,11 @@ private:
       const EventInfo&   event) const;
 
 protected:
-  const std::string&               _referenceFilename;
-  const bool&                      _isOutputContig;
-  mutable SynchronizedOutputStream _stream;
+  const std::string& _referenceFilename;
+  const bool&        _isOutputContig;
+
+  /// All records are buffered and written in sorted order when the writer is destroyed
+  mutable SortedVcfOutputStream _stream;
 
 private:
   const bam_header_info& _header;
@@ -30,11 +30,12 @@
 #include <iostream>
 #include <sstream>
 
-bam_dumper::bam_dumper(const char* filename, const bam_hdr_t& header) : _hdr(&header), _stream_name(filename)
+bam_dumper::bam_dumper(const char* filename, const bam_hdr_t& header, const char* mode)
+  : _hdr(&header), _stream_name(filename)
 {
   assert(filename);
 
-  _hfp = hts_open(filename, "wb");
+  _hfp = hts_open(filename, mode);
 
   if (!_hfp) {
     std::ostringstream oss;
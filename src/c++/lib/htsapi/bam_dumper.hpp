@@ -29,7 +29,8 @@
 
 /// \brief Helper for bam file writing
 struct bam_dumper {
-  bam_dumper(const char* filename, const bam_hdr_t& header);
+  /// \param mode htslib file mode, for example "wb1" writes BAM with fast compression
+  bam_dumper(const char* filename, const bam_hdr_t& header, const char* mode = "wb");
 
   /// Dtor closes the file if it is not already closed
   ~bam_dumper() { close(); }
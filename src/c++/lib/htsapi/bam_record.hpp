@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <iosfwd>
 
 #include "bam_seq.hpp"
@@ -39,23 +40,25 @@ struct bam_record {
   {
     if (this == &br) return (*this);
 
-    if (empty()) {
-      if (!br.empty()) {
-        freeBam();
-        _bp = bam_dup1(br._bp);
-      }
-      // else empty->empty : do nothing...
-    } else {
-      if (!br.empty()) {
-        bam_copy1(_bp, br._bp);
-      } else {
-        freeBam();
-        _bp = bam_init1();
-      }
+    if (!br.empty()) {
+      // reuses the data buffer of this record when it is large enough, including the buffer retained by
+      // clear():
+      bam_copy1(_bp, br._bp);
+    } else if (!empty()) {
+      freeBam();
+      _bp = bam_init1();
     }
+    // else empty->empty : do nothing...
     return (*this);
   }
 
+  /// \brief Reset to an empty record, retaining the allocated data buffer for reuse by a later assignment
+  void clear()
+  {
+    std::memset(&(_bp->core), 0, sizeof(_bp->core));
+    _bp->l_data = 0;
+  }
+
 private:
   const bam_record& operator==(const bam_record& rhs);
 
@@ -0,0 +1,62 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+///
+
+#include "htsapi/bam_region_cache.hpp"
+
+#include <cassert>
+
+std::size_t getBamRecordMemoryBytes(const bam_record& bamRead)
+{
+  const bam1_t* bp(bamRead.get_data());
+  return (sizeof(bam_record) + sizeof(bam1_t) + bp->m_data);
+}
+
+std::shared_ptr<const bam_region_cache_block> bam_region_cache::find(
+    const int tid, const int beginPos, const int endPos)
+{
+  for (const auto& blockPtr : _blocks) {
+    if (blockPtr->isContained(tid, beginPos, endPos)) {
+      _hitCount++;
+      return blockPtr;
+    }
+  }
+  _missCount++;
+  return std::shared_ptr<const bam_region_cache_block>();
+}
+
+void bam_region_cache::insert(std::shared_ptr<const bam_region_cache_block> blockPtr)
+{
+  assert(blockPtr);
+  if (!isBlockCacheable(blockPtr->memoryBytes)) return;
+
+  // Evict the oldest blocks until the new block fits. Any stream still reading an evicted block retains
+  // shared ownership of it until the stream is reset.
+  auto evictIter(_blocks.begin());
+  while ((evictIter != _blocks.end()) && ((_memoryBytes + blockPtr->memoryBytes) > _maxMemoryBytes)) {
+    _memoryBytes -= (*evictIter)->memoryBytes;
+    ++evictIter;
+  }
+  _blocks.erase(_blocks.begin(), evictIter);
+
+  _memoryBytes += blockPtr->memoryBytes;
+  _blocks.push_back(std::move(blockPtr));
+}
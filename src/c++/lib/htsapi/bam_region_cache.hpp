@@ -0,0 +1,108 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Interval-keyed cache of decoded alignment records
+///
+
+#pragma once
+
+#include "htsapi/bam_record.hpp"
+
+#include "boost/utility.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/// All decoded records from one indexed region query of an alignment file, in file order
+///
+struct bam_region_cache_block {
+  bam_region_cache_block(const int initTid, const int initBeginPos, const int initEndPos)
+    : tid(initTid), beginPos(initBeginPos), endPos(initEndPos)
+  {
+  }
+
+  /// True if every record returned by a query of [queryBeginPos,queryEndPos) on queryTid is in this block
+  bool isContained(const int queryTid, const int queryBeginPos, const int queryEndPos) const
+  {
+    return ((queryTid == tid) && (queryBeginPos >= beginPos) && (queryEndPos <= endPos));
+  }
+
+  int                    tid;
+  int                    beginPos;
+  int                    endPos;
+  std::size_t            memoryBytes = 0;
+  std::deque<bam_record> records;
+};
+
+/// Approximate heap footprint of a decoded record, used to enforce the cache memory limit
+std::size_t getBamRecordMemoryBytes(const bam_record& bamRead);
+
+/// Interval-keyed cache of decoded records from a single alignment file
+///
+/// This is intended to be shared by all bam_streamer objects reading the same alignment file from the
+/// same thread, so that each region is only decoded once even when multiple downstream stages query it. The
+/// cache is not thread-safe.
+///
+/// Records are added by bam_streamer as a side effect of reading a complete region from the file. Blocks are
+/// evicted in insertion order once the total memory of all cached records exceeds \p maxMemoryBytes.
+///
+struct bam_region_cache : private boost::noncopyable {
+  explicit bam_region_cache(const std::size_t maxMemoryBytes) : _maxMemoryBytes(maxMemoryBytes) {}
+
+  /// Remove all cached records and reset the hit/miss counters
+  void clear()
+  {
+    _blocks.clear();
+    _memoryBytes = 0;
+    _hitCount    = 0;
+    _missCount   = 0;
+  }
+
+  /// \brief Find a cached block containing all records for the query region
+  ///
+  /// Each call is counted as either a cache hit or miss.
+  ///
+  /// \return nullptr if no cached block contains the query region
+  std::shared_ptr<const bam_region_cache_block> find(const int tid, const int beginPos, const int endPos);
+
+  /// \brief Add a completely read region to the cache, evicting older blocks as required
+  ///
+  /// The block is not added if its size alone exceeds the memory limit.
+  void insert(std::shared_ptr<const bam_region_cache_block> blockPtr);
+
+  /// True if a block of size \p memoryBytes can be held by this cache
+  bool isBlockCacheable(const std::size_t memoryBytes) const { return (memoryBytes <= _maxMemoryBytes); }
+
+  std::size_t memoryBytes() const { return _memoryBytes; }
+
+  unsigned hitCount() const { return _hitCount; }
+
+  unsigned missCount() const { return _missCount; }
+
+private:
+  const std::size_t _maxMemoryBytes;
+  std::size_t       _memoryBytes = 0;
+  unsigned          _hitCount    = 0;
+  unsigned          _missCount   = 0;
+
+  std::vector<std::shared_ptr<const bam_region_cache_block>> _blocks;
+};
@@ -35,6 +35,8 @@
 
 stream_state_reporter::~stream_state_reporter() {}
 
+std::atomic<uint64_t> bam_streamer::_totalDecodedRecordCount(0);
+
 bam_streamer::bam_streamer(const char* filename, const char* referenceFilename, const char* region)
   : _is_record_set(false),
     _hfp(nullptr),
@@ -43,7 +45,11 @@ bam_streamer::bam_streamer(const char* filename, const char* referenceFilename,
     _hitr(nullptr),
     _record_no(0),
     _stream_name(filename),
-    _is_region(false)
+    _is_region(false),
+    _decodedRecordCount(0),
+    _cacheNextRecordIndex(0),
+    _cacheBeginPos(0),
+    _cacheEndPos(0)
 {
   assert(nullptr != filename);
   if ('\0' == *filename) {
@@ -92,6 +98,7 @@ bam_streamer::bam_streamer(const char* filename, const char* referenceFilename,
 
 bam_streamer::~bam_streamer()
 {
+  _flushDecodedRecordCount();
   if (nullptr != _hitr) hts_itr_destroy(_hitr);
   if (nullptr != _hidx) hts_idx_destroy(_hidx);
   if (nullptr != _hdr) bam_hdr_destroy(_hdr);
@@ -104,6 +111,18 @@ bam_streamer::~bam_streamer()
   }
 }
 
+void bam_streamer::setThreadPool(std::shared_ptr<hts_thread_pool> threadPoolPtr)
+{
+  if (threadPoolPtr) {
+    if (hts_set_thread_pool(_hfp, threadPoolPtr->get()) != 0) {
+      std::ostringstream oss;
+      oss << "Failed to attach thread pool to BAM/CRAM file: '" << name() << "'";
+      throw blt_exception(oss.str().c_str());
+    }
+  }
+  _threadPoolPtr = std::move(threadPoolPtr);
+}
+
 static bool fexists(const char* filename)
 {
   std::ifstream ifile(filename);
@@ -161,7 +180,13 @@ void bam_streamer::resetRegion(const char* region)
 
 void bam_streamer::resetRegion(int referenceContigId, int beginPos, int endPos)
 {
-  if (nullptr != _hitr) hts_itr_destroy(_hitr);
+  if (nullptr != _hitr) {
+    hts_itr_destroy(_hitr);
+    _hitr = nullptr;
+  }
+  _cacheBlockPtr.reset();
+  _cacheFillBlockPtr.reset();
+  _flushDecodedRecordCount();
 
   _load_index();
 
@@ -172,12 +197,26 @@ void bam_streamer::resetRegion(int referenceContigId, int beginPos, int endPos)
     throw blt_exception(oss.str().c_str());
   }
 
-  _hitr = sam_itr_queryi(_hidx, referenceContigId, beginPos, endPos);
-  if (_hitr == nullptr) {
-    std::ostringstream oss;
-    oss << "Failed to fetch region: #" << referenceContigId << ":" << beginPos << "-" << endPos
-        << " specified for BAM/CRAM file: '" << name() << "'";
-    throw blt_exception(oss.str().c_str());
+  // invalid ranges are left for htslib to reject below:
+  if (_regionCachePtr && (endPos >= beginPos)) {
+    _cacheBlockPtr = _regionCachePtr->find(referenceContigId, beginPos, endPos);
+    if (_cacheBlockPtr) {
+      _cacheNextRecordIndex = 0;
+      _cacheBeginPos        = beginPos;
+      _cacheEndPos          = endPos;
+    } else {
+      _cacheFillBlockPtr = std::make_shared<bam_region_cache_block>(referenceContigId, beginPos, endPos);
+    }
+  }
+
+  if (!_cacheBlockPtr) {
+    _hitr = sam_itr_queryi(_hidx, referenceContigId, beginPos, endPos);
+    if (_hitr == nullptr) {
+      std::ostringstream oss;
+      oss << "Failed to fetch region: #" << referenceContigId << ":" << beginPos << "-" << endPos
+          << " specified for BAM/CRAM file: '" << name() << "'";
+      throw blt_exception(oss.str().c_str());
+    }
   }
   _is_region = true;
   _region.clear();
@@ -186,10 +225,35 @@ void bam_streamer::resetRegion(int referenceContigId, int beginPos, int endPos)
   _record_no     = 0;
 }
 
+bool bam_streamer::_next_cached()
+{
+  const std::deque<bam_record>& records(_cacheBlockPtr->records);
+  const unsigned                recordCount(records.size());
+  while (_cacheNextRecordIndex < recordCount) {
+    const bam1_t& bamData(*(records[_cacheNextRecordIndex].get_data()));
+    _cacheNextRecordIndex++;
+
+    // Filter records from the (possibly larger) cached region using the same overlap criteria as the
+    // htslib region iterator:
+    if (bamData.core.pos >= _cacheEndPos) {
+      _cacheNextRecordIndex = recordCount;
+      break;
+    }
+    if (bam_endpos(&bamData) > _cacheBeginPos) return true;
+  }
+  return false;
+}
+
 bool bam_streamer::next()
 {
   if (nullptr == _hfp) return false;
 
+  if (_cacheBlockPtr) {
+    _is_record_set = _next_cached();
+    if (_is_record_set) _record_no++;
+    return _is_record_set;
+  }
+
   int ret;
   if (nullptr == _hitr) {
     ret = sam_read1(_hfp, _hdr, _brec._bp);
@@ -218,7 +282,25 @@ bool bam_streamer::next()
   }
 
   _is_record_set = (ret >= 0);
-  if (_is_record_set) _record_no++;
+  if (_is_record_set) {
+    _record_no++;
+    _decodedRecordCount++;
+  } else {
+    _flushDecodedRecordCount();
+  }
+
+  if (_cacheFillBlockPtr) {
+    if (_is_record_set) {
+      bam_region_cache_block& block(*_cacheFillBlockPtr);
+      block.records.push_back(_brec);
+      block.memoryBytes += getBamRecordMemoryBytes(block.records.back());
+      if (!_regionCachePtr->isBlockCacheable(block.memoryBytes)) _cacheFillBlockPtr.reset();
+    } else {
+      // the region has been read to completion, so it can be used to serve subsequent queries:
+      _regionCachePtr->insert(std::move(_cacheFillBlockPtr));
+      _cacheFillBlockPtr.reset();
+    }
+  }
 
   return _is_record_set;
 }
@@ -24,11 +24,16 @@
 #pragma once
 
 #include "htsapi/bam_record.hpp"
+#include "htsapi/bam_region_cache.hpp"
+#include "htsapi/hts_thread_pool.hpp"
 #include "htsapi/sam_util.hpp"
 
 #include "boost/utility.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
 /// Interface for any object which provides current record and file position for error reporting purposes
@@ -80,11 +85,38 @@ struct bam_streamer : public stream_state_reporter, public boost::noncopyable {
   const bam_record* get_record_ptr() const
   {
     if (_is_record_set)
-      return &_brec;
+      return (_cacheBlockPtr ? &(_cacheBlockPtr->records[_cacheNextRecordIndex - 1]) : &_brec);
     else
       return nullptr;
   }
 
+  /// \brief Share a decoded record cache with other streams reading the same alignment file
+  ///
+  /// After this is set, any region query which is contained in a cached region is served from memory
+  /// instead of the alignment file. Each region which is read from the file to completion is added to the
+  /// cache. The cache must correspond to this stream's alignment file and may be shared only by streams used
+  /// from the same thread.
+  ///
+  /// \param regionCachePtr Cache to use for all subsequent region queries, or nullptr to disable caching
+  void setRegionCache(std::shared_ptr<bam_region_cache> regionCachePtr)
+  {
+    _regionCachePtr = std::move(regionCachePtr);
+  }
+
+  /// \brief Decompress and decode the alignment file using threads from \p threadPoolPtr
+  ///
+  /// The pool may be shared with any other streams, including streams used from other threads.
+  ///
+  /// \param threadPoolPtr Thread pool to use for all subsequent reads, or nullptr to leave decoding on the
+  /// calling thread
+  void setThreadPool(std::shared_ptr<hts_thread_pool> threadPoolPtr);
+
+  /// \brief Total number of records decoded from alignment files by all streams in the process
+  ///
+  /// Records served from a region cache are not included. Each stream adds its records to the total when it
+  /// reaches the end of a region, is reset to a new region, or is destroyed.
+  static uint64_t getTotalDecodedRecordCount() { return _totalDecodedRecordCount.load(); }
+
   const char* name() const { return _stream_name.c_str(); }
 
   unsigned record_no() const { return _record_no; }
@@ -100,6 +132,16 @@ struct bam_streamer : public stream_state_reporter, public boost::noncopyable {
 private:
   void _load_index();
 
+  /// Advance to the next cached record overlapping the current region
+  bool _next_cached();
+
+  /// Add records decoded by this stream to the process total
+  void _flushDecodedRecordCount()
+  {
+    _totalDecodedRecordCount += _decodedRecordCount;
+    _decodedRecordCount = 0;
+  }
+
   bool       _is_record_set;
   htsFile*   _hfp;
   bam_hdr_t* _hdr;
@@ -112,4 +154,25 @@ private:
   std::string _stream_name;
   bool        _is_region;
   std::string _region;
+
+  // optional thread pool for file decompression, held here so that it outlives _hfp:
+  std::shared_ptr<hts_thread_pool> _threadPoolPtr;
+
+  /// Records decoded from the file which have not yet been added to _totalDecodedRecordCount
+  uint64_t _decodedRecordCount;
+
+  static std::atomic<uint64_t> _totalDecodedRecordCount;
+
+  // optional cache of decoded records shared with other streams on the same alignment file:
+  std::shared_ptr<bam_region_cache> _regionCachePtr;
+
+  /// Cached block used to serve the current region, if any
+  std::shared_ptr<const bam_region_cache_block> _cacheBlockPtr;
+  unsigned                                      _cacheNextRecordIndex;
+  int                                           _cacheBeginPos;
+  int                                           _cacheEndPos;
+
+  /// Block filled as the current region is read from the file, this is added to the cache if the region
+  /// is read to completion within the cache memory limit
+  std::shared_ptr<bam_region_cache_block> _cacheFillBlockPtr;
 };
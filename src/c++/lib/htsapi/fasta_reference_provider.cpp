@@ -0,0 +1,284 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "htsapi/fasta_reference_provider.hpp"
+
+#include "blt_util/blt_exception.hpp"
+#include "blt_util/parse_util.hpp"
+#include "blt_util/string_util.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Number of windows cached by shared providers of compressed FASTA files
+static const unsigned sharedCacheWindowCount(64);
+
+/// True if \p filename starts with the gzip magic number, as used by bgzip-compressed FASTA files
+static bool isGzipFile(const std::string& filename)
+{
+  std::ifstream ifs(filename.c_str(), std::ios::binary);
+  char          magic[2];
+  if (!ifs.read(magic, sizeof(magic))) return false;
+  return ((magic[0] == '\x1f') && (magic[1] == '\x8b'));
+}
+
+fasta_reference_provider::fasta_reference_provider(
+    const std::string& ref_file, const unsigned cacheWindowCount, const unsigned cacheWindowSize)
+  : _filename(ref_file), _cacheWindowCount(cacheWindowCount), _cacheWindowSize(cacheWindowSize)
+{
+  assert(!ref_file.empty());
+  assert(cacheWindowSize > 0);
+
+  // fai_load creates the FASTA index if it doesn't already exist:
+  _fai = fai_load(_filename.c_str());
+  if (nullptr == _fai) {
+    std::ostringstream oss;
+    oss << "Can't load index for reference file: '" << _filename << "'";
+    throw blt_exception(oss.str().c_str());
+  }
+
+  try {
+    readIndex();
+  } catch (...) {
+    fai_destroy(_fai);
+    throw;
+  }
+
+#ifndef _WIN32
+  if (isGzipFile(_filename)) return;
+
+  // Uncompressed FASTA files are read directly from a memory mapping, so the htslib handle isn't needed. If
+  // the file can't be mapped, all lookups fall back to the htslib handle.
+  const int fd(open(_filename.c_str(), O_RDONLY));
+  if (fd < 0) return;
+
+  struct stat fileStat;
+  if ((fstat(fd, &fileStat) == 0) && (fileStat.st_size > 0)) {
+    void* mapPtr(mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0));
+    if (mapPtr != MAP_FAILED) {
+      _data = static_cast<const char*>(mapPtr);
+      _size = fileStat.st_size;
+    }
+  }
+  close(fd);
+
+  if (nullptr != _data) {
+    fai_destroy(_fai);
+    _fai = nullptr;
+  }
+#endif
+}
+
+fasta_reference_provider::~fasta_reference_provider()
+{
+#ifndef _WIN32
+  if (nullptr != _data) munmap(const_cast<char*>(_data), _size);
+#endif
+  if (nullptr != _fai) fai_destroy(_fai);
+}
+
+void fasta_reference_provider::readIndex()
+{
+  static const char delim('\t');
+
+  const std::string faiFile(_filename + ".fai");
+  std::ifstream     fis(faiFile.c_str());
+  if (!fis) {
+    std::ostringstream oss;
+    oss << "Can't open index file: '" << faiFile << "'";
+    throw blt_exception(oss.str().c_str());
+  }
+
+  std::string              line;
+  std::vector<std::string> word;
+  while (getline(fis, line)) {
+    if (line.empty()) continue;
+    split_string(line, delim, word);
+    if (word.size() < 5) {
+      std::ostringstream oss;
+      oss << "Unexpected line format in index file: '" << faiFile << "' line: '" << line << "'";
+      throw blt_exception(oss.str().c_str());
+    }
+
+    using namespace illumina::blt_util;
+    contig_info contig;
+    contig.index     = _contigs.size();
+    contig.length    = parse_unsigned_str(word[1]);
+    contig.offset    = std::strtoull(word[2].c_str(), nullptr, 10);
+    contig.lineBases = parse_unsigned_str(word[3]);
+    contig.lineWidth = parse_unsigned_str(word[4]);
+    _contigs.insert(std::make_pair(word[0], contig));
+  }
+}
+
+void fasta_reference_provider::regionError(const std::string& chrom, int begin_pos, int end_pos) const
+{
+  std::ostringstream oss;
+  oss << "Can't find sequence region '" << chrom << ":" << (begin_pos + 1) << "-" << (end_pos + 1)
+      << "' in reference file: '" << _filename << "'";
+  throw blt_exception(oss.str().c_str());
+}
+
+const fasta_reference_provider::contig_info& fasta_reference_provider::getContig(
+    const std::string& chrom, int begin_pos, int end_pos) const
+{
+  const auto contigIter(_contigs.find(chrom));
+  if (contigIter == _contigs.end()) regionError(chrom, begin_pos, end_pos);
+  return contigIter->second;
+}
+
+void fasta_reference_provider::getRegionSeq(
+    const std::string& chrom, int begin_pos, int end_pos, std::string& ref_seq) const
+{
+  const contig_info& contig(getContig(chrom, begin_pos, end_pos));
+  const int          inputBeginPos(begin_pos);
+  const int          inputEndPos(end_pos);
+
+  // Clip the region exactly as faidx_fetch_seq does, so that at least one base is always returned:
+  if (end_pos < begin_pos) begin_pos = end_pos;
+  const int64_t maxPos(contig.length - 1);
+  const int64_t beginPos(std::min(std::max(static_cast<int64_t>(begin_pos), int64_t(0)), maxPos));
+  const int64_t endPos(std::min(std::max(static_cast<int64_t>(end_pos), int64_t(0)), maxPos) + 1);
+  if (beginPos < 0) regionError(chrom, inputBeginPos, inputEndPos);
+
+  ref_seq.clear();
+  if (_cacheWindowCount > 0) {
+    fetchCached(chrom, contig, beginPos, endPos, ref_seq);
+  } else {
+    fetch(chrom, contig, beginPos, endPos, ref_seq);
+  }
+}
+
+void fasta_reference_provider::fetch(
+    const std::string& chrom,
+    const contig_info& contig,
+    const int64_t      begin_pos,
+    const int64_t      end_pos,
+    std::string&       ref_seq) const
+{
+  assert(begin_pos <= end_pos);
+
+  if (nullptr != _data) {
+    // Copy the region one FASTA line at a time, skipping any non-sequence characters in the same way as
+    // htslib:
+    uint64_t pos(begin_pos);
+    while (pos < static_cast<uint64_t>(end_pos)) {
+      const uint64_t linePos(pos % contig.lineBases);
+      const uint64_t offset(contig.offset + (pos / contig.lineBases) * contig.lineWidth + linePos);
+      const uint64_t segmentSize(std::min(contig.lineBases - linePos, static_cast<uint64_t>(end_pos) - pos));
+      if ((offset + segmentSize) > _size) regionError(chrom, begin_pos, end_pos - 1);
+
+      const char* segment(_data + offset);
+      for (uint64_t i(0); i < segmentSize; ++i) {
+        if (isgraph(static_cast<unsigned char>(segment[i]))) ref_seq.push_back(segment[i]);
+      }
+      pos += segmentSize;
+    }
+    return;
+  }
+
+  char* ref_tmp(nullptr);
+  {
+    std::lock_guard<std::mutex> lock(_faiMutex);
+    int                         len;  // throwaway...
+    ref_tmp = faidx_fetch_seq(_fai, chrom.c_str(), begin_pos, end_pos - 1, &len);
+  }
+  if (nullptr == ref_tmp) regionError(chrom, begin_pos, end_pos - 1);
+  ref_seq.append(ref_tmp);
+  free(ref_tmp);
+}
+
+void fasta_reference_provider::fetchCached(
+    const std::string& chrom,
+    const contig_info& contig,
+    const int64_t      begin_pos,
+    const int64_t      end_pos,
+    std::string&       ref_seq) const
+{
+  // Lookups of a compressed FASTA file are serialized by the htslib handle in any case, so the cache mutex
+  // is simply held for the whole lookup:
+  std::lock_guard<std::mutex> lock(_cacheMutex);
+
+  for (int64_t windowIndex(begin_pos / _cacheWindowSize); (windowIndex * _cacheWindowSize) < end_pos;
+       ++windowIndex) {
+    const uint64_t key((static_cast<uint64_t>(contig.index) << 32) | windowIndex);
+    const auto     indexIter(_cacheIndex.find(key));
+    if (indexIter != _cacheIndex.end()) {
+      _cacheWindows.splice(_cacheWindows.begin(), _cacheWindows, indexIter->second);
+    } else {
+      const int64_t windowBeginPos(windowIndex * _cacheWindowSize);
+      const int64_t windowEndPos(std::min(windowBeginPos + _cacheWindowSize, contig.length));
+      _cacheWindows.emplace_front(key, std::string());
+      try {
+        fetch(chrom, contig, windowBeginPos, windowEndPos, _cacheWindows.front().second);
+      } catch (...) {
+        _cacheWindows.pop_front();
+        throw;
+      }
+      _cacheIndex[key] = _cacheWindows.begin();
+
+      if (_cacheWindows.size() > _cacheWindowCount) {
+        _cacheIndex.erase(_cacheWindows.back().first);
+        _cacheWindows.pop_back();
+      }
+    }
+
+    const int64_t      windowBeginPos(windowIndex * _cacheWindowSize);
+    const std::string& window(_cacheWindows.front().second);
+    const int64_t      copyBeginPos(std::max(begin_pos, windowBeginPos));
+    const int64_t      copyEndPos(std::min(end_pos, windowBeginPos + static_cast<int64_t>(window.size())));
+    if (copyBeginPos >= copyEndPos) regionError(chrom, begin_pos, end_pos - 1);
+    ref_seq.append(window, copyBeginPos - windowBeginPos, copyEndPos - copyBeginPos);
+  }
+}
+
+std::shared_ptr<const fasta_reference_provider> fasta_reference_provider::getShared(
+    const std::string& ref_file)
+{
+  static std::mutex                                                       sharedMutex;
+  static std::map<std::string, std::shared_ptr<fasta_reference_provider>> sharedProviders;
+
+  std::lock_guard<std::mutex> lock(sharedMutex);
+  auto&                       providerPtr(sharedProviders[ref_file]);
+  if (!providerPtr) {
+    const unsigned cacheWindowCount(isGzipFile(ref_file) ? sharedCacheWindowCount : 0);
+    try {
+      providerPtr = std::make_shared<fasta_reference_provider>(ref_file, cacheWindowCount);
+    } catch (...) {
+      sharedProviders.erase(ref_file);
+      throw;
+    }
+  }
+  return providerPtr;
+}
@@ -0,0 +1,130 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Persistent thread-safe reference sequence lookup
+///
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "htslib/faidx.h"
+}
+
+/// \brief Reference sequence lookup for a single indexed FASTA file
+///
+/// The FASTA index is loaded once on construction, after which the object serves any number of concurrent
+/// lookups. Uncompressed FASTA files are mapped into memory, so lookups from multiple threads only copy
+/// sequence out of the page cache without locking. bgzip-compressed FASTA files are read through a single
+/// htslib index handle, with lookups serialized by a mutex.
+///
+/// The provider can optionally keep the most recently used fixed-size reference windows in an LRU cache,
+/// which is mostly useful to avoid decompressing the same blocks of a compressed FASTA for nearby lookups.
+///
+struct fasta_reference_provider : private boost::noncopyable {
+  /// \param ref_file Indexed FASTA file. The index is created if it does not exist.
+  /// \param cacheWindowCount Maximum number of reference windows to cache, or zero to disable the cache
+  /// \param cacheWindowSize Number of reference bases in each cached window
+  explicit fasta_reference_provider(
+      const std::string& ref_file,
+      const unsigned     cacheWindowCount = 0,
+      const unsigned     cacheWindowSize  = 65536);
+
+  ~fasta_reference_provider();
+
+  /// \brief Get the reference sequence from a region
+  ///
+  /// Region positions are clipped to the chromosome as in htslib faidx_fetch_seq.
+  ///
+  /// \param begin_pos begin position (zero-indexed, closed)
+  /// \param end_pos end position (zero-indexed, closed)
+  void getRegionSeq(const std::string& chrom, int begin_pos, int end_pos, std::string& ref_seq) const;
+
+  const std::string& getFilename() const { return _filename; }
+
+  /// True if the FASTA file is read from a memory mapping
+  bool isMapped() const { return (nullptr != _data); }
+
+  /// \brief Get a provider for \p ref_file shared by all threads in the process
+  ///
+  /// The provider is created on first use. Window caching is enabled for compressed FASTA files only.
+  static std::shared_ptr<const fasta_reference_provider> getShared(const std::string& ref_file);
+
+private:
+  struct contig_info {
+    unsigned index;
+    int64_t  length;
+    uint64_t offset;
+    uint64_t lineBases;
+    uint64_t lineWidth;
+  };
+
+  typedef std::pair<uint64_t, std::string> cache_window_t;
+
+  /// Get the contig for \p chrom, or throw if the contig is not in the FASTA index
+  const contig_info& getContig(const std::string& chrom, int begin_pos, int end_pos) const;
+
+  /// Get sequence for the closed-open range [begin_pos,end_pos), which is already clipped to the chromosome
+  void fetch(
+      const std::string& chrom,
+      const contig_info& contig,
+      const int64_t      begin_pos,
+      const int64_t      end_pos,
+      std::string&       ref_seq) const;
+
+  void fetchCached(
+      const std::string& chrom,
+      const contig_info& contig,
+      const int64_t      begin_pos,
+      const int64_t      end_pos,
+      std::string&       ref_seq) const;
+
+  /// Throw an exception for a region which can't be retrieved from the reference
+  void regionError(const std::string& chrom, int begin_pos, int end_pos) const;
+
+  void readIndex();
+
+  std::string                                  _filename;
+  std::unordered_map<std::string, contig_info> _contigs;
+
+  /// memory mapping of an uncompressed FASTA file
+  const char* _data = nullptr;
+  uint64_t    _size = 0;
+
+  /// htslib index handle for a compressed FASTA file
+  faidx_t*           _fai = nullptr;
+  mutable std::mutex _faiMutex;
+
+  /// LRU window cache, most recently used window first
+  const unsigned                                                            _cacheWindowCount;
+  const int64_t                                                             _cacheWindowSize;
+  mutable std::mutex                                                        _cacheMutex;
+  mutable std::list<cache_window_t>                                         _cacheWindows;
+  mutable std::unordered_map<uint64_t, std::list<cache_window_t>::iterator> _cacheIndex;
+};
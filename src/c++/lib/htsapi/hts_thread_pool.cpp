@@ -0,0 +1,58 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "htsapi/hts_thread_pool.hpp"
+
+#include "blt_util/blt_exception.hpp"
+
+#include <cassert>
+#include <mutex>
+#include <sstream>
+
+hts_thread_pool::hts_thread_pool(const unsigned threadCount) : _threadCount(threadCount)
+{
+  assert(threadCount > 0);
+
+  _pool.qsize = 0;
+  _pool.pool  = hts_tpool_init(threadCount);
+  if (nullptr == _pool.pool) {
+    std::ostringstream oss;
+    oss << "Failed to create htslib thread pool with " << threadCount << " threads";
+    throw blt_exception(oss.str().c_str());
+  }
+}
+
+hts_thread_pool::~hts_thread_pool()
+{
+  hts_tpool_destroy(_pool.pool);
+}
+
+std::shared_ptr<hts_thread_pool> hts_thread_pool::getShared(const unsigned threadCount)
+{
+  static std::mutex                       sharedMutex;
+  static std::shared_ptr<hts_thread_pool> sharedPool;
+
+  if (0 == threadCount) return std::shared_ptr<hts_thread_pool>();
+
+  std::lock_guard<std::mutex> lock(sharedMutex);
+  if (!sharedPool) sharedPool = std::make_shared<hts_thread_pool>(threadCount);
+  return sharedPool;
+}
@@ -0,0 +1,61 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Shared htslib thread pool for alignment file decompression
+///
+
+#pragma once
+
+#include "boost/utility.hpp"
+
+#include <memory>
+
+extern "C" {
+#include "htslib/hts.h"
+#include "htslib/thread_pool.h"
+}
+
+/// \brief Owns an htslib thread pool which can be shared by any number of open alignment files
+///
+/// htslib uses the pool to inflate BGZF blocks and decode CRAM containers ahead of the thread reading the
+/// file. A single pool may be attached to files read from multiple threads. The pool must outlive every file
+/// it is attached to, which bam_streamer ensures by holding shared ownership of the pool.
+///
+struct hts_thread_pool : private boost::noncopyable {
+  /// \param threadCount Number of pool threads, must be at least 1
+  explicit hts_thread_pool(const unsigned threadCount);
+
+  ~hts_thread_pool();
+
+  htsThreadPool* get() { return &_pool; }
+
+  unsigned threadCount() const { return _threadCount; }
+
+  /// \brief Get the thread pool shared by all alignment files in the process
+  ///
+  /// The pool is created with \p threadCount threads on the first call with a non-zero thread count, later
+  /// calls return the same pool regardless of \p threadCount.
+  ///
+  /// \return nullptr if \p threadCount is zero
+  static std::shared_ptr<hts_thread_pool> getShared(const unsigned threadCount);
+
+private:
+  unsigned      _threadCount;
+  htsThreadPool _pool;
+};
@@ -27,10 +27,8 @@
 #include "blt_util/parse_util.hpp"
 #include "blt_util/seq_util.hpp"
 #include "blt_util/string_util.hpp"
-
-extern "C" {
-#include "htslib/faidx.h"
-}
+#include "htsapi/bam_header_util.hpp"
+#include "htsapi/fasta_reference_provider.hpp"
 
 #include <cassert>
 
@@ -98,17 +96,10 @@ unsigned get_chrom_length(const std::string& fai_file, const std::string& chrom_
 
 void get_region_seq(const std::string& ref_file, const std::string& fa_region, std::string& ref_seq)
 {
-  faidx_t* fai(fai_load(ref_file.c_str()));
-  int      len;  // throwaway...
-  char*    ref_tmp(fai_fetch(fai, fa_region.c_str(), &len));
-  if (nullptr == ref_tmp) {
-    std::ostringstream oss;
-    oss << "Can't find sequence region '" << fa_region << "' in reference file: '" << ref_file << "'";
-    throw blt_exception(oss.str().c_str());
-  }
-  ref_seq.assign(ref_tmp);
-  free(ref_tmp);
-  fai_destroy(fai);
+  std::string chrom;
+  int32_t     begin_pos, end_pos;
+  parse_bam_region(fa_region.c_str(), chrom, begin_pos, end_pos);
+  get_region_seq(ref_file, chrom, begin_pos, (end_pos - 1), ref_seq);
 }
 
 void get_region_seq(
@@ -119,18 +110,7 @@ void get_region_seq(
     std::string&       ref_seq)
 {
   assert(!ref_file.empty());
-  faidx_t* fai(fai_load(ref_file.c_str()));
-  int      len;  // throwaway...
-  char*    ref_tmp(faidx_fetch_seq(fai, const_cast<char*>(chrom.c_str()), begin_pos, end_pos, &len));
-  if (nullptr == ref_tmp) {
-    std::ostringstream oss;
-    oss << "Can't find sequence region '" << chrom << ":" << (begin_pos + 1) << "-" << (end_pos + 1)
-        << "' in reference file: '" << ref_file << "'";
-    throw blt_exception(oss.str().c_str());
-  }
-  ref_seq.assign(ref_tmp);
-  free(ref_tmp);
-  fai_destroy(fai);
+  fasta_reference_provider::getShared(ref_file)->getRegionSeq(chrom, begin_pos, end_pos, ref_seq);
 }
 
 void get_standardized_region_seq(
@@ -35,6 +35,9 @@ void get_chrom_sizes(const std::string& fai_file, std::map<std::string, unsigned
 unsigned get_chrom_length(const std::string& fai_file, const std::string& chrom_name);
 
 /// get reference sequence from region
+///
+/// All reference sequence lookups use the process-wide fasta_reference_provider for \p ref_file, so the
+/// FASTA index is only loaded once.
 void get_region_seq(const std::string& ref_file, const std::string& fa_region, std::string& ref_seq);
 
 /// get reference sequence from decomposed region
@@ -0,0 +1,143 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "testConfig.h"
+
+#include "htsapi/bam_region_cache.hpp"
+#include "htsapi/bam_streamer.hpp"
+
+#include "boost/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(bam_region_cache_test_suite)
+
+static std::string getTestBamPath()
+{
+  return (std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+}
+
+/// Read all remaining records from stream and return their qnames
+static std::vector<std::string> getStreamQnames(bam_streamer& stream)
+{
+  std::vector<std::string> qnames;
+  while (stream.next()) {
+    qnames.emplace_back(stream.get_record_ptr()->qname());
+  }
+  return qnames;
+}
+
+/// Test that records served from the cache match those read directly from the alignment file
+BOOST_AUTO_TEST_CASE(test_bam_region_cache_hit)
+{
+  const std::string testBamPath(getTestBamPath());
+  auto              cachePtr(std::make_shared<bam_region_cache>(1000000));
+
+  bam_streamer cachedStream(testBamPath.c_str(), nullptr);
+  cachedStream.setRegionCache(cachePtr);
+  bam_streamer stream(testBamPath.c_str(), nullptr);
+
+  // The first query of a region is read from the file:
+  cachedStream.resetRegion(0, 0, 10);
+  BOOST_REQUIRE_EQUAL(getStreamQnames(cachedStream).size(), 2u);
+  BOOST_REQUIRE_EQUAL(cachePtr->hitCount(), 0u);
+  BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 1u);
+
+  // Any query contained in the first region is served from the cache, with the same overlap filtration
+  // as the file iterator:
+  static const int testRanges[][2] = {{0, 10}, {7, 9}, {0, 3}, {6, 7}, {9, 10}};
+  for (const auto& range : testRanges) {
+    cachedStream.resetRegion(0, range[0], range[1]);
+    stream.resetRegion(0, range[0], range[1]);
+    const std::vector<std::string> cachedQnames(getStreamQnames(cachedStream));
+    const std::vector<std::string> qnames(getStreamQnames(stream));
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(cachedQnames.begin(), cachedQnames.end(), qnames.begin(), qnames.end());
+  }
+  BOOST_REQUIRE_EQUAL(cachePtr->hitCount(), 5u);
+  BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 1u);
+
+  // A query on a different chromosome is a cache miss:
+  cachedStream.resetRegion(1, 0, 10);
+  BOOST_REQUIRE_EQUAL(getStreamQnames(cachedStream).size(), 2u);
+  BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 2u);
+
+  cachePtr->clear();
+  BOOST_REQUIRE_EQUAL(cachePtr->hitCount(), 0u);
+  BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 0u);
+  BOOST_REQUIRE_EQUAL(cachePtr->memoryBytes(), 0u);
+}
+
+/// Test that a region is only cached once it has been read to completion
+BOOST_AUTO_TEST_CASE(test_bam_region_cache_partial_read)
+{
+  const std::string testBamPath(getTestBamPath());
+  auto              cachePtr(std::make_shared<bam_region_cache>(1000000));
+
+  bam_streamer cachedStream(testBamPath.c_str(), nullptr);
+  cachedStream.setRegionCache(cachePtr);
+
+  cachedStream.resetRegion(1, 0, 14);
+  BOOST_REQUIRE(cachedStream.next());
+  cachedStream.resetRegion(1, 0, 14);
+  BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 2u);
+  BOOST_REQUIRE_EQUAL(getStreamQnames(cachedStream).size(), 2u);
+
+  cachedStream.resetRegion(1, 0, 14);
+  BOOST_REQUIRE_EQUAL(getStreamQnames(cachedStream).size(), 2u);
+  BOOST_REQUIRE_EQUAL(cachePtr->hitCount(), 1u);
+}
+
+/// Test that the cache is shared between streams, and respects its memory limit
+BOOST_AUTO_TEST_CASE(test_bam_region_cache_shared_and_limit)
+{
+  const std::string testBamPath(getTestBamPath());
+
+  {
+    auto         cachePtr(std::make_shared<bam_region_cache>(1000000));
+    bam_streamer stream1(testBamPath.c_str(), nullptr);
+    bam_streamer stream2(testBamPath.c_str(), nullptr);
+    stream1.setRegionCache(cachePtr);
+    stream2.setRegionCache(cachePtr);
+
+    stream1.resetRegion(0, 0, 10);
+    BOOST_REQUIRE_EQUAL(getStreamQnames(stream1).size(), 2u);
+    stream2.resetRegion(0, 0, 10);
+    BOOST_REQUIRE_EQUAL(getStreamQnames(stream2).size(), 2u);
+    BOOST_REQUIRE_EQUAL(cachePtr->hitCount(), 1u);
+    BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 1u);
+  }
+
+  {
+    // Test a memory limit too small for any block:
+    auto         cachePtr(std::make_shared<bam_region_cache>(1));
+    bam_streamer stream(testBamPath.c_str(), nullptr);
+    stream.setRegionCache(cachePtr);
+
+    stream.resetRegion(0, 0, 10);
+    BOOST_REQUIRE_EQUAL(getStreamQnames(stream).size(), 2u);
+    stream.resetRegion(0, 0, 10);
+    BOOST_REQUIRE_EQUAL(getStreamQnames(stream).size(), 2u);
+    BOOST_REQUIRE_EQUAL(cachePtr->hitCount(), 0u);
+    BOOST_REQUIRE_EQUAL(cachePtr->missCount(), 2u);
+    BOOST_REQUIRE_EQUAL(cachePtr->memoryBytes(), 0u);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
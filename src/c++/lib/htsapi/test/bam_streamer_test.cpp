@@ -66,6 +66,31 @@ BOOST_AUTO_TEST_CASE(test_bam_streamer_cram_read)
   checkStream(stream, 2u);
 }
 
+/// Test that BAM and CRAM files read with a shared decompression thread pool give the same records
+BOOST_AUTO_TEST_CASE(test_bam_streamer_thread_pool)
+{
+  const std::string testBamPath(std::string(TEST_DATA_PATH) + "/alignment_test.bam");
+  const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
+  const std::string testRefPath(std::string(TEST_DATA_PATH) + "/alignment_test.fasta");
+
+  auto threadPoolPtr(std::make_shared<hts_thread_pool>(2));
+
+  bam_streamer bamStream(testBamPath.c_str(), nullptr);
+  bam_streamer cramStream(testCramPath.c_str(), testRefPath.c_str());
+  bamStream.setThreadPool(threadPoolPtr);
+  cramStream.setThreadPool(threadPoolPtr);
+
+  const uint64_t startDecodedCount(bam_streamer::getTotalDecodedRecordCount());
+  checkStream(bamStream, 4u);
+  checkStream(cramStream, 4u);
+  BOOST_REQUIRE_GE(bam_streamer::getTotalDecodedRecordCount(), startDecodedCount + 8);
+
+  bamStream.resetRegion("chrA");
+  checkStream(bamStream, 2u);
+  cramStream.resetRegion("chrB");
+  checkStream(cramStream, 2u);
+}
+
 BOOST_AUTO_TEST_CASE(test_bam_streamer_cram_read_fail)
 {
   const std::string testCramPath(std::string(TEST_DATA_PATH) + "/alignment_test.cram");
@@ -0,0 +1,132 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+#include "testConfig.h"
+
+#include "blt_util/blt_exception.hpp"
+#include "htsapi/fasta_reference_provider.hpp"
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(fasta_reference_provider_test_suite)
+
+static std::string getTestFastaPath()
+{
+  return (std::string(TEST_DATA_PATH) + "/fasta_reference_provider_test.fasta");
+}
+
+/// Get a region directly from htslib for comparison
+static std::string getFaidxRegionSeq(
+    const std::string& ref_file, const std::string& chrom, const int begin_pos, const int end_pos)
+{
+  faidx_t* fai(fai_load(ref_file.c_str()));
+  BOOST_REQUIRE(nullptr != fai);
+  int   len;
+  char* ref_tmp(faidx_fetch_seq(fai, chrom.c_str(), begin_pos, end_pos, &len));
+  BOOST_REQUIRE(nullptr != ref_tmp);
+  const std::string ref_seq(ref_tmp);
+  free(ref_tmp);
+  fai_destroy(fai);
+  return ref_seq;
+}
+
+/// Test every region of every contig, including regions extending past either contig end
+static void testAllRegions(const fasta_reference_provider& provider)
+{
+  static const std::pair<const char*, int> contigs[] = {{"chr1", 157}, {"chr2", 61}, {"chr3", 5}};
+  std::string                              ref_seq;
+  for (const auto& contig : contigs) {
+    const std::string chrom(contig.first);
+    for (int begin_pos(-2); begin_pos < (contig.second + 2); ++begin_pos) {
+      for (int end_pos(begin_pos - 1); end_pos < (contig.second + 2); ++end_pos) {
+        provider.getRegionSeq(chrom, begin_pos, end_pos, ref_seq);
+        BOOST_REQUIRE_EQUAL(ref_seq, getFaidxRegionSeq(provider.getFilename(), chrom, begin_pos, end_pos));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_fasta_reference_provider_mapped)
+{
+  const fasta_reference_provider provider(getTestFastaPath());
+  BOOST_REQUIRE(provider.isMapped());
+  testAllRegions(provider);
+}
+
+BOOST_AUTO_TEST_CASE(test_fasta_reference_provider_cached)
+{
+  // Use windows smaller than each contig, and too few windows to hold any contig:
+  const fasta_reference_provider provider(getTestFastaPath(), 2, 10);
+  testAllRegions(provider);
+}
+
+BOOST_AUTO_TEST_CASE(test_fasta_reference_provider_compressed)
+{
+  const std::string compressedPath(getTestFastaPath() + ".gz");
+  {
+    const fasta_reference_provider provider(compressedPath);
+    BOOST_REQUIRE(!provider.isMapped());
+    testAllRegions(provider);
+  }
+  {
+    const fasta_reference_provider provider(compressedPath, 3, 16);
+    testAllRegions(provider);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_fasta_reference_provider_unknown_chrom)
+{
+  const fasta_reference_provider provider(getTestFastaPath());
+  std::string                    ref_seq;
+  BOOST_REQUIRE_THROW(provider.getRegionSeq("chrX", 0, 10, ref_seq), blt_exception);
+}
+
+/// Test that concurrent lookups from the shared provider of a compressed reference are consistent
+BOOST_AUTO_TEST_CASE(test_fasta_reference_provider_shared_threads)
+{
+  const std::string compressedPath(getTestFastaPath() + ".gz");
+  const auto        providerPtr(fasta_reference_provider::getShared(compressedPath));
+  BOOST_REQUIRE(providerPtr == fasta_reference_provider::getShared(compressedPath));
+
+  const std::string expectSeq(getFaidxRegionSeq(compressedPath, "chr1", 0, 156));
+
+  static const unsigned    threadCount(4);
+  std::vector<std::thread> threads;
+  std::vector<unsigned>    mismatchCounts(threadCount, 0);
+  for (unsigned threadIndex(0); threadIndex < threadCount; ++threadIndex) {
+    threads.emplace_back([&, threadIndex]() {
+      std::string ref_seq;
+      for (int begin_pos(0); begin_pos < 157; ++begin_pos) {
+        providerPtr->getRegionSeq("chr1", begin_pos, (begin_pos + 20), ref_seq);
+        if (ref_seq != expectSeq.substr(begin_pos, 21)) mismatchCounts[threadIndex]++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const unsigned mismatchCount : mismatchCounts) {
+    BOOST_REQUIRE_EQUAL(mismatchCount, 0u);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
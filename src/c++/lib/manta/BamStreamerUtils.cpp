@@ -35,6 +35,32 @@ void openBamStreams(
   }
 }
 
+void openBamStreams(
+    const std::string&                          referenceFilename,
+    const AlignmentFileOptions&                 alignFileOpt,
+    std::vector<std::shared_ptr<bam_streamer>>& bamStreams)
+{
+  openBamStreams(referenceFilename, alignFileOpt.alignmentFilenames, bamStreams);
+
+  const std::shared_ptr<hts_thread_pool> threadPoolPtr(
+      hts_thread_pool::getShared(alignFileOpt.decompressThreadCount));
+  if (!threadPoolPtr) return;
+  for (auto& bamStream : bamStreams) {
+    bamStream->setThreadPool(threadPoolPtr);
+  }
+}
+
+void setBamStreamsRegionCache(
+    const BamRegionCacheSet& regionCaches, std::vector<std::shared_ptr<bam_streamer>>& bamStreams)
+{
+  const unsigned bamCount(bamStreams.size());
+  assert(regionCaches.empty() || (regionCaches.size() == bamCount));
+  for (unsigned bamIndex(0); bamIndex < bamCount; ++bamIndex) {
+    bamStreams[bamIndex]->setRegionCache(
+        regionCaches.empty() ? std::shared_ptr<bam_region_cache>() : regionCaches[bamIndex]);
+  }
+}
+
 void resetBamStreamsRegion(const std::string& region, std::vector<std::shared_ptr<bam_streamer>>& bamStreams)
 {
   if (region.empty()) return;
@@ -25,6 +25,10 @@
 
 #include "blt_util/input_stream_handler.hpp"
 #include "htsapi/bam_streamer.hpp"
+#include "options/AlignmentFileOptions.hpp"
+
+/// Decoded record caches for each alignment file, shared by all bam_streamers on one thread
+typedef std::vector<std::shared_ptr<bam_region_cache>> BamRegionCacheSet;
 
 /// \brief Open all bam files as bam_streamer objects, with no genomic region set
 ///
@@ -35,6 +39,25 @@ void openBamStreams(
     const std::vector<std::string>&             bamFilenames,
     std::vector<std::shared_ptr<bam_streamer>>& bamStreams);
 
+/// \brief Open all alignment files in \p alignFileOpt as bam_streamer objects, with no genomic region set
+///
+/// All streams share the process-wide htslib decompression thread pool if one is requested in
+/// \p alignFileOpt.
+///
+/// \param[out] bamStreams Vector of bam_streamers corresponding to the input alignment files. Existing
+/// content will be cleared on input.
+void openBamStreams(
+    const std::string&                          referenceFilename,
+    const AlignmentFileOptions&                 alignFileOpt,
+    std::vector<std::shared_ptr<bam_streamer>>& bamStreams);
+
+/// \brief Set all \p bamStreams to share the corresponding decoded record cache in \p regionCaches
+///
+/// \param[in] regionCaches Record cache for each alignment file, in the same order as \p bamStreams. An empty
+/// vector disables caching for all streams.
+void setBamStreamsRegionCache(
+    const BamRegionCacheSet& regionCaches, std::vector<std::shared_ptr<bam_streamer>>& bamStreams);
+
 /// \brief Reset the target genomic region of all \p bamStreams
 ///
 /// Note when \p region is empty this function has no effect
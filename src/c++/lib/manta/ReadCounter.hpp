@@ -40,6 +40,20 @@ struct ReadCounter {
   {
   }
 
+  ReadCounter(
+      const unsigned totalReadCount,
+      const unsigned totalPairedReadCount,
+      const unsigned totalUnpairedReadCount,
+      const unsigned totalPairedLowMapqReadCount,
+      const unsigned totalHighConfidenceReadPairCount)
+    : _totalReadCount(totalReadCount),
+      _totalPairedReadCount(totalPairedReadCount),
+      _totalUnpairedReadCount(totalUnpairedReadCount),
+      _totalPairedLowMapqReadCount(totalPairedLowMapqReadCount),
+      _totalHighConfidenceReadPairCount(totalHighConfidenceReadPairCount)
+  {
+  }
+
   unsigned totalReadCount() const { return _totalReadCount; }
 
   unsigned totalPairedReadCount() const { return _totalPairedReadCount; }
@@ -60,6 +74,16 @@ struct ReadCounter {
 
   void addHighConfidenceReadPairCount() { _totalHighConfidenceReadPairCount += 1; }
 
+  /// Add all counts from \p rhs to this counter
+  void addCounts(const ReadCounter& rhs)
+  {
+    _totalReadCount += rhs._totalReadCount;
+    _totalPairedReadCount += rhs._totalPairedReadCount;
+    _totalUnpairedReadCount += rhs._totalUnpairedReadCount;
+    _totalPairedLowMapqReadCount += rhs._totalPairedLowMapqReadCount;
+    _totalHighConfidenceReadPairCount += rhs._totalHighConfidenceReadPairCount;
+  }
+
 private:
   friend class boost::serialization::access;
   template <class Archive>
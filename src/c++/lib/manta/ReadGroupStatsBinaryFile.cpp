@@ -0,0 +1,275 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "manta/ReadGroupStatsBinaryFile.hpp"
+
+#include "common/Exceptions.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+static const char     binaryStatsMagic[8] = {'M', 'R', 'G', 'S', 'T', 'A', 'T', 'B'};
+static const uint32_t binaryStatsVersion  = 1;
+
+static_assert(sizeof(ReadGroupStatsBinaryHeader) == 72, "Unexpected binary stats file header size");
+static_assert(sizeof(ReadGroupStatsBinaryGroup) == 56, "Unexpected binary stats file group size");
+static_assert(sizeof(ReadGroupStatsBinarySize) == 12, "Unexpected binary stats file size record size");
+
+/// Round offset up to the next 8-byte section boundary
+static uint64_t getSectionOffset(const uint64_t offset)
+{
+  return ((offset + 7) & ~static_cast<uint64_t>(7));
+}
+
+static void binaryStatsError(const char* filename, const char* message)
+{
+  using namespace illumina::common;
+
+  std::ostringstream oss;
+  oss << "Invalid Manta binary alignment stats file '" << filename << "': " << message;
+  BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+}
+
+bool isReadGroupStatsBinaryFile(const char* filename)
+{
+  assert(nullptr != filename);
+
+  std::ifstream ifs(filename, std::ios::binary);
+  char          magic[sizeof(binaryStatsMagic)];
+  if (!ifs.read(magic, sizeof(magic))) return false;
+  return (0 == std::memcmp(magic, binaryStatsMagic, sizeof(magic)));
+}
+
+void writeReadGroupStatsBinaryFile(const char* filename, const ReadGroupStatsSet& rstats)
+{
+  using namespace illumina::common;
+
+  assert(nullptr != filename);
+
+  const unsigned quantileCount(SizeDistribution::quantileCount());
+
+  std::vector<ReadGroupStatsBinaryGroup> groupTable;
+  std::string                            labels;
+  std::vector<ReadGroupStatsBinarySize>  sizeTable;
+  std::vector<int32_t>                   quantileTable;
+
+  auto addLabel = [&](const char* label) {
+    const uint64_t labelOffset(labels.size());
+    labels.append(label);
+    labels.push_back('\0');
+    return labelOffset;
+  };
+
+  const unsigned numGroups(rstats.size());
+  for (unsigned groupIndex(0); groupIndex < numGroups; ++groupIndex) {
+    const ReadGroupLabel&   key(rstats.getKey(groupIndex));
+    const ReadGroupStats&   groupStats(rstats.getStats(groupIndex));
+    const SizeDistribution& fragStats(groupStats.fragStats);
+    const ReadCounter&      readCounter(groupStats.readCounter);
+
+    ReadGroupStatsBinaryGroup group;
+    std::memset(&group, 0, sizeof(group));
+    group.bamLabelOffset                   = addLabel(key.bamLabel);
+    group.rgLabelOffset                    = addLabel(key.rgLabel);
+    group.sizeBeginIndex                   = sizeTable.size();
+    group.totalObservationCount            = fragStats.totalObservations();
+    group.pairOrientation                  = groupStats.relOrients.val();
+    group.totalReadCount                   = readCounter.totalReadCount();
+    group.totalPairedReadCount             = readCounter.totalPairedReadCount();
+    group.totalUnpairedReadCount           = readCounter.totalUnpairedReadCount();
+    group.totalPairedLowMapqReadCount      = readCounter.totalPairedLowMapqReadCount();
+    group.totalHighConfidenceReadPairCount = readCounter.totalHighConfidenceReadPairCount();
+
+    // the size map is sorted from high to low, and the size table from low to high:
+    const SizeDistribution::map_type& sizeMap(fragStats.getSizeMap());
+    for (auto sizeIter(sizeMap.rbegin()); sizeIter != sizeMap.rend(); ++sizeIter) {
+      ReadGroupStatsBinarySize binarySize;
+      binarySize.size  = sizeIter->first;
+      binarySize.count = sizeIter->second.count;
+      binarySize.cprob = sizeIter->second.cprob;
+      sizeTable.push_back(binarySize);
+    }
+    group.sizeCount = sizeMap.size();
+
+    const std::vector<int>& quantiles(fragStats.getQuantiles());
+    assert(quantiles.size() == quantileCount);
+    quantileTable.insert(quantileTable.end(), quantiles.begin(), quantiles.end());
+
+    groupTable.push_back(group);
+  }
+
+  ReadGroupStatsBinaryHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, binaryStatsMagic, sizeof(binaryStatsMagic));
+  header.version          = binaryStatsVersion;
+  header.quantileCount    = quantileCount;
+  header.groupCount       = groupTable.size();
+  header.groupTableOffset = getSectionOffset(sizeof(header));
+  header.labelOffset =
+      getSectionOffset(header.groupTableOffset + groupTable.size() * sizeof(ReadGroupStatsBinaryGroup));
+  header.labelSize       = labels.size();
+  header.sizeTableOffset = getSectionOffset(header.labelOffset + header.labelSize);
+  header.sizeCount       = sizeTable.size();
+  header.quantileTableOffset =
+      getSectionOffset(header.sizeTableOffset + sizeTable.size() * sizeof(ReadGroupStatsBinarySize));
+
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) {
+    std::ostringstream oss;
+    oss << "Can't open alignment stats file '" << filename << "' for writing";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+
+  uint64_t offset(0);
+  auto     writeSection = [&](const uint64_t sectionOffset, const void* data, const uint64_t size) {
+    static const char padding[8] = {};
+    assert(sectionOffset >= offset);
+    ofs.write(padding, sectionOffset - offset);
+    ofs.write(static_cast<const char*>(data), size);
+    offset = sectionOffset + size;
+  };
+
+  writeSection(0, &header, sizeof(header));
+  writeSection(
+      header.groupTableOffset, groupTable.data(), groupTable.size() * sizeof(ReadGroupStatsBinaryGroup));
+  writeSection(header.labelOffset, labels.data(), labels.size());
+  writeSection(header.sizeTableOffset, sizeTable.data(), sizeTable.size() * sizeof(ReadGroupStatsBinarySize));
+  writeSection(header.quantileTableOffset, quantileTable.data(), quantileTable.size() * sizeof(int32_t));
+
+  if (!ofs) {
+    std::ostringstream oss;
+    oss << "Failed to write alignment stats file '" << filename << "'";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+}
+
+void readReadGroupStatsBinaryFile(const char* filename, ReadGroupStatsSet& rstats)
+{
+  using namespace illumina::common;
+
+  assert(nullptr != filename);
+
+  std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+  if (!ifs) {
+    std::ostringstream oss;
+    oss << "Can't open alignment stats file '" << filename << "'";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+  const uint64_t fileSize(ifs.tellg());
+  if (fileSize < sizeof(ReadGroupStatsBinaryHeader)) binaryStatsError(filename, "file is too small");
+
+  // Use a 64-bit element buffer to guarantee the alignment of all file sections:
+  std::vector<uint64_t> buffer((fileSize + 7) / 8);
+  const char*           data(reinterpret_cast<const char*>(buffer.data()));
+  ifs.seekg(0);
+  if (!ifs.read(reinterpret_cast<char*>(buffer.data()), fileSize)) {
+    binaryStatsError(filename, "can't read file");
+  }
+
+  const ReadGroupStatsBinaryHeader& header(*reinterpret_cast<const ReadGroupStatsBinaryHeader*>(data));
+  if (0 != std::memcmp(header.magic, binaryStatsMagic, sizeof(binaryStatsMagic))) {
+    binaryStatsError(filename, "unrecognized file signature");
+  }
+  if (header.version != binaryStatsVersion) {
+    std::ostringstream oss;
+    oss << "unsupported format version " << header.version << ", expected version " << binaryStatsVersion;
+    binaryStatsError(filename, oss.str().c_str());
+  }
+  if (header.quantileCount != SizeDistribution::quantileCount()) {
+    binaryStatsError(filename, "unexpected quantile table size");
+  }
+
+  // Check that every section is aligned and fits in the file:
+  auto isValidSection = [&](const uint64_t offset, const uint64_t count, const uint64_t elementSize) {
+    if ((offset % 8) != 0) return false;
+    if (offset > fileSize) return false;
+    return (count <= ((fileSize - offset) / elementSize));
+  };
+
+  if (!isValidSection(header.groupTableOffset, header.groupCount, sizeof(ReadGroupStatsBinaryGroup))) {
+    binaryStatsError(filename, "invalid group table section");
+  }
+  if ((!isValidSection(header.labelOffset, header.labelSize, 1)) ||
+      ((header.labelSize > 0) && (data[header.labelOffset + header.labelSize - 1] != '\0'))) {
+    binaryStatsError(filename, "invalid label section");
+  }
+  if (!isValidSection(header.sizeTableOffset, header.sizeCount, sizeof(ReadGroupStatsBinarySize))) {
+    binaryStatsError(filename, "invalid size table section");
+  }
+  if (!isValidSection(
+          header.quantileTableOffset, header.groupCount * header.quantileCount, sizeof(int32_t))) {
+    binaryStatsError(filename, "invalid quantile table section");
+  }
+
+  const ReadGroupStatsBinaryGroup* groupTable(
+      reinterpret_cast<const ReadGroupStatsBinaryGroup*>(data + header.groupTableOffset));
+  const char*                     labels(data + header.labelOffset);
+  const ReadGroupStatsBinarySize* sizeTable(
+      reinterpret_cast<const ReadGroupStatsBinarySize*>(data + header.sizeTableOffset));
+  const int32_t* quantileTable(reinterpret_cast<const int32_t*>(data + header.quantileTableOffset));
+
+  std::vector<std::pair<int, SizeData>> sizeData;
+  for (uint64_t groupIndex(0); groupIndex < header.groupCount; ++groupIndex) {
+    const ReadGroupStatsBinaryGroup& group(groupTable[groupIndex]);
+
+    // Check that all table cross-references are in range and the size distribution is consistent:
+    if ((group.bamLabelOffset >= header.labelSize) || (group.rgLabelOffset >= header.labelSize)) {
+      binaryStatsError(filename, "inconsistent group label");
+    }
+    if ((group.sizeBeginIndex > header.sizeCount) ||
+        (group.sizeCount > (header.sizeCount - group.sizeBeginIndex))) {
+      binaryStatsError(filename, "inconsistent group size table range");
+    }
+    if (group.pairOrientation >= PAIR_ORIENT::SIZE) {
+      binaryStatsError(filename, "invalid group pair orientation");
+    }
+
+    sizeData.clear();
+    uint64_t totalCount(0);
+    for (uint64_t sizeIndex(0); sizeIndex < group.sizeCount; ++sizeIndex) {
+      const ReadGroupStatsBinarySize& binarySize(sizeTable[group.sizeBeginIndex + sizeIndex]);
+      if ((!sizeData.empty()) && (binarySize.size <= sizeData.back().first)) {
+        binaryStatsError(filename, "size table is not sorted");
+      }
+      sizeData.emplace_back(binarySize.size, SizeData(binarySize.count, binarySize.cprob));
+      totalCount += binarySize.count;
+    }
+    if (totalCount != group.totalObservationCount) {
+      binaryStatsError(filename, "inconsistent group observation count");
+    }
+
+    ReadGroupStats groupStats;
+    groupStats.fragStats.loadPrecomputed(
+        group.totalObservationCount, sizeData, quantileTable + (groupIndex * header.quantileCount));
+    groupStats.relOrients.setVal(group.pairOrientation);
+    groupStats.readCounter = ReadCounter(
+        group.totalReadCount,
+        group.totalPairedReadCount,
+        group.totalUnpairedReadCount,
+        group.totalPairedLowMapqReadCount,
+        group.totalHighConfidenceReadPairCount);
+
+    rstats.setStats(ReadGroupLabel(labels + group.bamLabelOffset, labels + group.rgLabelOffset), groupStats);
+  }
+}
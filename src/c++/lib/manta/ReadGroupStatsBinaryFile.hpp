@@ -0,0 +1,96 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Binary alignment statistics file format
+///
+/// The binary format stores each read group's statistics along with the precomputed cumulative
+/// probability and quantile tables of its fragment size distribution, so that the stats can be loaded without
+/// XML parsing or any distribution statistics computation. All tables have fixed-width records addressed by
+/// offsets from the start of the file, so the file can also be read in place from a memory mapping. All
+/// values are stored in native byte order.
+///
+/// File layout:
+/// 1. ReadGroupStatsBinaryHeader
+/// 2. Group table: ReadGroupStatsBinaryGroup records
+/// 3. Label block: null-terminated bam and read group labels
+/// 4. Size table: ReadGroupStatsBinarySize records for all groups
+/// 5. Quantile table: quantileCount sizes for each group
+///
+/// Each section starts on an 8-byte boundary.
+///
+
+#pragma once
+
+#include "manta/ReadGroupStatsSet.hpp"
+
+#include <cstdint>
+
+struct ReadGroupStatsBinaryHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t quantileCount;
+  uint64_t groupCount;
+  uint64_t groupTableOffset;
+  uint64_t labelOffset;
+  uint64_t labelSize;
+  uint64_t sizeTableOffset;
+  uint64_t sizeCount;
+  uint64_t quantileTableOffset;
+};
+
+/// Statistics for one read group in the binary stats format
+///
+/// The fragment size distribution is stored in the size table range [sizeBeginIndex,sizeBeginIndex+sizeCount)
+/// in order of increasing size.
+struct ReadGroupStatsBinaryGroup {
+  /// Label block offsets of the bam and read group labels
+  uint64_t bamLabelOffset;
+  uint64_t rgLabelOffset;
+
+  uint64_t sizeBeginIndex;
+  uint32_t sizeCount;
+  uint32_t totalObservationCount;
+  uint32_t pairOrientation;
+  uint32_t totalReadCount;
+  uint32_t totalPairedReadCount;
+  uint32_t totalUnpairedReadCount;
+  uint32_t totalPairedLowMapqReadCount;
+  uint32_t totalHighConfidenceReadPairCount;
+};
+
+/// One observed fragment size in the binary stats format
+struct ReadGroupStatsBinarySize {
+  int32_t  size;
+  uint32_t count;
+
+  /// Cumulative probability of all sizes up to and including this one
+  float cprob;
+};
+
+/// True if the file starts with the binary stats file signature
+bool isReadGroupStatsBinaryFile(const char* filename);
+
+/// \brief Write all read group statistics in the binary stats format
+void writeReadGroupStatsBinaryFile(const char* filename, const ReadGroupStatsSet& rstats);
+
+/// \brief Add all read group statistics from a binary stats file to \p rstats
+///
+/// The fragment size distribution of each group is frozen. Throws if the file is not a valid binary stats
+/// file of the current version.
+void readReadGroupStatsBinaryFile(const char* filename, ReadGroupStatsSet& rstats);
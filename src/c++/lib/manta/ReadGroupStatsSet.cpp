@@ -23,6 +23,7 @@
 #include "blt_util/log.hpp"
 #include "blt_util/parse_util.hpp"
 #include "blt_util/string_util.hpp"
+#include "manta/ReadGroupStatsBinaryFile.hpp"
 
 // workaround intel compiler boost warnings:
 #include "boost/config.hpp"
@@ -102,11 +103,21 @@ void ReadGroupStatsSet::save(const char* filename) const
   }
 }
 
+void ReadGroupStatsSet::saveBinary(const char* filename) const
+{
+  writeReadGroupStatsBinaryFile(filename, *this);
+}
+
 void ReadGroupStatsSet::load(const char* filename)
 {
   clear();
 
   assert(nullptr != filename);
+  if (isReadGroupStatsBinaryFile(filename)) {
+    readReadGroupStatsBinaryFile(filename, *this);
+    return;
+  }
+
   std::ifstream                ifs(filename);
   boost::archive::xml_iarchive ia(ifs);
 
@@ -116,6 +127,8 @@ void ReadGroupStatsSet::load(const char* filename)
   for (int i = 0; i < numGroups; i++) {
     ia >> boost::serialization::make_nvp("bogus", se);
 
+    // loaded stats are only queried, so they can be frozen for concurrent lookup:
+    se.groupStats.fragStats.freeze();
     setStats(KeyType(se.bamFile.c_str(), se.readGroup.c_str()), se.groupStats);
   }
 }
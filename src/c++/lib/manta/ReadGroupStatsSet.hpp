@@ -64,8 +64,16 @@ struct ReadGroupStatsSet {
   /// merge in the contents of another stats set object:
   void merge(const ReadGroupStatsSet& rhs);
 
+  /// Save stats in the human-readable XML format
   void save(const char* filename) const;
 
+  /// Save stats in the binary format, which includes precomputed fragment size distribution tables
+  void saveBinary(const char* filename) const;
+
+  /// Load stats from \p filename, the fragment size distribution of each group is frozen for concurrent
+  /// lookup after loading
+  ///
+  /// Both the XML format written by save() and the binary format written by saveBinary() are accepted.
   void load(const char* filename);
 
   bool isEmpty() { return _group.empty(); }
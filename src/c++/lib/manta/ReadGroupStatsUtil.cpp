@@ -32,8 +32,11 @@
 #include "manta/ReadFilter.hpp"
 #include "manta/ReadGroupLabel.hpp"
 
+#include "ctpl_stl.h"
+
 #include <array>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -339,9 +342,22 @@ struct ReadGroupTracker {
 
   ReadGroupBuffer& getBuffer() { return _buffer; }
 
-  void addBufferedData()
+  void addBufferedData() { addReads(_buffer.getBufferedReads()); }
+
+  /// Add a complete, normal buffer of read pairs sampled outside of this tracker, and update the insert size
+  /// check state as if the reads had been added by addObservation
+  void addSampledReads(const std::vector<SimpleRead>& reads)
+  {
+    addReads(reads);
+    checkInsertSizeCount();
+  }
+
+  /// Add read counts accumulated outside of this tracker
+  void addReadCounts(const ReadCounter& readCounter) { _stats.readCounter.addCounts(readCounter); }
+
+  void addReads(const std::vector<SimpleRead>& reads)
   {
-    for (const SimpleRead& srd : _buffer.getBufferedReads()) {
+    for (const SimpleRead& srd : reads) {
       // get orientation stats before final filter for innie reads below:
       //
       // we won't use anything but innie reads for insert size stats, but sampling
@@ -830,13 +846,16 @@ private:
   RGMapType         _rgTracker;
 };
 
-void extractReadGroupStatsFromAlignmentFile(
+/// Sample read group stats by reading chunks of each chromosome in turn on the calling thread
+static void sampleAlignmentFileChunks(
     const std::string& referenceFilename,
     const std::string& alignmentFilename,
     const std::string& defaultStatsFilename,
-    ReadGroupStatsSet& rstats)
+    const unsigned     decompressThreadCount,
+    ReadGroupManager&  rgManager)
 {
   bam_streamer read_stream(alignmentFilename.c_str(), referenceFilename.c_str());
+  read_stream.setThreadPool(hts_thread_pool::getShared(decompressThreadCount));
 
   const bam_hdr_t&     header(read_stream.get_header());
   const int32_t        chromCount(header.n_targets);
@@ -850,7 +869,6 @@ void extractReadGroupStatsFromAlignmentFile(
   bool isActiveChrom(true);
 
   CoreInsertStatsReadFilter coreFilter;
-  ReadGroupManager          rgManager(alignmentFilename.c_str());
 
 #ifndef READ_GROUPS
   static const char defaultReadGroup[] = "";
@@ -940,6 +958,262 @@ void extractReadGroupStatsFromAlignmentFile(
       }
     }
   }
+}
+
+#ifndef READ_GROUPS
+/// Read counts and read pairs sampled from one chromosome slice, independent of any ReadGroupTracker
+///
+/// The sample is stored as a sequence of blocks, where each block holds the read counts and buffered read
+/// pairs from one normal ReadGroupBuffer flush. This allows a slice sampled on a worker thread to be merged
+/// into the tracker one buffer at a time, applying the same convergence tests as serial sampling.
+///
+struct ReadGroupSliceSample {
+  struct Block {
+    ReadCounter             readCounter;
+    std::vector<SimpleRead> reads;
+
+    /// Highest sampled read position on the chromosome as of the end of this block
+    int32_t highestPos = -1;
+  };
+
+  std::vector<Block> blocks;
+
+  /// Read pairs left in the buffer at the end of the chromosome, these continue into the tracker buffer
+  std::vector<SimpleRead> pendingReads;
+};
+
+/// Sample one slice of a chromosome, starting after \p startHighestPos
+///
+/// The slice ends after the same number of buffered read pairs used between each serial convergence test,
+/// or at the end of the chromosome. The jump rules for regions without reads or with abnormal fragment
+/// sizes follow serial sampling.
+static void sampleChromSlice(
+    bam_streamer&         read_stream,
+    const int32_t         chromIndex,
+    const int32_t         chromSize,
+    const int32_t         startHighestPos,
+    ReadGroupSliceSample& slice)
+{
+  // each normal buffer flush contributes 1000 FR read pairs, so this is the 100000 insert size observation
+  // interval used by ReadGroupTracker to schedule convergence tests:
+  static const unsigned sliceBlockCount(100);
+
+  CoreInsertStatsReadFilter coreFilter;
+  ReadGroupBuffer           buffer;
+
+  slice.blocks.clear();
+  slice.blocks.emplace_back();
+  int32_t highestPos(startHighestPos);
+  bool    isFinishedSlice(false);
+  while (!isFinishedSlice) {
+    const int32_t startPos(highestPos + 1);
+    if (startPos >= chromSize) break;
+
+    read_stream.resetRegion(chromIndex, startPos, chromSize);
+
+    while (read_stream.next()) {
+      const bam_record& bamRead(*(read_stream.get_record_ptr()));
+      if (bamRead.pos() < startPos) continue;
+
+      highestPos = bamRead.pos();
+
+      ReadCounter& readCounter(slice.blocks.back().readCounter);
+      readCounter.addReadCount();
+      if (bamRead.is_paired()) {
+        readCounter.addPairedReadCount();
+        if (bamRead.map_qual() == 0) {
+          readCounter.addPairedLowMapqReadCount();
+        }
+      } else {
+        readCounter.addUnpairedReadCount();
+      }
+
+      if (coreFilter.isFilterRead(bamRead)) continue;
+
+      const PAIR_ORIENT::index_t ori(getRelOrient(bamRead));
+      unsigned                   fragSize(0);
+      if (ori == PAIR_ORIENT::Rp) {
+        fragSize = getSimplifiedFragSize(getFragSizeMinusSkip(bamRead));
+      }
+
+      buffer.updateBuffer(ori, fragSize);
+      if (!buffer.isBufferFull()) continue;
+
+      const bool isNormal(buffer.isBufferNormal());
+      if (isNormal) {
+        slice.blocks.back().reads      = buffer.getBufferedReads();
+        slice.blocks.back().highestPos = highestPos;
+        slice.blocks.emplace_back();
+      }
+      buffer.clearBuffer();
+
+      if (!isNormal) {
+        highestPos += std::max(1, chromSize / 100);
+        break;
+      }
+
+      if (slice.blocks.size() > sliceBlockCount) {
+        isFinishedSlice = true;
+        break;
+      }
+    }
+
+    // move to next region if no read falling in the current region
+    if (highestPos <= startPos) {
+      highestPos += std::max(1, chromSize / 100);
+    }
+  }
+
+  // the final block holds read counts following the last buffer flush:
+  slice.blocks.back().highestPos = highestPos;
+  slice.pendingReads             = buffer.getBufferedReads();
+}
+
+/// Merge a sampled chromosome slice into the read group tracker
+///
+/// Blocks are merged in order until the tracker finishes a slice, at which point the remaining blocks are
+/// discarded, so that they are sampled again in a later round just as they would be by serial sampling.
+/// Pending reads from the end of the chromosome are merged last.
+///
+/// \param[out] chromHighestPos Highest read position on the chromosome among all merged blocks
+///
+/// \return True if all read groups have converged or hit other stopping conditions
+static bool mergeChromSlice(
+    const ReadGroupSliceSample& slice,
+    ReadGroupTracker&           rgInfo,
+    ReadGroupManager&           rgManager,
+    int32_t&                    chromHighestPos)
+{
+  for (const ReadGroupSliceSample::Block& block : slice.blocks) {
+    rgInfo.addReadCounts(block.readCounter);
+    chromHighestPos = block.highestPos;
+    if (block.reads.empty()) continue;
+
+    rgInfo.addSampledReads(block.reads);
+    if (!rgInfo.isInsertSizeChecked()) continue;
+
+    // check convergence
+    rgInfo.updateInsertSizeConvergenceTest();
+    if (!rgManager.isFinishedSlice()) continue;
+    return rgManager.isStopEstimation();
+  }
+
+  // Serial sampling carries a partially filled buffer over to the next chromosome, this is replicated by
+  // adding the pending reads to the tracker's own buffer:
+  for (const SimpleRead& srd : slice.pendingReads) {
+    rgInfo.addObservation(srd._orient, srd._insertSize);
+    if (!rgInfo.isInsertSizeChecked()) continue;
+
+    rgInfo.updateInsertSizeConvergenceTest();
+    if (!rgManager.isFinishedSlice()) continue;
+    return rgManager.isStopEstimation();
+  }
+  return false;
+}
+
+/// Sample read group stats by reading chunks from several chromosomes concurrently
+///
+/// Sampling proceeds in rounds. Each round samples one slice from each of the next \p threadCount
+/// chromosomes with remaining data, in the same cyclic chromosome order used by serial sampling. Slices are
+/// merged in chromosome order after the round completes, and the stopping rule is only evaluated during this
+/// merge, so results are reproducible for a given thread count.
+static void sampleAlignmentFileChunksParallel(
+    const std::string& referenceFilename,
+    const std::string& alignmentFilename,
+    const std::string& defaultStatsFilename,
+    const unsigned     threadCount,
+    const unsigned     decompressThreadCount,
+    ReadGroupManager&  rgManager)
+{
+  assert(threadCount > 0);
+
+  std::vector<std::unique_ptr<bam_streamer>> threadStreams;
+  for (unsigned threadIndex(0); threadIndex < threadCount; ++threadIndex) {
+    threadStreams.emplace_back(new bam_streamer(alignmentFilename.c_str(), referenceFilename.c_str()));
+    threadStreams.back()->setThreadPool(hts_thread_pool::getShared(decompressThreadCount));
+  }
+
+  const bam_hdr_t&     header(threadStreams.front()->get_header());
+  const int32_t        chromCount(header.n_targets);
+  std::vector<int32_t> chromSize(chromCount, 0);
+  std::vector<int32_t> chromHighestPos(chromCount, -1);
+  for (int32_t i(0); i < chromCount; ++i) {
+    chromSize[i] = (header.target_len[i]);
+  }
+
+  static const char defaultReadGroup[] = "";
+  ReadGroupTracker& rgInfo(rgManager.getTracker(defaultReadGroup, defaultStatsFilename));
+
+  ctpl::thread_pool                 pool(threadCount);
+  std::vector<ReadGroupSliceSample> slices(threadCount);
+  std::vector<int32_t>              roundChroms;
+  int32_t                           nextChromIndex(0);
+  bool                              isStopEstimation(false);
+  while (!isStopEstimation) {
+    // find the next set of chromosomes with remaining data:
+    roundChroms.clear();
+    for (int32_t chromOffset(0); chromOffset < chromCount; ++chromOffset) {
+      if (roundChroms.size() >= threadCount) break;
+      const int32_t chromIndex((nextChromIndex + chromOffset) % chromCount);
+      if ((chromHighestPos[chromIndex] + 1) >= chromSize[chromIndex]) continue;
+      roundChroms.push_back(chromIndex);
+    }
+    if (roundChroms.empty()) break;
+    nextChromIndex = (roundChroms.back() + 1) % chromCount;
+
+    const unsigned                 roundSize(roundChroms.size());
+    std::vector<std::future<void>> sliceReturnValues;
+    for (unsigned sliceIndex(0); sliceIndex < roundSize; ++sliceIndex) {
+      sliceReturnValues.push_back(pool.push([&, sliceIndex](int threadId) {
+        const int32_t chromIndex(roundChroms[sliceIndex]);
+        sampleChromSlice(
+            *threadStreams[threadId],
+            chromIndex,
+            chromSize[chromIndex],
+            chromHighestPos[chromIndex],
+            slices[sliceIndex]);
+      }));
+    }
+
+    // Wait for all slices before rethrowing any worker thread exception, so that no worker is left using the
+    // round data:
+    for (auto& sliceReturnValue : sliceReturnValues) sliceReturnValue.wait();
+    for (auto& sliceReturnValue : sliceReturnValues) sliceReturnValue.get();
+
+    for (unsigned sliceIndex(0); sliceIndex < roundSize; ++sliceIndex) {
+      const int32_t chromIndex(roundChroms[sliceIndex]);
+      isStopEstimation = mergeChromSlice(slices[sliceIndex], rgInfo, rgManager, chromHighestPos[chromIndex]);
+      if (isStopEstimation) break;
+    }
+  }
+}
+#endif
+
+void extractReadGroupStatsFromAlignmentFile(
+    const std::string& referenceFilename,
+    const std::string& alignmentFilename,
+    const std::string& defaultStatsFilename,
+    const unsigned     threadCount,
+    const unsigned     decompressThreadCount,
+    ReadGroupStatsSet& rstats)
+{
+  ReadGroupManager rgManager(alignmentFilename.c_str());
+
+#ifndef READ_GROUPS
+  if (threadCount > 1) {
+    sampleAlignmentFileChunksParallel(
+        referenceFilename,
+        alignmentFilename,
+        defaultStatsFilename,
+        threadCount,
+        decompressThreadCount,
+        rgManager);
+  } else
+#endif
+  {
+    sampleAlignmentFileChunks(
+        referenceFilename, alignmentFilename, defaultStatsFilename, decompressThreadCount, rgManager);
+  }
 
   for (const ReadGroupManager::RGMapType::value_type& val : rgManager.getMap()) {
     rstats.setStats(val.first, val.second.getStats());
@@ -27,8 +27,17 @@
 
 #include <string>
 
+/// \param threadCount Number of threads used to sample alignment file chunks. With one thread, chunks are
+/// sampled serially from each chromosome in turn. With more threads, chunks from several chromosomes are
+/// sampled concurrently and merged in a fixed order, so results are reproducible for a given thread count.
+/// Builds which define READ_GROUPS track each read group separately and always use serial sampling.
+///
+/// \param decompressThreadCount Size of the htslib thread pool used to decode the alignment file, zero
+/// decodes the file on the reading thread
 void extractReadGroupStatsFromAlignmentFile(
     const std::string& referenceFilename,
     const std::string& alignmentFilename,
     const std::string& defaultStatsFilename,
+    const unsigned     threadCount,
+    const unsigned     decompressThreadCount,
     ReadGroupStatsSet& rstats);
@@ -0,0 +1,126 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "manta/ReadNameIndex.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+const unsigned ReadNameIndex::notFound;
+
+/// Size of each block of interned read name storage
+static const unsigned blockSize(1 << 16);
+
+/// Smallest slot table size, must be a power of two
+static const uint64_t minSlotCount(1 << 10);
+
+/// FNV-1a hash of a null-terminated string
+static uint32_t getReadNameHash(const char* qname)
+{
+  uint32_t hash(2166136261u);
+  for (; *qname != '\0'; ++qname) {
+    hash ^= static_cast<uint8_t>(*qname);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+uint64_t ReadNameIndex::findSlot(const char* qname, const uint32_t hash) const
+{
+  assert(!_slots.empty());
+  const uint64_t slotMask(_slots.size() - 1);
+  for (uint64_t slotIndex(hash & slotMask);; slotIndex = ((slotIndex + 1) & slotMask)) {
+    const Slot& slot(_slots[slotIndex]);
+    if (!isOccupied(slot)) return slotIndex;
+    if ((slot.hash == hash) && (0 == std::strcmp(slot.qname, qname))) return slotIndex;
+  }
+}
+
+unsigned ReadNameIndex::find(const char* qname) const
+{
+  if (_count == 0) return notFound;
+  const Slot& slot(_slots[findSlot(qname, getReadNameHash(qname))]);
+  return (isOccupied(slot) ? slot.index : notFound);
+}
+
+void ReadNameIndex::insert(const char* qname, const unsigned index)
+{
+  // keep the table at most half full:
+  if ((_count + 1) * 2 > _slots.size()) grow();
+
+  const uint32_t hash(getReadNameHash(qname));
+  Slot&          slot(_slots[findSlot(qname, hash)]);
+  assert(!isOccupied(slot));
+  slot.qname      = intern(qname);
+  slot.hash       = hash;
+  slot.generation = _generation;
+  slot.index      = index;
+  _count++;
+}
+
+void ReadNameIndex::clear()
+{
+  _count       = 0;
+  _blockIndex  = 0;
+  _blockOffset = 0;
+
+  _generation++;
+  if (_generation == 0) {
+    // reset all slots when the generation counter wraps around:
+    for (Slot& slot : _slots) slot.generation = 0;
+    _generation = 1;
+  }
+}
+
+void ReadNameIndex::grow()
+{
+  std::vector<Slot> oldSlots(std::max(minSlotCount, static_cast<uint64_t>(_slots.size() * 2)));
+  _slots.swap(oldSlots);
+
+  const uint32_t oldGeneration(_generation);
+  _generation = 1;
+  for (const Slot& oldSlot : oldSlots) {
+    if (oldSlot.generation != oldGeneration) continue;
+    Slot& slot(_slots[findSlot(oldSlot.qname, oldSlot.hash)]);
+    slot            = oldSlot;
+    slot.generation = _generation;
+  }
+}
+
+const char* ReadNameIndex::intern(const char* qname)
+{
+  const unsigned qnameSize(std::strlen(qname) + 1);
+  assert(qnameSize <= blockSize);
+
+  if (_blockOffset + qnameSize > blockSize) {
+    _blockIndex++;
+    _blockOffset = 0;
+  }
+  if (_blockIndex == _blocks.size()) {
+    _blocks.emplace_back(new char[blockSize]);
+  }
+
+  char* internedQname(_blocks[_blockIndex].get() + _blockOffset);
+  std::memcpy(internedQname, qname, qnameSize);
+  _blockOffset += qnameSize;
+  return internedQname;
+}
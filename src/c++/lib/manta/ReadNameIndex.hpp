@@ -0,0 +1,82 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Hashed lookup from read name to an integer index
+///
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/// \brief Hashed lookup from read name (QNAME) to an integer index
+///
+/// Read names are interned into block storage owned by the index, so keys remain valid regardless of the
+/// lifetime of the records they were copied from. clear() retains all storage, so the index can be recycled
+/// for successive read sets without reallocation.
+///
+struct ReadNameIndex {
+  static const unsigned notFound = std::numeric_limits<unsigned>::max();
+
+  /// \return The index associated with \p qname, or notFound
+  unsigned find(const char* qname) const;
+
+  /// \brief Associate \p qname with \p index
+  ///
+  /// \p qname must not already be in the index
+  void insert(const char* qname, const unsigned index);
+
+  unsigned size() const { return _count; }
+
+  /// Remove all read names, retaining allocated storage for reuse
+  void clear();
+
+private:
+  struct Slot {
+    const char* qname      = nullptr;
+    uint32_t    hash       = 0;
+    uint32_t    generation = 0;
+    unsigned    index      = 0;
+  };
+
+  /// \return True if \p slot holds a read name inserted since the last clear()
+  bool isOccupied(const Slot& slot) const { return (slot.generation == _generation); }
+
+  /// \return The slot holding \p qname, or the empty slot where it would be inserted
+  uint64_t findSlot(const char* qname, const uint32_t hash) const;
+
+  /// Double the slot table size and reinsert all read names
+  void grow();
+
+  /// Copy \p qname into block storage and return the stable copy
+  const char* intern(const char* qname);
+
+  std::vector<Slot> _slots;
+  unsigned          _count = 0;
+
+  /// Slots are only occupied if their generation matches this value, which allows clear() to skip resetting
+  /// the slot table
+  uint32_t _generation = 1;
+
+  std::vector<std::unique_ptr<char[]>> _blocks;
+  unsigned                             _blockIndex  = 0;
+  unsigned                             _blockOffset = 0;
+};
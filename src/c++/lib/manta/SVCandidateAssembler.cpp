@@ -61,7 +61,8 @@ SVCandidateAssembler::SVCandidateAssembler(
     const bam_header_info&      bamHeader,
     const AllSampleReadCounts&  counts,
     const bool                  isRNA,
-    TimeTracker&                remoteReadRetrievalTime)
+    TimeTracker&                remoteReadRetrievalTime,
+    const BamRegionCacheSet&    regionCaches)
   : _scanOpt(scanOpt),
     _assembleOpt(assembleOpt),
     _isAlignmentTumor(alignFileOpt.isAlignmentTumor),
@@ -71,7 +72,8 @@ SVCandidateAssembler::SVCandidateAssembler(
     _readScanner(_scanOpt, statsFilename, alignFileOpt.alignmentFilenames, isRNA),
     _remoteReadRetrievalTime(remoteReadRetrievalTime)
 {
-  openBamStreams(referenceFilename, alignFileOpt.alignmentFilenames, _bamStreams);
+  openBamStreams(referenceFilename, alignFileOpt, _bamStreams);
+  setBamStreamsRegionCache(regionCaches, _bamStreams);
 
   const unsigned bamSize(_bamStreams.size());
   _sampleRemoteRecoveryCandidateRate.resize(bamSize);
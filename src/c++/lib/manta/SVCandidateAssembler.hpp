@@ -22,6 +22,7 @@
 #include "assembly/AssemblyReadInfo.hpp"
 #include "blt_util/time_util.hpp"
 #include "htsapi/bam_streamer.hpp"
+#include "manta/BamStreamerUtils.hpp"
 #include "manta/ChromDepthFilterUtil.hpp"
 #include "manta/SVCandidate.hpp"
 #include "manta/SVCandidateAssemblyData.hpp"
@@ -53,7 +54,8 @@ struct SVCandidateAssembler {
       const bam_header_info&      bamHeader,
       const AllSampleReadCounts&  counts,
       const bool                  isRNA,
-      TimeTracker&                remoteReadRetrievalTime);
+      TimeTracker&                remoteReadRetrievalTime,
+      const BamRegionCacheSet&    regionCaches = BamRegionCacheSet());
 
   /// Given a 'complex' SV candidate with 1 breakend region, assemble reads
   /// over the breakend region
@@ -59,22 +59,38 @@ std::ostream& operator<<(std::ostream& os, const SVCandidateSetSequenceFragment&
 }
 
 SVCandidateSetSequenceFragment* SVCandidateSetSequenceFragmentSampleGroup::getSequenceFragment(
-    const pindex_t::key_type& key)
+    const char* qname)
 {
-  const pindex_t::const_iterator kiter(_pairIndex.find(key));
+  const unsigned pairIndex(_pairIndex.find(qname));
 
-  if (kiter == _pairIndex.end()) {
+  if (pairIndex == ReadNameIndex::notFound) {
     /// don't add more pairs to the object once it's full:
     if (isFull()) return nullptr;
 
-    _pairIndex[key] = _pairs.size();
-    _pairs.emplace_back();
-    return &(_pairs.back());
+    _pairIndex.insert(qname, _pairCount);
+    if (_pairCount == _pairs.size()) {
+      _pairs.emplace_back();
+    } else {
+      _pairs[_pairCount].clear();
+    }
+    return &(_pairs[_pairCount++]);
   } else {
-    return &(_pairs[kiter->second]);
+    return &(_pairs[pairIndex]);
   }
 }
 
+void SVCandidateSetSequenceFragmentSampleGroup::clear()
+{
+  // fragments are cleared when they are reused, so that a recycled object doesn't need to touch the
+  // storage of fragments beyond the size of the next read set:
+  _pairCount = 0;
+  _pairIndex.clear();
+  dataSourceName      = "UNKNOWN";
+  _isFull             = false;
+  _mappedReadIndex    = 0;
+  _subMappedReadIndex = 0;
+}
+
 void SVCandidateSetSequenceFragmentSampleGroup::add(
     const bam_header_info& bamHeader,
     const bam_record&      bamRead,
@@ -25,11 +25,13 @@
 
 #include <iosfwd>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "alignment/Alignment.hpp"
 #include "htsapi/bam_header_info.hpp"
 #include "htsapi/bam_record.hpp"
+#include "manta/ReadNameIndex.hpp"
 #include "manta/SVBreakend.hpp"
 #include "svgraph/GenomeInterval.hpp"
 
@@ -49,6 +51,15 @@ struct SVCandidateSetRead {
 
   bool isAnchored() const { return (isSet() && (!isSubMapped)); }
 
+  /// Reset to an unset read, retaining the bam record storage for reuse
+  void clear()
+  {
+    bamrec.clear();
+    isSourcedFromGraphEdgeNode1 = true;
+    isSubMapped                 = false;
+    readIndex                   = 0;
+  }
+
   // realignment info, etc...
   bam_record bamrec;
 
@@ -107,6 +118,16 @@ struct SVCandidateSetSequenceFragment {
 
   bool isAnchored() const { return (read1.isAnchored() || read2.isAnchored()); }
 
+  /// Reset to an empty fragment, retaining the read storage for reuse
+  void clear()
+  {
+    svLink.clear();
+    read1.clear();
+    read1Supplemental.clear();
+    read2.clear();
+    read2Supplemental.clear();
+  }
+
   bool checkReadPair() const
   {
     if (read1.isSet() && read2.isSet()) {
@@ -134,6 +155,10 @@ std::ostream& operator<<(std::ostream& os, const SVCandidateSetSequenceFragment&
 
 /// SVCandidateSet data associated with a specific bam-file/read-group
 ///
+/// Fragments and their read records are kept after clear() and reused for the next set of reads, so that
+/// an object recycled over many SV locus graph edges stops allocating once it has grown to the size of the
+/// largest edge.
+///
 struct SVCandidateSetSequenceFragmentSampleGroup {
   typedef std::vector<SVCandidateSetSequenceFragment> pair_t;
   typedef pair_t::iterator                            iterator;
@@ -173,35 +198,39 @@ struct SVCandidateSetSequenceFragmentSampleGroup {
 
   iterator begin() { return _pairs.begin(); }
 
-  iterator end() { return _pairs.end(); }
+  iterator end() { return (_pairs.begin() + _pairCount); }
 
   const_iterator begin() const { return _pairs.begin(); }
 
-  const_iterator end() const { return _pairs.end(); }
+  const_iterator end() const { return (_pairs.begin() + _pairCount); }
 
-  unsigned size() const { return _pairs.size(); }
+  unsigned size() const { return _pairCount; }
 
   bool isFull() const { return _isFull; }
 
   void setFull() { _isFull = true; }
 
-private:
-  typedef std::string                    bamqname_t;
-  typedef std::map<bamqname_t, unsigned> pindex_t;
+  /// Remove all fragments and reset read counts, retaining fragment storage for reuse
+  void clear();
 
+private:
   /// get existing fragment or return pointer for a new fragment
   ///
   /// this will return null for new fragments when isFull() is true
   ///
-  SVCandidateSetSequenceFragment* getSequenceFragment(const pindex_t::key_type& key);
+  SVCandidateSetSequenceFragment* getSequenceFragment(const char* qname);
 
 public:
   /// Record a name for the data source to improve error messages:
   std::string dataSourceName = "UNKNOWN";
 
 private:
+  /// Fragment storage, only the first _pairCount fragments are in use
   pair_t   _pairs;
-  pindex_t _pairIndex;
+  unsigned _pairCount = 0;
+
+  /// Index of each fragment in _pairs by read name
+  ReadNameIndex _pairIndex;
 
   bool _isFull = false;  ///< this flag can be set if the object grows too large to insert more data into it
 
@@ -242,9 +271,12 @@ struct SVCandidateSetData {
     return diter->second;
   }
 
+  /// Remove all data, retaining the storage of each sample group for reuse
   void clear()
   {
-    _data.clear();
+    for (data_t::value_type& dataGroup : _data) {
+      dataGroup.second.clear();
+    }
     _searchIntervals.clear();
   }
 
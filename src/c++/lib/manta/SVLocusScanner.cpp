@@ -45,6 +45,36 @@
 #include "blt_util/log.hpp"
 #endif
 
+void SVLocusScannerReadAnalysis::reset(const bam_record& bamRead)
+{
+  _bamReadPtr = &bamRead;
+  getAlignment(bamRead, alignment);
+  isSASplit            = bamRead.isSASplit();
+  isSemiAlignedScanned = false;
+  leadingMismatchLen   = 0;
+  leadingRefPos        = 0;
+  trailingMismatchLen  = 0;
+  trailingRefPos       = 0;
+  candidates.clear();
+}
+
+void SVLocusScannerReadAnalysis::scanSemiAlignedEdges(
+    const reference_contig_segment& refSeq, const bool useOverlapPairEvidence)
+{
+  assert(nullptr != _bamReadPtr);
+  if (isSemiAlignedScanned) return;
+  getSVBreakendCandidateSemiAligned(
+      *_bamReadPtr,
+      alignment,
+      refSeq,
+      useOverlapPairEvidence,
+      leadingMismatchLen,
+      leadingRefPos,
+      trailingMismatchLen,
+      trailingRefPos);
+  isSemiAlignedScanned = true;
+}
+
 /// \brief Utilities pertaining to classifying anomolous fragments based on size so that they can be
 /// treated/weighted differently.
 ///
@@ -477,23 +507,16 @@ static void getSVCandidatesFromSemiAligned(
     const ReadScannerDerivOptions&                 dopt,
     const bam_record&                              bamRead,
     const bam_header_info&                         bamHeader,
-    const SimpleAlignment&                         bamAlign,
+    SVLocusScannerReadAnalysis&                    readAnalysis,
     const SourceOfSVEvidenceInDNAFragment::index_t dnaFragmentSVEvidenceSource,
     const reference_contig_segment&                refSeq,
     std::vector<SVObservation>&                    candidates)
 {
-  unsigned leadingMismatchLen(0);
-  unsigned trailingMismatchLen(0);
-  pos_t    leadingRefPos(0), trailingRefPos(0);
-  getSVBreakendCandidateSemiAligned(
-      bamRead,
-      bamAlign,
-      refSeq,
-      opt.useOverlapPairEvidence,
-      leadingMismatchLen,
-      leadingRefPos,
-      trailingMismatchLen,
-      trailingRefPos);
+  readAnalysis.scanSemiAlignedEdges(refSeq, opt.useOverlapPairEvidence);
+  const unsigned leadingMismatchLen(readAnalysis.leadingMismatchLen);
+  const unsigned trailingMismatchLen(readAnalysis.trailingMismatchLen);
+  const pos_t    leadingRefPos(readAnalysis.leadingRefPos);
+  const pos_t    trailingRefPos(readAnalysis.trailingRefPos);
 
   if ((leadingMismatchLen + trailingMismatchLen) >= bamRead.read_size()) return;
 
@@ -871,6 +894,9 @@ private:
 /// \param[in] remoteReadPtr Pointer to the bam record of \p localRead's mate. If nullptr, then properties of
 /// the mate alignment are inferred from the local alignment record.
 ///
+/// \param[in] remoteAlignPtr Pointer to the alignment of \p remoteReadPtr, this must be provided if
+/// \p remoteReadPtr is not nullptr.
+///
 /// \param[in,out] candidates New SVObservation objects are appended to this vector. Contents of the vector
 /// are preserved but not read.
 static void getSVCandidatesFromPair(
@@ -880,6 +906,7 @@ static void getSVCandidatesFromPair(
     const bam_record&                           localRead,
     const SimpleAlignment&                      localAlign,
     const bam_record*                           remoteReadPtr,
+    const SimpleAlignment*                      remoteAlignPtr,
     const bam_header_info&                      bamHeader,
     std::vector<SVObservation>&                 candidates)
 {
@@ -898,9 +925,11 @@ static void getSVCandidatesFromPair(
 
   // All information about the remote alignment is consolidated to one object. If the remote alignment record
   // is available the remote alignment will be more accurate.
-  const bool            isRemoteReadAvailable(nullptr != remoteReadPtr);
-  const SimpleAlignment remoteAlign(
-      isRemoteReadAvailable ? getAlignment(*remoteReadPtr) : getKnownOrFakedMateAlignment(localRead));
+  const bool      isRemoteReadAvailable(nullptr != remoteReadPtr);
+  SimpleAlignment inferredRemoteAlign;
+  if (!isRemoteReadAvailable) inferredRemoteAlign = getKnownOrFakedMateAlignment(localRead);
+  assert((!isRemoteReadAvailable) || (nullptr != remoteAlignPtr));
+  const SimpleAlignment& remoteAlign(isRemoteReadAvailable ? (*remoteAlignPtr) : inferredRemoteAlign);
 
   AlignmentPairAnalyzer pairInspector(opt, dopt, rstats, bamHeader);
   pairInspector.reset(localAlign, remoteAlign, (!isRemoteReadAvailable), localRead.is_first());
@@ -993,13 +1022,15 @@ static void getSingleReadSVCandidates(
     const ReadScannerOptions&       opt,
     const ReadScannerDerivOptions&  dopt,
     const bam_record&               localRead,
-    const SimpleAlignment&          localAlign,
+    SVLocusScannerReadAnalysis&     localAnalysis,
     const bam_header_info&          bamHeader,
     const reference_contig_segment& refSeq,
     std::vector<SVObservation>&     candidates)
 {
   using namespace illumina::common;
 
+  const SimpleAlignment& localAlign(localAnalysis.alignment);
+
   const bool                                     isRead2(localRead.is_paired() && (localRead.read_no() == 2));
   const SourceOfSVEvidenceInDNAFragment::index_t fragSource(
       isRead2 ? SourceOfSVEvidenceInDNAFragment::READ2 : SourceOfSVEvidenceInDNAFragment::READ1);
@@ -1014,7 +1045,7 @@ static void getSingleReadSVCandidates(
   // this prevents split reads from triggering spurious local assembles. It is
   // possible for a read to genuinely contain evidence of both, but this should
   // be very rare.
-  if (localRead.isSASplit()) {
+  if (localAnalysis.isSASplit) {
     getSACandidatesFromRead(opt, dopt, localRead, localAlign, fragSource, bamHeader, candidates);
 #ifdef DEBUG_SCANNER
     log_os << __FUNCTION__ << ": post-split read candidate_size: " << candidates.size() << "\n";
@@ -1022,7 +1053,7 @@ static void getSingleReadSVCandidates(
   } else {
     if (dopt.isSmallCandidates) {
       getSVCandidatesFromSemiAligned(
-          opt, dopt, localRead, bamHeader, localAlign, fragSource, refSeq, candidates);
+          opt, dopt, localRead, bamHeader, localAnalysis, fragSource, refSeq, candidates);
     }
 #ifdef DEBUG_SCANNER
     log_os << __FUNCTION__ << ": post-semialigned candidate_size: " << candidates.size() << "\n";
@@ -1034,11 +1065,14 @@ static void getSingleReadSVCandidates(
 //
 /// Note that estimation is improved by the mate record (because we have the mate cigar string in this case)
 ///
+/// \param[in,out] localAnalysis Intermediates for \p localRead, this must already be reset for \p localRead
+///
 static void getReadBreakendsImpl(
     const ReadScannerOptions&                   opt,
     const ReadScannerDerivOptions&              dopt,
     const SVLocusScanner::CachedReadGroupStats& rstats,
     const bam_record&                           localRead,
+    SVLocusScannerReadAnalysis&                 localAnalysis,
     const bam_record*                           remoteReadPtr,
     const bam_header_info&                      bamHeader,
     const reference_contig_segment&             localRefSeq,
@@ -1056,30 +1090,40 @@ static void getReadBreakendsImpl(
 
   candidates.clear();
 
-  /// get some basic derived information from the bam_record:
-  const SimpleAlignment localAlign(getAlignment(localRead));
+  assert(localAnalysis.isReset(localRead));
+  const SimpleAlignment& localAlign(localAnalysis.alignment);
 
   try {
-    getSingleReadSVCandidates(opt, dopt, localRead, localAlign, bamHeader, localRefSeq, candidates);
+    getSingleReadSVCandidates(opt, dopt, localRead, localAnalysis, bamHeader, localRefSeq, candidates);
 
     // run the same check on the read's mate if we have access to it
+    SVLocusScannerReadAnalysis remoteAnalysis;
     if (nullptr != remoteReadPtr) {
-      const bam_record&     remoteRead(*remoteReadPtr);
-      const SimpleAlignment remoteAlign(getAlignment(remoteRead));
+      const bam_record& remoteRead(*remoteReadPtr);
+      remoteAnalysis.reset(remoteRead);
 
       if (nullptr == remoteRefSeqPtr) {
         static const char msg[] = "ERROR: remoteRefSeqPtr cannot be null";
         BOOST_THROW_EXCEPTION(GeneralException(msg));
       }
       getSingleReadSVCandidates(
-          opt, dopt, remoteRead, remoteAlign, bamHeader, (*remoteRefSeqPtr), candidates);
+          opt, dopt, remoteRead, remoteAnalysis, bamHeader, (*remoteRefSeqPtr), candidates);
     }
 
     // process shadows:
     //getSVCandidatesFromShadow(opt, rstats, localRead, localAlign,remoteReadPtr,candidates);
 
     // - process anomalous read pairs:
-    getSVCandidatesFromPair(opt, dopt, rstats, localRead, localAlign, remoteReadPtr, bamHeader, candidates);
+    getSVCandidatesFromPair(
+        opt,
+        dopt,
+        rstats,
+        localRead,
+        localAlign,
+        remoteReadPtr,
+        &(remoteAnalysis.alignment),
+        bamHeader,
+        candidates);
   } catch (...) {
     std::cerr << "ERROR: Exception caught while processing ";
     if (nullptr == remoteReadPtr) {
@@ -1157,30 +1201,41 @@ static void getReadBreakendsImpl(
   }
 }
 
-/// \brief Create an SVLocus for each potential SV event supported by the BAM record
+/// \brief Create an SVLocusEvidence record for each potential SV event supported by the BAM record
 ///
-/// The loci count should almost always be one (or, depending on input filtration, zero).
-/// multiple suggested loci from one read is more of a theoretical possibility than an
+/// The record count should almost always be one (or, depending on input filtration, zero).
+/// multiple suggested records from one read is more of a theoretical possibility than an
 /// expectation.
 ///
-static void getSVLociImpl(
+static void getSVLocusEvidenceImpl(
     const ReadScannerOptions&                   opt,
     const ReadScannerDerivOptions&              dopt,
     const SVLocusScanner::CachedReadGroupStats& rstats,
     const bam_record&                           bamRead,
+    SVLocusScannerReadAnalysis&                 readAnalysis,
     const bam_header_info&                      bamHeader,
     const reference_contig_segment&             refSeq,
-    std::vector<SVLocus>&                       loci,
+    std::vector<SVLocusEvidence>&               locusEvidence,
     SampleEvidenceCounts&                       eCounts)
 {
   using namespace illumina::common;
 
-  loci.clear();
-  std::vector<SVObservation> candidates;
-  known_pos_range2           localEvidenceRange;
+  locusEvidence.clear();
+  std::vector<SVObservation>& candidates(readAnalysis.candidates);
+  known_pos_range2            localEvidenceRange;
 
   getReadBreakendsImpl(
-      opt, dopt, rstats, bamRead, nullptr, bamHeader, refSeq, nullptr, candidates, localEvidenceRange);
+      opt,
+      dopt,
+      rstats,
+      bamRead,
+      readAnalysis,
+      nullptr,
+      bamHeader,
+      refSeq,
+      nullptr,
+      candidates,
+      localEvidenceRange);
 
 #ifdef DEBUG_SCANNER
   log_os << __FUNCTION__ << ": candidate_size: " << candidates.size() << "\n";
@@ -1236,26 +1291,23 @@ static void getSVLociImpl(
       }
     }
 
-    // finally, create the graph locus:
-    SVLocus locus;
-    // set local breakend estimate:
-    const NodeIndexType localBreakendNode(locus.addNode(localBreakend.interval));
-    locus.setNodeEvidence(localBreakendNode, localEvidenceRange);
-
+    // finally, create the graph locus evidence:
+    locusEvidence.emplace_back();
+    SVLocusEvidence& evidence(locusEvidence.back());
     if (isCandComplex) {
-      locus.linkNodes(localBreakendNode, localBreakendNode, localEvidenceWeight);
+      evidence.setSelfEdge(localBreakend.interval, localEvidenceRange, localEvidenceWeight);
     } else {
-      // set remote breakend estimate:
-      const NodeIndexType remoteBreakendNode(locus.addNode(remoteBreakend.interval));
-      locus.linkNodes(localBreakendNode, remoteBreakendNode, localEvidenceWeight, remoteEvidenceWeight);
-
-      locus.mergeSelfOverlap();
+      evidence.setNodePair(
+          localBreakend.interval,
+          localEvidenceRange,
+          localEvidenceWeight,
+          remoteBreakend.interval,
+          remoteEvidenceWeight);
     }
 
 #ifdef DEBUG_SCANNER
-    log_os << __FUNCTION__ << ": adding Locus: " << locus << "\n";
+    log_os << __FUNCTION__ << ": adding locus evidence with node count: " << evidence.nodeCount << "\n";
 #endif
-    loci.push_back(locus);
   }
 }
 
@@ -1438,16 +1490,22 @@ bool SVLocusScanner::isSVEvidence(
     const bam_record&               bamRead,
     const unsigned                  defaultReadGroupIndex,
     const reference_contig_segment& refSeq,
+    SVLocusScannerReadAnalysis&     readAnalysis,
     SVLocusEvidenceCount*           incountsPtr) const
 {
+  readAnalysis.reset(bamRead);
+
   // exclude innie read pairs which are anomalously short:
-  const bool      isAnom(isNonCompressedAnomalousReadPair(bamRead, defaultReadGroupIndex));
-  const bool      isSplit(bamRead.isSASplit());
-  SimpleAlignment _bamAlign;
-  getAlignment(bamRead, _bamAlign);
-  const bool isIndel(isLocalIndelEvidence(_bamAlign));
-  const bool isAssm(
-      (_dopt.isSmallCandidates) && ((!isSplit) && isSemiAlignedEvidence(bamRead, _bamAlign, refSeq)));
+  const bool isAnom(isNonCompressedAnomalousReadPair(bamRead, defaultReadGroupIndex));
+  const bool isSplit(readAnalysis.isSASplit);
+  const bool isIndel(isLocalIndelEvidence(readAnalysis.alignment));
+  bool       isAssm(false);
+  if (_dopt.isSmallCandidates && (!isSplit)) {
+    readAnalysis.scanSemiAlignedEdges(refSeq, _opt.useOverlapPairEvidence);
+    isAssm =
+        ((readAnalysis.leadingMismatchLen >= _opt.minSemiAlignedMismatchLen) ||
+         (readAnalysis.trailingMismatchLen >= _opt.minSemiAlignedMismatchLen));
+  }
 
   // Mark supplemental segments of split reads, and exclude these from the "normal" read counts
   const bool isSupplementary(bamRead.is_supplementary() || bamRead.is_secondary());
@@ -1482,6 +1540,20 @@ bool SVLocusScanner::isSVEvidence(
   return isEvidence;
 }
 
+void SVLocusScanner::getSVLocusEvidence(
+    const bam_record&               bamRead,
+    const unsigned                  defaultReadGroupIndex,
+    const bam_header_info&          bamHeader,
+    const reference_contig_segment& refSeq,
+    SVLocusScannerReadAnalysis&     readAnalysis,
+    std::vector<SVLocusEvidence>&   locusEvidence,
+    SampleEvidenceCounts&           eCounts) const
+{
+  const CachedReadGroupStats& rstats(_stats[defaultReadGroupIndex]);
+  getSVLocusEvidenceImpl(
+      _opt, _dopt, rstats, bamRead, readAnalysis, bamHeader, refSeq, locusEvidence, eCounts);
+}
+
 void SVLocusScanner::getSVLoci(
     const bam_record&               bamRead,
     const unsigned                  defaultReadGroupIndex,
@@ -1492,8 +1564,13 @@ void SVLocusScanner::getSVLoci(
 {
   loci.clear();
 
-  const CachedReadGroupStats& rstats(_stats[defaultReadGroupIndex]);
-  getSVLociImpl(_opt, _dopt, rstats, bamRead, bamHeader, refSeq, loci, eCounts);
+  std::vector<SVLocusEvidence> locusEvidence;
+  getSVLocusEvidence(bamRead, defaultReadGroupIndex, bamHeader, refSeq, locusEvidence, eCounts);
+
+  loci.resize(locusEvidence.size());
+  for (unsigned evidenceIndex(0); evidenceIndex < locusEvidence.size(); ++evidenceIndex) {
+    loci[evidenceIndex].addEvidence(locusEvidence[evidenceIndex]);
+  }
 }
 
 void SVLocusScanner::getBreakendPair(
@@ -1507,6 +1584,9 @@ void SVLocusScanner::getBreakendPair(
 {
   const CachedReadGroupStats& rstats(_stats[defaultReadGroupIndex]);
 
+  SVLocusScannerReadAnalysis localAnalysis;
+  localAnalysis.reset(localRead);
+
   // throw evidence range away in this case
   known_pos_range2 evidenceRange;
   getReadBreakendsImpl(
@@ -1514,6 +1594,7 @@ void SVLocusScanner::getBreakendPair(
       _dopt,
       rstats,
       localRead,
+      localAnalysis,
       remoteReadPtr,
       bamHeader,
       localRefSeq,
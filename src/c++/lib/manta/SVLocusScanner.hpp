@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "blt_util/LinearScaler.hpp"
+#include "blt_util/SimpleAlignment.hpp"
 #include "htsapi/align_path_bam_util.hpp"
 #include "htsapi/bam_header_info.hpp"
 #include "htsapi/bam_record.hpp"
@@ -93,6 +94,47 @@ struct ReadScannerDerivOptions {
   const bool isTranscriptStrandKnown;
 };
 
+/// \brief Per-read intermediate results shared by the SV evidence scanning methods of SVLocusScanner
+///
+/// Classifying a read as SV evidence and converting the read into SV observations both depend on the read's
+/// alignment, its split read status and (for reads without split alignments) a scan of poorly aligned read
+/// edges against the reference. This object holds these intermediates so that they are computed only once
+/// per read when both steps are run. All buffers are retained between reads to avoid reallocation.
+///
+/// The analysis must be reset for each new read, this is done by SVLocusScanner::isSVEvidence.
+///
+struct SVLocusScannerReadAnalysis {
+  /// Clear all results from any previous read and compute the basic read intermediates for \p bamRead
+  void reset(const bam_record& bamRead);
+
+  /// True if this analysis was last reset for \p bamRead
+  bool isReset(const bam_record& bamRead) const { return (_bamReadPtr == &bamRead); }
+
+  /// \brief Scan the read edges for poorly aligned segments, unless this has already been done since the last
+  /// reset
+  ///
+  /// See ::getSVBreakendCandidateSemiAligned for details.
+  void scanSemiAlignedEdges(const reference_contig_segment& refSeq, const bool useOverlapPairEvidence);
+
+  SimpleAlignment alignment;
+
+  /// True if the read has an SA tag
+  bool isSASplit = false;
+
+  /// True if the poorly aligned edge results below have been computed since the last reset
+  bool     isSemiAlignedScanned = false;
+  unsigned leadingMismatchLen   = 0;
+  pos_t    leadingRefPos        = 0;
+  unsigned trailingMismatchLen  = 0;
+  pos_t    trailingRefPos       = 0;
+
+  /// SV observations generated from the read
+  std::vector<SVObservation> candidates;
+
+private:
+  const bam_record* _bamReadPtr = nullptr;
+};
+
 /// \brief Consolidate functions which test aligned reads for SV evidence
 ///
 /// In manta, evidence is scanned (at least) twice: once for SVLocus Graph generation
@@ -167,8 +209,62 @@ struct SVLocusScanner {
       const bam_record&               bamRead,
       const unsigned                  defaultReadGroupIndex,
       const reference_contig_segment& refSeq,
+      SVLocusEvidenceCount*           incountsPtr = nullptr) const
+  {
+    SVLocusScannerReadAnalysis readAnalysis;
+    return isSVEvidence(bamRead, defaultReadGroupIndex, refSeq, readAnalysis, incountsPtr);
+  }
+
+  /// \brief A fast test to eliminate reads which are very unlikely to contribute any SV or indel evidence
+  ///
+  /// This version resets \p readAnalysis for \p bamRead, so that the read intermediates computed for the
+  /// test can be reused by getSVLocusEvidence.
+  ///
+  /// \param[out] readAnalysis Reset and partially computed for \p bamRead
+  bool isSVEvidence(
+      const bam_record&               bamRead,
+      const unsigned                  defaultReadGroupIndex,
+      const reference_contig_segment& refSeq,
+      SVLocusScannerReadAnalysis&     readAnalysis,
       SVLocusEvidenceCount*           incountsPtr = nullptr) const;
 
+  /// \brief Get zero to many SV locus evidence records if the read supports any structural variant(s)
+  /// (detectable by manta)
+  ///
+  /// This is the allocation-free equivalent of getSVLoci, intended for use in the SV locus graph build.
+  ///
+  /// \param defaultReadGroupIndex the read group index to use in the absence of an RG tag
+  /// (for now RGs are ignored for the purpose of gathering insert stats)
+  ///
+  /// \param[out] locusEvidence Evidence records for the read. This vector is cleared on input, so that it can
+  /// be reused for each read without reallocation.
+  void getSVLocusEvidence(
+      const bam_record&               bamRead,
+      const unsigned                  defaultReadGroupIndex,
+      const bam_header_info&          bamHeader,
+      const reference_contig_segment& refSeq,
+      std::vector<SVLocusEvidence>&   locusEvidence,
+      SampleEvidenceCounts&           eCounts) const
+  {
+    SVLocusScannerReadAnalysis readAnalysis;
+    readAnalysis.reset(bamRead);
+    getSVLocusEvidence(
+        bamRead, defaultReadGroupIndex, bamHeader, refSeq, readAnalysis, locusEvidence, eCounts);
+  }
+
+  /// \brief Get zero to many SV locus evidence records from a read which has already been analyzed
+  ///
+  /// \param[in,out] readAnalysis Intermediates for \p bamRead, this must have been reset for \p bamRead, for
+  /// instance by calling isSVEvidence on the same read.
+  void getSVLocusEvidence(
+      const bam_record&               bamRead,
+      const unsigned                  defaultReadGroupIndex,
+      const bam_header_info&          bamHeader,
+      const reference_contig_segment& refSeq,
+      SVLocusScannerReadAnalysis&     readAnalysis,
+      std::vector<SVLocusEvidence>&   locusEvidence,
+      SampleEvidenceCounts&           eCounts) const;
+
   /// return zero to many SVLocus objects if the read supports any
   /// structural variant(s) (detectable by manta)
   ///
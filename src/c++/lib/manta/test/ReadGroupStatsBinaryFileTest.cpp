@@ -0,0 +1,136 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "boost/test/unit_test.hpp"
+
+#include "manta/ReadGroupStatsBinaryFile.hpp"
+
+#include "test/testFileMakers.hpp"
+
+#include <fstream>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(test_ReadGroupStatsBinaryFile)
+
+static ReadGroupStats getTestGroupStats(const unsigned seed)
+{
+  std::mt19937                    generator(seed);
+  std::normal_distribution<float> sizeDistro(400, 60);
+
+  ReadGroupStats groupStats;
+  for (unsigned observationIndex(0); observationIndex < 5000; ++observationIndex) {
+    groupStats.fragStats.addObservation(static_cast<int>(sizeDistro(generator)));
+  }
+  groupStats.relOrients.setVal(PAIR_ORIENT::Rp);
+  groupStats.readCounter = ReadCounter(seed + 100, seed + 80, seed + 20, seed + 10, seed + 50);
+  return groupStats;
+}
+
+static void checkStatsEqual(const ReadGroupStatsSet& expected, const ReadGroupStatsSet& result)
+{
+  BOOST_REQUIRE_EQUAL(expected.size(), result.size());
+  for (unsigned groupIndex(0); groupIndex < expected.size(); ++groupIndex) {
+    const ReadGroupLabel& key(expected.getKey(groupIndex));
+    const auto            resultIndex(result.getGroupIndex(key));
+    BOOST_REQUIRE(resultIndex);
+
+    const ReadGroupStats& expectedStats(expected.getStats(groupIndex));
+    const ReadGroupStats& resultStats(result.getStats(*resultIndex));
+    BOOST_REQUIRE(resultStats.fragStats.isFrozen());
+    BOOST_REQUIRE_EQUAL(expectedStats.relOrients.val(), resultStats.relOrients.val());
+
+    const ReadCounter& expectedCounter(expectedStats.readCounter);
+    const ReadCounter& resultCounter(resultStats.readCounter);
+    BOOST_REQUIRE_EQUAL(expectedCounter.totalReadCount(), resultCounter.totalReadCount());
+    BOOST_REQUIRE_EQUAL(expectedCounter.totalPairedReadCount(), resultCounter.totalPairedReadCount());
+    BOOST_REQUIRE_EQUAL(expectedCounter.totalUnpairedReadCount(), resultCounter.totalUnpairedReadCount());
+    BOOST_REQUIRE_EQUAL(
+        expectedCounter.totalPairedLowMapqReadCount(), resultCounter.totalPairedLowMapqReadCount());
+    BOOST_REQUIRE_EQUAL(
+        expectedCounter.totalHighConfidenceReadPairCount(), resultCounter.totalHighConfidenceReadPairCount());
+
+    const SizeDistribution& expectedFragStats(expectedStats.fragStats);
+    const SizeDistribution& resultFragStats(resultStats.fragStats);
+    BOOST_REQUIRE_EQUAL(expectedFragStats.totalObservations(), resultFragStats.totalObservations());
+    for (int size(-10); size < 1000; ++size) {
+      BOOST_REQUIRE_EQUAL(expectedFragStats.cdf(size), resultFragStats.cdf(size));
+      // pdf is undefined for an empty distribution:
+      if (expectedFragStats.totalObservations() == 0) continue;
+      BOOST_REQUIRE_EQUAL(expectedFragStats.pdf(size), resultFragStats.pdf(size));
+    }
+    for (float prob(0); prob <= 1; prob += 0.001f) {
+      BOOST_REQUIRE_EQUAL(expectedFragStats.quantile(prob), resultFragStats.quantile(prob));
+    }
+  }
+}
+
+// Test that stats loaded from the binary format match the original stats and the stats loaded from XML
+BOOST_AUTO_TEST_CASE(test_BinaryStatsRoundTrip)
+{
+  ReadGroupStatsSet rstats;
+  rstats.setStats(ReadGroupLabel("sample1.bam", ""), getTestGroupStats(1));
+  rstats.setStats(ReadGroupLabel("sample2.bam", ""), getTestGroupStats(2));
+  rstats.setStats(ReadGroupLabel("sample3.bam", ""), ReadGroupStats());
+
+  TestFilenameMaker binaryFilenameMaker;
+  const char*       binaryFilename(binaryFilenameMaker.getFilename().c_str());
+  rstats.saveBinary(binaryFilename);
+  BOOST_REQUIRE(isReadGroupStatsBinaryFile(binaryFilename));
+
+  ReadGroupStatsSet binaryStats;
+  binaryStats.load(binaryFilename);
+  checkStatsEqual(rstats, binaryStats);
+
+  TestFilenameMaker xmlFilenameMaker;
+  const char*       xmlFilename(xmlFilenameMaker.getFilename().c_str());
+  rstats.save(xmlFilename);
+  BOOST_REQUIRE(!isReadGroupStatsBinaryFile(xmlFilename));
+
+  ReadGroupStatsSet xmlStats;
+  xmlStats.load(xmlFilename);
+  checkStatsEqual(xmlStats, binaryStats);
+}
+
+// Test that a truncated binary stats file is rejected
+BOOST_AUTO_TEST_CASE(test_BinaryStatsTruncated)
+{
+  ReadGroupStatsSet rstats;
+  rstats.setStats(ReadGroupLabel("sample1.bam", ""), getTestGroupStats(1));
+
+  TestFilenameMaker binaryFilenameMaker;
+  const char*       binaryFilename(binaryFilenameMaker.getFilename().c_str());
+  rstats.saveBinary(binaryFilename);
+
+  std::string fileContents;
+  {
+    std::ifstream ifs(binaryFilename, std::ios::binary);
+    fileContents.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream ofs(binaryFilename, std::ios::binary);
+    ofs.write(fileContents.data(), fileContents.size() - 8);
+  }
+
+  ReadGroupStatsSet truncatedStats;
+  BOOST_REQUIRE_THROW(truncatedStats.load(binaryFilename), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
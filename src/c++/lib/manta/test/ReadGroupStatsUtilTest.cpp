@@ -0,0 +1,115 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "boost/test/unit_test.hpp"
+
+#include "manta/ReadGroupStatsUtil.hpp"
+
+#include "test/testAlignmentDataUtil.hpp"
+#include "test/testFileMakers.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+/// Build a test alignment file with FR read pairs spread evenly over several chromosomes
+///
+/// There are enough pairs to fill many sampling buffers on each chromosome, but not enough to trigger an
+/// insert size convergence test, so all reads are sampled regardless of sampling order.
+static void buildTestStatsBamFile(const std::string& bamFilename)
+{
+  static const int chromSize(20000);
+  static const int readLength(50);
+
+  bam_header_info bamHeader;
+  for (const char* chromName : {"chr1", "chr2", "chr3"}) {
+    bamHeader.chrom_data.emplace_back(chromName, chromSize);
+  }
+  int32_t chromIndex(0);
+  for (const auto& chromData : bamHeader.chrom_data) {
+    bamHeader.chrom_to_index.insert(std::make_pair(chromData.label, chromIndex));
+    chromIndex++;
+  }
+
+  std::vector<bam_record> readsToAdd;
+  for (int tid(0); tid < 3; ++tid) {
+    for (int pos(0); (pos + 250) < chromSize; ++pos) {
+      const int         fragmentSize(150 + ((pos * (tid + 1)) % 97));
+      const int         matePos(pos + fragmentSize - readLength);
+      const std::string qname("pair_" + std::to_string(tid) + "_" + std::to_string(pos));
+
+      readsToAdd.emplace_back();
+      bam_record& read1(readsToAdd.back());
+      buildTestBamRecord(read1, tid, pos, tid, matePos, readLength, 40, "", "", fragmentSize);
+      read1.set_qname(qname.c_str());
+      read1.toggle_is_first();
+
+      readsToAdd.emplace_back();
+      bam_record& read2(readsToAdd.back());
+      buildTestBamRecord(read2, tid, matePos, tid, pos, readLength, 40, "", "", -fragmentSize);
+      read2.set_qname(qname.c_str());
+      read2.toggle_is_second();
+      read2.toggle_is_fwd_strand();
+      read2.toggle_is_mate_fwd_strand();
+    }
+  }
+  std::stable_sort(readsToAdd.begin(), readsToAdd.end(), [](const bam_record& a, const bam_record& b) {
+    return ((a.target_id() < b.target_id()) || ((a.target_id() == b.target_id()) && (a.pos() < b.pos())));
+  });
+
+  buildTestBamFile(bamHeader, readsToAdd, bamFilename);
+}
+
+/// Get the stats estimated from \p bamFilename, in the serialized XML format
+static std::string getAlignmentFileStats(const std::string& bamFilename, const unsigned threadCount)
+{
+  ReadGroupStatsSet rstats;
+  extractReadGroupStatsFromAlignmentFile(getTestReferenceFilename(), bamFilename, "", threadCount, 0, rstats);
+  BOOST_REQUIRE_EQUAL(rstats.size(), 1u);
+
+  TestFilenameMaker statsFilename;
+  rstats.save(statsFilename.getFilename().c_str());
+  std::ifstream      ifs(statsFilename.getFilename());
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  return oss.str();
+}
+
+BOOST_AUTO_TEST_SUITE(test_ReadGroupStatsUtil)
+
+// Test that parallel stats sampling gives the same result on repeated runs, and the same result as serial
+// sampling when every read is sampled
+BOOST_AUTO_TEST_CASE(test_ParallelStatsSampling)
+{
+  BamFilenameMaker bamFilename;
+  buildTestStatsBamFile(bamFilename.getFilename());
+
+  const std::string serialStats(getAlignmentFileStats(bamFilename.getFilename(), 1));
+  BOOST_REQUIRE(!serialStats.empty());
+
+  for (const unsigned threadCount : {2u, 3u}) {
+    const std::string parallelStats(getAlignmentFileStats(bamFilename.getFilename(), threadCount));
+    BOOST_REQUIRE_EQUAL(getAlignmentFileStats(bamFilename.getFilename(), threadCount), parallelStats);
+    BOOST_REQUIRE_EQUAL(parallelStats, serialStats);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,63 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "boost/test/unit_test.hpp"
+
+#include "manta/ReadNameIndex.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(test_ReadNameIndex)
+
+// Test index lookups against std::map over several clear and reuse cycles
+BOOST_AUTO_TEST_CASE(test_ReadNameIndexMatchesMap)
+{
+  std::mt19937                            generator(7);
+  std::uniform_int_distribution<unsigned> nameDistro(0, 20000);
+
+  ReadNameIndex index;
+  for (const unsigned nameCount : {5000u, 100u, 30000u, 0u, 10u}) {
+    index.clear();
+    BOOST_REQUIRE_EQUAL(index.size(), 0u);
+
+    std::map<std::string, unsigned> expected;
+    for (unsigned nameIndex(0); nameIndex < nameCount; ++nameIndex) {
+      const std::string qname("READ:1:" + std::to_string(nameDistro(generator)));
+      const auto        expectedIter(expected.find(qname));
+      if (expectedIter == expected.end()) {
+        BOOST_REQUIRE_EQUAL(index.find(qname.c_str()), ReadNameIndex::notFound);
+        index.insert(qname.c_str(), nameIndex);
+        expected[qname] = nameIndex;
+      } else {
+        BOOST_REQUIRE_EQUAL(index.find(qname.c_str()), expectedIter->second);
+      }
+    }
+
+    BOOST_REQUIRE_EQUAL(index.size(), expected.size());
+    for (const auto& expectedValue : expected) {
+      BOOST_REQUIRE_EQUAL(index.find(expectedValue.first.c_str()), expectedValue.second);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,88 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "boost/test/unit_test.hpp"
+
+#include "manta/SVCandidateSetData.hpp"
+#include "test/testAlignmentDataUtil.hpp"
+
+BOOST_AUTO_TEST_SUITE(test_SVCandidateSetData)
+
+static void addTestRead(
+    const bam_header_info&                     bamHeader,
+    const char*                                qname,
+    const int                                  pos,
+    const bool                                 isRead1,
+    SVCandidateSetSequenceFragmentSampleGroup& group)
+{
+  bam_record bamRead;
+  buildTestBamRecord(bamRead, 0, pos, 0, pos + 200);
+  bamRead.set_qname(qname);
+  bamRead.toggle_is_paired();
+  if (isRead1) {
+    bamRead.toggle_is_first();
+  } else {
+    bamRead.toggle_is_second();
+  }
+  group.add(bamHeader, bamRead, false, true, false);
+}
+
+// Test that fragments are grouped by read name, and that a cleared object is correctly reused
+BOOST_AUTO_TEST_CASE(test_SVCandidateSetDataReuse)
+{
+  const bam_header_info bamHeader(buildTestBamHeader());
+
+  SVCandidateSetData svData;
+  for (unsigned cycleIndex(0); cycleIndex < 3; ++cycleIndex) {
+    svData.clear();
+    SVCandidateSetSequenceFragmentSampleGroup& group(svData.getDataGroup(0));
+    BOOST_REQUIRE_EQUAL(group.size(), 0u);
+
+    // use fewer fragments in later cycles, so that some of the reused storage is left unused:
+    const unsigned fragmentCount(300 - (cycleIndex * 100));
+    for (unsigned fragmentIndex(0); fragmentIndex < fragmentCount; ++fragmentIndex) {
+      const std::string qname("frag" + std::to_string(fragmentIndex));
+      addTestRead(bamHeader, qname.c_str(), 100 + fragmentIndex, true, group);
+      if ((fragmentIndex % 2) == 0) {
+        addTestRead(bamHeader, qname.c_str(), 300 + fragmentIndex, false, group);
+      }
+    }
+    BOOST_REQUIRE_EQUAL(group.size(), fragmentCount);
+
+    unsigned fragmentIndex(0);
+    for (const SVCandidateSetSequenceFragment& fragment : group) {
+      const std::string qname("frag" + std::to_string(fragmentIndex));
+      BOOST_REQUIRE_EQUAL(std::string(fragment.qname()), qname);
+      BOOST_REQUIRE(fragment.svLink.empty());
+      BOOST_REQUIRE(fragment.read1.isSet());
+      BOOST_REQUIRE_EQUAL(fragment.read1.bamrec.pos(), static_cast<int>(101 + fragmentIndex));
+      BOOST_REQUIRE_EQUAL(fragment.read2.isSet(), ((fragmentIndex % 2) == 0));
+      BOOST_REQUIRE(fragment.read1Supplemental.empty());
+      BOOST_REQUIRE(fragment.read2Supplemental.empty());
+
+      // modify fragments to check that they're reset on reuse:
+      const_cast<SVCandidateSetSequenceFragment&>(fragment).svLink.emplace_back(0);
+      fragmentIndex++;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -338,6 +338,65 @@ BOOST_AUTO_TEST_CASE(test_SemiAlignedReads)
   BOOST_REQUIRE(rnaScanner->isSemiAlignedEvidence(overlappingRead, semiAlignment, ref));
 }
 
+/// Test that SV locus evidence computed from the read analysis shared with isSVEvidence matches evidence
+/// computed directly from each read
+BOOST_AUTO_TEST_CASE(test_SharedReadAnalysis)
+{
+  static const pos_t alignPos(500);
+
+  const bam_header_info           bamHeader(buildTestBamHeader());
+  std::unique_ptr<SVLocusScanner> scanner(buildTestSVLocusScanner(bamHeader, false, 100));
+
+  reference_contig_segment ref      = reference_contig_segment();
+  static const char        refSeq[] = "AACCTTTTTTCATCACACACAAGAGTCCAGAGACCGACTTCCCCCCAAAA";
+  ref.seq()                         = refSeq;
+  ref.set_offset(alignPos);
+
+  SVLocusScannerReadAnalysis readAnalysis;
+
+  // The semi-aligned edge scan from the evidence test is retained in the read analysis:
+  static const char semiQuerySeq[] = "AACCCACAAACATCACACACAAGAGTCCAGAGACCGACTTTTTTCTAAAA";
+  bam_record        semiRead;
+  buildTestBamRecord(semiRead, 0, alignPos, 0, alignPos + 50, 50, 15, "50M", semiQuerySeq);
+  semiRead.toggle_is_paired();
+  BOOST_REQUIRE(scanner->isSVEvidence(semiRead, 0, ref, readAnalysis));
+  BOOST_REQUIRE(readAnalysis.isSemiAlignedScanned);
+  BOOST_REQUIRE(readAnalysis.leadingMismatchLen > 0);
+
+  std::vector<bam_record> reads(2);
+
+  // large deletion read
+  buildTestBamRecord(reads[0], 0, 100, 0, 300, 200, 15, "50M100D50M");
+
+  // anomalous read pair with mate on another chromosome
+  buildTestBamRecord(reads[1], 0, 100, 1, 200, 200, 15, "50M");
+
+  std::vector<SVLocusEvidence> sharedEvidence;
+  std::vector<SVLocusEvidence> directEvidence;
+  SampleEvidenceCounts         eCounts;
+  for (const bam_record& read : reads) {
+    const bool isEvidence(scanner->isSVEvidence(read, 0, ref, readAnalysis));
+    BOOST_REQUIRE(isEvidence);
+    BOOST_REQUIRE_EQUAL(isEvidence, scanner->isSVEvidence(read, 0, ref));
+    BOOST_REQUIRE(readAnalysis.isReset(read));
+
+    scanner->getSVLocusEvidence(read, 0, bamHeader, ref, readAnalysis, sharedEvidence, eCounts);
+    scanner->getSVLocusEvidence(read, 0, bamHeader, ref, directEvidence, eCounts);
+    BOOST_REQUIRE(!sharedEvidence.empty());
+    BOOST_REQUIRE_EQUAL(sharedEvidence.size(), directEvidence.size());
+    for (unsigned evidenceIndex(0); evidenceIndex < sharedEvidence.size(); ++evidenceIndex) {
+      const SVLocusEvidence& shared(sharedEvidence[evidenceIndex]);
+      const SVLocusEvidence& direct(directEvidence[evidenceIndex]);
+      BOOST_REQUIRE_EQUAL(shared.nodeCount, direct.nodeCount);
+      for (unsigned nodeIndex(0); nodeIndex < shared.nodeCount; ++nodeIndex) {
+        BOOST_REQUIRE_EQUAL(shared.intervals[nodeIndex], direct.intervals[nodeIndex]);
+        BOOST_REQUIRE_EQUAL(shared.evidenceRanges[nodeIndex], direct.evidenceRanges[nodeIndex]);
+        BOOST_REQUIRE_EQUAL(shared.edgeCounts[nodeIndex], direct.edgeCounts[nodeIndex]);
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_getSVCandidatesFromReadIndels)
 {
   const bool                    isStranded(true);
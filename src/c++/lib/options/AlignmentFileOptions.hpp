@@ -39,4 +39,8 @@ struct AlignmentFileOptions {
 
   /// Indicates which positions in the alignmnetFilename correspond to tumor
   std::vector<bool> isAlignmentTumor;
+
+  /// Size of the htslib thread pool shared by all alignment file streams, zero decodes every file on the
+  /// thread reading it
+  unsigned decompressThreadCount = 0;
 };
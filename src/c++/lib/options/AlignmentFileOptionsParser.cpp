@@ -24,7 +24,7 @@
 
 typedef std::vector<std::string> files_t;
 
-boost::program_options::options_description getOptionsDescription(AlignmentFileOptions& /*opt*/)
+boost::program_options::options_description getOptionsDescription(AlignmentFileOptions& opt)
 {
   namespace po = boost::program_options;
   po::options_description desc("alignment-files");
@@ -35,7 +35,11 @@ boost::program_options::options_description getOptionsDescription(AlignmentFileO
       "alignment file in BAM or CRAM format (may be specified multiple times, assumed to be non-tumor if tumor file(s) provided)")(
       "tumor-align-file",
       po::value<files_t>(),
-      "tumor sample alignment file in BAM or CRAM format (may be specified multiple times)");
+      "tumor sample alignment file in BAM or CRAM format (may be specified multiple times)")(
+      "decompress-threads",
+      po::value(&opt.decompressThreadCount)->default_value(opt.decompressThreadCount),
+      "number of additional threads shared by all alignment files for BAM/CRAM decompression and decoding "
+      "(0 decodes on the reading thread)");
   // clang-format on
 
   return desc;
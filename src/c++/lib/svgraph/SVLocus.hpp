@@ -24,6 +24,7 @@
 #pragma once
 
 #include "blt_util/flyweight_observer.hpp"
+#include "svgraph/SVLocusEvidence.hpp"
 #include "svgraph/SVLocusNode.hpp"
 
 typedef unsigned LocusIndexType;
@@ -135,6 +136,24 @@ struct SVLocus : public flyweight_notifier<SVLocusNodeMoveMessage> {
     getNode(nodeIndex).setEvidenceRange(evidenceRange);
   }
 
+  /// Add the nodes and edges described by \p evidence to this locus
+  ///
+  /// \param[in] obs observer subscribes to the addNode events
+  void addEvidence(const SVLocusEvidence& evidence, flyweight_observer_t* obs = nullptr)
+  {
+    assert((evidence.nodeCount == 1) || (evidence.nodeCount == 2));
+
+    const NodeIndexType localNode(addNode(evidence.intervals[0], obs));
+    setNodeEvidence(localNode, evidence.evidenceRanges[0]);
+    if (evidence.isSelfEdge()) {
+      linkNodes(localNode, localNode, evidence.edgeCounts[0]);
+    } else {
+      const NodeIndexType remoteNode(addNode(evidence.intervals[1], obs));
+      setNodeEvidence(remoteNode, evidence.evidenceRanges[1]);
+      linkNodes(localNode, remoteNode, evidence.edgeCounts[0], evidence.edgeCounts[1]);
+    }
+  }
+
   /// Find the indices of all nodes connected to the \p startIndex node
   ///
   /// \param[in] startIndex Index of node to start connected node search from
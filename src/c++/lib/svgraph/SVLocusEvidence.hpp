@@ -0,0 +1,110 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+
+/// \file
+/// \brief Lightweight representation of the SV locus graph elements contributed by a single read
+///
+
+#pragma once
+
+#include "svgraph/GenomeInterval.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+/// \brief The SV locus graph nodes and edges contributed by a single piece of read evidence
+///
+/// This holds the same information as the one or two node SVLocus built for each read during graph
+/// construction, without any heap allocated node or edge storage, so that read scanning can emit evidence
+/// into a reusable buffer which is merged directly into an SVLocusSet.
+///
+/// Node 0 is always the local breakend of the read. A single node evidence record represents a local node
+/// with a self-edge, a two node record represents a local node linked to a remote node.
+///
+struct SVLocusEvidence {
+  /// \brief Set evidence for a single breakend node with a self-edge
+  void setSelfEdge(
+      const GenomeInterval& interval, const known_pos_range2& evidenceRange, const unsigned edgeCount)
+  {
+    nodeCount         = 1;
+    intervals[0]      = interval;
+    evidenceRanges[0] = evidenceRange;
+    edgeCounts[0]     = edgeCount;
+    edgeCounts[1]     = 0;
+  }
+
+  /// \brief Set evidence linking a local and remote breakend node
+  ///
+  /// The remote node evidence range is set to its breakend interval. If the two breakend intervals intersect,
+  /// they are combined into a single node with a self-edge, following the same rules used to merge nodes in
+  /// SVLocus::mergeSelfOverlap().
+  ///
+  /// \param[in] localEdgeCount Edge count on the local -> remote edge
+  /// \param[in] remoteEdgeCount Edge count on the remote -> local edge
+  void setNodePair(
+      const GenomeInterval&   localInterval,
+      const known_pos_range2& localEvidenceRange,
+      const unsigned          localEdgeCount,
+      const GenomeInterval&   remoteInterval,
+      const unsigned          remoteEdgeCount)
+  {
+    if (!localInterval.isIntersect(remoteInterval)) {
+      nodeCount         = 2;
+      intervals[0]      = localInterval;
+      intervals[1]      = remoteInterval;
+      evidenceRanges[0] = localEvidenceRange;
+      evidenceRanges[1] = remoteInterval.range;
+      edgeCounts[0]     = localEdgeCount;
+      edgeCounts[1]     = remoteEdgeCount;
+      return;
+    }
+
+    GenomeInterval mergedInterval(localInterval);
+    mergedInterval.range = merge_range(localInterval.range, remoteInterval.range);
+
+    // The evidence range only retains the contribution of nodes with outgoing evidence, unless neither node
+    // has any:
+    known_pos_range2 mergedEvidenceRange(localEvidenceRange);
+    if ((0 == localEdgeCount) && (0 != remoteEdgeCount)) {
+      mergedEvidenceRange = remoteInterval.range;
+    } else if ((0 == localEdgeCount) || (0 != remoteEdgeCount)) {
+      mergedEvidenceRange = merge_range(localEvidenceRange, remoteInterval.range);
+    }
+
+    // Edge counts on the collapsed edge pair are combined with max instead of sum, so that a single
+    // fragment is not counted twice:
+    setSelfEdge(mergedInterval, mergedEvidenceRange, std::max(localEdgeCount, remoteEdgeCount));
+  }
+
+  bool isSelfEdge() const
+  {
+    assert(nodeCount > 0);
+    return (1 == nodeCount);
+  }
+
+  /// Number of breakend nodes, either 1 or 2
+  unsigned nodeCount = 0;
+
+  GenomeInterval   intervals[2];
+  known_pos_range2 evidenceRanges[2];
+
+  /// For a two node record, edge counts on the local -> remote and remote -> local edges, for a single node
+  /// record the self-edge count is stored in the first entry
+  unsigned edgeCounts[2] = {0, 0};
+};
@@ -33,8 +33,6 @@ std::ostream& operator<<(std::ostream& os, const SVLocusEdge& edge)
   return os;
 }
 
-const SVLocusEdgesType SVLocusEdgeManager::staticMap;
-
 void SVLocusNode::getEdgeException(const NodeIndexType toIndex, const char* label) const
 {
   using namespace illumina::common;
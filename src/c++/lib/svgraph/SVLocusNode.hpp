@@ -33,6 +33,7 @@
 
 #include "blt_util/thirdparty_pop.h"
 
+#include <algorithm>
 #include <iosfwd>
 #include <limits>
 #include <map>
@@ -105,40 +106,140 @@ BOOST_CLASS_IMPLEMENTATION(SVLocusEdge, boost::serialization::object_serializabl
 
 typedef unsigned NodeIndexType;
 
-/// TODO: get SVLocusNode to switch between real and fake maps transparently using some fancy iterator:
+typedef std::pair<NodeIndexType, SVLocusEdge> SVLocusEdgeValueType;
+
+/// \brief Read-only view of a sequence of node edges sorted by target node index
 ///
-#if 0
-class customConstEdgeIterator
-    : public boost::iterator_adaptor<
-      customConstEdgeIterator            // Derived
-    , Finite_vertices_iterator      // Base
-    , Vertex_handle                 // Value
-    , boost::forward_traversal_tag  // Traversal type
-    , Vertex_handle>                // Reference
-{
-private:
-    struct enabler {};
+/// This provides the subset of the std::map const interface used to query node edges.
+///
+struct SVLocusEdgesRange {
+  typedef NodeIndexType        key_type;
+  typedef SVLocusEdge          mapped_type;
+  typedef SVLocusEdgeValueType value_type;
+  typedef const value_type*    const_iterator;
+
+  SVLocusEdgesRange(const_iterator beginIter, const_iterator endIter) : _begin(beginIter), _end(endIter) {}
+
+  bool empty() const { return (_begin == _end); }
+
+  unsigned size() const { return (_end - _begin); }
+
+  const_iterator begin() const { return _begin; }
+  const_iterator end() const { return _end; }
+  const_iterator cbegin() const { return _begin; }
+  const_iterator cend() const { return _end; }
 
-public:
-    my_vertex_iterator()
-        : my_vertex_iterator::iterator_adaptor_(0) {}
+  /// Return the first edge with a target node index not less than \p index
+  const_iterator lower_bound(const NodeIndexType index) const
+  {
+    return std::lower_bound(_begin, _end, index, [](const value_type& val, const NodeIndexType key) {
+      return (val.first < key);
+    });
+  }
 
-    explicit my_vertex_iterator(const Finite_vertices_iterator p)
-        : my_vertex_iterator::iterator_adaptor_(p) {}
+  /// Return the edge with target node \p index, or end() if no such edge exists
+  const_iterator find(const NodeIndexType index) const
+  {
+    const const_iterator iter(lower_bound(index));
+    if ((iter == _end) || (iter->first != index)) return _end;
+    return iter;
+  }
 
 private:
-    friend class boost::iterator_core_access;
-    typename my_vertex_iterator::reference
-    dereference() const
-    {
-        return this->base();
+  const_iterator _begin;
+  const_iterator _end;
+};
+
+/// \brief Sorted vector map used to represent all edges for a node in the "normal" case
+///
+/// This provides the subset of the std::map interface used for node edges. Edges are stored contiguously in
+/// order of target node index, which takes much less memory than a tree-based map and is faster to search and
+/// iterate. Note that unlike std::map, inserting or erasing an edge invalidates all iterators.
+///
+/// The serialized format is identical to that of std::map<NodeIndexType, SVLocusEdge>, so that graph files
+/// are interchangeable with those written by the previous map-based edge container.
+///
+struct SVLocusEdgeFlatMap {
+  typedef NodeIndexType        key_type;
+  typedef SVLocusEdge          mapped_type;
+  typedef SVLocusEdgeValueType value_type;
+  typedef value_type*          iterator;
+  typedef const value_type*    const_iterator;
+
+  bool empty() const { return _edges.empty(); }
+
+  unsigned size() const { return _edges.size(); }
+
+  void clear() { _edges.clear(); }
+
+  iterator       begin() { return _edges.data(); }
+  iterator       end() { return (_edges.data() + _edges.size()); }
+  const_iterator begin() const { return _edges.data(); }
+  const_iterator end() const { return (_edges.data() + _edges.size()); }
+
+  SVLocusEdgesRange getRange() const { return SVLocusEdgesRange(begin(), end()); }
+
+  const_iterator lower_bound(const NodeIndexType index) const { return getRange().lower_bound(index); }
+
+  const_iterator find(const NodeIndexType index) const { return getRange().find(index); }
+
+  iterator find(const NodeIndexType index)
+  {
+    return (begin() + (getRange().find(index) - getRange().begin()));
+  }
+
+  /// Insert \p val if no edge with the same target node index exists
+  ///
+  /// \return A pair of the iterator to the edge with the target node index of \p val, and true if \p val was
+  /// inserted
+  std::pair<iterator, bool> insert(const value_type& val)
+  {
+    const unsigned offset(getRange().lower_bound(val.first) - getRange().begin());
+    if ((offset < _edges.size()) && (_edges[offset].first == val.first)) {
+      return std::make_pair(begin() + offset, false);
     }
+    _edges.insert(_edges.begin() + offset, val);
+    return std::make_pair(begin() + offset, true);
+  }
+
+  void erase(const const_iterator iter) { _edges.erase(_edges.begin() + (iter - getRange().begin())); }
+
+  /// \return The number of erased edges
+  unsigned erase(const NodeIndexType index)
+  {
+    const const_iterator iter(find(index));
+    if (iter == end()) return 0;
+    erase(iter);
+    return 1;
+  }
+
+  template <class Archive>
+  void save(Archive& ar, const unsigned /* version */) const
+  {
+    const std::map<NodeIndexType, SVLocusEdge> edgeMap(begin(), end());
+    ar << edgeMap;
+  }
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned /* version */)
+  {
+    std::map<NodeIndexType, SVLocusEdge> edgeMap;
+    ar >> edgeMap;
+    _edges.assign(edgeMap.begin(), edgeMap.end());
+  }
+
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+private:
+  std::vector<value_type> _edges;
 };
-#endif
+
+// Serialize without any class information so that the archive is identical to a std::map archive:
+BOOST_CLASS_IMPLEMENTATION(SVLocusEdgeFlatMap, boost::serialization::object_serializable)
 
 /// This map is used to represent all edges for a node in the "normal" case.
 ///
-typedef std::map<NodeIndexType, SVLocusEdge> SVLocusEdgesType;
+typedef SVLocusEdgeFlatMap SVLocusEdgesType;
 
 /// this object is used for an alternate compact representation of a node, when the node has only zero or one
 /// edges. It is an alternative to to SVLocusEdgesType. Because the majority of nodes have a zero or one edge
@@ -155,29 +256,37 @@ struct SVLocusEdgeSingle {
   bool          isZero;
 };
 
-/// The edge manager enables iterator over either of the two edge container formats (the "fat" map option or
-/// the compact SVLocusEdgeSingle option). The two edge formats need to be differentiated from a union.
+/// The edge manager enables iteration over either of the two edge container formats (the "fat" map option or
+/// the compact SVLocusEdgeSingle option), which need to be differentiated from a union.
+///
+/// A single edge is copied into the manager, so that no heap allocation is required in either case.
 ///
-/// TODO: hide the union behind an actual iterator class
 struct SVLocusEdgeManager {
-  SVLocusEdgeManager(const SVLocusEdgeSingle& edge) : mapPtr(&(staticMap))
+  explicit SVLocusEdgeManager(const SVLocusEdgeSingle& edge)
+    : _single(), _range(&_single, (&_single + (edge.isZero ? 0 : 1)))
   {
     if (!edge.isZero) {
-      sharedMapPtr.reset(new SVLocusEdgesType);
-      sharedMapPtr->insert(std::make_pair(edge.index, edge.edge));
-      mapPtr = sharedMapPtr.get();
+      _single = std::make_pair(edge.index, edge.edge);
     }
   }
 
-  SVLocusEdgeManager(const SVLocusEdgesType& edgeMap) : mapPtr(&edgeMap) {}
+  explicit SVLocusEdgeManager(const SVLocusEdgesType& edgeMap) : _single(), _range(edgeMap.getRange()) {}
+
+  SVLocusEdgeManager(const SVLocusEdgeManager& rhs)
+    : _single(rhs._single),
+      _range(rhs.isLocalRange() ? SVLocusEdgesRange(&_single, (&_single + rhs._range.size())) : rhs._range)
+  {
+  }
+
+  SVLocusEdgeManager& operator=(const SVLocusEdgeManager&) = delete;
 
-  const SVLocusEdgesType& getMap() const { return *mapPtr; }
+  const SVLocusEdgesRange& getMap() const { return _range; }
 
 private:
-  const SVLocusEdgesType*           mapPtr;
-  std::shared_ptr<SVLocusEdgesType> sharedMapPtr;
+  bool isLocalRange() const { return (_range.begin() == &_single); }
 
-  static const SVLocusEdgesType staticMap;
+  SVLocusEdgeValueType _single;
+  SVLocusEdgesRange    _range;
 };
 
 /// \brief stores all node region information plus all edges connecting to this node
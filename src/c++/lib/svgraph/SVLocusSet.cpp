@@ -25,6 +25,7 @@
 #include "blt_util/SizeDistribution.hpp"
 #include "blt_util/log.hpp"
 #include "common/Exceptions.hpp"
+#include "svgraph/SVLocusSetFlatFile.hpp"
 
 #include "blt_util/thirdparty_push.h"
 
@@ -37,6 +38,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 std::ostream& operator<<(std::ostream& os, const SVLocusSet::NodeAddressType& a)
@@ -122,8 +124,37 @@ void SVLocusSet::merge(const SVLocus& inputLocus)
   // place.
   //
   const LocusIndexType startLocusIndex(insertLocus(inputLocus));
-  const SVLocus&       startLocus(_loci[startLocusIndex]);
-  LocusIndexType       headLocusIndex(startLocusIndex);
+
+  // See the complexity test description in mergeStartLocus for details on the usability test criteria:
+  const bool isTestUsability(inputLocus.size() <= 2);
+  mergeStartLocus(startLocusIndex, isTestUsability);
+}
+
+void SVLocusSet::merge(const SVLocusEvidence& inputEvidence)
+{
+  assert(!_isFinalized);
+  assert(inputEvidence.nodeCount > 0);
+
+#ifdef DEBUG_SVL
+  checkState(true);
+#endif
+
+  // Add the evidence directly to the graph as a new locus, this is equivalent to creating an SVLocus from the
+  // evidence and inserting it in merge(const SVLocus&) above. All evidence records have at most 2 nodes, so
+  // the usability test always applies.
+  const LocusIndexType startLocusIndex(insertLocus(inputEvidence));
+  mergeStartLocus(startLocusIndex, true);
+}
+
+void SVLocusSet::mergeStartLocus(const LocusIndexType startLocusIndex, const bool isTestUsability)
+{
+#ifdef DEBUG_SVL
+  static const std::string logtag("SVLocusSet::mergeStartLocus");
+  log_os << logtag << " startLocus: " << getLocus(startLocusIndex);
+#endif
+
+  const SVLocus& startLocus(_loci[startLocusIndex]);
+  LocusIndexType headLocusIndex(startLocusIndex);
 
   // True if the startLocus has been copied from its original position at startLocusIndex into another locus
   // in the graph
@@ -135,14 +166,28 @@ void SVLocusSet::merge(const SVLocus& inputLocus)
   // Setup data structures for node intersection search (step 3) below.
   //
   // Search nodes must be ordered by begin position on each chromosome (this is an artifact of using a
-  // non-general interval overlap test).
-  typedef std::map<GenomeInterval, NodeIndexType> nodeMap_t;
-  nodeMap_t                                       startLocusNodeMap;
+  // non-general interval overlap test). Only the lowest index node is searched for any set of nodes with
+  // identical intervals.
+  //
+  // The node order is stored in a member buffer to avoid heap allocation on each merge.
+  typedef MergeNodeOrderType::value_type nodeMapValue_t;
+  MergeNodeOrderType&                    startLocusNodeMap(_mergeNodeOrder);
   {
+    startLocusNodeMap.clear();
     const NodeIndexType nodeCount(startLocus.size());
     for (NodeIndexType nodeIndex(0); nodeIndex < nodeCount; ++nodeIndex) {
-      startLocusNodeMap.insert(std::make_pair(startLocus.getNode(nodeIndex).getInterval(), nodeIndex));
+      startLocusNodeMap.emplace_back(startLocus.getNode(nodeIndex).getInterval(), nodeIndex);
     }
+    std::stable_sort(
+        startLocusNodeMap.begin(),
+        startLocusNodeMap.end(),
+        [](const nodeMapValue_t& a, const nodeMapValue_t& b) { return (a.first < b.first); });
+    startLocusNodeMap.erase(
+        std::unique(
+            startLocusNodeMap.begin(),
+            startLocusNodeMap.end(),
+            [](const nodeMapValue_t& a, const nodeMapValue_t& b) { return (a.first == b.first); }),
+        startLocusNodeMap.end());
   }
 
   // reuse this intersectingNodeAddresses object throughout the merge:
@@ -165,8 +210,7 @@ void SVLocusSet::merge(const SVLocus& inputLocus)
   // check continues to check and filter these simple cases while skipping filtration of more complex loci,
   // there is no risk of throwing out a good edge by transitive association with a complex node.
   //
-  const bool isTestUsability(inputLocus.size() <= 2);
-  for (const nodeMap_t::value_type& startLocusNodeVal : startLocusNodeMap) {
+  for (const nodeMapValue_t& startLocusNodeVal : startLocusNodeMap) {
     const bool isUsable(getIntersectingNodeAddresses(
         startLocusIndex, startLocusNodeVal.second, intersectingNodeAddresses, isTestUsability));
 
@@ -183,7 +227,7 @@ void SVLocusSet::merge(const SVLocus& inputLocus)
   // 4. Test each node in the startLocus for mergeable intersections to other nodes in this graph. If such
   // cases are found, merge these nodes.
   //
-  for (const nodeMap_t::value_type& startLocusNodeVal : startLocusNodeMap) {
+  for (const nodeMapValue_t& startLocusNodeVal : startLocusNodeMap) {
     if (isAbortMerge) break;
 
     const NodeIndexType startLocusNodeIndex(startLocusNodeVal.second);
@@ -349,8 +393,8 @@ void SVLocusSet::merge(const SVLocusSet& inputSet)
 }
 
 bool SVLocusSet::getIntersectingNodeAddressesCore(
-    const LocusIndexType       queryLocusIndex,
-    const NodeIndexType        queryNodeIndex,
+    const GenomeInterval&      queryInterval,
+    const NodeAddressType&     queryNodeAddress,
     const LocusSetIndexerType& searchNodes,
     const LocusIndexType       filterLocusIndex,
     std::set<NodeAddressType>& intersectingNodeAddresses,
@@ -358,8 +402,8 @@ bool SVLocusSet::getIntersectingNodeAddressesCore(
 {
 #ifdef DEBUG_SVL
   static const std::string logtag("SVLocusSet::getNodeIntersectCore");
-  log_os << logtag << " inputNode: " << queryLocusIndex << ":" << queryNodeIndex << " "
-         << getNode(std::make_pair(queryLocusIndex, queryNodeIndex));
+  log_os << logtag << " queryInterval: " << queryInterval << " queryNodeAddress: " << queryNodeAddress
+         << "\n";
   checkState();
 #endif
 
@@ -367,18 +411,16 @@ bool SVLocusSet::getIntersectingNodeAddressesCore(
 
   intersectingNodeAddresses.clear();
 
-  // Get all nodes in searchNodes which intersect with the query node:
-  const NodeAddressType queryNodeAddress(std::make_pair(queryLocusIndex, queryNodeIndex));
-  const auto            searchNodeIterStart(searchNodes.data().lower_bound(queryNodeAddress));
-  const GenomeInterval& queryInterval(getNode(queryNodeAddress).getInterval());
-  const pos_t           maxRegionSize(_maxRegionSize[queryInterval.tid]);
+  // Get all nodes in searchNodes which intersect with the query interval:
+  const auto  searchNodeIterStart(searchNodes.lower_bound(std::make_pair(queryInterval, queryNodeAddress)));
+  const pos_t maxRegionSize(getMaxRegionSize(queryInterval.tid));
 
   // diagnostics to determine if graph is growing too dense in one region:
   bool     isUsable(true);
   unsigned searchCount(0);
 
   // Look for all intersecting nodes with begin position >= queryInterval's begin position
-  const auto searchNodeIterEnd(searchNodes.data().end());
+  const auto searchNodeIterEnd(searchNodes.end());
   for (auto searchNodeIter(searchNodeIterStart); searchNodeIter != searchNodeIterEnd; ++searchNodeIter) {
     if (isTestUsability) {
       searchCount++;
@@ -389,23 +431,23 @@ bool SVLocusSet::getIntersectingNodeAddressesCore(
       }
     }
 
-    const auto searchNodeLocusIndex(searchNodeIter->first);
-    if (searchNodeLocusIndex == filterLocusIndex) continue;
+    const NodeAddressType& searchNodeAddress(searchNodeIter->second);
+    if (searchNodeAddress.first == filterLocusIndex) continue;
 
 #ifdef DEBUG_SVL
-    log_os << logtag << "\tFWD test: " << (*searchNodeIter) << " " << getNode(*searchNodeIter);
+    log_os << logtag << "\tFWD test: " << searchNodeAddress << " " << getNode(searchNodeAddress);
 #endif
 
-    if (!queryInterval.isIntersect(getNode(*searchNodeIter).getInterval())) break;
-    intersectingNodeAddresses.insert(*searchNodeIter);
+    if (!queryInterval.isIntersect(searchNodeIter->first)) break;
+    intersectingNodeAddresses.insert(searchNodeAddress);
 
 #ifdef DEBUG_SVL
-    log_os << logtag << "\tFWD insert: " << (*searchNodeIter) << "\n";
+    log_os << logtag << "\tFWD insert: " << searchNodeAddress << "\n";
 #endif
   }
 
   // Look for all intersecting nodes with begin position < queryInterval's begin position
-  const auto searchNodeIterBegin(searchNodes.data().begin());
+  const auto searchNodeIterBegin(searchNodes.begin());
   for (auto searchNodeIter(searchNodeIterStart); searchNodeIter != searchNodeIterBegin;) {
     --searchNodeIter;
 
@@ -419,11 +461,12 @@ bool SVLocusSet::getIntersectingNodeAddressesCore(
       }
     }
 
-    if (searchNodeIter->first == filterLocusIndex) continue;
+    const NodeAddressType& searchNodeAddress(searchNodeIter->second);
+    if (searchNodeAddress.first == filterLocusIndex) continue;
 #ifdef DEBUG_SVL
-    log_os << logtag << "\tREV test: " << (*searchNodeIter) << " " << getNode(*searchNodeIter);
+    log_os << logtag << "\tREV test: " << searchNodeAddress << " " << getNode(searchNodeAddress);
 #endif
-    const GenomeInterval& searchInterval(getNode(*searchNodeIter).getInterval());
+    const GenomeInterval& searchInterval(searchNodeIter->first);
     if (!queryInterval.isIntersect(searchInterval)) {
       if (!isOverlapAllowed()) break;
 
@@ -432,9 +475,9 @@ bool SVLocusSet::getIntersectingNodeAddressesCore(
       continue;
     }
 
-    intersectingNodeAddresses.insert(*searchNodeIter);
+    intersectingNodeAddresses.insert(searchNodeAddress);
 #ifdef DEBUG_SVL
-    log_os << logtag << "\tREV insert: " << (*searchNodeIter) << "\n";
+    log_os << logtag << "\tREV insert: " << searchNodeAddress << "\n";
 #endif
   }
 
@@ -479,8 +522,13 @@ void SVLocusSet::getIntersectingEdges(
   // intersected in the query locus are filtered out
   //
   std::set<NodeAddressType> edgeIntersectRemoteTemp;
+  const NodeAddressType     queryRemoteNodeAddress(queryLocusIndex, queryRemoteNodeIndex);
   getIntersectingNodeAddressesCore(
-      queryLocusIndex, queryRemoteNodeIndex, remoteIntersectNodes, queryLocusIndex, edgeIntersectRemoteTemp);
+      getNode(queryRemoteNodeAddress).getInterval(),
+      queryRemoteNodeAddress,
+      remoteIntersectNodes,
+      queryLocusIndex,
+      edgeIntersectRemoteTemp);
 
   for (const NodeAddressType& remoteIsectAddy : edgeIntersectRemoteTemp) {
     // find what local nodes the remote nodes trace back to:
@@ -507,8 +555,8 @@ void SVLocusSet::getIntersectingSignalNodeAddresses(
   // Get all nodes which intersect the node at targetNodeAddress.
   std::set<NodeAddressType> intersectingNodeAddresses;
   getIntersectingNodeAddressesCore(
-      targetNodeAddress.first,
-      targetNodeAddress.second,
+      getNode(targetNodeAddress).getInterval(),
+      targetNodeAddress,
       _inodes,
       filterLocusIndex,
       intersectingNodeAddresses);
@@ -644,7 +692,7 @@ void SVLocusSet::getMergeableIntersectingNodeAddresses(
       for (const SVLocusEdgesType::value_type& intersectingNodeEdge : intersectingNodeEdgeMap.getMap()) {
         NodeAddressType connectingNodeAddress(
             std::make_pair(intersectingNodeAddress.first, intersectingNodeEdge.first));
-        searchableIntersectingNodeConnections.data().insert(connectingNodeAddress);
+        searchableIntersectingNodeConnections.insert(connectingNodeAddress);
         connectedNodeToIntersectingNodeMap.insert(
             std::make_pair(connectingNodeAddress, intersectingNodeAddress.second));
       }
@@ -956,14 +1004,16 @@ void SVLocusSet::getMergeableIntersectingNodeAddresses(
 #endif
 }
 
-void SVLocusSet::getRegionIntersect(const GenomeInterval interval, std::set<NodeAddressType>& intersectNodes)
+void SVLocusSet::getRegionIntersect(
+    const GenomeInterval interval, std::set<NodeAddressType>& intersectNodes) const
 {
-  const LocusIndexType startLocusIndex(insertLocus(SVLocus()));
-  const NodeIndexType  nodeIndex(getLocus(startLocusIndex).addNode(interval, this));
+  // No locus is filtered from the search results:
+  static const LocusIndexType noFilterLocusIndex(std::numeric_limits<LocusIndexType>::max());
 
-  getIntersectingNodeAddresses(startLocusIndex, nodeIndex, intersectNodes);
+  // Start the search before any node with the same interval as the query:
+  const NodeAddressType queryNodeAddress(0, 0);
 
-  clearLocus(startLocusIndex);
+  getIntersectingNodeAddressesCore(interval, queryNodeAddress, _inodes, noFilterLocusIndex, intersectNodes);
 }
 
 void SVLocusSet::moveIntersectingNodesToLowestLocusIndex(
@@ -1022,6 +1072,20 @@ void SVLocusSet::combineLoci(
 }
 
 LocusIndexType SVLocusSet::insertLocus(const SVLocus& inputLocus)
+{
+  const LocusIndexType locusIndex(insertEmptyLocus());
+  _loci[locusIndex].copyLocus(inputLocus, this);
+  return locusIndex;
+}
+
+LocusIndexType SVLocusSet::insertLocus(const SVLocusEvidence& inputEvidence)
+{
+  const LocusIndexType locusIndex(insertEmptyLocus());
+  _loci[locusIndex].addEvidence(inputEvidence, this);
+  return locusIndex;
+}
+
+LocusIndexType SVLocusSet::insertEmptyLocus()
 {
   assert(_isIndexed);
 
@@ -1045,9 +1109,7 @@ LocusIndexType SVLocusSet::insertLocus(const SVLocus& inputLocus)
     _emptyLoci.erase(locusIndex);
   }
 
-  SVLocus& locus(_loci[locusIndex]);
-  locus.updateIndex(locusIndex);
-  locus.copyLocus(inputLocus, this);
+  _loci[locusIndex].updateIndex(locusIndex);
   return locusIndex;
 }
 
@@ -1060,8 +1122,7 @@ void SVLocusSet::mergeNodePtr(NodeAddressType fromPtr, NodeAddressType toPtr)
 #endif
   assert(_isIndexed);
 
-  LocusSetIndexerType::iterator iter(_inodes.data().find(toPtr));
-  assert(iter != _inodes.data().end());
+  assert(_inodes.isMember(toPtr));
   assert(fromPtr.first == toPtr.first);
   getLocus(fromPtr.first).mergeNode(fromPtr.second, toPtr.second, this);
 }
@@ -1087,6 +1148,11 @@ void SVLocusSet::cleanRegion(const GenomeInterval interval)
   log_os << logtag << " interval: " << interval << "\n";
 #endif
 
+  // The maximum node size bounding all graph searches is expanded to include each cleaned region. This bound
+  // feeds into the search count/density limits applied during merging, so it is part of the graph
+  // construction method:
+  updateMaxRegionSize(interval);
+
   std::set<NodeAddressType> intersectNodes;
   getRegionIntersect(interval, intersectNodes);
 
@@ -1118,19 +1184,19 @@ void SVLocusSet::dump(std::ostream& os) const
   os << "LOCUSSET_END\n";
 }
 
-void SVLocusSet::dumpRegion(std::ostream& os, const GenomeInterval interval)
+void SVLocusSet::dumpRegion(std::ostream& os, const GenomeInterval interval) const
 {
   std::set<NodeAddressType> intersectNodes;
   getRegionIntersect(interval, intersectNodes);
 
   LocusSetIndexerType sortedNodes(*this);
   for (const NodeAddressType& val : intersectNodes) {
-    sortedNodes.data().insert(val);
+    sortedNodes.insert(val);
   }
 
-  for (const NodeAddressType& val : sortedNodes.data()) {
-    os << "SVNode LocusIndex:NodeIndex : " << val << "\n";
-    os << getNode(val);
+  for (const auto& val : sortedNodes) {
+    os << "SVNode LocusIndex:NodeIndex : " << val.second << "\n";
+    os << getNode(val.second);
   }
 }
 
@@ -1254,6 +1320,38 @@ void SVLocusSet::dumpLocusStats(std::ostream& os) const
   }
 }
 
+template <class Archive>
+void SVLocusSet::saveHeader(Archive& ar) const
+{
+  ar << getBamHeader();
+  ar << _opt;
+  ar << _isFinalized;
+  ar << _totalCleaned;
+  ar << _counts;
+  ar << _highestSearchCount;
+  ar << _highestSearchDensity;
+  ar << _isMaxSearchCount;
+  ar << _isMaxSearchDensity;
+  ar << _buildTime;
+  ar << _mergeTime;
+}
+
+template <class Archive>
+void SVLocusSet::loadHeader(Archive& ar)
+{
+  ar >> _bamHeaderInfo;
+  ar >> _opt;
+  ar >> _isFinalized;
+  ar >> _totalCleaned;
+  ar >> _counts;
+  ar >> _highestSearchCount;
+  ar >> _highestSearchDensity;
+  ar >> _isMaxSearchCount;
+  ar >> _isMaxSearchDensity;
+  ar >> _buildTime;
+  ar >> _mergeTime;
+}
+
 void SVLocusSet::save(const char* filename) const
 {
   using namespace boost::archive;
@@ -1262,17 +1360,7 @@ void SVLocusSet::save(const char* filename) const
   std::ofstream   ofs(filename, std::ios::binary);
   binary_oarchive oa(ofs);
 
-  oa << getBamHeader();
-  oa << _opt;
-  oa << _isFinalized;
-  oa << _totalCleaned;
-  oa << _counts;
-  oa << _highestSearchCount;
-  oa << _highestSearchDensity;
-  oa << _isMaxSearchCount;
-  oa << _isMaxSearchDensity;
-  oa << _buildTime;
-  oa << _mergeTime;
+  saveHeader(oa);
 
   for (const SVLocus& locus : _loci) {
     if (locus.empty()) continue;
@@ -1280,6 +1368,56 @@ void SVLocusSet::save(const char* filename) const
   }
 }
 
+void SVLocusSet::saveFlat(const char* filename) const
+{
+  using namespace boost::archive;
+
+  assert(nullptr != filename);
+
+  std::ostringstream metadata;
+  {
+    binary_oarchive oa(metadata);
+    saveHeader(oa);
+  }
+
+  writeSVLocusSetFlatFile(filename, metadata.str(), _loci);
+}
+
+void SVLocusSet::loadFlat(const char* filename)
+{
+  using namespace boost::archive;
+
+  const SVLocusSetFlatView view(filename);
+
+  {
+    std::istringstream metadata(std::string(view.getMetadata(), view.getMetadataSize()));
+    binary_iarchive    ia(metadata);
+    loadHeader(ia);
+  }
+
+  _loci.resize(view.locusCount());
+  for (uint64_t locusIndex(0); locusIndex < view.locusCount(); ++locusIndex) {
+    SVLocus& locus(_loci[locusIndex]);
+    locus.updateIndex(locusIndex);
+
+    const unsigned nodeCount(view.nodeCount(locusIndex));
+    locus._graph.resize(nodeCount);
+    for (unsigned nodeIndex(0); nodeIndex < nodeCount; ++nodeIndex) {
+      const SVLocusSetFlatNode& flatNode(view.getNode(locusIndex, nodeIndex));
+      SVLocusNode&              node(locus._graph[nodeIndex]);
+      node.setInterval(GenomeInterval(flatNode.tid, flatNode.beginPos, flatNode.endPos));
+      node.setEvidenceRange(known_pos_range2(flatNode.evidenceBeginPos, flatNode.evidenceEndPos));
+      for (const SVLocusSetFlatEdge* flatEdgeIter(view.edgesBegin(flatNode));
+           flatEdgeIter != view.edgesEnd(flatNode);
+           ++flatEdgeIter) {
+        SVLocusEdge edge;
+        edge.setCount(flatEdgeIter->count);
+        node.mergeEdge(flatEdgeIter->nodeIndex, edge);
+      }
+    }
+  }
+}
+
 SVLocusSet::SVLocusSet(const char* filename, const bool isSkipIndex)
   : SVLocusSet(SVLocusSetOptions(), bam_header_info(), {})
 {
@@ -1292,32 +1430,27 @@ SVLocusSet::SVLocusSet(const char* filename, const bool isSkipIndex)
   assert(filename);
 
   try {
-    std::ifstream   ifs(filename, std::ios::binary);
-    binary_iarchive ia(ifs);
-
     _source = filename;
 
-    ia >> _bamHeaderInfo;
-    ia >> _opt;
-    ia >> _isFinalized;
-    ia >> _totalCleaned;
-    ia >> _counts;
-    ia >> _highestSearchCount;
-    ia >> _highestSearchDensity;
-    ia >> _isMaxSearchCount;
-    ia >> _isMaxSearchDensity;
-    ia >> _buildTime;
-    ia >> _mergeTime;
-
-    SVLocus locus;
-    while (ifs.peek() != EOF) {
-      locus.clear(this);
-      ia >> locus;
-      if (locus.empty()) continue;
-      const LocusIndexType locusIndex(size());
-      _loci.push_back(locus);
-      SVLocus& locusCopy(_loci.back());
-      locusCopy.updateIndex(locusIndex);
+    if (SVLocusSetFlatView::isFlatFile(filename)) {
+      loadFlat(filename);
+    } else {
+      std::ifstream   ifs(filename, std::ios::binary);
+      binary_iarchive ia(ifs);
+
+      loadHeader(ia);
+
+      SVLocus locus;
+      while (ifs.peek() != EOF) {
+        // The scratch locus is not part of this graph, so the node index is not notified when it is cleared:
+        locus.clear(nullptr);
+        ia >> locus;
+        if (locus.empty()) continue;
+        const LocusIndexType locusIndex(size());
+        _loci.push_back(locus);
+        SVLocus& locusCopy(_loci.back());
+        locusCopy.updateIndex(locusIndex);
+      }
     }
   } catch (...) {
     log_os << "ERROR: Exception caught while attempting to deserialize Manta SV locus graph file:\n"
@@ -1354,7 +1487,7 @@ void SVLocusSet::reconstructIndex()
     const unsigned nodeCount(locus.size());
     for (NodeIndexType nodeIndex(0); nodeIndex < nodeCount; ++nodeIndex) {
       const NodeAddressType addy(std::make_pair(locusIndex, nodeIndex));
-      _inodes.data().insert(addy);
+      _inodes.insert(addy);
       updateMaxRegionSize(getNode(addy).getInterval());
     }
     if (locus.empty()) _emptyLoci.insert(locusIndex);
@@ -1374,8 +1507,8 @@ void SVLocusSet::dumpIndex(std::ostream& os) const
   assert(_isIndexed);
 
   os << "SVLocusSet Index START\n";
-  for (const NodeAddressType& in : _inodes.data()) {
-    os << "SVNodeIndex: " << in << "\n";
+  for (const auto& in : _inodes) {
+    os << "SVNodeIndex: " << in.second << " interval: " << in.first << "\n";
   }
   os << "SVLocusSet Index END\n";
 }
@@ -1404,30 +1537,22 @@ void SVLocusSet::checkState(const bool isCheckOverlap, const bool isCheckLocusCo
     }
 
     for (NodeIndexType nodeIndex(0); nodeIndex < nodeCount; ++nodeIndex) {
-      LocusSetIndexerType::const_iterator citer(_inodes.data().find(std::make_pair(locusIndex, nodeIndex)));
-      if (citer == _inodes.data().end()) {
-        std::ostringstream oss;
-        oss << "Locus node is missing from node index\n"
-            << "\tNode index: " << locusIndex << " node: " << getNode(std::make_pair(locusIndex, nodeIndex));
-        BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
-      }
-      if ((citer->first != locusIndex) || (citer->second != nodeIndex)) {
+      const NodeAddressType nodeAddress(locusIndex, nodeIndex);
+      if (!_inodes.isMember(nodeAddress)) {
         std::ostringstream oss;
-        oss << "Locus node has conflicting index number in node index\n"
-            << "\tinode index_value: " << citer->first << ":" << citer->second << "\n"
-            << "\tNode index: " << locusIndex << ":" << locusIndex
-            << " node: " << getNode(std::make_pair(locusIndex, nodeIndex));
+        oss << "Locus node is missing from node index, or is indexed with a conflicting interval\n"
+            << "\tNode index: " << nodeAddress << " node: " << getNode(nodeAddress);
         BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
       }
     }
     locusIndex++;
   }
 
-  if (checkStateTotalNodeCount != _inodes.data().size()) {
+  if (checkStateTotalNodeCount != _inodes.size()) {
     using namespace illumina::common;
     std::ostringstream oss;
     oss << "SVLocusSet conflicting internal node counts. TotalNodeCount: " << checkStateTotalNodeCount
-        << " inodeSize: " << _inodes.data().size();
+        << " inodeSize: " << _inodes.size();
     BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
   }
 
@@ -1492,7 +1617,8 @@ void SVLocusSet::checkForOverlapNodes(const bool isFilterNoise) const
   bool            isFirst(true);
   GenomeInterval  lastInterval;
   NodeAddressType lastAddy;
-  for (const NodeAddressType& addy : _inodes.data()) {
+  for (const auto& indexedNode : _inodes) {
+    const NodeAddressType& addy(indexedNode.second);
     if (isFilterNoise) {
       if (isNoiseNode(addy)) continue;
     }
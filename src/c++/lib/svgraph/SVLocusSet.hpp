@@ -99,6 +99,9 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>, private b
       const std::vector<std::string>& alignmentFilenames = {});
 
   /// \brief Deserialize object from binary file format
+  ///
+  /// Both the serialized format written by save() and the flat format written by saveFlat() are accepted.
+  ///
   /// \param[in] isSkipIndex If true, don't build the graph index, and only allow a limited set of operations
   ///
   explicit SVLocusSet(const char* filename, const bool isSkipIndex = false);
@@ -137,6 +140,12 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>, private b
   /// The referenced SVLocus is destroyed in this process.
   void merge(const SVLocus& locus);
 
+  /// \brief Merge the graph elements described by a single evidence record into the SVLocusSet.
+  ///
+  /// This is equivalent to merging the SVLocus built from \p evidence, but the evidence is inserted directly
+  /// into the graph without creating a temporary SVLocus.
+  void merge(const SVLocusEvidence& evidence);
+
   /// \brief Merge referenced SVLocusSet into the calling SVLocusSet.
   ///
   /// The referenced SVLocusSet is destroyed in this process.
@@ -162,14 +171,17 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>, private b
   /// Binary serialization
   void save(const char* filename) const;
 
+  /// \brief Binary serialization to the flat file format
+  ///
+  /// The flat format is described in SVLocusSetFlatFile.hpp. It can be loaded much faster than the format
+  /// written by save(), because locus graph components do not need to be deserialized individually.
+  void saveFlat(const char* filename) const;
+
   /// Debug output.
   void dump(std::ostream& os) const;
 
   /// \brief Debug output for a specific region.
-  ///
-  /// Note this is conceptually const but can't be marked const to the compiler right now due to
-  /// implementation details (see getRegionIntersect).
-  void dumpRegion(std::ostream& os, const GenomeInterval interval);
+  void dumpRegion(std::ostream& os, const GenomeInterval interval) const;
 
   /// Debug stats output on the whole SVLocus set.
   void dumpStats(std::ostream& os) const;
@@ -267,10 +279,7 @@ struct SVLocusSet : public flyweight_observer<SVLocusNodeMoveMessage>, private b
   ///
   /// \param[in] interval Target genome region for node intersection search
   /// \param[out] intersectNodes Intersecting nodes are put in this object. This object is cleared on input.
-  ///
-  /// This method is conceptually const. For programming convenience it temporarily changes the graph
-  /// structure (then undoes the change), so it can't be marked const to the compiler.
-  void getRegionIntersect(const GenomeInterval interval, std::set<NodeAddressType>& intersectNodes);
+  void getRegionIntersect(const GenomeInterval interval, std::set<NodeAddressType>& intersectNodes) const;
 
   /// |brief Provide const access the bam header info which this object stores
   const bam_header_info& getBamHeader() const { return _bamHeaderInfo; }
@@ -283,60 +292,52 @@ private:
 
   typedef std::pair<EdgeMapKeyType, EdgeMapValueType> EdgeInfoType;
 
-  /// \brief  NodeAddressSorter wraps a SVLocusSet in order to add support for
-  /// testing if 2 NodeAddressTypes are sorted a < b.
-  struct NodeAddressSorter {
-    NodeAddressSorter(const SVLocusSet& set) : _set(set) {}
-
-    bool operator()(const NodeAddressType& a, const NodeAddressType& b) const
-    {
-      if (getInterval(a) < getInterval(b)) return true;
-      if (getInterval(a) == getInterval(b)) {
-        // If the GenomeIntervals are the same, compare the contents of the NodeAddressTypes directly.
-        return (a < b);
-      }
-      return false;
-    }
-
-  private:
-    const GenomeInterval& getInterval(const NodeAddressType& n) const
-    {
-      return (_set.getLocus(n.first).getNode(n.second).getInterval());
-    }
-
-    const SVLocusSet& _set;
-  };
-
   /// \brief Container to hold a set of node addresses which support range-based node intersect queries.
   ///
-  /// This object holds a set of node addresses with a sorting scheme designed to support
-  /// range-based intersection queries.
+  /// Node addresses are sorted by node interval, using the address itself to break ties. Each address is
+  /// stored together with its node interval, so that sorting and searching the index never requires a node
+  /// lookup in the graph, and the index can be searched for intervals which are not in the graph.
   ///
-  /// The core data type here, data_t, is wrapped by this object because this object requires a custom
-  /// copy-ctor/assign-op, whereas data_t can use defaults.
+  /// The stored intervals are kept current by the SVLocusNodeMoveMessage notifications, which always remove
+  /// a node from the index before its interval is changed, and add it back after the change.
   struct LocusSetIndexerType {
-    typedef std::set<NodeAddressType, NodeAddressSorter> data_t;
-    typedef data_t::iterator                             iterator;
-    typedef data_t::const_iterator                       const_iterator;
+    typedef std::pair<GenomeInterval, NodeAddressType> value_type;
+    typedef std::set<value_type>                       data_t;
+    typedef data_t::const_iterator                     const_iterator;
 
-    LocusSetIndexerType(const SVLocusSet& set) : _data(NodeAddressSorter(set)) {}
+    explicit LocusSetIndexerType(const SVLocusSet& set) : _set(set) {}
 
     LocusSetIndexerType(const LocusSetIndexerType& rhs) = delete;
+    LocusSetIndexerType& operator=(const LocusSetIndexerType& rhs) = delete;
+
+    void insert(const NodeAddressType& nodeAddress) { _data.insert(getValue(nodeAddress)); }
+
+    void erase(const NodeAddressType& nodeAddress) { _data.erase(getValue(nodeAddress)); }
 
-    LocusSetIndexerType& operator=(const LocusSetIndexerType& rhs)
+    /// True if the node address is in the index with the node's current interval
+    bool isMember(const NodeAddressType& nodeAddress) const
     {
-      if (this == &rhs) return *this;
-      _data.clear();
-      _data.insert(rhs._data.begin(), rhs._data.end());
-      return *this;
+      return (_data.count(getValue(nodeAddress)) != 0);
     }
 
-    data_t& data() { return _data; }
+    void clear() { _data.clear(); }
+
+    unsigned size() const { return _data.size(); }
+
+    const_iterator begin() const { return _data.begin(); }
+
+    const_iterator end() const { return _data.end(); }
 
-    const data_t& data() const { return _data; }
+    const_iterator lower_bound(const value_type& value) const { return _data.lower_bound(value); }
 
   private:
-    data_t _data;
+    value_type getValue(const NodeAddressType& nodeAddress) const
+    {
+      return std::make_pair(_set.getNode(nodeAddress).getInterval(), nodeAddress);
+    }
+
+    const SVLocusSet& _set;
+    data_t            _data;
   };
 
   friend std::ostream& operator<<(std::ostream& os, const NodeAddressType& a);
@@ -369,12 +370,13 @@ private:
     _source = "UNKNOWN";
   }
 
-  /// \brief Get addresses of all nodes in the graph which intersect with the query node. (A more general
+  /// \brief Get addresses of all nodes in the graph which intersect with the query interval. (A more general
   /// version of getNodeIntersect)
   ///
-  /// \param[in] queryLocusIndex First part of query node address.
+  /// \param[in] queryInterval Query interval, this does not need to correspond to a node in the graph.
   ///
-  /// \param[in] queryNodeIndex Second part of query node address.
+  /// \param[in] queryNodeAddress Address used to position the query among nodes with the same interval in
+  /// \p searchNodes. This affects only the search count used for usability tests.
   ///
   /// \param[in] searchNodes The set of nodes which will be searched for intersections with the query node.
   ///
@@ -387,8 +389,8 @@ private:
   ///
   /// \return True if the query node is usable. This can only be false when isTestUsability is true.
   bool getIntersectingNodeAddressesCore(
-      const LocusIndexType       queryLocusIndex,
-      const NodeIndexType        queryNodeIndex,
+      const GenomeInterval&      queryInterval,
+      const NodeAddressType&     queryNodeAddress,
       const LocusSetIndexerType& searchNodes,
       const LocusIndexType       filterLocusIndex,
       std::set<NodeAddressType>& intersectingNodeAddresses,
@@ -412,9 +414,10 @@ private:
       std::set<NodeAddressType>& intersectingNodeAddresses,
       const bool                 isTestUsability = false) const
   {
+    const NodeAddressType queryNodeAddress(queryLocusIndex, queryNodeIndex);
     return getIntersectingNodeAddressesCore(
-        queryLocusIndex,
-        queryNodeIndex,
+        getNode(queryNodeAddress).getInterval(),
+        queryNodeAddress,
         _inodes,
         queryLocusIndex,
         intersectingNodeAddresses,
@@ -486,13 +489,31 @@ private:
   /// \return The locus index assigned to the copy of inputLocus inserted into this object
   LocusIndexType insertLocus(const SVLocus& inputLocus);
 
+  /// \brief Add the graph elements described by \p inputEvidence to this SVLocusSet as a new locus
+  ///
+  /// This is the SVLocusEvidence equivalent of insertLocus(const SVLocus&).
+  ///
+  /// \return The locus index assigned to the new locus
+  LocusIndexType insertLocus(const SVLocusEvidence& inputEvidence);
+
+  /// \brief Add a new empty locus to this SVLocusSet, reusing the lowest empty locus index if available
+  ///
+  /// \return The locus index assigned to the new locus
+  LocusIndexType insertEmptyLocus();
+
+  /// \brief Merge the locus at \p startLocusIndex, which has just been inserted into the graph, with any
+  /// intersecting nodes from other loci in the graph
+  ///
+  /// \param[in] isTestUsability If true, abort the merge when the start locus nodes intersect a region of
+  /// the graph exceeding the complexity limits
+  void mergeStartLocus(const LocusIndexType startLocusIndex, const bool isTestUsability);
+
   /// \brief Erase the node at \p nodeAddress by calling SVLocus::eraseNode() on the appropriate locus.
   void eraseNode(const NodeAddressType nodeAddress)
   {
     assert(_isIndexed);
 
-    LocusSetIndexerType::iterator iter(_inodes.data().find(nodeAddress));
-    if (iter == _inodes.data().end()) return;
+    if (!_inodes.isMember(nodeAddress)) return;
 
     SVLocus& locus(getLocus(nodeAddress.first));
     locus.eraseNode(nodeAddress.second, this);
@@ -528,17 +549,25 @@ private:
 #ifdef DEBUG_SVL
       log_os << "SVLocusSetObserver: Adding node: " << msg.second.first << ":" << msg.second.second << "\n";
 #endif
-      _inodes.data().insert(msg.second);
+      _inodes.insert(msg.second);
       updateMaxRegionSize(getNode(msg.second).getInterval());
     } else {
       // delete
 #ifdef DEBUG_SVL
       log_os << "SVLocusSetObserver: Deleting node: " << msg.second.first << ":" << msg.second.second << "\n";
 #endif
-      _inodes.data().erase(msg.second);
+      _inodes.erase(msg.second);
     }
   }
 
+  /// Get the maximum size of any node interval on chromosome \p tid
+  pos_t getMaxRegionSize(const int32_t tid) const
+  {
+    assert(tid >= 0);
+    if (static_cast<unsigned>(tid) >= _maxRegionSize.size()) return 0;
+    return _maxRegionSize[tid];
+  }
+
   void updateMaxRegionSize(const GenomeInterval& interval)
   {
     assert(interval.tid >= 0);
@@ -551,10 +580,20 @@ private:
 
   void reconstructIndex();
 
+  /// Write/read all graph-level information other than the loci themselves
+  template <class Archive>
+  void saveHeader(Archive& ar) const;
+
+  template <class Archive>
+  void loadHeader(Archive& ar);
+
+  /// Load all loci from a flat format file
+  void loadFlat(const char* filename);
+
   void clearIndex()
   {
     _emptyLoci.clear();
-    _inodes.data().clear();
+    _inodes.clear();
     _maxRegionSize.clear();
   }
 
@@ -672,6 +711,12 @@ private:
   ///
   /// The RegionCheck process searches for peak SV evidence density among a set of overlapping nodes.
   mutable MergeRegionSumData _mergeRegions;
+
+  /// \brief A temporary data structure used by the merge process.
+  ///
+  /// Holds the nodes of the start locus ordered by genome interval.
+  typedef std::vector<std::pair<GenomeInterval, NodeIndexType>> MergeNodeOrderType;
+  MergeNodeOrderType                                            _mergeNodeOrder;
 };
 
 std::ostream& operator<<(std::ostream& os, const SVLocusSet::NodeAddressType& a);
@@ -0,0 +1,274 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "svgraph/SVLocusSetFlatFile.hpp"
+
+#include "common/Exceptions.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char     flatFileMagic[8] = {'M', 'S', 'V', 'L', 'F', 'L', 'A', 'T'};
+static const uint32_t flatFileVersion  = 1;
+
+static_assert(sizeof(SVLocusSetFlatHeader) == 80, "Unexpected flat graph file header size");
+static_assert(sizeof(SVLocusSetFlatNode) == 32, "Unexpected flat graph file node size");
+static_assert(sizeof(SVLocusSetFlatEdge) == 8, "Unexpected flat graph file edge size");
+
+/// Round offset up to the next 8-byte section boundary
+static uint64_t getSectionOffset(const uint64_t offset)
+{
+  return ((offset + 7) & ~static_cast<uint64_t>(7));
+}
+
+static void flatFileError(const char* filename, const char* message)
+{
+  using namespace illumina::common;
+
+  std::ostringstream oss;
+  oss << "Invalid Manta flat SV locus graph file '" << filename << "': " << message;
+  BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+}
+
+SVLocusSetFlatView::SVLocusSetFlatView(const char* filename)
+{
+  using namespace illumina::common;
+
+  assert(nullptr != filename);
+
+#ifndef _WIN32
+  const int fd(open(filename, O_RDONLY));
+  if (fd < 0) {
+    std::ostringstream oss;
+    oss << "Can't open SV locus graph file '" << filename << "': " << std::strerror(errno);
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
+    flatFileError(filename, "can't stat file");
+  }
+  _size = fileStat.st_size;
+
+  if (_size < sizeof(SVLocusSetFlatHeader)) {
+    close(fd);
+    flatFileError(filename, "file is too small");
+  }
+
+  void* mapPtr(mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0));
+  close(fd);
+  if (mapPtr == MAP_FAILED) {
+    std::ostringstream oss;
+    oss << "Can't map SV locus graph file '" << filename << "': " << std::strerror(errno);
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+  _data = static_cast<const char*>(mapPtr);
+#else
+  std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+  if (!ifs) {
+    std::ostringstream oss;
+    oss << "Can't open SV locus graph file '" << filename << "'";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+  _size = ifs.tellg();
+  if (_size < sizeof(SVLocusSetFlatHeader)) flatFileError(filename, "file is too small");
+
+  // Use a 64-bit element buffer to guarantee the alignment of all file sections:
+  _buffer.resize(_size + 8);
+  char* bufferPtr(_buffer.data() + ((8 - (reinterpret_cast<uintptr_t>(_buffer.data()) % 8)) % 8));
+  ifs.seekg(0);
+  ifs.read(bufferPtr, _size);
+  _data = bufferPtr;
+#endif
+
+  try {
+    validate(filename);
+  } catch (...) {
+#ifndef _WIN32
+    munmap(const_cast<char*>(_data), _size);
+#endif
+    throw;
+  }
+}
+
+SVLocusSetFlatView::~SVLocusSetFlatView()
+{
+#ifndef _WIN32
+  if (nullptr != _data) munmap(const_cast<char*>(_data), _size);
+#endif
+}
+
+bool SVLocusSetFlatView::isFlatFile(const char* filename)
+{
+  assert(nullptr != filename);
+
+  std::ifstream ifs(filename, std::ios::binary);
+  char          magic[sizeof(flatFileMagic)];
+  if (!ifs.read(magic, sizeof(magic))) return false;
+  return (0 == std::memcmp(magic, flatFileMagic, sizeof(magic)));
+}
+
+void SVLocusSetFlatView::validate(const char* filename) const
+{
+  const SVLocusSetFlatHeader& header(_header());
+  if (0 != std::memcmp(header.magic, flatFileMagic, sizeof(flatFileMagic))) {
+    flatFileError(filename, "unrecognized file signature");
+  }
+  if (header.version != flatFileVersion) {
+    std::ostringstream oss;
+    oss << "unsupported format version " << header.version << ", expected version " << flatFileVersion;
+    flatFileError(filename, oss.str().c_str());
+  }
+
+  // Check that every section is aligned and fits in the file:
+  auto isValidSection = [&](const uint64_t offset, const uint64_t count, const uint64_t elementSize) {
+    if ((offset % 8) != 0) return false;
+    if (offset > _size) return false;
+    return (count <= ((_size - offset) / elementSize));
+  };
+
+  if (!isValidSection(header.metadataOffset, header.metadataSize, 1)) {
+    flatFileError(filename, "invalid metadata section");
+  }
+  if ((header.locusCount == std::numeric_limits<uint64_t>::max()) ||
+      (!isValidSection(header.locusTableOffset, header.locusCount + 1, sizeof(uint64_t)))) {
+    flatFileError(filename, "invalid locus table section");
+  }
+  if (!isValidSection(header.nodeTableOffset, header.nodeCount, sizeof(SVLocusSetFlatNode))) {
+    flatFileError(filename, "invalid node table section");
+  }
+  if (!isValidSection(header.edgeTableOffset, header.edgeCount, sizeof(SVLocusSetFlatEdge))) {
+    flatFileError(filename, "invalid edge table section");
+  }
+
+  // Check that all table cross-references are in range:
+  const uint64_t* locusTable(_locusTable());
+  if ((locusTable[0] != 0) || (locusTable[header.locusCount] != header.nodeCount)) {
+    flatFileError(filename, "inconsistent locus table");
+  }
+  for (uint64_t locusIndex(0); locusIndex < header.locusCount; ++locusIndex) {
+    if (locusTable[locusIndex + 1] < locusTable[locusIndex]) {
+      flatFileError(filename, "inconsistent locus table");
+    }
+    const uint64_t locusNodeCount(locusTable[locusIndex + 1] - locusTable[locusIndex]);
+    for (uint64_t nodeIndex(locusTable[locusIndex]); nodeIndex < locusTable[locusIndex + 1]; ++nodeIndex) {
+      const SVLocusSetFlatNode& node(_nodeTable()[nodeIndex]);
+      if ((node.edgeBeginIndex > header.edgeCount) ||
+          (node.edgeCount > (header.edgeCount - node.edgeBeginIndex))) {
+        flatFileError(filename, "inconsistent node table");
+      }
+      for (const SVLocusSetFlatEdge* edgeIter(edgesBegin(node)); edgeIter != edgesEnd(node); ++edgeIter) {
+        if (edgeIter->nodeIndex >= locusNodeCount) flatFileError(filename, "inconsistent edge table");
+      }
+    }
+  }
+}
+
+void writeSVLocusSetFlatFile(
+    const char* filename, const std::string& metadata, const std::vector<SVLocus>& loci)
+{
+  using namespace illumina::common;
+
+  assert(nullptr != filename);
+
+  std::vector<uint64_t>           locusTable(1, 0);
+  std::vector<SVLocusSetFlatNode> nodeTable;
+  std::vector<SVLocusSetFlatEdge> edgeTable;
+
+  for (const SVLocus& locus : loci) {
+    if (locus.empty()) continue;
+    for (const SVLocusNode& node : locus) {
+      SVLocusSetFlatNode flatNode;
+      flatNode.tid              = node.getInterval().tid;
+      flatNode.beginPos         = node.getInterval().range.begin_pos();
+      flatNode.endPos           = node.getInterval().range.end_pos();
+      flatNode.evidenceBeginPos = node.getEvidenceRange().begin_pos();
+      flatNode.evidenceEndPos   = node.getEvidenceRange().end_pos();
+      flatNode.edgeCount        = 0;
+      flatNode.edgeBeginIndex   = edgeTable.size();
+
+      const SVLocusEdgeManager edgeMap(node.getEdgeManager());
+      for (const SVLocusEdgesType::value_type& edgeIter : edgeMap.getMap()) {
+        SVLocusSetFlatEdge flatEdge;
+        flatEdge.nodeIndex = edgeIter.first;
+        flatEdge.count     = edgeIter.second.getCount();
+        edgeTable.push_back(flatEdge);
+        flatNode.edgeCount++;
+      }
+      nodeTable.push_back(flatNode);
+    }
+    locusTable.push_back(nodeTable.size());
+  }
+
+  SVLocusSetFlatHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, flatFileMagic, sizeof(flatFileMagic));
+  header.version          = flatFileVersion;
+  header.metadataOffset   = getSectionOffset(sizeof(header));
+  header.metadataSize     = metadata.size();
+  header.locusTableOffset = getSectionOffset(header.metadataOffset + header.metadataSize);
+  header.locusCount       = locusTable.size() - 1;
+  header.nodeTableOffset  = getSectionOffset(header.locusTableOffset + locusTable.size() * sizeof(uint64_t));
+  header.nodeCount        = nodeTable.size();
+  header.edgeTableOffset =
+      getSectionOffset(header.nodeTableOffset + nodeTable.size() * sizeof(SVLocusSetFlatNode));
+  header.edgeCount = edgeTable.size();
+
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) {
+    std::ostringstream oss;
+    oss << "Can't open SV locus graph file '" << filename << "' for writing";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+
+  uint64_t offset(0);
+  auto     writeSection = [&](const uint64_t sectionOffset, const void* data, const uint64_t size) {
+    static const char padding[8] = {};
+    assert(sectionOffset >= offset);
+    ofs.write(padding, sectionOffset - offset);
+    ofs.write(static_cast<const char*>(data), size);
+    offset = sectionOffset + size;
+  };
+
+  writeSection(0, &header, sizeof(header));
+  writeSection(header.metadataOffset, metadata.data(), metadata.size());
+  writeSection(header.locusTableOffset, locusTable.data(), locusTable.size() * sizeof(uint64_t));
+  writeSection(header.nodeTableOffset, nodeTable.data(), nodeTable.size() * sizeof(SVLocusSetFlatNode));
+  writeSection(header.edgeTableOffset, edgeTable.data(), edgeTable.size() * sizeof(SVLocusSetFlatEdge));
+
+  if (!ofs) {
+    std::ostringstream oss;
+    oss << "Failed to write SV locus graph file '" << filename << "'";
+    BOOST_THROW_EXCEPTION(GeneralException(oss.str()));
+  }
+}
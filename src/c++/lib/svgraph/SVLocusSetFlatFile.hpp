@@ -0,0 +1,166 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Flat, memory-mappable file format for SV locus graphs
+///
+/// The flat format stores the graph as fixed-width tables addressed by offsets from the start of the file,
+/// so that an SVLocusSet can be rebuilt from it with sequential table reads, instead of deserializing each
+/// locus graph component through a boost archive. All values are stored in native byte order.
+///
+/// This is a faster load format only. The SVLocusSet file constructor copies the whole graph into memory and
+/// releases the file mapping, so graph consumers do not read the file in place, and each process holds its
+/// own copy of the graph.
+///
+/// File layout:
+/// 1. SVLocusSetFlatHeader
+/// 2. Metadata: opaque byte block written by SVLocusSet (bam header, options, counts, etc.)
+/// 3. Locus table: locusCount+1 node table start indices, so that locus i contains nodes [t[i],t[i+1])
+/// 4. Node table: SVLocusSetFlatNode records for all loci
+/// 5. Edge table: SVLocusSetFlatEdge records for all nodes
+///
+/// Each section starts on an 8-byte boundary.
+///
+
+#pragma once
+
+#include "svgraph/SVLocus.hpp"
+
+#include "boost/utility.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SVLocusSetFlatHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t metadataOffset;
+  uint64_t metadataSize;
+  uint64_t locusTableOffset;
+  uint64_t locusCount;
+  uint64_t nodeTableOffset;
+  uint64_t nodeCount;
+  uint64_t edgeTableOffset;
+  uint64_t edgeCount;
+};
+
+/// One graph node in the flat file format
+///
+/// Node edges are stored in the edge table range [edgeBeginIndex,edgeBeginIndex+edgeCount) in order of
+/// increasing target node index.
+struct SVLocusSetFlatNode {
+  int32_t  tid;
+  int32_t  beginPos;
+  int32_t  endPos;
+  int32_t  evidenceBeginPos;
+  int32_t  evidenceEndPos;
+  uint32_t edgeCount;
+  uint64_t edgeBeginIndex;
+};
+
+/// One directed graph edge in the flat file format
+struct SVLocusSetFlatEdge {
+  /// Target node index within the same locus
+  uint32_t nodeIndex;
+
+  /// Evidence count of the edge
+  uint32_t count;
+};
+
+/// \brief Read-only view of a flat SV locus graph file
+///
+/// The file is mapped into memory so that the graph tables can be read without an intermediate copy while
+/// an SVLocusSet is built from them. All methods are thread-safe.
+///
+struct SVLocusSetFlatView : private boost::noncopyable {
+  /// \brief Map the flat graph file into memory and validate its header
+  ///
+  /// Throws if the file is not a valid flat graph file of the current version.
+  explicit SVLocusSetFlatView(const char* filename);
+
+  ~SVLocusSetFlatView();
+
+  /// True if the file starts with the flat graph file signature
+  static bool isFlatFile(const char* filename);
+
+  const char* getMetadata() const { return (_data + _header().metadataOffset); }
+
+  uint64_t getMetadataSize() const { return _header().metadataSize; }
+
+  uint64_t locusCount() const { return _header().locusCount; }
+
+  /// Number of nodes in locus \p locusIndex
+  unsigned nodeCount(const uint64_t locusIndex) const
+  {
+    return static_cast<unsigned>(_locusTable()[locusIndex + 1] - _locusTable()[locusIndex]);
+  }
+
+  const SVLocusSetFlatNode& getNode(const uint64_t locusIndex, const unsigned nodeIndex) const
+  {
+    return _nodeTable()[_locusTable()[locusIndex] + nodeIndex];
+  }
+
+  const SVLocusSetFlatEdge* edgesBegin(const SVLocusSetFlatNode& node) const
+  {
+    return (_edgeTable() + node.edgeBeginIndex);
+  }
+
+  const SVLocusSetFlatEdge* edgesEnd(const SVLocusSetFlatNode& node) const
+  {
+    return (edgesBegin(node) + node.edgeCount);
+  }
+
+private:
+  const SVLocusSetFlatHeader& _header() const
+  {
+    return *reinterpret_cast<const SVLocusSetFlatHeader*>(_data);
+  }
+
+  const uint64_t* _locusTable() const
+  {
+    return reinterpret_cast<const uint64_t*>(_data + _header().locusTableOffset);
+  }
+
+  const SVLocusSetFlatNode* _nodeTable() const
+  {
+    return reinterpret_cast<const SVLocusSetFlatNode*>(_data + _header().nodeTableOffset);
+  }
+
+  const SVLocusSetFlatEdge* _edgeTable() const
+  {
+    return reinterpret_cast<const SVLocusSetFlatEdge*>(_data + _header().edgeTableOffset);
+  }
+
+  void validate(const char* filename) const;
+
+  const char* _data = nullptr;
+  uint64_t    _size = 0;
+
+  /// Holds the file contents on platforms where it is read instead of mapped
+  std::vector<char> _buffer;
+};
+
+/// \brief Write SV locus graph components in the flat file format
+///
+/// Empty loci are skipped, consistent with the serialized graph format.
+///
+/// \param[in] metadata Opaque block of graph-level information, returned by SVLocusSetFlatView::getMetadata
+void writeSVLocusSetFlatFile(
+    const char* filename, const std::string& metadata, const std::vector<SVLocus>& loci);
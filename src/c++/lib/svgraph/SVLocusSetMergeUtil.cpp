@@ -0,0 +1,168 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+///
+
+#include "svgraph/SVLocusSetMergeUtil.hpp"
+
+#include "ctpl_stl.h"
+
+#include <algorithm>
+#include <cassert>
+
+/// Merge the tail graph into the head graph, or the reverse if the tail graph is larger, leaving the merged
+/// graph in \p headSetPtr
+static void mergeLocusSetPair(
+    std::shared_ptr<SVLocusSet>& headSetPtr, std::shared_ptr<SVLocusSet>& tailSetPtr)
+{
+  if (tailSetPtr->size() > headSetPtr->size()) std::swap(headSetPtr, tailSetPtr);
+  headSetPtr->merge(*tailSetPtr);
+  tailSetPtr.reset();
+}
+
+/// Add \p times to the entry for tree level \p level in \p levelTimes
+static void addLevelTime(std::vector<CpuTimes>* levelTimes, const unsigned level, const CpuTimes& times)
+{
+  if (levelTimes == nullptr) return;
+  if (levelTimes->size() <= level) levelTimes->resize(level + 1);
+  (*levelTimes)[level].merge(times);
+}
+
+/// Merge the graph at the top of \p mergeStack into the graph below it, and add the merge time to the tree
+/// level of the lower graph
+static void mergeLocusSetStackTop(
+    std::vector<std::pair<unsigned, std::shared_ptr<SVLocusSet>>>& mergeStack,
+    std::vector<CpuTimes>*                                         levelTimes)
+{
+  assert(mergeStack.size() > 1);
+
+  TimeTracker mergeTimer;
+  mergeTimer.resume();
+
+  auto& tail(mergeStack.back());
+  auto& head(mergeStack[mergeStack.size() - 2]);
+  mergeLocusSetPair(head.second, tail.second);
+  mergeTimer.stop();
+  addLevelTime(levelTimes, head.first, mergeTimer.getTimes());
+
+  head.first++;
+  mergeStack.pop_back();
+}
+
+void mergeLocusSetsInTree(
+    std::vector<std::shared_ptr<SVLocusSet>>& locusSets,
+    const unsigned                            threadCount,
+    std::vector<CpuTimes>*                    levelTimes)
+{
+  assert(!locusSets.empty());
+  assert(threadCount > 0);
+
+  ctpl::thread_pool pool(std::min(threadCount, static_cast<unsigned>(locusSets.size() / 2) + 1));
+
+  while (locusSets.size() > 1) {
+    TimeTracker levelTimer;
+    levelTimer.resume();
+
+    const unsigned setCount(locusSets.size());
+
+    std::vector<std::future<void>> mergeReturnValues;
+    for (unsigned setIndex(1); setIndex < setCount; setIndex += 2) {
+      mergeReturnValues.push_back(pool.push(
+          [&locusSets, setIndex](int) { mergeLocusSetPair(locusSets[setIndex - 1], locusSets[setIndex]); }));
+    }
+
+    // Wait for all merges on this level, rethrowing any merge exception in this thread:
+    for (auto& mergeReturnValue : mergeReturnValues) {
+      mergeReturnValue.get();
+    }
+
+    // Compact the list to the merged graphs:
+    for (unsigned setIndex(0); setIndex < setCount; setIndex += 2) {
+      locusSets[setIndex / 2] = locusSets[setIndex];
+    }
+    locusSets.resize((setCount + 1) / 2);
+
+    levelTimer.stop();
+    if (levelTimes != nullptr) levelTimes->push_back(levelTimer.getTimes());
+  }
+}
+
+std::shared_ptr<SVLocusSet> mergeLocusSetStreamInTree(
+    const unsigned                                              setCount,
+    const std::function<std::shared_ptr<SVLocusSet>(unsigned)>& getLocusSet,
+    const unsigned                                              threadCount,
+    std::vector<CpuTimes>*                                      levelTimes)
+{
+  assert(setCount > 0);
+  assert(threadCount > 0);
+
+  unsigned blockSize(1);
+  unsigned blockLevel(0);
+  while ((blockSize * 2) <= threadCount) {
+    blockSize *= 2;
+    blockLevel++;
+  }
+
+  ctpl::thread_pool pool(std::min(blockSize, setCount));
+
+  // Partially merged graphs paired with their tree level. Levels strictly decrease from the bottom of the
+  // stack, as in a binary counter:
+  std::vector<std::pair<unsigned, std::shared_ptr<SVLocusSet>>> mergeStack;
+
+  for (unsigned blockBegin(0); blockBegin < setCount; blockBegin += blockSize) {
+    const unsigned blockEnd(std::min(setCount, blockBegin + blockSize));
+
+    std::vector<std::shared_ptr<SVLocusSet>> blockSets(blockEnd - blockBegin);
+    {
+      std::vector<std::future<void>> loadReturnValues;
+      for (unsigned setIndex(blockBegin); setIndex < blockEnd; ++setIndex) {
+        loadReturnValues.push_back(pool.push([&getLocusSet, &blockSets, blockBegin, setIndex](int) {
+          blockSets[setIndex - blockBegin] = getLocusSet(setIndex);
+        }));
+      }
+
+      // Rethrow any worker thread exceptions:
+      for (auto& loadReturnValue : loadReturnValues) {
+        loadReturnValue.get();
+      }
+    }
+
+    std::vector<CpuTimes> blockLevelTimes;
+    mergeLocusSetsInTree(blockSets, threadCount, &blockLevelTimes);
+    for (unsigned level(0); level < blockLevelTimes.size(); ++level) {
+      addLevelTime(levelTimes, level, blockLevelTimes[level]);
+    }
+    mergeStack.emplace_back(blockLevel, std::move(blockSets.front()));
+
+    // Merge completed subtrees of equal level. A final partial block is left to the fold below:
+    const bool isFullBlock((blockEnd - blockBegin) == blockSize);
+    while (isFullBlock && (mergeStack.size() > 1) &&
+           (mergeStack.back().first == mergeStack[mergeStack.size() - 2].first)) {
+      mergeLocusSetStackTop(mergeStack, levelTimes);
+    }
+  }
+
+  // Remaining subtrees are merged from the end of the list, matching the order in which mergeLocusSetsInTree
+  // carries unpaired graphs up the tree. Each of these merges occurs at the tree level of the lower graph:
+  while (mergeStack.size() > 1) {
+    mergeLocusSetStackTop(mergeStack, levelTimes);
+  }
+
+  return mergeStack.front().second;
+}
@@ -0,0 +1,78 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+/// \file
+/// \brief Utilities to merge multiple SV locus graphs concurrently
+///
+
+#pragma once
+
+#include "blt_util/time_util.hpp"
+#include "svgraph/SVLocusSet.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// \brief Merge a list of SV locus graphs into the first graph of the list using a balanced pairwise tree
+///
+/// At each level of the tree, every graph at an odd position in the list is paired with the graph which
+/// precedes it, and all pairs are merged concurrently using up to \p threadCount threads. Within each pair,
+/// the graph with fewer loci is merged into the other, because merge cost mostly scales with the size of
+/// the graph being merged in. Graphs from different genome segments rarely intersect, so this keeps most
+/// merges close to a simple append of the smaller graph.
+///
+/// The merge order is fixed by the input order and graph sizes, so the final graph does not depend on
+/// \p threadCount.
+///
+/// \param[in,out] locusSets List of graphs to merge. On return the list contains a single merged graph.
+/// \param[in] threadCount Maximum number of threads used to merge graphs
+/// \param[out] levelTimes If non-null, the time to merge each level of the tree is appended here
+///
+void mergeLocusSetsInTree(
+    std::vector<std::shared_ptr<SVLocusSet>>& locusSets,
+    const unsigned                            threadCount,
+    std::vector<CpuTimes>*                    levelTimes = nullptr);
+
+/// \brief Load and merge a sequence of SV locus graphs using the same balanced pairwise tree as
+/// mergeLocusSetsInTree, while holding only a bounded number of graphs in memory
+///
+/// Graphs are requested from \p getLocusSet in consecutive blocks, where the block size is the largest power
+/// of two not greater than \p threadCount. The graphs of each block are loaded and tree merged concurrently,
+/// then each block result is merged with earlier block results of the same tree level as soon as it is
+/// available. Blocks are aligned to the subtrees of the full tree, so the final graph is the same as the
+/// result of mergeLocusSetsInTree over all graphs, for any \p threadCount.
+///
+/// At most one block of input graphs plus one partially merged graph per tree level are held at once. With a
+/// single thread, graphs are loaded and merged one at a time.
+///
+/// \param[in] setCount Number of graphs to merge, must be greater than zero
+/// \param[in] getLocusSet Functor returning the graph at the given index. It may be called concurrently from
+///                        up to \p threadCount threads.
+/// \param[in] threadCount Maximum number of threads used to load and merge graphs
+/// \param[out] levelTimes If non-null, the time to merge each level of the tree is added to the entry for
+///                        that level, resizing the list as required. Time to load input graphs is not
+///                        included.
+///
+/// \return The merged graph
+///
+std::shared_ptr<SVLocusSet> mergeLocusSetStreamInTree(
+    const unsigned                                              setCount,
+    const std::function<std::shared_ptr<SVLocusSet>(unsigned)>& getLocusSet,
+    const unsigned                                              threadCount,
+    std::vector<CpuTimes>*                                      levelTimes = nullptr);
@@ -22,6 +22,11 @@
 #include "svgraph/SVLocus.hpp"
 #include "test/testSVLocusUtil.hpp"
 
+#include "boost/archive/binary_oarchive.hpp"
+
+#include <memory>
+#include <sstream>
+
 BOOST_AUTO_TEST_SUITE(SVLocusNode_test_suite)
 
 BOOST_AUTO_TEST_CASE(test_SVLocusNode_EdgeManager)
@@ -45,4 +50,86 @@ BOOST_AUTO_TEST_CASE(test_SVLocusNode_EdgeManager)
   BOOST_REQUIRE_EQUAL(em.getMap().begin()->second.getCount(), 1u);
 }
 
+static SVLocusEdge getTestEdge(const unsigned count)
+{
+  SVLocusEdge edge;
+  edge.setCount(count);
+  return edge;
+}
+
+BOOST_AUTO_TEST_CASE(test_SVLocusEdgeFlatMap)
+{
+  SVLocusEdgesType edges;
+  BOOST_REQUIRE(edges.empty());
+
+  // edges are kept sorted independent of insertion order:
+  static const unsigned testIndices[] = {5, 2, 9, 0, 7};
+  for (const unsigned index : testIndices) {
+    BOOST_REQUIRE(edges.insert(std::make_pair(index, getTestEdge(index + 1))).second);
+  }
+  BOOST_REQUIRE(!edges.insert(std::make_pair(5u, getTestEdge(100))).second);
+  BOOST_REQUIRE_EQUAL(edges.size(), 5u);
+
+  std::vector<unsigned> edgeIndices;
+  for (const SVLocusEdgesType::value_type& edge : edges) {
+    edgeIndices.push_back(edge.first);
+  }
+  const std::vector<unsigned> expectedEdgeIndices = {0, 2, 5, 7, 9};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(
+      edgeIndices.begin(), edgeIndices.end(), expectedEdgeIndices.begin(), expectedEdgeIndices.end());
+
+  BOOST_REQUIRE_EQUAL(edges.find(5)->second.getCount(), 6u);
+  BOOST_REQUIRE(edges.find(6) == edges.end());
+  BOOST_REQUIRE_EQUAL(edges.lower_bound(6)->first, 7u);
+  BOOST_REQUIRE(edges.lower_bound(10) == edges.end());
+
+  BOOST_REQUIRE_EQUAL(edges.erase(2u), 1u);
+  BOOST_REQUIRE_EQUAL(edges.erase(2u), 0u);
+  edges.erase(edges.find(0));
+  BOOST_REQUIRE_EQUAL(edges.size(), 3u);
+  BOOST_REQUIRE_EQUAL(edges.begin()->first, 5u);
+}
+
+template <typename T>
+static std::string getArchive(const T& container)
+{
+  std::ostringstream oss;
+  {
+    boost::archive::binary_oarchive oa(oss);
+    oa << container;
+  }
+  return oss.str();
+}
+
+/// Test that the edge container serializes exactly as the std::map container it replaced, so that graph
+/// files are compatible between the two
+BOOST_AUTO_TEST_CASE(test_SVLocusEdgeFlatMapSerialize)
+{
+  SVLocusEdgesType                     edges;
+  std::map<NodeIndexType, SVLocusEdge> edgeMap;
+  for (unsigned index(0); index < 10; ++index) {
+    const auto edge(std::make_pair((index * 7) % 10, getTestEdge(index)));
+    edges.insert(edge);
+    edgeMap.insert(edge);
+  }
+
+  BOOST_REQUIRE(getArchive(edges) == getArchive(edgeMap));
+}
+
+/// Test that edge manager copies of a single-edge node refer to their own copy of the edge
+BOOST_AUTO_TEST_CASE(test_SVLocusEdgeManagerCopy)
+{
+  SVLocus locus1;
+  locusAddPair(locus1, 1, 10, 20, 2, 30, 40, false, 3);
+
+  const SVLocusNode&                  node(static_cast<const SVLocus&>(locus1).getNode(0));
+  std::unique_ptr<SVLocusEdgeManager> emPtr(new SVLocusEdgeManager(node.getEdgeManager()));
+  const SVLocusEdgeManager            emCopy(*emPtr);
+  emPtr.reset();
+
+  BOOST_REQUIRE_EQUAL(emCopy.getMap().size(), 1u);
+  BOOST_REQUIRE_EQUAL(emCopy.getMap().begin()->first, 1u);
+  BOOST_REQUIRE_EQUAL(emCopy.getMap().begin()->second.getCount(), 3u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
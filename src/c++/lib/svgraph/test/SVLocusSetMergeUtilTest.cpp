@@ -0,0 +1,145 @@
+//
+// Manta - Structural Variant and Indel Caller
+// Copyright (c) 2013-2019 Illumina, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+#include "boost/test/unit_test.hpp"
+
+#include "svgraph/SVLocusSetMergeUtil.hpp"
+#include "test/testSVLocusUtil.hpp"
+
+#include <atomic>
+#include <sstream>
+
+static const int32_t testPairs[][6] = {{1, 10, 20, 2, 30, 40},
+                                       {1, 15, 25, 2, 35, 45},
+                                       {3, 10, 20, 4, 30, 40},
+                                       {1, 18, 22, 3, 12, 18},
+                                       {5, 10, 20, 6, 10, 20}};
+
+static const unsigned testPairCount(sizeof(testPairs) / sizeof(testPairs[0]));
+
+/// Add a single test locus pair to \p locusSet, cycling through the test pairs by \p pairIndex
+static void addTestLocus(const unsigned pairIndex, SVLocusSet& locusSet)
+{
+  const int32_t(&testPair)[6](testPairs[pairIndex % testPairCount]);
+  SVLocus locus;
+  locusAddPair(locus, testPair[0], testPair[1], testPair[2], testPair[3], testPair[4], testPair[5]);
+  locusSet.merge(locus);
+}
+
+/// Build a list of small graphs, some of which intersect each other when merged
+static std::vector<std::shared_ptr<SVLocusSet>> getTestLocusSets(
+    const SVLocusSetOptions& sopt, const unsigned setCount = testPairCount)
+{
+  std::vector<std::shared_ptr<SVLocusSet>> locusSets;
+  for (unsigned setIndex(0); setIndex < setCount; ++setIndex) {
+    locusSets.push_back(std::make_shared<SVLocusSet>(sopt));
+    addTestLocus(setIndex, *locusSets.back());
+  }
+  return locusSets;
+}
+
+static std::string getLocusSetDump(const SVLocusSet& set)
+{
+  std::ostringstream oss;
+  set.dump(oss);
+  return oss.str();
+}
+
+BOOST_AUTO_TEST_SUITE(SVLocusSetMergeUtil_test_suite)
+
+// Test that the tree merge produces the same graph components as a serial merge, and that its result does not
+// depend on thread count
+BOOST_AUTO_TEST_CASE(test_mergeLocusSetsInTree)
+{
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+
+  SVLocusSet serialSet(sopt);
+  for (const auto& locusSetPtr : getTestLocusSets(sopt)) {
+    serialSet.merge(*locusSetPtr);
+  }
+  serialSet.checkState(true, true);
+
+  auto singleThreadSets(getTestLocusSets(sopt));
+  mergeLocusSetsInTree(singleThreadSets, 1);
+  BOOST_REQUIRE_EQUAL(singleThreadSets.size(), 1u);
+  const SVLocusSet& singleThreadSet(*singleThreadSets.front());
+  singleThreadSet.checkState(true, true);
+
+  BOOST_REQUIRE_EQUAL(singleThreadSet.nonEmptySize(), serialSet.nonEmptySize());
+  BOOST_REQUIRE_EQUAL(singleThreadSet.nonEmptySize(), 2u);
+  BOOST_REQUIRE_EQUAL(singleThreadSet.totalObservationCount(), serialSet.totalObservationCount());
+
+  auto                  multiThreadSets(getTestLocusSets(sopt));
+  std::vector<CpuTimes> levelTimes;
+  mergeLocusSetsInTree(multiThreadSets, 3, &levelTimes);
+  BOOST_REQUIRE_EQUAL(multiThreadSets.size(), 1u);
+  BOOST_REQUIRE_EQUAL(levelTimes.size(), 3u);
+  BOOST_REQUIRE_EQUAL(getLocusSetDump(*multiThreadSets.front()), getLocusSetDump(singleThreadSet));
+}
+
+// Test that the streaming tree merge reproduces the full tree merge for any input and thread count, while
+// bounding the number of graphs held in memory
+BOOST_AUTO_TEST_CASE(test_mergeLocusSetStreamInTree)
+{
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+
+  for (unsigned setCount(1); setCount <= 13; ++setCount) {
+    auto treeSets(getTestLocusSets(sopt, setCount));
+    mergeLocusSetsInTree(treeSets, 1);
+    const std::string expectedDump(getLocusSetDump(*treeSets.front()));
+
+    unsigned expectedLevelCount(0);
+    while ((1u << expectedLevelCount) < setCount) expectedLevelCount++;
+
+    for (const unsigned threadCount : {1u, 2u, 3u, 4u, 8u}) {
+      std::atomic<int> liveSetCount(0);
+      std::atomic<int> maxLiveSetCount(0);
+
+      const std::function<std::shared_ptr<SVLocusSet>(unsigned)> getLocusSet = [&](const unsigned setIndex) {
+        const int newLiveSetCount(++liveSetCount);
+        int       oldMaxLiveSetCount(maxLiveSetCount);
+        while ((newLiveSetCount > oldMaxLiveSetCount) &&
+               (!maxLiveSetCount.compare_exchange_weak(oldMaxLiveSetCount, newLiveSetCount))) {
+        }
+        std::shared_ptr<SVLocusSet> locusSetPtr(new SVLocusSet(sopt), [&liveSetCount](SVLocusSet* setPtr) {
+          --liveSetCount;
+          delete setPtr;
+        });
+        addTestLocus(setIndex, *locusSetPtr);
+        return locusSetPtr;
+      };
+
+      std::vector<CpuTimes> levelTimes;
+      const auto streamSet(mergeLocusSetStreamInTree(setCount, getLocusSet, threadCount, &levelTimes));
+      streamSet->checkState(true, true);
+      BOOST_REQUIRE_EQUAL(getLocusSetDump(*streamSet), expectedDump);
+
+      // Merge times are reported for each level of the full tree:
+      BOOST_REQUIRE_EQUAL(levelTimes.size(), expectedLevelCount);
+
+      // At most one block of inputs plus one merged graph per level of the block tree:
+      const int blockSize((threadCount >= 8) ? 8 : ((threadCount >= 4) ? 4 : ((threadCount >= 2) ? 2 : 1)));
+      const int levelCount(4);
+      BOOST_REQUIRE_LE(maxLiveSetCount.load(), blockSize + levelCount);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,7 +27,7 @@
 #include "test/testSVLocusUtil.hpp"
 
 static unsigned testOverlap(
-    SVLocusSet& locusSet, const int32_t tid, const int32_t beginPos, const int32_t endPos)
+    const SVLocusSet& locusSet, const int32_t tid, const int32_t beginPos, const int32_t endPos)
 {
   std::set<SVLocusSet::NodeAddressType> intersect;
   locusSet.getRegionIntersect(GenomeInterval(tid, beginPos, endPos), intersect);
@@ -102,4 +102,30 @@ BOOST_AUTO_TEST_CASE(test_SVLocusCombine)
 #endif
 }
 
+/// Test that region intersection queries do not change the graph, including queries on chromosomes without
+/// any graph nodes
+BOOST_AUTO_TEST_CASE(test_SVLocusIntersectConst)
+{
+  SVLocus locus1;
+  locusAddPair(locus1, 1, 10, 20, 2, 30, 40);
+
+  SVLocus locus2;
+  locusAddPair(locus2, 1, 10, 20, 3, 30, 40);
+
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 2;
+  SVLocusSet set1(sopt);
+  set1.merge(locus1);
+  set1.merge(locus2);
+  const SVLocusSet& cset1(set1);
+
+  const unsigned setSize(cset1.size());
+  BOOST_REQUIRE_EQUAL(testOverlap(cset1, 1, 15, 16), 2u);
+  BOOST_REQUIRE_EQUAL(testOverlap(cset1, 1, 5, 10), 0u);
+  BOOST_REQUIRE_EQUAL(testOverlap(cset1, 3, 0, 100), 1u);
+  BOOST_REQUIRE_EQUAL(testOverlap(cset1, 10, 0, 100), 0u);
+  BOOST_REQUIRE_EQUAL(cset1.size(), setSize);
+  cset1.checkState(true, true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -96,4 +96,58 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSetSerialize2)
   BOOST_REQUIRE_EQUAL(set1_locus1.size(), set1_copy_locus1.size());
 }
 
+/// Test that graphs read back from the flat and serialized file formats are identical
+BOOST_AUTO_TEST_CASE(test_SVLocusSetFlatSerialize)
+{
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet set1(sopt);
+  {
+    SVLocus locus1;
+    locusAddPair(locus1, 1, 10, 20, 2, 30, 40, false, 3);
+
+    SVLocus locus4;
+    locusAddPair(locus4, 1, 15, 25, 5, 30, 40);
+
+    SVLocus locus2;
+    locusAddPair(locus2, 3, 10, 20, 3, 30, 40, true, 2);
+
+    SVLocus locus3;
+    locusAddPair(locus3, 4, 100, 200, 4, 300, 400);
+
+    set1.merge(locus1);
+    set1.merge(locus2);
+    set1.merge(locus3);
+    set1.merge(locus4);
+  }
+
+  const auto        copyPtr(getSerializedSVLocusSetCopy(set1, false));
+  const auto        flatCopyPtr(getSerializedSVLocusSetCopy(set1, true));
+  const SVLocusSet& copySet(*copyPtr);
+  const SVLocusSet& flatCopySet(*flatCopyPtr);
+
+  BOOST_REQUIRE_EQUAL(flatCopySet.size(), copySet.size());
+  BOOST_REQUIRE_EQUAL(flatCopySet.nonEmptySize(), copySet.nonEmptySize());
+  BOOST_REQUIRE_EQUAL(flatCopySet.getMinMergeEdgeCount(), 1u);
+
+  for (unsigned locusIndex(0); locusIndex < copySet.size(); ++locusIndex) {
+    const SVLocus& locus(copySet.getLocus(locusIndex));
+    const SVLocus& flatLocus(flatCopySet.getLocus(locusIndex));
+    BOOST_REQUIRE_EQUAL(flatLocus.size(), locus.size());
+    for (NodeIndexType nodeIndex(0); nodeIndex < locus.size(); ++nodeIndex) {
+      const SVLocusNode& node(locus.getNode(nodeIndex));
+      const SVLocusNode& flatNode(flatLocus.getNode(nodeIndex));
+      BOOST_REQUIRE_EQUAL(flatNode.getInterval(), node.getInterval());
+      BOOST_REQUIRE_EQUAL(flatNode.getEvidenceRange(), node.getEvidenceRange());
+      BOOST_REQUIRE_EQUAL(flatNode.size(), node.size());
+
+      const SVLocusEdgeManager edgeMap(node.getEdgeManager());
+      for (const auto& edgeIter : edgeMap.getMap()) {
+        BOOST_REQUIRE(flatNode.isEdge(edgeIter.first));
+        BOOST_REQUIRE_EQUAL(flatNode.getEdge(edgeIter.first).getCount(), edgeIter.second.getCount());
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,7 @@
 #include "boost/timer/timer.hpp"
 
 #include <fstream>  // For FindStringInFile
+#include <sstream>
 
 /// \brief Test the size and count of the properties of the SVLocusSet.
 ///
@@ -561,11 +562,11 @@ BOOST_AUTO_TEST_CASE(test_SVLocusNoiseClean)
     BOOST_REQUIRE_EQUAL(cset1.getLocus(1).size(), 2u);
 
     set1.cleanRegion(GenomeInterval(3, 0, 70));
-    TestSVLocusSetProperties(cset1, 3, 2, 4, 4);
+    TestSVLocusSetProperties(cset1, 2, 2, 4, 4);
     BOOST_REQUIRE_EQUAL(cset1.getLocus(1).size(), 2u);
 
     set1.cleanRegion(GenomeInterval(1, 0, 70));
-    TestSVLocusSetProperties(cset1, 3, 1, 2, 2);
+    TestSVLocusSetProperties(cset1, 2, 1, 2, 2);
     BOOST_REQUIRE_EQUAL(cset1.getLocus(0).size(), 2u);
   }
 }
@@ -637,7 +638,7 @@ BOOST_AUTO_TEST_CASE(test_SVLocusNoiseCleanRemote)
     BOOST_REQUIRE_EQUAL(cset1.getLocus(0).size(), 2u);
 
     set1.cleanRegion(GenomeInterval(1, 0, 120));
-    TestSVLocusSetProperties(cset1, 2, 0, 0, 0);
+    TestSVLocusSetProperties(cset1, 1, 0, 0, 0);
     BOOST_REQUIRE_EQUAL(cset1.getLocus(0).size(), 0u);
   }
 }
@@ -677,6 +678,99 @@ BOOST_AUTO_TEST_CASE(test_SVLocusEvidenceRange)
   }
 }
 
+/// \brief Build the SVLocus corresponding to a node pair evidence record, using the SVLocus interface
+/// directly
+static SVLocus getNodePairLocus(
+    const GenomeInterval&   localInterval,
+    const known_pos_range2& localEvidenceRange,
+    const unsigned          localEdgeCount,
+    const GenomeInterval&   remoteInterval,
+    const unsigned          remoteEdgeCount)
+{
+  SVLocus             locus;
+  const NodeIndexType localNode(locus.addNode(localInterval));
+  locus.setNodeEvidence(localNode, localEvidenceRange);
+  const NodeIndexType remoteNode(locus.addNode(remoteInterval));
+  locus.linkNodes(localNode, remoteNode, localEdgeCount, remoteEdgeCount);
+  locus.mergeSelfOverlap();
+  return locus;
+}
+
+/// \brief Get a text dump of every locus in the set
+static std::string getSVLocusSetDump(const SVLocusSet& set1)
+{
+  std::ostringstream oss;
+  for (const SVLocus& locus : set1) {
+    oss << locus;
+  }
+  return oss.str();
+}
+
+/// Test that merging SVLocusEvidence records produces the same graph as merging the equivalent SVLocus
+/// objects
+BOOST_AUTO_TEST_CASE(test_SVLocusEvidenceMerge)
+{
+  struct NodePairInput {
+    GenomeInterval   localInterval;
+    known_pos_range2 localEvidenceRange;
+    unsigned         localEdgeCount;
+    GenomeInterval   remoteInterval;
+    unsigned         remoteEdgeCount;
+  };
+
+  // Cover separate, overlapping (self-edge) and merging node pairs with all combinations of zero edge counts:
+  const std::vector<NodePairInput> nodePairs = {
+      {GenomeInterval(1, 10, 20), known_pos_range2(5, 25), 3, GenomeInterval(2, 30, 40), 3},
+      {GenomeInterval(1, 15, 25), known_pos_range2(10, 20), 2, GenomeInterval(2, 35, 45), 0},
+      {GenomeInterval(1, 100, 110), known_pos_range2(90, 105), 1, GenomeInterval(1, 105, 120), 2},
+      {GenomeInterval(1, 200, 210), known_pos_range2(190, 205), 3, GenomeInterval(1, 205, 220), 0},
+      {GenomeInterval(1, 300, 310), known_pos_range2(290, 305), 0, GenomeInterval(1, 305, 320), 2},
+      {GenomeInterval(1, 400, 410), known_pos_range2(390, 405), 0, GenomeInterval(1, 405, 420), 0},
+      {GenomeInterval(1, 108, 130), known_pos_range2(100, 125), 3, GenomeInterval(2, 10, 20), 3}};
+
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+  SVLocusSet locusSet(sopt);
+  SVLocusSet evidenceSet(sopt);
+
+  for (const NodePairInput& nodePair : nodePairs) {
+    const SVLocus locus(getNodePairLocus(
+        nodePair.localInterval,
+        nodePair.localEvidenceRange,
+        nodePair.localEdgeCount,
+        nodePair.remoteInterval,
+        nodePair.remoteEdgeCount));
+    locusSet.merge(locus);
+
+    SVLocusEvidence evidence;
+    evidence.setNodePair(
+        nodePair.localInterval,
+        nodePair.localEvidenceRange,
+        nodePair.localEdgeCount,
+        nodePair.remoteInterval,
+        nodePair.remoteEdgeCount);
+    BOOST_REQUIRE_EQUAL(evidence.nodeCount, locus.size());
+    evidenceSet.merge(evidence);
+  }
+
+  // Add a complex (self-edge) record:
+  {
+    SVLocus             locus;
+    const NodeIndexType node(locus.addNode(GenomeInterval(3, 10, 20)));
+    locus.setNodeEvidence(node, known_pos_range2(5, 25));
+    locus.linkNodes(node, node, 2);
+    locusSet.merge(locus);
+
+    SVLocusEvidence evidence;
+    evidence.setSelfEdge(GenomeInterval(3, 10, 20), known_pos_range2(5, 25), 2);
+    evidenceSet.merge(evidence);
+  }
+
+  locusSet.checkState();
+  evidenceSet.checkState();
+  BOOST_REQUIRE_EQUAL(getSVLocusSetDump(evidenceSet), getSVLocusSetDump(locusSet));
+}
+
 BOOST_AUTO_TEST_CASE(test_SVLocusNoiseOverlap)
 {
   BOOST_TEST_MESSAGE("SDS MANTA-700");
@@ -1135,7 +1229,7 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSmallRegionClean)
 
     set1.cleanRegion(GenomeInterval(1, 0, 70));
 
-    TestSVLocusSetProperties(cset1, 2, 0, 0, 0);
+    TestSVLocusSetProperties(cset1, 1, 0, 0, 0);
   }
 
   {
@@ -1147,7 +1241,7 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSmallRegionClean)
 
     set1.cleanRegion(GenomeInterval(1, 25, 70));
 
-    TestSVLocusSetProperties(cset1, 2, 1, 2, 2);
+    TestSVLocusSetProperties(cset1, 1, 1, 2, 2);
   }
 
   {
@@ -1159,7 +1253,7 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSmallRegionClean)
 
     set1.cleanRegion(GenomeInterval(1, 5, 25));
 
-    TestSVLocusSetProperties(cset1, 2, 0, 0, 0);
+    TestSVLocusSetProperties(cset1, 1, 0, 0, 0);
   }
 
   {
@@ -1171,7 +1265,7 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSmallRegionClean)
 
     set1.cleanRegion(GenomeInterval(1, 5, 15));
 
-    TestSVLocusSetProperties(cset1, 2, 0, 0, 0);
+    TestSVLocusSetProperties(cset1, 1, 0, 0, 0);
   }
 }
 
@@ -1191,7 +1285,7 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSmallDelRegionClean)
 
     set1.cleanRegion(GenomeInterval(1, 0, 70));
 
-    TestSVLocusSetProperties(cset1, 2, 0, 0, 0);
+    TestSVLocusSetProperties(cset1, 1, 0, 0, 0);
   }
 
   {
@@ -1519,6 +1613,40 @@ BOOST_AUTO_TEST_CASE(test_SVLocusSet_Save_Load)
   TestSVLocusSetProperties(cset1_copy, 2, 2, 4, 4);
 }
 
+// Test loading a graph where a locus has more nodes than the first locus, and is followed by another locus
+BOOST_AUTO_TEST_CASE(test_SVLocusSet_Save_Load_LargerLocus)
+{
+  SVLocus locus1;
+  locusAddPair(locus1, 1, 10, 20, 2, 30, 40);
+
+  // construct a three-node locus
+  SVLocus             locus2;
+  const NodeIndexType nodePtr1(locus2.addNode(GenomeInterval(3, 60, 80)));
+  const NodeIndexType nodePtr2(locus2.addNode(GenomeInterval(4, 90, 100)));
+  const NodeIndexType nodePtr3(locus2.addNode(GenomeInterval(5, 110, 120)));
+  locus2.linkNodes(nodePtr1, nodePtr2);
+  locus2.linkNodes(nodePtr1, nodePtr3);
+
+  SVLocus locus3;
+  locusAddPair(locus3, 6, 10, 20, 7, 30, 40);
+
+  SVLocusSetOptions sopt;
+  sopt.minMergeEdgeObservations = 1;
+
+  SVLocusSet set1(sopt);
+  set1.merge(locus1);
+  set1.merge(locus2);
+  set1.merge(locus3);
+  set1.checkState(true, true);
+
+  const auto        set1_copy_ptr(getSerializedSVLocusSetCopy(set1));
+  const SVLocusSet& cset1_copy(*set1_copy_ptr);
+
+  cset1_copy.checkState(true, true);
+  BOOST_REQUIRE_EQUAL(cset1_copy.size(), 3u);
+  BOOST_REQUIRE_EQUAL(cset1_copy.getLocus(1).size(), 3u);
+}
+
 BOOST_AUTO_TEST_CASE(test_SVLocusSet_DumpLoci)
 {
   // construct a simple two-node locus
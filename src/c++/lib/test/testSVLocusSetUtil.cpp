@@ -22,13 +22,17 @@
 
 #include "boost/make_unique.hpp"
 
-std::unique_ptr<SVLocusSet> getSerializedSVLocusSetCopy(const SVLocusSet& set)
+std::unique_ptr<SVLocusSet> getSerializedSVLocusSetCopy(const SVLocusSet& set, const bool isFlat)
 {
   TestFilenameMaker testFilenameMaker;
   const char*       testFilenamePtr(testFilenameMaker.getFilename().c_str());
 
   // serialize
-  set.save(testFilenamePtr);
+  if (isFlat) {
+    set.saveFlat(testFilenamePtr);
+  } else {
+    set.save(testFilenamePtr);
+  }
 
   // deserialize
   return boost::make_unique<SVLocusSet>(testFilenamePtr);
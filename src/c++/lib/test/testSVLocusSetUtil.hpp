@@ -28,4 +28,6 @@
 #include <memory>
 
 /// Serialize, then deserialize object and pass back a pointer to the resulting object copy
-std::unique_ptr<SVLocusSet> getSerializedSVLocusSetCopy(const SVLocusSet& set);
+///
+/// \param[in] isFlat If true, serialize to the flat file format
+std::unique_ptr<SVLocusSet> getSerializedSVLocusSetCopy(const SVLocusSet& set, const bool isFlat = false);
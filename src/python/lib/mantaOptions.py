@@ -103,20 +103,17 @@ class MantaWorkflowOptionsBase(ConfigureWorkflowOptions) :
         getChromDepthBin=joinFile(libexecDir,exeFile("GetChromDepth"))
         mantaGraphBin=joinFile(libexecDir,exeFile("EstimateSVLoci"))
         mantaGraphMergeBin=joinFile(libexecDir,exeFile("MergeSVLoci"))
+        mantaMergeSVVcfBin=joinFile(libexecDir,exeFile("MergeSVVcf"))
         mantaGraphCheckBin=joinFile(libexecDir,exeFile("CheckSVLoci"))
         mantaHyGenBin=joinFile(libexecDir,exeFile("GenerateSVCandidates"))
         mantaGraphStatsBin=joinFile(libexecDir,exeFile("SummarizeSVLoci"))
         mantaStatsSummaryBin=joinFile(libexecDir,exeFile("SummarizeAlignmentStats"))
 
-        mergeChromDepth=joinFile(libexecDir,"mergeChromDepth.py")
-        mantaSortVcf=joinFile(libexecDir,"sortVcf.py")
         mantaExtraSmallVcf=joinFile(libexecDir,"extractSmallIndelCandidates.py")
         mantaPloidyFilter=joinFile(libexecDir,"ploidyFilter.py")
         mantaSortEdgeLogs=joinFile(libexecDir,"sortEdgeLogs.py")
         catScript=joinFile(libexecDir,"cat.py")
         vcfCmdlineSwapper=joinFile(libexecDir,"vcfCmdlineSwapper.py")
-        mantaSortBam=joinFile(libexecDir,"sortBam.py")
-        mantaMergeBam=joinFile(libexecDir,"mergeBam.py")
 
         workflowScriptName = "runWorkflow.py"
 
@@ -189,19 +189,21 @@ def runStats(self,taskPrefix="",dependencies=None) :
 
     for (bamIndex,bamPath) in enumerate(self.params.normalBamList + self.params.tumorBamList) :
         indexStr = str(bamIndex).zfill(3)
-        tmpStatsFiles.append(os.path.join(tmpStatsDir,statsFilename+"."+ indexStr +".xml"))
+        tmpStatsFiles.append(os.path.join(tmpStatsDir,statsFilename+"."+ indexStr +".bin"))
 
         cmd = [ self.params.mantaStatsBin ]
         cmd.extend(["--ref", self.params.referenceFasta])
-        cmd.extend(["--output-file",tmpStatsFiles[-1]])
+        cmd.extend(["--output-binary-file",tmpStatsFiles[-1]])
         cmd.extend(["--align-file",bamPath])
         if self.params.defaultAlignStatsFile:
             cmd.extend(["--default-stats-file",self.params.defaultAlignStatsFile])
 
         statsTasks.add(self.addTask(preJoin(taskPrefix,"generateStats_"+indexStr),cmd,dependencies=dirTask))
 
+    # the binary stats file is used by all downstream steps, the XML version is only written for human review
     cmd = [ self.params.mantaMergeStatsBin ]
-    cmd.extend(["--output-file",statsPath])
+    cmd.extend(["--output-binary-file",statsPath])
+    cmd.extend(["--output-file",self.paths.getStatsXmlPath()])
     for tmpStatsFile in tmpStatsFiles :
         cmd.extend(["--align-stats-file",tmpStatsFile])
 
@@ -289,7 +291,8 @@ def runLocusGraph(self,taskPrefix="",dependencies=None):
     mergeCmd = [ self.params.mantaGraphMergeBin ]
     mergeCmd.extend(["--output-file", graphPath])
     mergeCmd.extend(["--graph-file-list",tmpGraphFileList])
-    mergeTask = self.addTask(preJoin(taskPrefix,"mergeLocusGraph"),mergeCmd,dependencies=tmpGraphFileListTask,memMb=self.params.mergeMemMb)
+    mergeCmd.extend(["--threads", str(self.getNCores())])
+    mergeTask = self.addTask(preJoin(taskPrefix,"mergeLocusGraph"),mergeCmd,dependencies=tmpGraphFileListTask,nCores=self.getNCores(),memMb=self.params.mergeMemMb)
 
     # Run a separate process to rigorously check that the final graph is valid, the sv candidate generators will check as well, but
     # this makes the check much more clear:
@@ -330,46 +333,30 @@ class listFileWorkflow(WorkflowRunner) :
 
 
 
-def sortEvidenceBams(self, sortBamTasks, taskPrefix="", binStr="", dependencies=None):
-
-    for bamIdx, _ in enumerate(self.params.normalBamList + self.params.tumorBamList):
-        supportBam = self.paths.getSupportBamPath(bamIdx, binStr)
-        sortedBam = self.paths.getSortedSupportBamPath(bamIdx, binStr)
-
-
-        # first check the existence of the supporting bam
-        # then sort the bam only if it exists
-        sortBamCmd = [ sys.executable, self.params.mantaSortBam,
-                      self.params.samtoolsBin, supportBam, sortedBam ]
-
-        sortBamTask = preJoin(taskPrefix, "sortEvidenceBam_%s_%s" % (binStr, bamIdx))
-        sortBamTasks.add(self.addTask(sortBamTask, sortBamCmd, dependencies=dependencies))
-
-
 def sortAllVcfs(self, taskPrefix="", dependencies=None) :
     """sort/prep final vcf outputs"""
 
     nextStepWait = set()
 
     def getVcfSortCmd(vcfListFile, outPath, isDiploid, isCandidate) :
-        cmd  = "\"%s\" \"%s\" " % (sys.executable, self.params.mantaSortVcf)
-        cmd += "-f \"%s\"" % (vcfListFile)
+        cmd  = "\"%s\" " % (self.params.mantaMergeSVVcfBin)
+        cmd += "--vcf-list \"%s\"" % (vcfListFile)
 
         # Boolean variable isCandidate is set "True" for candidateSV.vcf
-        # If it is True, commandline argument "-a" is passed on to sortBam.py to print out all vcf records
+        # If it is True, commandline argument "--print-all" is passed on to MergeSVVcf to print out all vcf records
         if isCandidate:
-            cmd += " -a"
+            cmd += " --print-all"
 
         # apply the ploidy filter to diploid variants
         if isDiploid:
             tempVcf = self.paths.getTempDiploidPath()
             cmd += " > \"%s\"" % (tempVcf)
             cmd += " && \"%s\" \"%s\" \"%s\"" % (sys.executable, self.params.mantaPloidyFilter, tempVcf)
-
-        cmd += " | \"%s\" -c > \"%s\"" % (self.params.bgzipBin, outPath)
-
-        if isDiploid:
+            cmd += " | \"%s\" -c > \"%s\"" % (self.params.bgzipBin, outPath)
             cmd += " && " + " ".join(getRmCmd()) + " \"%s\"" % (self.paths.getTempDiploidPath())
+        else:
+            # write bgzip compressed output and its tabix index directly
+            cmd += " --output-file \"%s\"" % (outPath)
         return cmd
 
     def getVcfTabixCmd(vcfPath) :
@@ -397,7 +384,10 @@ def sortAllVcfs(self, taskPrefix="", dependencies=None) :
         sortCmd = getVcfSortCmd(vcfListFile, outPath, isDiploid, isCandidate)
         sortTask=self.addTask(preJoin(taskPrefix,"sort_"+label),sortCmd,dependencies=inputVcfTask)
 
-        nextStepWait.add(self.addTask(preJoin(taskPrefix,"tabix_"+label),getVcfTabixCmd(outPath),dependencies=sortTask,isForceLocal=True))
+        if isDiploid:
+            nextStepWait.add(self.addTask(preJoin(taskPrefix,"tabix_"+label),getVcfTabixCmd(outPath),dependencies=sortTask,isForceLocal=True))
+        else:
+            nextStepWait.add(sortTask)
         return sortTask
 
 
@@ -438,26 +428,21 @@ def sortAllVcfs(self, taskPrefix="", dependencies=None) :
 
 
 
-def mergeEvidenceBams(self, mergeBamTasks, taskPrefix="", dependencies=None) :
+def moveEvidenceBams(self, moveBamTasks, taskPrefix="", binStr="", dependencies=None) :
+    """
+    Move the sorted and indexed evidence bams written by candidate generation to their final location
+    """
 
     for bamIdx, bamPath in enumerate(self.params.normalBamList + self.params.tumorBamList) :
-        # merge support bams
+        supportBam = self.paths.getSupportBamPath(bamIdx, binStr)
         evidenceBamFile = self.paths.getFinalSupportBamPath(bamPath, bamIdx)
-        mergeCmd = [ sys.executable, self.params.mantaMergeBam,
-                     self.params.samtoolsBin,
-                     self.paths.getSortedSupportBamMask(bamIdx),
-                     evidenceBamFile,
-                     self.paths.getSupportBamListPath(bamIdx) ]
 
-        mergeBamTask=self.addTask(preJoin(taskPrefix,"merge_evidenceBam_%s" % (bamIdx)),
-                                  mergeCmd, dependencies=dependencies)
+        mvCmd = " ".join(getMvCmd())
+        moveCmd  = mvCmd + " \"%s\" \"%s\"" % (supportBam, evidenceBamFile)
+        moveCmd += " && " + mvCmd + " \"%s.bai\" \"%s.bai\"" % (supportBam, evidenceBamFile)
 
-        # index the filtered bam
-        ### TODO still needs to handle the case where supportBamFile does not exist
-        indexCmd = [ self.params.samtoolsBin, "index", evidenceBamFile ]
-        indexBamTask = self.addTask(preJoin(taskPrefix,"index_evidenceBam_%s" % (bamIdx)),
-                                    indexCmd, dependencies=mergeBamTask)
-        mergeBamTasks.add(indexBamTask)
+        moveBamTasks.add(self.addTask(preJoin(taskPrefix,"move_evidenceBam_%s" % (bamIdx)),
+                                      moveCmd, dependencies=dependencies, isForceLocal=True))
 
 
 
@@ -480,7 +465,7 @@ def runHyGen(self, taskPrefix="", dependencies=None) :
 
     hygenTasks=set()
     if self.params.isGenerateSupportBam :
-        sortEvidenceBamTasks = set()
+        moveEvidenceBamTasks = set()
 
     self.candidateVcfPaths = []
     self.diploidVcfPaths = []
@@ -577,13 +562,8 @@ def runHyGen(self, taskPrefix="", dependencies=None) :
         hygenTasks.add(self.addTask(hygenTask,hygenCmd,dependencies=dirTask, nCores=self.getNCores(), memMb=self.params.hyGenMemMb))
 
         if self.params.isGenerateSupportBam :
-            # sort evidence bams
-            #
-            # TODO: if the bam is large, for efficiency, consider
-            # 1) filtering the bin-specific bam first w.r.t. the final candidate vcf
-            # 2) then sort the bin-specific bam and merge them
-            # This would require moving the filter/sort bam jobs outside the hygen loop
-            sortEvidenceBams(self, sortEvidenceBamTasks, taskPrefix=taskPrefix, binStr=binStr, dependencies=hygenTask)
+            # evidence bams are written sorted and indexed by candidate generation
+            moveEvidenceBams(self, moveEvidenceBamTasks, taskPrefix=taskPrefix, binStr=binStr, dependencies=hygenTask)
 
     nextStepWait = copy.deepcopy(hygenTasks)
 
@@ -591,13 +571,7 @@ def runHyGen(self, taskPrefix="", dependencies=None) :
     nextStepWait = nextStepWait.union(vcfTasks)
 
     if self.params.isGenerateSupportBam :
-        mergeBamTasks = set()
-
-        # merge evidence bams
-        mergeEvidenceBams(self, mergeBamTasks, taskPrefix=taskPrefix,
-                          dependencies=sortEvidenceBamTasks)
-
-        nextStepWait = nextStepWait.union(mergeBamTasks)
+        nextStepWait = nextStepWait.union(moveEvidenceBamTasks)
 
     #
     # sort the edge runtime logs
@@ -632,6 +606,9 @@ class PathInfo:
         self.params = params
 
     def getStatsPath(self) :
+        return os.path.join(self.params.workDir,"alignmentStats.bin")
+
+    def getStatsXmlPath(self) :
         return os.path.join(self.params.workDir,"alignmentStats.xml")
 
     def getStatsSummaryPath(self) :
@@ -712,23 +689,11 @@ class PathInfo:
         return os.path.join(self.getHyGenDir(),
                             "evidence_%s" % (binStr))
 
-    def getSortedSupportBamPath(self, bamIdx, binStr):
-        return os.path.join(self.getHyGenDir(),
-                            "evidence_%s.bam_%s.sorted.bam" % (binStr, bamIdx))
-
-    def getSortedSupportBamMask(self, bamIdx):
-        return os.path.join(self.getHyGenDir(),
-                            "evidence_*.bam_%s.sorted.bam" % (bamIdx))
-
     def getFinalSupportBamPath(self, bamPath, bamIdx):
         bamPrefix = os.path.splitext(os.path.basename(bamPath))[0]
         return os.path.join(self.params.evidenceDir,
                             "evidence_%s.%s.bam" % (bamIdx, bamPrefix))
 
-    def getSupportBamListPath(self, bamIdx):
-        return os.path.join(self.getHyGenDir(),
-                            "list.evidence.bam_%s.txt" % (bamIdx))
-
     def getTmpGraphFileListPath(self) :
         return os.path.join(self.getTmpGraphDir(),"list.svLocusGraph.txt")
 
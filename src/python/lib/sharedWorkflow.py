@@ -29,7 +29,7 @@ import sys
 scriptDir=os.path.abspath(os.path.dirname(__file__))
 sys.path.append(os.path.abspath(scriptDir))
 
-from workflowUtil import isWindows, preJoin, getRobustChromId
+from workflowUtil import isWindows, preJoin
 
 
 
@@ -93,102 +93,26 @@ def quoteStringList(strList):
 
 
 
-def _getDepthShared(self,taskPrefix, dependencies, bamList, outputPath, depthFunc) :
-    """
-    estimate chrom depth using the specified depthFunc to compute per-sample depth
+def getDepthFromAlignments(self, bamList, outputPath, taskPrefix="", dependencies=None) :
     """
+    estimate chrom depth directly from BAM/CRAM files
 
-    outputFilename=os.path.basename(outputPath)
-
-    tmpDir=outputPath+".tmpdir"
-    makeTmpDirCmd = getMkdirCmd() + [tmpDir]
-    dirTask=self.addTask(preJoin(taskPrefix,"makeTmpDir"), makeTmpDirCmd, dependencies=dependencies, isForceLocal=True)
-
-    tmpFiles = []
-    scatterTasks = set()
+    A single GetChromDepth task estimates all chromosomes of all BAM/CRAM files in parallel, and writes the
+    chrom depth file summed over all files.
+    """
 
-    for (bamIndex, bamFile) in enumerate(bamList) :
-        indexStr = str(bamIndex).zfill(3)
-        tmpFiles.append(os.path.join(tmpDir,outputFilename+"."+ indexStr +".txt"))
-        scatterTasks |= setzer(depthFunc(self,taskPrefix+"_sample"+indexStr,dirTask,bamFile,tmpFiles[-1]))
+    cmd = [self.params.getChromDepthBin,"--ref", self.params.referenceFasta, "--output-file", outputPath]
+    cmd.extend(["--threads", str(self.getNCores())])
+    for bamFile in bamList :
+        cmd.extend(["--align-file", bamFile])
 
-    cmd = [ self.params.mergeChromDepth ]
-    cmd.extend(["--out",outputPath])
-    for tmpFile in tmpFiles :
-        cmd.extend(["--in",tmpFile])
+    for chromLabel in self.params.chromOrder :
+        if chromLabel in self.params.chromIsSkipped : continue
+        cmd.extend(["--chrom", chromLabel])
 
-    mergeTask = self.addTask(preJoin(taskPrefix,"mergeChromDepth"),cmd,dependencies=scatterTasks,isForceLocal=True)
+    depthTask = self.addTask(preJoin(taskPrefix,"estimateChromDepth"),cmd,dependencies=dependencies,
+                             nCores=self.getNCores(),memMb=self.params.estimateMemMb)
 
     nextStepWait = set()
-    nextStepWait.add(mergeTask)
-
-    if not self.params.isRetainTempFiles :
-        rmTmpCmd = getRmdirCmd() + [tmpDir]
-        rmTask=self.addTask(preJoin(taskPrefix,"removeTmpDir"),rmTmpCmd,dependencies=mergeTask, isForceLocal=True)
-
+    nextStepWait.add(depthTask)
     return nextStepWait
-
-
-def getDepthFromAlignments(self, bamList, outputPath, taskPrefix="", dependencies=None) :
-    """
-    estimate chrom depth directly from BAM/CRAM file
-    """
-
-    def depthFunc(self,taskPrefix,dependencies,bamFile,outFile) :
-        outputPath=outFile
-        outputFilename=os.path.basename(outputPath)
-
-        tmpDir=os.path.join(outputPath+".tmpdir")
-        makeTmpDirCmd = getMkdirCmd() + [tmpDir]
-        dirTask=self.addTask(preJoin(taskPrefix,"makeTmpDir"), makeTmpDirCmd, dependencies=dependencies, isForceLocal=True)
-
-        tmpFiles = []
-        scatterTasks = set()
-
-        def getChromosomeGroups(params) :
-            """
-            Iterate through chromosomes/contigs and group small contigs together. This functions as a generator yielding
-            successive contig groups.
-            """
-            minSize=200000
-            group = []
-            headSize = 0
-
-            chromCount = len(params.chromSizes)
-            assert(len(params.chromOrder) == chromCount)
-            for chromIndex in range(chromCount) :
-                chromLabel = params.chromOrder[chromIndex]
-                if chromLabel in params.chromIsSkipped : continue
-
-                chromSize = params.chromSizes[chromLabel]
-                if headSize+chromSize <= minSize :
-                    group.append((chromIndex,chromLabel))
-                    headSize += chromSize
-                else :
-                    if len(group) != 0 : yield(group)
-                    group = [(chromIndex,chromLabel)]
-                    headSize = chromSize
-            if len(group) != 0 : yield(group)
-
-        for chromGroup in getChromosomeGroups(self.params) :
-            assert(len(chromGroup) > 0)
-            cid = getRobustChromId(chromGroup[0][0], chromGroup[0][1])
-            if len(chromGroup) > 1 :
-                cid += "_to_"+getRobustChromId(chromGroup[-1][0], chromGroup[-1][1])
-            tmpFiles.append(os.path.join(tmpDir,outputFilename+"_"+cid))
-            cmd = [self.params.getChromDepthBin,"--ref", self.params.referenceFasta, "--align-file", bamFile, "--output", tmpFiles[-1]]
-            for (chromIndex,chromLabel) in chromGroup :
-                cmd.extend(["--chrom",chromLabel])
-            scatterTasks.add(self.addTask(preJoin(taskPrefix,"estimateChromDepth_"+cid),cmd,dependencies=dirTask,memMb=self.params.estimateMemMb))
-
-        assert(len(tmpFiles) != 0)
-
-        catCmd = [self.params.catScript,"--output",outputPath]+tmpFiles
-        catTask = self.addTask(preJoin(taskPrefix,"catChromDepth"),catCmd,dependencies=scatterTasks, isForceLocal=True)
-
-        nextStepWait = set()
-        nextStepWait.add(catTask)
-
-        return nextStepWait
-
-    return _getDepthShared(self, taskPrefix, dependencies, bamList, outputPath, depthFunc)